@@ -18,12 +18,15 @@
 #ifndef ERAGPSIM_ARCH_COMMON_ABSTRACT_REGISTER_NODE_HPP
 #define ERAGPSIM_ARCH_COMMON_ABSTRACT_REGISTER_NODE_HPP
 
+#include <mutex>
 #include <string>
 
 #include "arch/common/abstract-syntax-tree-node.hpp"
 #include "arch/common/architecture-properties.hpp"
 #include "arch/common/validation-result.hpp"
+#include "core/integer-operand.hpp"
 #include "core/memory-value.hpp"
+#include "core/register-id.hpp"
 
 /**
  * A node that represents a register.
@@ -50,6 +53,14 @@ class AbstractRegisterNode : public AbstractSyntaxTreeNode {
   MemoryValue getValue(MemoryAccess& memoryAccess) const override;
 
   /**
+   * \return The content of the register, read by its RegisterID.
+   */
+  IntegerOperand getOperand(MemoryAccess& memoryAccess) const override;
+
+  /**
+   * Looks up the RegisterID of the register, as this is called while
+   * parsing.
+   *
    * \return succefss, if there are no children.
    */
   ValidationResult validate(MemoryAccess& memoryAccess) const override;
@@ -62,6 +73,18 @@ class AbstractRegisterNode : public AbstractSyntaxTreeNode {
  protected:
   /** The name of the register (e.g. "x12" or "pc"). */
   std::string _name;
+
+ private:
+  /**
+   * Looks up the RegisterID once, even if several harts execute this node.
+   */
+  void _resolveID(MemoryAccess& memoryAccess) const;
+
+  /** Whether the RegisterID was looked up. */
+  mutable std::once_flag _resolved;
+
+  /** The RegisterID of the register in the project. */
+  mutable RegisterID _id;
 };
 
 #endif /* ERAGPSIM_ARCH_COMMON_ABSTRACT_REGISTER_NODE_HPP */
@@ -24,6 +24,7 @@
 
 class MemoryValue;
 class MemoryAccess;
+struct IntegerOperand;
 class ValidationResult;
 
 /** The base class for nodes in the abstract syntax tree */
@@ -64,6 +65,19 @@ class AbstractSyntaxTreeNode {
   /** \copydoc getValue() */
   MemoryValue operator()(MemoryAccess& memoryAccess) const;
 
+  /**
+   * Executes this node and returns its value as native integer.
+   *
+   * Operands of instructions are read like this. Nodes that know their value
+   * without converting a memory value (like immediates and registers) override
+   * this, the default converts the result of getValue().
+   *
+   * \param memoryAccess An access object to memory and registers.
+   *
+   * \return The lower 64 bit of the value of this node.
+   */
+  virtual IntegerOperand getOperand(MemoryAccess& memoryAccess) const;
+
   /**
    * Validates the structure of this syntax tree. This should be called
    * while the assembler code is parsed.
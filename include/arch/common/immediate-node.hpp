@@ -23,6 +23,7 @@
 #include <string>
 
 #include "arch/common/abstract-syntax-tree-node.hpp"
+#include "core/integer-operand.hpp"
 #include "core/memory-value.hpp"
 
 class MemoryAccess;
@@ -46,6 +47,11 @@ class ImmediateNode : public AbstractSyntaxTreeNode {
    */
   MemoryValue getValue(MemoryAccess& MemoryAccess) const override;
 
+  /**
+   * \return The concrete value, converted when it was set.
+   */
+  IntegerOperand getOperand(MemoryAccess& memoryAccess) const override;
+
   /**
    * \return success, if there are no children.
    */
@@ -66,6 +72,9 @@ class ImmediateNode : public AbstractSyntaxTreeNode {
  private:
   MemoryValue _value;
 
+  /** The value as integer, so that reading it needs no copy. */
+  IntegerOperand _operand;
+
   // needed, because getIdentifier returns a reference
   static const std::string IMMEDIATE_IDENTIFIER;
 };
@@ -20,6 +20,7 @@
 #ifndef ERAGPSIM_ARCH_REGISTER_INFORMATION_HPP
 #define ERAGPSIM_ARCH_REGISTER_INFORMATION_HPP
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -68,7 +69,15 @@ class RegisterInformation : public InformationInterface {
   using ConstituentList = std::initializer_list<ConstituentInformation>;
 
   /** The type of data stored in this register. */
-  enum class Type { INTEGER, FLOAT, VECTOR, FLAG, LINK, PROGRAM_COUNTER };
+  enum class Type {
+    INTEGER,
+    FLOAT,
+    VECTOR,
+    FLAG,
+    LINK,
+    PROGRAM_COUNTER,
+    HART_ID
+  };
 
   /**
    * Tests if the given register type is special.
@@ -410,8 +419,11 @@ class RegisterInformation : public InformationInterface {
   bool isValid() const noexcept override;
 
  private:
-  /** An ID that increments for each new created instance (for default IDs). */
-  static id_t _rollingID;
+  /**
+   * An ID that increments for each new created instance (for default IDs).
+   * Atomic, as architectures are also brewed in the background.
+   */
+  static std::atomic<id_t> _rollingID;
 
   /**
    * Deserializes the RegisterInformation from the given data.
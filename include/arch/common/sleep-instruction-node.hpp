@@ -25,6 +25,8 @@
  * a certain amount of time.
  * This time in milliseconds will be the result of calling the only child's
  * getValue() and converting it into a number.
+ * The sleep does not block, it is requested through MemoryAccess::sleep() and
+ * the execution is suspended after this instruction.
  * This instruction is not automatically available in a architecture
  * implementation. In order to use it, this instruction must be
  * returned in the architecture specific implementation of
@@ -63,8 +65,8 @@ class SimulatorSleepInstructionNode : public AbstractInstructionNode {
   ValidationResult validateRuntime(MemoryAccess& memoryAccess) const override;
 
   /**
-   * Retrieves the numeric value of the operand and holds the execution of the
-   * next instruction for that value in milliseconds
+   * Retrieves the numeric value of the operand and requests to hold the
+   * execution of the next instruction for that value in milliseconds
    * \param memoryAccess
    * \return Returnes the adress for the next instruction
    */
@@ -74,9 +76,9 @@ class SimulatorSleepInstructionNode : public AbstractInstructionNode {
   /**
    * Function to ensure matching architecture specific behaviour without the
    * need to extend.
-   * This function gets called after sleeping in getValue() and should return
-   * the adress of the next instruction (see return value in getValue()
-   * documentation)
+   * This function gets called after requesting the sleep in getValue() and
+   * should return the adress of the next instruction (see return value in
+   * getValue() documentation)
    */
   const PCIncrementer _pcIncFunction;
 };
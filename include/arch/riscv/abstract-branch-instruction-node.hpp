@@ -62,7 +62,8 @@ template <typename UnsignedWord, typename SignedWord>
 class AbstractBranchInstructionNode : public InstructionNode {
  public:
   using super = InstructionNode;
-  using Condition = std::function<bool(const MemoryValue&, const MemoryValue&)>;
+  using Condition =
+      std::function<bool(const IntegerOperand&, const IntegerOperand&)>;
 
   /**
    * An enum indicating whether the
@@ -105,8 +106,8 @@ class AbstractBranchInstructionNode : public InstructionNode {
    */
   MemoryValue getValue(MemoryAccess& memoryAccess) const override {
     assert::that(validate(memoryAccess).isSuccess());
-    auto first = _children[0]->getValue(memoryAccess);
-    auto second = _children[1]->getValue(memoryAccess);
+    auto first = _children[0]->getOperand(memoryAccess);
+    auto second = _children[1]->getOperand(memoryAccess);
 
     if (_checkCondition(first, second)) {
       auto programCounter =
@@ -185,13 +186,13 @@ class AbstractBranchInstructionNode : public InstructionNode {
    * it is not clear at this point if they should be converted to signed or
    * unsigned types.
    *
-   * \param first The first operand's memory value.
-   * \param second The second operand's memory value.
+   * \param first The first operand's value.
+   * \param second The second operand's value.
    *
    * \return True if the condition w.r.t. the operands holds, else false.
    */
-  virtual bool _checkCondition(const MemoryValue& first,
-                               const MemoryValue& second) const {
+  virtual bool _checkCondition(const IntegerOperand& first,
+                               const IntegerOperand& second) const {
     assert::that(static_cast<bool>(_condition));
     return _condition(first, second);
   }
@@ -29,6 +29,7 @@
 #include "common/utility.hpp"
 #include "core/memory-access.hpp"
 #include "core/memory-value.hpp"
+#include "core/transaction.hpp"
 
 namespace riscv {
 
@@ -89,9 +90,23 @@ class AbstractLoadStoreInstructionNode : public InstructionNode {
 
   ValidationResult validateRuntime(MemoryAccess& memoryAccess) const override {
     size_t effectiveAddress = _getEffectiveAddress(memoryAccess);
-
-    if (effectiveAddress + _byteAmount - 1 >
-        memoryAccess.getMemorySize().get()) {
+    auto byteAmount = _byteAmount;
+    auto writesProtectedMemory = _writesProtectedMemory;
+
+    // Check the range and the protection in a single request
+    auto check = memoryAccess
+                     .transaction([=](Transaction& transaction) {
+                       auto outOfRange = effectiveAddress + byteAmount - 1 >
+                                         transaction.getMemorySize();
+                       auto isProtected =
+                           !outOfRange && writesProtectedMemory &&
+                           transaction.isMemoryProtectedAt(effectiveAddress,
+                                                           byteAmount);
+                       return std::make_pair(outOfRange, isProtected);
+                     })
+                     .get();
+
+    if (check.first) {
       return ValidationResult::fail(
           QT_TRANSLATE_NOOP("Syntax-Tree-Validation",
                             "The memory area you are trying to access is "
@@ -100,8 +115,7 @@ class AbstractLoadStoreInstructionNode : public InstructionNode {
           std::to_string(effectiveAddress + _byteAmount - 1));
     }
 
-    if (_writesProtectedMemory &&
-        memoryAccess.isMemoryProtectedAt(effectiveAddress, _byteAmount).get()) {
+    if (check.second) {
       return ValidationResult::fail(
           QT_TRANSLATE_NOOP("Syntax-Tree-Validation",
                             "The memory area you are trying to access is "
@@ -118,8 +132,8 @@ class AbstractLoadStoreInstructionNode : public InstructionNode {
    * \returns the value of the child that holds the base address.
    * \parma memoryAccess The memory access to retrive the register value.
    */
-  MemoryValue _getBase(MemoryAccess& memoryAccess) const {
-    return super::_children.at(1)->getValue(memoryAccess);
+  IntegerOperand _getBase(MemoryAccess& memoryAccess) const {
+    return super::_children.at(1)->getOperand(memoryAccess);
   }
 
   /**
@@ -127,8 +141,8 @@ class AbstractLoadStoreInstructionNode : public InstructionNode {
    * address.
    * \param memoryAccess The memory access to retrive the register value.
    */
-  MemoryValue _getOffset(MemoryAccess& memoryAccess) const {
-    return super::_children.at(2)->getValue(memoryAccess);
+  IntegerOperand _getOffset(MemoryAccess& memoryAccess) const {
+    return super::_children.at(2)->getOperand(memoryAccess);
   }
 
   /**
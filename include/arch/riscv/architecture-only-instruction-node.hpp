@@ -166,8 +166,8 @@ class ArchitectureOnlyInstructionNode : public InstructionNode {
 
  private:
   OperationSize _getChildValue(size_t index, MemoryAccess& memoryAccess) const {
-    auto memory = _children[index]->getValue(memoryAccess);
-    return riscv::convert<OperationSize>(memory);
+    auto operand = _children[index]->getOperand(memoryAccess);
+    return riscv::convert<OperationSize>(operand);
   }
 
   ValidationResult _validateNumberOfChildren() const {
@@ -0,0 +1,377 @@
+/* C++ Assembler Interpreter
+ * Copyright (C) 2016 Chair of Computer Architecture
+ * at Technical University of Munich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef ERAGPSIM_ARCH_RISCV_ATOMIC_INSTRUCTIONS_HPP
+#define ERAGPSIM_ARCH_RISCV_ATOMIC_INSTRUCTIONS_HPP
+
+#include <QtGlobal>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "arch/common/validation-result.hpp"
+#include "arch/riscv/format.hpp"
+#include "arch/riscv/instruction-node.hpp"
+#include "arch/riscv/utility.hpp"
+#include "common/assert.hpp"
+#include "core/memory-access.hpp"
+#include "core/memory-value.hpp"
+#include "core/transaction.hpp"
+
+namespace riscv {
+
+/**
+ * \brief Superclass of the instructions of the "A" extension.
+ *
+ * The memory access of an atomic instruction is a single transaction on the
+ * project, so it never interleaves with the accesses of other harts. As the
+ * project orders the accesses of all harts, they are sequentially consistent
+ * and the aq and rl bits of the specification hold implicitly.
+ *
+ * The operands are `rd, rs2, rs1`, like `rd, rs2, (rs1)` in the
+ * specification. Load-reserved has no `rs2`.
+ */
+template <typename UnsignedWord, typename SignedWord>
+class AbstractAtomicInstructionNode : public InstructionNode {
+ public:
+  using size_t = std::size_t;
+
+  AbstractAtomicInstructionNode(
+      const InstructionInformation& instructionInformation,
+      size_t byteAmount,
+      size_t operandAmount,
+      bool writesMemory)
+  : InstructionNode(instructionInformation)
+  , _byteAmount(byteAmount)
+  , _operandAmount(operandAmount)
+  , _writesMemory(writesMemory) {
+  }
+
+  /* Ensure this class is pure virtual */
+  virtual MemoryValue getValue(MemoryAccess& memoryAccess) const override = 0;
+
+  ValidationResult validate(MemoryAccess& memoryAccess) const override {
+    if (_children.size() != _operandAmount) {
+      return ValidationResult::fail(
+          QT_TRANSLATE_NOOP("Syntax-Tree-Validation",
+                            "This instruction must have exactly %1 operands"),
+          std::to_string(_operandAmount));
+    }
+
+    if (!_requireChildren(
+            AbstractSyntaxTreeNode::Type::REGISTER, 0, _operandAmount)) {
+      return ValidationResult::fail(
+          QT_TRANSLATE_NOOP("Syntax-Tree-Validation",
+                            "The atomic instructions must have only "
+                            "registers as operands"));
+    }
+
+    return _validateChildren(memoryAccess);
+  }
+
+  ValidationResult validateRuntime(MemoryAccess& memoryAccess) const override {
+    size_t address = _getAddress(memoryAccess);
+
+    if (address % _byteAmount != 0) {
+      return ValidationResult::fail(
+          QT_TRANSLATE_NOOP("Syntax-Tree-Validation",
+                            "The address of an atomic instruction must be a "
+                            "multiple of %1 (address: %2)"),
+          std::to_string(_byteAmount),
+          std::to_string(address));
+    }
+
+    auto byteAmount = _byteAmount;
+    auto writesMemory = _writesMemory;
+
+    // Check the range and the protection in a single request
+    auto check = memoryAccess
+                     .transaction([=](Transaction& transaction) {
+                       auto outOfRange = address + byteAmount - 1 >
+                                         transaction.getMemorySize();
+                       auto isProtected =
+                           !outOfRange && writesMemory &&
+                           transaction.isMemoryProtectedAt(address,
+                                                           byteAmount);
+                       return std::make_pair(outOfRange, isProtected);
+                     })
+                     .get();
+
+    if (check.first) {
+      return ValidationResult::fail(
+          QT_TRANSLATE_NOOP("Syntax-Tree-Validation",
+                            "The memory area you are trying to access is "
+                            "out of range (area: [%1,%2])"),
+          std::to_string(address),
+          std::to_string(address + _byteAmount - 1));
+    }
+
+    if (check.second) {
+      return ValidationResult::fail(
+          QT_TRANSLATE_NOOP("Syntax-Tree-Validation",
+                            "The memory area you are trying to access is "
+                            "protected (area: [%1,%2])"),
+          std::to_string(address),
+          std::to_string(address + _byteAmount - 1));
+    }
+
+    return ValidationResult::success();
+  }
+
+  MemoryValue assemble() const override {
+    // The encoding orders the registers as rd, rs1, rs2
+    Format::Operands operands;
+    operands.emplace_back(_children.at(0)->assemble());
+    operands.emplace_back(_children.back()->assemble());
+    if (_operandAmount == 3) {
+      operands.emplace_back(_children.at(1)->assemble());
+    } else {
+      operands.emplace_back(riscv::convert<riscv::unsigned32_t>(0));
+    }
+    return InstructionNode::_assemble(operands);
+  }
+
+ protected:
+  /**
+   * \returns the address of the memory, held by rs1.
+   * \param memoryAccess The memory access to retrieve the register value.
+   */
+  size_t _getAddress(MemoryAccess& memoryAccess) const {
+    return riscv::convert<UnsignedWord>(
+        _children.back()->getOperand(memoryAccess));
+  }
+
+  /**
+   * \returns the lower bytes of rs2, which are written to the memory.
+   * \param memoryAccess The memory access to retrieve the register value.
+   */
+  MemoryValue _getSource(MemoryAccess& memoryAccess) const {
+    auto value = _children.at(1)->getValue(memoryAccess);
+    return value.subSet(0, _byteAmount * riscv::BITS_PER_BYTE);
+  }
+
+  /**
+   * Sign-extends a value loaded from memory to the size of a register.
+   *
+   * This is static, as it runs on the project thread, where the node might
+   * not exist anymore.
+   */
+  static MemoryValue _toRegister(const MemoryValue& value) {
+    SignedWord extended;
+    if (value.getSize() == 32) {
+      extended = riscv::convert<std::int32_t>(value);
+    } else {
+      extended = riscv::convert<SignedWord>(value);
+    }
+    return riscv::convert<UnsignedWord>(static_cast<UnsignedWord>(extended));
+  }
+
+  /** The amount of bytes this instruction operates on. */
+  size_t _byteAmount;
+
+  /** The number of register operands. */
+  size_t _operandAmount;
+
+  /** Whether this instruction writes memory. */
+  bool _writesMemory;
+};
+
+/**
+ * \brief Represents a load-reserved instruction (LR.W and LR.D).
+ *
+ * Loads a value and reserves its memory for the hart, see
+ * Project::loadReserved().
+ */
+template <typename UnsignedWord, typename SignedWord>
+class LoadReservedInstructionNode
+    : public AbstractAtomicInstructionNode<UnsignedWord, SignedWord> {
+ public:
+  using super = AbstractAtomicInstructionNode<UnsignedWord, SignedWord>;
+  using typename super::size_t;
+
+  LoadReservedInstructionNode(
+      const InstructionInformation& instructionInformation, size_t byteAmount)
+  : super(instructionInformation, byteAmount, 2, false) {
+  }
+
+  MemoryValue getValue(MemoryAccess& memoryAccess) const override {
+    assert::that(super::validate(memoryAccess));
+
+    const auto& destination = super::_children.at(0)->getIdentifier();
+    auto address = super::_getAddress(memoryAccess);
+    auto byteAmount = super::_byteAmount;
+
+    memoryAccess.runTransaction([=](Transaction& transaction) {
+      auto value = transaction.loadReserved(address, byteAmount);
+      transaction.putRegisterValue(destination, super::_toRegister(value));
+    });
+
+    return super::template _incrementProgramCounter<UnsignedWord>(memoryAccess);
+  }
+};
+
+/**
+ * \brief Represents a store-conditional instruction (SC.W and SC.D).
+ *
+ * Stores rs2 if the hart still holds the reservation of the memory, see
+ * Project::storeConditional(). rd is set to zero if the value was stored and
+ * to one otherwise.
+ */
+template <typename UnsignedWord, typename SignedWord>
+class StoreConditionalInstructionNode
+    : public AbstractAtomicInstructionNode<UnsignedWord, SignedWord> {
+ public:
+  using super = AbstractAtomicInstructionNode<UnsignedWord, SignedWord>;
+  using typename super::size_t;
+
+  StoreConditionalInstructionNode(
+      const InstructionInformation& instructionInformation, size_t byteAmount)
+  : super(instructionInformation, byteAmount, 3, true) {
+  }
+
+  MemoryValue getValue(MemoryAccess& memoryAccess) const override {
+    assert::that(super::validate(memoryAccess));
+
+    const auto& destination = super::_children.at(0)->getIdentifier();
+    auto source = super::_getSource(memoryAccess);
+    auto address = super::_getAddress(memoryAccess);
+
+    memoryAccess.runTransaction([=](Transaction& transaction) {
+      auto stored = transaction.storeConditional(address, source);
+      UnsignedWord result = stored ? 0 : 1;
+      transaction.putRegisterValue(destination,
+                                   riscv::convert<UnsignedWord>(result));
+    });
+
+    return super::template _incrementProgramCounter<UnsignedWord>(memoryAccess);
+  }
+};
+
+/**
+ * \brief Represents an atomic memory operation (the AMO instructions).
+ *
+ * Loads a value into rd, combines it with rs2 and stores the result, all
+ * without another hart accessing the memory in between.
+ */
+template <typename UnsignedWord, typename SignedWord>
+class AtomicMemoryOperationInstructionNode
+    : public AbstractAtomicInstructionNode<UnsignedWord, SignedWord> {
+ public:
+  using super = AbstractAtomicInstructionNode<UnsignedWord, SignedWord>;
+  using typename super::size_t;
+
+  /* The different operations. See RISC V specification for reference. */
+  enum class Operation {
+    SWAP,          // AMOSWAP
+    ADD,           // AMOADD
+    XOR,           // AMOXOR
+    AND,           // AMOAND
+    OR,            // AMOOR
+    MIN,           // AMOMIN
+    MAX,           // AMOMAX
+    MIN_UNSIGNED,  // AMOMINU
+    MAX_UNSIGNED   // AMOMAXU
+  };
+
+  AtomicMemoryOperationInstructionNode(
+      const InstructionInformation& instructionInformation,
+      size_t byteAmount,
+      Operation operation)
+  : super(instructionInformation, byteAmount, 3, true)
+  , _operation(operation) {
+  }
+
+  MemoryValue getValue(MemoryAccess& memoryAccess) const override {
+    assert::that(super::validate(memoryAccess));
+
+    const auto& destination = super::_children.at(0)->getIdentifier();
+    auto source = super::_getSource(memoryAccess);
+    auto address = super::_getAddress(memoryAccess);
+    auto byteAmount = super::_byteAmount;
+    auto operation = _operation;
+
+    memoryAccess.runTransaction([=](Transaction& transaction) {
+      auto value = transaction.getMemoryValueAt(address, byteAmount);
+      transaction.putMemoryValueAt(address, compute(operation, value, source));
+      transaction.putRegisterValue(destination, super::_toRegister(value));
+    });
+
+    return super::template _incrementProgramCounter<UnsignedWord>(memoryAccess);
+  }
+
+  /**
+   * Combines the value in memory with the value of rs2.
+   *
+   * \param operation The operation to perform.
+   * \param memory The value in memory.
+   * \param source The value of rs2, as large as memory.
+   * \return The value to store.
+   */
+  static MemoryValue compute(Operation operation,
+                             const MemoryValue& memory,
+                             const MemoryValue& source) {
+    assert::that(memory.getSize() == source.getSize());
+    if (memory.getSize() == 32) {
+      return _compute<std::uint32_t, std::int32_t>(operation, memory, source);
+    }
+    return _compute<std::uint64_t, std::int64_t>(operation, memory, source);
+  }
+
+ private:
+  template <typename Unsigned, typename Signed>
+  static MemoryValue _compute(Operation operation,
+                              const MemoryValue& memory,
+                              const MemoryValue& source) {
+    auto first = riscv::convert<Unsigned>(memory);
+    auto second = riscv::convert<Unsigned>(source);
+    auto firstSigned = static_cast<Signed>(first);
+    auto secondSigned = static_cast<Signed>(second);
+
+    Unsigned result = 0;
+    switch (operation) {
+      case Operation::SWAP: result = second; break;
+      case Operation::ADD: result = first + second; break;
+      case Operation::XOR: result = first ^ second; break;
+      case Operation::AND: result = first & second; break;
+      case Operation::OR: result = first | second; break;
+      case Operation::MIN:
+        result = firstSigned < secondSigned ? first : second;
+        break;
+      case Operation::MAX:
+        result = firstSigned < secondSigned ? second : first;
+        break;
+      case Operation::MIN_UNSIGNED:
+        result = first < second ? first : second;
+        break;
+      case Operation::MAX_UNSIGNED:
+        result = first < second ? second : first;
+        break;
+      default: assert::that(false);
+    }
+
+    return riscv::convert<Unsigned>(result);
+  }
+
+  /** The operation of this instruction. */
+  Operation _operation;
+};
+}
+
+#endif /* ERAGPSIM_ARCH_RISCV_ATOMIC_INSTRUCTIONS_HPP */
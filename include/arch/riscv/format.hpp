@@ -22,6 +22,8 @@
 #include <string>
 #include <vector>
 
+#include "arch/riscv/instruction-table.hpp"
+#include "arch/riscv/properties.hpp"
 #include "core/memory-value.hpp"
 
 class InstructionInformation;
@@ -76,6 +78,114 @@ AssemblerFunction getAssembler(const std::string& format);
 MemoryValue assemble(const InstructionInformation& instructionInformation,
                      const Operands& operands);
 
+/**
+ * Assembles the operands for the given entry of the instruction table.
+ *
+ * Unlike the overload taking the information object, this does not look up
+ * any key field by name.
+ *
+ * \param  entry The table entry of the instruction. Its format must be one of
+ *               the six formats below (see `isSupported()`).
+ * \param  operands The operands to assemble.
+ * \return The assembled memory value.
+ */
+MemoryValue
+assemble(const InstructionTable::Entry& entry, const Operands& operands);
+
+/**
+ * Returns whether the given entry can be assembled from its table entry.
+ *
+ * \param entry The table entry of the instruction.
+ * \return True if the format of the entry is one of the six formats below.
+ */
+bool isSupported(const InstructionTable::Entry& entry) noexcept;
+
+/**
+ * The raw encoding of the six formats on plain integers.
+ *
+ * Every field is truncated to its width, so that these functions can be
+ * evaluated at compile-time and are shared by the table and key based
+ * assemblers.
+ */
+namespace Encoding {
+
+/**
+ * Takes the `width` low bits of `value` and moves them to `position`.
+ */
+constexpr unsigned32_t
+field(unsigned32_t value, unsigned32_t width, unsigned32_t position) {
+  return (value & ((unsigned32_t(1) << width) - 1)) << position;
+}
+
+/**
+ * Takes the bits `first` to `last` (inclusive) of `value` and moves them to
+ * `position`.
+ */
+constexpr unsigned32_t range(unsigned32_t value,
+                             unsigned32_t first,
+                             unsigned32_t last,
+                             unsigned32_t position) {
+  return field(value >> first, last - first + 1, position);
+}
+
+/** \see Format::R */
+constexpr unsigned32_t R(unsigned32_t opcode,
+                         unsigned32_t funct3,
+                         unsigned32_t funct7,
+                         unsigned32_t rd,
+                         unsigned32_t rs1,
+                         unsigned32_t rs2) {
+  return field(opcode, 7, 0) | field(rd, 5, 7) | field(funct3, 3, 12) |
+         field(rs1, 5, 15) | field(rs2, 5, 20) | field(funct7, 7, 25);
+}
+
+/** \see Format::I */
+constexpr unsigned32_t I(unsigned32_t opcode,
+                         unsigned32_t funct3,
+                         unsigned32_t rd,
+                         unsigned32_t rs1,
+                         unsigned32_t immediate) {
+  return field(opcode, 7, 0) | field(rd, 5, 7) | field(funct3, 3, 12) |
+         field(rs1, 5, 15) | field(immediate, 12, 20);
+}
+
+/** \see Format::S */
+constexpr unsigned32_t S(unsigned32_t opcode,
+                         unsigned32_t funct3,
+                         unsigned32_t rs1,
+                         unsigned32_t rs2,
+                         unsigned32_t immediate) {
+  return field(opcode, 7, 0) | field(immediate, 5, 7) | field(funct3, 3, 12) |
+         field(rs1, 5, 15) | field(rs2, 5, 20) | range(immediate, 5, 11, 25);
+}
+
+/** \see Format::SB */
+constexpr unsigned32_t SB(unsigned32_t opcode,
+                          unsigned32_t funct3,
+                          unsigned32_t rs1,
+                          unsigned32_t rs2,
+                          unsigned32_t immediate) {
+  return field(opcode, 7, 0) | range(immediate, 10, 10, 7) |
+         range(immediate, 0, 3, 8) | field(funct3, 3, 12) | field(rs1, 5, 15) |
+         field(rs2, 5, 20) | range(immediate, 4, 9, 25) |
+         range(immediate, 11, 11, 31);
+}
+
+/** \see Format::U */
+constexpr unsigned32_t
+U(unsigned32_t opcode, unsigned32_t rd, unsigned32_t immediate) {
+  return field(opcode, 7, 0) | field(rd, 5, 7) | field(immediate, 20, 12);
+}
+
+/** \see Format::UJ */
+constexpr unsigned32_t
+UJ(unsigned32_t opcode, unsigned32_t rd, unsigned32_t immediate) {
+  return field(opcode, 7, 0) | field(rd, 5, 7) | range(immediate, 11, 18, 12) |
+         range(immediate, 10, 10, 20) | range(immediate, 0, 9, 21) |
+         range(immediate, 19, 19, 31);
+}
+}
+
 /*
  * Assembles instructions with the `R` format.
  *
@@ -219,6 +219,18 @@ class InstructionContextInformation {
                      const std::string& operand2Desc,
                      const std::string& resultPart = std::string());
 
+  /**
+   * A convenience function for defining the documentation of all instructions
+   * from RISCV Extension A of one size.
+   * \param suffix The suffix of the mnemonics (".w" or ".d")
+   * \param sizeDescription A string description of the accessed size (like
+   * word or double-word)
+   * \param size The accessed size in bits
+   */
+  void _atomicInstructions(const std::string& suffix,
+                           const std::string& sizeDescription,
+                           size_t size);
+
   /**
    *
    * \param mnemonic mnemonic of the instruction to check
@@ -18,11 +18,13 @@
 #ifndef ERAGPSIM_ARCH_RISCV_INSTRUCTION_NODE_HPP
 #define ERAGPSIM_ARCH_RISCV_INSTRUCTION_NODE_HPP
 
+#include <cstddef>
 #include <initializer_list>
 #include <memory>
 #include <string>
 
 #include "arch/common/abstract-instruction-node.hpp"
+#include "arch/riscv/format.hpp"
 #include "arch/riscv/instruction-context-information.hpp"
 #include "arch/riscv/properties.hpp"
 #include "arch/riscv/utility.hpp"
@@ -42,6 +44,9 @@ class InstructionNode : public AbstractInstructionNode {
   /**
    * Constructs a new node that represents a RISC V specific instruction.
    *
+   * The entry of the instruction in the generated instruction table is looked
+   * up once here, so that assembling does not need any string lookups.
+   *
    * \param The information object associated with the instruction.
    */
   InstructionNode(const InstructionInformation& information);
@@ -80,8 +85,8 @@ class InstructionNode : public AbstractInstructionNode {
   template <typename T>
   T _getChildValue(MemoryAccess& memoryAccess, size_t index) const {
     assert::that(index < _children.size());
-    auto memory = _children[index]->getValue(memoryAccess);
-    return riscv::convert<T>(memory);
+    auto operand = _children[index]->getOperand(memoryAccess);
+    return riscv::convert<T>(operand);
   }
 
   /**
@@ -120,6 +125,16 @@ class InstructionNode : public AbstractInstructionNode {
    */
   bool _compareChildTypes(TypeList list, size_t startIndex = 0) const;
 
+  /**
+   * Assembles this instruction from already assembled operands.
+   *
+   * Allows subclasses to reorder their operands before encoding.
+   *
+   * \param operands The operands, in the order of the format.
+   * \return The assembled instruction.
+   */
+  MemoryValue _assemble(const Format::Operands& operands) const;
+
  private:
   /**
    * A pointer to the RISCV specific user instruction documentation.
@@ -127,6 +142,13 @@ class InstructionNode : public AbstractInstructionNode {
    * AbstractInstructionNode::getInstructionDocumentation()
    */
   std::shared_ptr<InstructionContextInformation> _documentation;
+
+  /**
+   * The ID of the instruction in the InstructionTable, or
+   * `InstructionTable::invalidID` if it must be assembled from the
+   * information object.
+   */
+  std::size_t _tableID;
 };
 }
 
@@ -0,0 +1,159 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ERAGPSIM_ARCH_RISCV_INSTRUCTION_TABLE_HPP
+#define ERAGPSIM_ARCH_RISCV_INSTRUCTION_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+class InstructionInformation;
+
+namespace riscv {
+
+/**
+ * Holds the static encoding information of all RISC-V instructions.
+ *
+ * The table is generated at build time from the ISA description in
+ * `isa/riscv.isa/<extension>/config.json`, so that assembling an instruction
+ * does not need to look up its key fields by string. Every entry has a dense
+ * ID (its index in the table), which nodes resolve once when they are created.
+ *
+ * Entries are sorted by mnemonic and extension. The same mnemonic may appear
+ * in several extensions with different keys (e.g. `srai` in rv32i and rv64i).
+ */
+namespace InstructionTable {
+
+/** The instruction formats of the ISA description. */
+enum class InstructionFormat { R, R4, I, S, SB, U, UJ, CUSTOM };
+
+/** Marks a key field which is not part of the key of an instruction. */
+constexpr std::int32_t none = -1;
+
+/**
+ * The encoding information of one instruction.
+ */
+struct Entry {
+  /** The mnemonic, in lower case. */
+  const char* mnemonic;
+
+  /** The name of the extension which defines the instruction. */
+  const char* extension;
+
+  /** The format of the instruction. */
+  InstructionFormat format;
+
+  /** The key fields, `none` if the field is not part of the key. */
+  std::int32_t opcode;
+  std::int32_t funct3;
+  std::int32_t funct7;
+  std::int32_t funct2;
+  std::int32_t rs1;
+  std::int32_t rs2;
+
+  /** The length of the instruction in bits. */
+  std::size_t length;
+};
+
+namespace Detail {
+constexpr int compare(const char* first, const char* second) {
+  while (*first != '\0' && *first == *second) {
+    ++first;
+    ++second;
+  }
+  return static_cast<unsigned char>(*first) -
+         static_cast<unsigned char>(*second);
+}
+}
+}
+}
+
+// The generated entries (riscv::InstructionTable::entries and ::size)
+#include "arch/riscv/instruction-table-data.hpp"
+
+namespace riscv {
+namespace InstructionTable {
+
+/** The ID returned if an instruction is not in the table. */
+constexpr std::size_t invalidID = size;
+
+/**
+ * Returns the entry with the given ID.
+ *
+ * \param id A valid ID.
+ * \return The entry with the given ID.
+ */
+constexpr const Entry& get(std::size_t id) {
+  return entries[id];
+}
+
+/**
+ * Returns the ID of the first entry with the given mnemonic.
+ *
+ * \param mnemonic The mnemonic, in lower case.
+ * \return The ID of the first entry, `invalidID` if there is none.
+ */
+constexpr std::size_t find(const char* mnemonic) {
+  std::size_t first = 0;
+  std::size_t last = size;
+  // binary search for the lower bound
+  while (first < last) {
+    auto middle = first + (last - first) / 2;
+    if (Detail::compare(entries[middle].mnemonic, mnemonic) < 0) {
+      first = middle + 1;
+    } else {
+      last = middle;
+    }
+  }
+  if (first < size && Detail::compare(entries[first].mnemonic, mnemonic) == 0) {
+    return first;
+  }
+  return invalidID;
+}
+
+/**
+ * Returns the ID of the entry with the given mnemonic and extension.
+ *
+ * \param mnemonic The mnemonic, in lower case.
+ * \param extension The name of the extension, e.g. "rv32i".
+ * \return The ID of the entry, `invalidID` if there is none.
+ */
+constexpr std::size_t find(const char* mnemonic, const char* extension) {
+  for (auto id = find(mnemonic);
+       id < size && Detail::compare(entries[id].mnemonic, mnemonic) == 0;
+       ++id) {
+    if (Detail::compare(entries[id].extension, extension) == 0) return id;
+  }
+  return invalidID;
+}
+
+/**
+ * Returns the ID of the entry matching an instruction of an architecture.
+ *
+ * The mnemonic, format and all key fields of the entry have to match, which
+ * selects the right entry if an extension overrides an instruction.
+ *
+ * \param information The information object of the instruction.
+ * \return The ID of the entry, `invalidID` if there is none.
+ */
+std::size_t find(const InstructionInformation& information);
+}
+}
+
+#endif /* ERAGPSIM_ARCH_RISCV_INSTRUCTION_TABLE_HPP */
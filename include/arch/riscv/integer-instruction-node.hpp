@@ -131,8 +131,8 @@ class AbstractIntegerInstructionNode : public InstructionNode {
 
  private:
   SizeType _getChildValue(size_t index, MemoryAccess& memoryAccess) const {
-    auto memory = _children[index]->getValue(memoryAccess);
-    return riscv::convert<SizeType>(memory);
+    auto operand = _children[index]->getOperand(memoryAccess);
+    return riscv::convert<SizeType>(operand);
   }
 
   ValidationResult _validateNumberOfChildren() const {
@@ -28,6 +28,7 @@
 #include "arch/riscv/abstract-load-store-instruction-node.hpp"
 #include "arch/riscv/instruction-node.hpp"
 #include "common/assert.hpp"
+#include "core/transaction.hpp"
 
 namespace riscv {
 /**
@@ -204,13 +205,18 @@ class StoreInstructionNode
     const auto& sourceRegister = super::_children.at(0)->getIdentifier();
     auto effectiveAddress = super::_getEffectiveAddress(memoryAccess);
 
-    auto registerValue = memoryAccess.getRegisterValue(sourceRegister).get();
-    MemoryValue resultValue(super::_byteAmount * riscv::BITS_PER_BYTE);
-    for (size_t i = 0; i < super::_byteAmount * riscv::BITS_PER_BYTE; ++i) {
-      resultValue.put(i, registerValue.get(i));
-    }
+    auto bitAmount = super::_byteAmount * riscv::BITS_PER_BYTE;
 
-    memoryAccess.putMemoryValueAt(effectiveAddress, resultValue);
+    // Read the register and write the memory in one task, nothing has to be
+    // waited for
+    memoryAccess.runTransaction([=](Transaction& transaction) {
+      auto registerValue = transaction.getRegisterValue(sourceRegister);
+      MemoryValue resultValue(bitAmount);
+      for (size_t i = 0; i < bitAmount; ++i) {
+        resultValue.put(i, registerValue.get(i));
+      }
+      transaction.putMemoryValueAt(effectiveAddress, resultValue);
+    });
 
     return super::template _incrementProgramCounter<UnsignedWord>(memoryAccess);
   }
@@ -97,7 +97,7 @@ class LuiAuipcValidationNode : public InstructionNode {
     static const auto internalWidth =
         std::numeric_limits<InternalUnsigned>::digits;
 
-    auto immediate = _children[1]->getValue(memoryAccess);
+    auto immediate = _children[1]->getOperand(memoryAccess);
 
     // Convert the offset to an internal integer representation
     auto immediateConverted = riscv::convert<InternalUnsigned>(immediate);
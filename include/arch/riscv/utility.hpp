@@ -26,10 +26,19 @@
 
 #include "arch/riscv/properties.hpp"
 #include "core/conversions.hpp"
+#include "core/integer-operand.hpp"
 #include "core/memory-access.hpp"
 #include "core/memory-value.hpp"
+#include "core/transaction.hpp"
 
 namespace riscv {
+/**
+ * The conversions for RISC-V, specialized at compile time for its properties.
+ */
+using Converter = conversions::Converter<riscv::ENDIANNESS,
+                                         riscv::SIGNED_REPRESENTATION,
+                                         riscv::BITS_PER_BYTE>;
+
 /**
  * Utility function to convert a memory value for RISC-V.
  *
@@ -42,9 +51,21 @@ namespace riscv {
  */
 template <typename T>
 T convert(const MemoryValue& memoryValue) {
-  return conversions::convert<T>(memoryValue, riscv::BITS_PER_BYTE,
-                                 riscv::ENDIANNESS,
-                                 riscv::SIGNED_REPRESENTATION);
+  return Converter::toIntegral<T>(memoryValue);
+}
+
+/**
+ * Utility function to convert an operand for RISC-V, exactly like the memory
+ * value it was read from.
+ *
+ * \tparam T The type to convert to.
+ * \param operand The operand to convert.
+ *
+ * \return The converted value.
+ */
+template <typename T>
+T convert(const IntegerOperand& operand) {
+  return operand.as<T>();
 }
 
 /**
@@ -61,15 +82,13 @@ template <typename T>
 std::enable_if_t<std::is_integral<T>::value, MemoryValue> convert(
     const T& value) {
   static const auto digits = sizeof(T) * CHAR_BIT;
-  return conversions::convert(value, digits, riscv::BITS_PER_BYTE,
-                              riscv::ENDIANNESS, riscv::SIGNED_REPRESENTATION);
+  return Converter::toMemoryValue<T>(value, digits);
 }
 
 template <typename T>
 std::enable_if_t<std::is_integral<T>::value, MemoryValue> convert(
     const T& value, std::size_t size) {
-  return conversions::convert(value, size, riscv::BITS_PER_BYTE,
-                              riscv::ENDIANNESS, riscv::SIGNED_REPRESENTATION);
+  return Converter::toMemoryValue<T>(value, size);
 }
 
 /**
@@ -106,23 +125,26 @@ template <typename UnsignedWord>
 std::enable_if_t<std::is_unsigned<UnsignedWord>::value, bool> addressIsValid(
     MemoryAccess& memoryAccess, UnsignedWord absoluteAdress,
     UnsignedWord validAdress) {
-  UnsignedWord lowerBound = 0;
-  UnsignedWord upperBound = memoryAccess.getMemorySize().get();
   // validAddress is used to determine if the the given Adress is correctly
   // aligned in memory.
   // correct alignment is that (absoluteAdress-offset)%4 == 0
   // problem: we don't know the offset,
   // but we know that (validAdress-offset)%4 = 0
-  if (absoluteAdress < lowerBound ||
-      absoluteAdress + riscv::INSTRUCTION_LENGTH_BYTE >= upperBound) {
-    return false;
-  }
   bool validAlignement = (validAdress - absoluteAdress) % 4 == 0;
-  bool insideOfProgram =
-      memoryAccess
-          .isMemoryProtectedAt(absoluteAdress, riscv::INSTRUCTION_LENGTH_BYTE)
-          .get();
-  return validAlignement && insideOfProgram;
+  if (!validAlignement) return false;
+
+  // Check the range and whether the address is part of the program in a
+  // single request
+  return memoryAccess
+      .transaction([absoluteAdress](Transaction& transaction) {
+        UnsignedWord upperBound = transaction.getMemorySize();
+        if (absoluteAdress + riscv::INSTRUCTION_LENGTH_BYTE >= upperBound) {
+          return false;
+        }
+        return transaction.isMemoryProtectedAt(absoluteAdress,
+                                               riscv::INSTRUCTION_LENGTH_BYTE);
+      })
+      .get();
 }
 
 template <std::size_t numberOfBits, typename T>
@@ -20,6 +20,10 @@
 #ifndef ERAGPSIM_COMMON_STRING_CONVERSIONS_HPP
 #define ERAGPSIM_COMMON_STRING_CONVERSIONS_HPP
 
+#include <cstddef>
+#include <string>
+#include <vector>
+
 #include "common/optional.hpp"
 #include "core/memory-value.hpp"
 
@@ -42,6 +46,28 @@ std::string toBinString(const MemoryValue& memoryValue);
  */
 std::string toHexString(const MemoryValue& memoryValue);
 
+/**
+ * \brief toBinStrings Converts a contiguous range of memory cells to binary
+ * strings at once, without creating a MemoryValue for every cell.
+ * \param memoryValue The cells to convert, lowest address first.
+ * \param cellSize The size of a cell in bits. The size of memoryValue has to
+ * be a multiple of it.
+ * \return The binary strings of all cells, as toBinString would return them.
+ */
+std::vector<std::string>
+toBinStrings(const MemoryValue& memoryValue, std::size_t cellSize);
+
+/**
+ * \brief toHexStrings Converts a contiguous range of memory cells to hex
+ * strings at once, without creating a MemoryValue for every cell.
+ * \param memoryValue The cells to convert, lowest address first.
+ * \param cellSize The size of a cell in bits. The size of memoryValue has to
+ * be a multiple of it.
+ * \return The hex strings of all cells, as toHexString would return them.
+ */
+std::vector<std::string>
+toHexStrings(const MemoryValue& memoryValue, std::size_t cellSize);
+
 /**
  * \brief toUnsignedDecString Converts a given MemoryValue with a maximum size
  * of 64 bits to a corresponding unsigned decimal string.
@@ -448,7 +448,7 @@ std::string loadFromFile(const std::string &filePath);
 
 template <typename Data>
 void storeToFile(const std::string &filePath, Data &&data) {
-  std::ofstream file(filePath);
+  std::ofstream file(filePath, std::ios::binary);
   file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
   file << std::forward<Data>(data);
 }
@@ -0,0 +1,264 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ERAGPSIM_CORE_BINARY_SNAPSHOT_HPP
+#define ERAGPSIM_CORE_BINARY_SNAPSHOT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "arch/common/architecture-formula.hpp"
+#include "core/memory-value.hpp"
+
+class Memory;
+class RegisterSet;
+
+/**
+ * A compact binary snapshot of memory and registers.
+ *
+ * Unlike the json Snapshot, which stores every cell as a hex string, the
+ * binary format stores the raw register words and the raw memory split into
+ * pages. Only the pages which are not zero are stored, consecutive pages are
+ * grouped into runs and every run is compressed with PackBits. A snapshot of a
+ * mostly empty 16 MB memory thus only takes a few KB.
+ *
+ * The pages are read straight out of the pages of the Memory, so pages which
+ * were never written are skipped without looking at their bytes.
+ *
+ * A delta snapshot only stores the pages which differ from a base snapshot,
+ * which has to be a full snapshot. It can only be restored on top of its
+ * base, which is checked through the checksum of the base. If a fork of the
+ * memory taken along with the base is at hand, the pages still shared with
+ * it are skipped as well, and the base does not have to be decoded.
+ *
+ * Layout, all numbers little endian, strings prefixed by their 32 bit length:
+ *
+ *   "ERASNAP\0", version (32 bit), flags (32 bit), checksum of the base
+ *   (64 bit, 0 for full snapshots), architecture name, number of extensions
+ *   (32 bit) and extension names,
+ *   number of registers (32 bit), and for every register its name, its size
+ *   in bit (32 bit) and its bytes,
+ *   number of cells (64 bit), bits per cell (32 bit), page size in bytes
+ *   (32 bit), number of runs (32 bit), and for every run its first page
+ *   (64 bit), number of pages (32 bit), compressed size (32 bit) and the
+ *   compressed bytes,
+ *   checksum (FNV-1a, 64 bit) of everything before.
+ *
+ * The runs are decoded straight from the buffer into the memory, so loading
+ * never builds an intermediate representation of the pages.
+ */
+class BinarySnapshot {
+ public:
+  using size_t = std::size_t;
+  using checksum_t = std::uint64_t;
+
+  /** The number of raw memory bytes in a page. */
+  static constexpr size_t pageSize = 4096;
+
+  /**
+   * Creates an empty, invalid snapshot.
+   */
+  BinarySnapshot() = default;
+
+  /**
+   * Creates a full snapshot of a project.
+   *
+   * \param architectureFormula The architecture formula of the project.
+   * \param memory The memory of the project.
+   * \param registerSet The registers of the project.
+   */
+  BinarySnapshot(const ArchitectureFormula& architectureFormula,
+                 const Memory& memory,
+                 const RegisterSet& registerSet);
+
+  /**
+   * Creates a delta snapshot of a project, which only stores the pages
+   * differing from a base snapshot.
+   *
+   * \param architectureFormula The architecture formula of the project.
+   * \param memory The memory of the project.
+   * \param registerSet The registers of the project.
+   * \param base A valid full snapshot of the same architecture.
+   */
+  BinarySnapshot(const ArchitectureFormula& architectureFormula,
+                 const Memory& memory,
+                 const RegisterSet& registerSet,
+                 const BinarySnapshot& base);
+
+  /**
+   * Creates a delta snapshot of a project, comparing the memory against a
+   * fork of the memory the base snapshot was created from.
+   *
+   * \param architectureFormula The architecture formula of the project.
+   * \param memory The memory of the project.
+   * \param registerSet The registers of the project.
+   * \param base A valid full snapshot of the same architecture.
+   * \param baseMemory A fork of the memory of the base, see Memory::fork().
+   */
+  BinarySnapshot(const ArchitectureFormula& architectureFormula,
+                 const Memory& memory,
+                 const RegisterSet& registerSet,
+                 const BinarySnapshot& base,
+                 const Memory& baseMemory);
+
+  /**
+   * Loads a snapshot from its binary representation.
+   *
+   * \param data The bytes of the snapshot, e.g. the content of a file.
+   * \throws DeserializationError If the data is not a valid snapshot.
+   */
+  explicit BinarySnapshot(std::string data);
+
+  /**
+   * Returns true if the data starts like a binary snapshot, which tells it
+   * apart from a json snapshot.
+   */
+  static bool isBinarySnapshot(const std::string& data);
+
+  /**
+   * \return true if the snapshot contains data.
+   */
+  bool isValid() const noexcept;
+
+  /**
+   * \return true if this is a delta snapshot.
+   */
+  bool isDelta() const noexcept;
+
+  /**
+   * \return The checksum identifying this snapshot.
+   */
+  checksum_t getChecksum() const noexcept;
+
+  /**
+   * \return The checksum of the base of a delta snapshot, 0 for a full one.
+   */
+  checksum_t getBaseChecksum() const noexcept;
+
+  /**
+   * \return The architecture formula of this snapshot.
+   */
+  ArchitectureFormula getArchitectureFormula() const;
+
+  /**
+   * \return The number of memory cells.
+   */
+  size_t getMemorySize() const;
+
+  /**
+   * \return The binary representation, e.g. to store it in a file.
+   */
+  const std::string& getData() const noexcept;
+
+  /**
+   * Restores memory and registers from a full snapshot.
+   *
+   * \param memory The memory to overwrite, which has to have the same cell
+   * size. It grows if the snapshot is bigger.
+   * \param registerSet The registers to overwrite.
+   * \throws DeserializationError If the snapshot does not fit the project.
+   */
+  void restore(Memory& memory, RegisterSet& registerSet) const;
+
+  /**
+   * Restores memory and registers from a delta snapshot and its base.
+   *
+   * \param base The full snapshot the delta was created against.
+   * \param memory The memory to overwrite.
+   * \param registerSet The registers to overwrite.
+   * \throws DeserializationError If base is not the base of the delta or the
+   * snapshot does not fit the project.
+   */
+  void restore(const BinarySnapshot& base,
+               Memory& memory,
+               RegisterSet& registerSet) const;
+
+ private:
+  /**
+   * Encodes memory and registers, only storing the pages for which
+   * storePage(index, bytes, size) returns true.
+   */
+  template <typename PagePredicate>
+  void _encode(const ArchitectureFormula& architectureFormula,
+               const Memory& memory,
+               const RegisterSet& registerSet,
+               checksum_t baseChecksum,
+               PagePredicate storePage);
+
+  /**
+   * Parses and checks the header, setting up all members but _data.
+   */
+  void _parseHeader();
+
+  /**
+   * Decodes the memory runs into raw memory data, which has to be at least as
+   * big as the memory of this snapshot.
+   */
+  void _decodePages(MemoryValue::Underlying& raw) const;
+
+  /**
+   * Decodes the registers and checks that they fit the register set.
+   */
+  std::vector<std::pair<std::string, MemoryValue>>
+  _decodeRegisters(const RegisterSet& registerSet) const;
+
+  /**
+   * Throws if the snapshot cannot be restored into the memory.
+   */
+  void _checkMemory(const Memory& memory) const;
+
+  /** The binary representation. */
+  std::string _data;
+
+  /** The name of the architecture. */
+  std::string _architectureName;
+
+  /** The names of the extensions of the architecture. */
+  std::vector<std::string> _extensions;
+
+  /** The flags stored in the header. */
+  std::uint32_t _flags = 0;
+
+  /** The checksum of the whole snapshot. */
+  checksum_t _checksum = 0;
+
+  /** The checksum of the base, 0 for full snapshots. */
+  checksum_t _baseChecksum = 0;
+
+  /** The number of memory cells. */
+  size_t _memorySize = 0;
+
+  /** The number of bits per cell. */
+  size_t _cellSize = 0;
+
+  /** The offset of the register section in _data. */
+  size_t _registerOffset = 0;
+
+  /** The offset of the first memory run in _data. */
+  size_t _runOffset = 0;
+
+  /** The number of memory runs. */
+  size_t _runCount = 0;
+};
+
+#endif /* ERAGPSIM_CORE_BINARY_SNAPSHOT_HPP */
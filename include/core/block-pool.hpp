@@ -0,0 +1,89 @@
+/* C++ Assembler Interpreter
+ * Copyright (C) 2016 Chair of Computer Architecture
+ * at Technical University of Munich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ERAGPSIM_CORE_BLOCK_POOL_HPP
+#define ERAGPSIM_CORE_BLOCK_POOL_HPP
+
+#include <cstddef>
+
+/**
+ * A process-wide pool of memory blocks of a fixed size.
+ *
+ * Freed blocks are kept in a lockfree BoundedQueue and handed out again, so
+ * short-lived objects like the shared state of a promise do not go through
+ * the allocator every time. Requests larger than a block and blocks that do
+ * not fit into the pool anymore go to operator new and delete.
+ */
+class BlockPool {
+ public:
+  /** The size of a block in bytes. */
+  static constexpr std::size_t blockSize = 256;
+
+  /** The maximum number of free blocks kept in the pool. */
+  static constexpr std::size_t capacity = 4096;
+
+  /**
+   * \param size The number of bytes to allocate.
+   * \returns Memory aligned like memory from operator new.
+   */
+  static void* allocate(std::size_t size);
+
+  /**
+   * \param block Memory returned by allocate().
+   * \param size The size that was passed to allocate().
+   */
+  static void deallocate(void* block, std::size_t size) noexcept;
+};
+
+/**
+ * An allocator taking its memory from the BlockPool, e.g. for
+ * std::promise(std::allocator_arg, PoolAllocator<T>()).
+ *
+ * \tparam T The type of the allocated objects.
+ */
+template <typename T>
+class PoolAllocator {
+ public:
+  using value_type = T;
+
+  PoolAllocator() noexcept = default;
+
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>&) noexcept {
+  }
+
+  T* allocate(std::size_t count) {
+    return static_cast<T*>(BlockPool::allocate(count * sizeof(T)));
+  }
+
+  void deallocate(T* pointer, std::size_t count) noexcept {
+    BlockPool::deallocate(pointer, count * sizeof(T));
+  }
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept {
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept {
+  return false;
+}
+
+#endif /* ERAGPSIM_CORE_BLOCK_POOL_HPP */
@@ -0,0 +1,216 @@
+/* C++ Assembler Interpreter
+ * Copyright (C) 2016 Chair of Computer Architecture
+ * at Technical University of Munich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ERAGPSIM_CORE_BOUNDED_QUEUE_HPP
+#define ERAGPSIM_CORE_BOUNDED_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+/**
+ * \brief A lockfree multi-producer, multi-consumer queue with a fixed capacity.
+ *
+ * The values are stored in a ring buffer which is allocated once, so neither
+ * pushing nor popping allocates memory or takes a lock. Every cell carries a
+ * sequence number telling whether it is ready to be written or read, which
+ * protects against the ABA problem.
+ *
+ * For more information, see
+ *   "Bounded MPMC queue", Dmitry Vyukov (http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue)
+ *
+ * \tparam T The type of values stored within the queue.
+ */
+template <class T>
+class BoundedQueue {
+ public:
+  /** The capacity of a default constructed queue. */
+  static constexpr std::size_t defaultCapacity = 1024;
+
+  /**
+   * \brief Creates an empty queue.
+   * \param capacity The maximum number of values, rounded up to a power of
+   *        two.
+   */
+  explicit BoundedQueue(std::size_t capacity = defaultCapacity)
+  : _mask(_roundUp(capacity) - 1), _cells(new Cell[_mask + 1]) {
+    for (std::size_t index = 0; index <= _mask; ++index) {
+      _cells[index].sequence.store(index, std::memory_order_relaxed);
+    }
+    _enqueuePosition.store(0, std::memory_order_relaxed);
+    _dequeuePosition.store(0, std::memory_order_relaxed);
+  }
+
+  ~BoundedQueue() {
+    // Destroy the values that were never popped
+    auto position = _dequeuePosition.load(std::memory_order_relaxed);
+    auto end = _enqueuePosition.load(std::memory_order_relaxed);
+    for (; position != end; ++position) {
+      _cells[position & _mask].value()->~T();
+    }
+  }
+
+  // The cells are shared with other threads, the queue can not be moved.
+  BoundedQueue(const BoundedQueue<T>& other) = delete;
+  BoundedQueue(BoundedQueue&& other) = delete;
+  BoundedQueue<T>& operator=(const BoundedQueue<T>& other) = delete;
+  BoundedQueue<T>& operator=(BoundedQueue&& other) = delete;
+
+  /**
+   * \brief Try to add a new value into the queue.
+   * \pre \c T must be constructible from \c U&& via \c std::forward<U>.
+   * \param value The value to add into the queue. It is left untouched if the
+   *        queue is full.
+   * \returns \c true if the value was added, \c false if the queue is full.
+   */
+  template <typename U>
+  bool tryPush(U&& value) {
+    auto position = _enqueuePosition.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &_cells[position & _mask];
+      auto sequence = cell->sequence.load(std::memory_order_acquire);
+      auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+      if (difference == 0) {
+        // The cell is free, try to claim it
+        if (_enqueuePosition.compare_exchange_weak(
+                position, position + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        // The cell still holds a value from the previous round
+        return false;
+      } else {
+        // Another producer claimed the cell first
+        position = _enqueuePosition.load(std::memory_order_relaxed);
+      }
+    }
+    using Target = typename std::conditional<std::is_move_assignable<U>::value,
+                                             U&&, const U&>::type;
+    new (&cell->storage) T(static_cast<Target>(value));
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * \brief Add a new value into the queue, waiting while the queue is full.
+   * \pre \c T must be constructible from \c U&& via \c std::forward<U>.
+   * \param value The value to add into the queue.
+   */
+  template <typename U>
+  void push(U&& value) {
+    while (!tryPush(std::forward<U>(value))) {
+      std::this_thread::yield();
+    }
+  }
+
+  /**
+   * \brief Try to pop a value from the queue.
+   * \post If the queue contained an element, \c value now points to it. The
+   *       element is removed from the queue.
+   * \returns \c true if and only if an element was successfully removed from
+   *          the queue. This can fail while a producer is still writing the
+   *          oldest value, see isEmpty().
+   */
+  bool pop(T& value) {
+    auto position = _dequeuePosition.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &_cells[position & _mask];
+      auto sequence = cell->sequence.load(std::memory_order_acquire);
+      auto difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+      if (difference == 0) {
+        if (_dequeuePosition.compare_exchange_weak(
+                position, position + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        // The cell was not written yet
+        return false;
+      } else {
+        position = _dequeuePosition.load(std::memory_order_relaxed);
+      }
+    }
+    using Target = typename std::conditional<std::is_move_assignable<T>::value,
+                                             T&&, const T&>::type;
+    value = static_cast<Target>(*cell->value());
+    cell->value()->~T();
+    // The cell can be written again in the next round
+    cell->sequence.store(position + _mask + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * \returns \c true if no producer has claimed a cell that was not popped
+   *          yet. Unlike a failing pop(), this also counts values which are
+   *          still being written.
+   */
+  bool isEmpty() const {
+    return _enqueuePosition.load(std::memory_order_acquire) ==
+           _dequeuePosition.load(std::memory_order_relaxed);
+  }
+
+  /** \returns The maximum number of values in the queue. */
+  std::size_t capacity() const noexcept {
+    return _mask + 1;
+  }
+
+ private:
+  /// \brief A value together with the round it belongs to
+  struct Cell {
+    std::atomic<std::size_t> sequence;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+    T* value() {
+      return reinterpret_cast<T*>(&storage);
+    }
+  };
+
+  /// \brief Rounds up to the next power of two, so that a mask can be used.
+  static std::size_t _roundUp(std::size_t capacity) {
+    std::size_t result = 2;
+    while (result < capacity) result <<= 1;
+    return result;
+  }
+
+  /// \brief Keeps the positions on separate cache lines.
+  static constexpr std::size_t _cacheLine = 64;
+
+  /// \brief The capacity minus one, used to map positions to cells
+  const std::size_t _mask;
+
+  /// \brief The ring buffer
+  std::unique_ptr<Cell[]> _cells;
+
+  char _padding0[_cacheLine];
+
+  /// \brief The position the next value is pushed to
+  std::atomic<std::size_t> _enqueuePosition;
+
+  char _padding1[_cacheLine - sizeof(std::atomic<std::size_t>)];
+
+  /// \brief The position the next value is popped from
+  std::atomic<std::size_t> _dequeuePosition;
+
+  char _padding2[_cacheLine - sizeof(std::atomic<std::size_t>)];
+};
+
+#endif  // ERAGPSIM_CORE_BOUNDED_QUEUE_HPP
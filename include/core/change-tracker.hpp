@@ -0,0 +1,114 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ERAGPSIM_CORE_CHANGE_TRACKER_HPP
+#define ERAGPSIM_CORE_CHANGE_TRACKER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Collects changes to the memory and the registers so that they can be
+ * reported to the ui in one batch.
+ *
+ * Memory changes are tracked per page in a bitmap, register changes in a
+ * bitset indexed by the order in which the registers were first changed.
+ * Marking a change only sets bits, no matter how often the same cells or
+ * registers are written. A flush reports every run of consecutive dirty pages
+ * as one range and every dirty register once, then starts over.
+ */
+class ChangeTracker {
+ public:
+  using size_t = std::size_t;
+  using MemoryCallback = std::function<void(size_t, size_t)>;
+  using RegisterCallback = std::function<void(const std::string &)>;
+
+  /** The default number of memory cells per page. */
+  static constexpr size_t defaultPageSize = 64;
+
+  /**
+   * Creates a new ChangeTracker without any changes.
+   *
+   * \param pageSize The number of memory cells per page.
+   */
+  explicit ChangeTracker(size_t pageSize = defaultPageSize);
+
+  /**
+   * Marks the pages containing [address, address + amount) as changed.
+   */
+  void markMemory(size_t address, size_t amount);
+
+  /**
+   * Marks a register as changed.
+   */
+  void markRegister(const std::string &name);
+
+  /**
+   * Returns true if anything was marked since the last flush.
+   */
+  bool isDirty() const noexcept;
+
+  /**
+   * Reports all changes and forgets about them.
+   *
+   * \param memorySize The size of the memory, ranges are cut off there.
+   * \param memoryCallback Called with address and amount of every changed
+   *        range of memory, in ascending order.
+   * \param registerCallback Called with the name of every changed register.
+   */
+  void flush(size_t memorySize,
+             const MemoryCallback &memoryCallback,
+             const RegisterCallback &registerCallback);
+
+ private:
+  using Word = std::uint64_t;
+  static constexpr size_t _wordSize = 64;
+
+  /**
+   * Returns the first page at or after page (before end) with the given
+   * state, or end if there is none.
+   */
+  size_t _findPage(size_t page, size_t end, bool dirty) const noexcept;
+
+  size_t _pageSize;
+
+  /** One bit per page, set if the page changed. */
+  std::vector<Word> _pages;
+
+  /** The words of _pages which may contain set bits. */
+  size_t _firstWord;
+  size_t _lastWord;
+
+  /** One bit per register, set if the register changed. */
+  std::vector<Word> _registers;
+
+  /** Maps register names to their bit. */
+  std::unordered_map<std::string, size_t> _registerIndices;
+
+  /** The name of the register of every bit. */
+  std::vector<std::string> _registerNames;
+
+  bool _registersDirty;
+};
+
+#endif /* ERAGPSIM_CORE_CHANGE_TRACKER_HPP */
@@ -51,6 +51,50 @@ class CommandInterface : public Proxy<ParsingAndExecutionUnit> {
    */
   POST(executeToBreakpoint)
 
+  /**
+   * Undo the last executed line of the assembler program
+   *
+   */
+  POST(executePreviousLine)
+
+  /**
+   * Undo executed instructions until a breakpoint is reached
+   *
+   */
+  POST(executeBackwardsToBreakpoint)
+
+  /**
+   * Resumes a sleeping program immediately
+   *
+   */
+  POST(interruptSleep)
+
+  /**
+   * Starts writing an execution trace to a file.
+   *
+   * \param path The path of the trace file.
+   * \param compress Whether to compress the trace.
+   *
+   * \returns std::future<bool>, false if the file could not be created.
+   */
+  POST_FUTURE(startTrace)
+
+  /**
+   * Stops the trace.
+   *
+   * \returns std::future<std::uint64_t>, the number of traced instructions.
+   */
+  POST_FUTURE(stopTrace)
+
+  /**
+   * Sets the number of harts which execute the program.
+   *
+   * \param count The number of harts, at least one.
+   *
+   * \see ParsingAndExecutionUnit::setHartCount()
+   */
+  POST(setHartCount)
+
   /**
    * Set the line which should be executed with any execute...() method
    *
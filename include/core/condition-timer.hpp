@@ -20,10 +20,20 @@
 #ifndef ERAGPSIM_CORE_CONDITION_TIMER_HPP
 #define ERAGPSIM_CORE_CONDITION_TIMER_HPP
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <mutex>
 
+#include "core/spin-wait.hpp"
+
+/**
+ * A flag that threads can wait for.
+ *
+ * The flag is an atomic, so setting and reading it does not lock. Waiting
+ * threads poll the flag for a moment (see SpinWait) and only then block on a
+ * condition variable, which notify only has to lock if somebody is blocked.
+ */
 class ConditionTimer {
  public:
   ConditionTimer();
@@ -44,7 +54,8 @@ class ConditionTimer {
   void reset();
 
   /**
-   * Return the value of the flag.
+   * Return the value of the flag. This is a single relaxed load, so it can be
+   * checked before every instruction.
    */
   bool getFlag();
 
@@ -70,12 +81,14 @@ class ConditionTimer {
    */
   template <typename Rep, typename Period>
   void waitFor(std::chrono::duration<Rep, Period> duration) {
+    if (_spinWait.spinUntil([this] { return _isSet(); })) return;
+    BlockedThread blocked(*this);
     std::unique_lock<std::mutex> lock(_mutex);
-    while (!_flag) {
+    while (!_isSet()) {
       auto start = std::chrono::steady_clock::now();
       auto didTimeOut = _conditionVariable.wait_for(lock, duration);
       // check if the sleep was interupted by the notify method or timed out.
-      if (_flag) break;
+      if (_isSet()) break;
       if (didTimeOut == std::cv_status::timeout) break;
       // this appears to be a spurious wakeup, sleep again.
       auto end = std::chrono::steady_clock::now();
@@ -87,11 +100,39 @@ class ConditionTimer {
   }
 
  private:
+  /** Counts a thread as blocked while it exists. */
+  struct BlockedThread {
+    explicit BlockedThread(ConditionTimer& timer) : _timer(timer) {
+      _timer._blocked.fetch_add(1, std::memory_order_seq_cst);
+    }
+    ~BlockedThread() {
+      _timer._blocked.fetch_sub(1, std::memory_order_relaxed);
+    }
+    ConditionTimer& _timer;
+  };
+
+  /** Whether the flag is set, for waiting threads. */
+  bool _isSet() const {
+    return _flag.load(std::memory_order_seq_cst);
+  }
+
+  /** Sets the flag and wakes up one or all blocked threads. */
+  void _notify(bool all);
+
+  /** Blocks until the flag is set, after spinning for a moment. */
+  void _wait();
+
   /** Mutex for the condition variable. */
   std::mutex _mutex;
 
-  /** Flag to avoid race conditions with the condition variable. */
-  bool _flag;
+  /** The flag threads wait for. */
+  std::atomic<bool> _flag;
+
+  /** The number of threads blocked on the condition variable. */
+  std::atomic<int> _blocked;
+
+  /** Decides how long to spin before blocking. */
+  SpinWait _spinWait;
 
   /** A condition variable for sleeping until a condition is met. */
   std::condition_variable _conditionVariable;
@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <type_traits>
 #include <vector>
@@ -148,6 +149,113 @@ convertUnsigned(const MemoryValue& memoryValue) {
   }
   return result;
 }
+
+/** The unsigned type holding the bits of T. */
+template <typename T>
+struct UnsignedBits : std::make_unsigned<T> {};
+template <>
+struct UnsignedBits<bool> {
+  using type = std::uint8_t;
+};
+
+template <typename T>
+constexpr bool isNegative(T value, std::true_type) {
+  return value < 0;
+}
+template <typename T>
+constexpr bool isNegative(T, std::false_type) {
+  return false;
+}
+
+/**
+ * \brief Checks whether a layout matches the layout of integers on the host,
+ * so that values can be copied instead of converted bit by bit.
+ * \param byteSize size of a byte in bit
+ * \param byteOrder Endianess of the MemoryValue
+ * \param representation the method of storing signed values
+ * \returns true if the fast conversions can be used
+ */
+constexpr bool
+hasNativeLayout(std::size_t byteSize,
+                ArchitectureProperties::Endianness byteOrder,
+                ArchitectureProperties::SignedRepresentation representation =
+                    ArchitectureProperties::SignedRepresentation::
+                        TWOS_COMPLEMENT) {
+  return byteSize == 8 &&
+         byteOrder == ArchitectureProperties::Endianness::LITTLE &&
+         representation ==
+             ArchitectureProperties::SignedRepresentation::TWOS_COMPLEMENT;
+}
+
+/**
+ * \brief Converts a little endian MemoryValue with 8 bit bytes into integral
+ * form, sign extending it if T is signed (two's complement).
+ * \param memoryValue The to be converted MemoryValue
+ * \tparam T The desired type of the output
+ * \returns integral representation of memoryValue, truncated to T
+ */
+template <typename T>
+T loadLittleEndian(const MemoryValue& memoryValue) {
+  using Unsigned = typename UnsignedBits<T>::type;
+  constexpr std::size_t bits = sizeof(Unsigned) * 8;
+  const auto& data = memoryValue.internal();
+  const std::size_t size = memoryValue.getSize();
+
+  Unsigned result = 0;
+  const std::size_t bytes = std::min(sizeof(Unsigned), data.size());
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  std::memcpy(&result, data.data(), bytes);
+#else
+  for (std::size_t i = 0; i < bytes; ++i) {
+    result |= static_cast<Unsigned>(Unsigned(data[i]) << (i * 8));
+  }
+#endif
+
+  if (size < bits) {
+    const auto mask = static_cast<Unsigned>((Unsigned(1) << size) - 1);
+    result &= mask;
+    if (std::is_signed<T>::value && size > 0 &&
+        ((result >> (size - 1)) & 1)) {
+      result = static_cast<Unsigned>(result | ~mask);
+    }
+  }
+  return static_cast<T>(result);
+}
+
+/**
+ * \brief Converts an integral value into a little endian MemoryValue with 8
+ * bit bytes, sign extending it if T is signed (two's complement).
+ * \param value The to be converted value
+ * \param size number of bits to reserve for storing the value
+ * \tparam T The type of the input
+ * \returns MemoryValue representating value
+ */
+template <typename T>
+MemoryValue storeLittleEndian(T value, std::size_t size) {
+  using Unsigned = typename UnsignedBits<T>::type;
+  const bool negative = isNegative(value, std::is_signed<T>{});
+  const auto bits = static_cast<Unsigned>(value);
+
+  std::vector<std::uint8_t> raw((size + 7) / 8, negative ? 0xFF : 0x00);
+  const std::size_t bytes = std::min(sizeof(Unsigned), raw.size());
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  std::memcpy(raw.data(), &bits, bytes);
+#else
+  for (std::size_t i = 0; i < bytes; ++i) {
+    raw[i] = static_cast<std::uint8_t>(bits >> (i * 8));
+  }
+#endif
+  if (size % 8 != 0) {
+    raw.back() &= static_cast<std::uint8_t>((1u << (size % 8)) - 1);
+  }
+
+  MemoryValue result{std::move(raw), size};
+  if (std::is_signed<T>::value) {
+    // Like the generic conversion, the most significant bit holds the sign
+    result.set(size - 1, negative);
+  }
+  return result;
+}
 }
 
 /**
@@ -360,6 +468,9 @@ typename std::
                 ArchitectureProperties::Endianness::LITTLE,
             ArchitectureProperties::SignedRepresentation representation =
                 ArchitectureProperties::SignedRepresentation::TWOS_COMPLEMENT) {
+  if (detail::hasNativeLayout(byteSize, byteOrder)) {
+    return detail::loadLittleEndian<T>(memoryValue);
+  }
   return detail::convertForced<T>(
       memoryValue, detail::SignedRepresentation::UNSIGNED, byteSize, byteOrder);
 }
@@ -372,6 +483,9 @@ convert(const MemoryValue& memoryValue,
             ArchitectureProperties::Endianness::LITTLE,
         ArchitectureProperties::SignedRepresentation representation =
             ArchitectureProperties::SignedRepresentation::TWOS_COMPLEMENT) {
+  if (detail::hasNativeLayout(byteSize, byteOrder, representation)) {
+    return detail::loadLittleEndian<T>(memoryValue);
+  }
   return detail::convertForced<T>(memoryValue,
                                   detail::mapRepresentation(representation),
                                   byteSize,
@@ -400,6 +514,9 @@ convert(T value,
             ArchitectureProperties::Endianness::LITTLE,
         ArchitectureProperties::SignedRepresentation representation =
             ArchitectureProperties::SignedRepresentation::TWOS_COMPLEMENT) {
+  if (detail::hasNativeLayout(byteSize, byteOrder)) {
+    return detail::storeLittleEndian<T>(value, size);
+  }
   return detail::convertForced<T>(
       value, size, detail::SignedRepresentation::UNSIGNED, byteSize, byteOrder);
 }
@@ -413,12 +530,57 @@ convert(T value,
             ArchitectureProperties::Endianness::LITTLE,
         ArchitectureProperties::SignedRepresentation representation =
             ArchitectureProperties::SignedRepresentation::TWOS_COMPLEMENT) {
+  if (detail::hasNativeLayout(byteSize, byteOrder, representation)) {
+    return detail::storeLittleEndian<T>(value, size);
+  }
   return detail::convertForced<T>(value,
                                   size,
                                   detail::mapRepresentation(representation),
                                   byteSize,
                                   byteOrder);
 }
+
+/**
+ * \brief Converts values for an architecture whose properties are known at
+ * compile time.
+ *
+ * The general template uses the generic conversions. Little endian, two's
+ * complement architectures with 8 bit bytes are specialized to copy the bytes
+ * and sign extend, without permuting or allocating temporary values.
+ *
+ * \tparam byteOrder Endianess of the architecture
+ * \tparam representation the method of storing signed values
+ * \tparam byteSize size of a byte in bit
+ */
+template <ArchitectureProperties::Endianness byteOrder,
+          ArchitectureProperties::SignedRepresentation representation,
+          std::size_t byteSize>
+struct Converter {
+  template <typename T>
+  static T toIntegral(const MemoryValue& memoryValue) {
+    return convert<T>(memoryValue, byteSize, byteOrder, representation);
+  }
+
+  template <typename T>
+  static MemoryValue toMemoryValue(T value, std::size_t size) {
+    return convert<T>(value, size, byteSize, byteOrder, representation);
+  }
+};
+
+template <>
+struct Converter<ArchitectureProperties::Endianness::LITTLE,
+                 ArchitectureProperties::SignedRepresentation::TWOS_COMPLEMENT,
+                 8> {
+  template <typename T>
+  static T toIntegral(const MemoryValue& memoryValue) {
+    return detail::loadLittleEndian<T>(memoryValue);
+  }
+
+  template <typename T>
+  static MemoryValue toMemoryValue(T value, std::size_t size) {
+    return detail::storeLittleEndian<T>(value, size);
+  }
+};
 }
 
 #endif// ERAGPSIM_CORE_ADVANCED_CONVERSIONS_HPP
@@ -0,0 +1,159 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ERAGPSIM_CORE_FRAMEBUFFER_CHANNEL_HPP
+#define ERAGPSIM_CORE_FRAMEBUFFER_CHANNEL_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * A lock-free, triple buffered copy of a memory area for output devices.
+ *
+ * The memory (on the thread of the project) publishes a new frame after every
+ * write to the area, an output component (on the GUI thread) consumes the
+ * newest frame whenever it paints. Neither side ever waits for the other:
+ * the writer always owns one buffer, the reader owns another and the third
+ * one is exchanged atomically between them. Frames the reader did not pick up
+ * in time are simply replaced by newer ones.
+ *
+ * Every frame carries a range covering all cells which changed since the last
+ * frame the reader consumed, so it only has to redraw that part. The range may
+ * be larger than necessary, but never misses a change.
+ *
+ * There must be at most one writer and one reader at a time.
+ */
+class FramebufferChannel {
+ public:
+  using size_t = std::size_t;
+  using Buffer = std::vector<std::uint8_t>;
+  using Reader = std::function<void(size_t, size_t, std::uint8_t *)>;
+
+  /**
+   * Creates a channel mirroring an area of the memory.
+   *
+   * \param address The first cell of the area.
+   * \param amount The number of cells of the area.
+   */
+  FramebufferChannel(size_t address, size_t amount);
+
+  FramebufferChannel(const FramebufferChannel &other) = delete;
+  FramebufferChannel &operator=(const FramebufferChannel &other) = delete;
+
+  /**
+   * Returns the first cell of the mirrored area.
+   */
+  size_t getAddress() const noexcept;
+
+  /**
+   * Returns the number of cells of the mirrored area.
+   */
+  size_t getSize() const noexcept;
+
+  /**
+   * Returns true if [address, address + amount) overlaps the mirrored area.
+   */
+  bool overlaps(size_t address, size_t amount) const noexcept;
+
+  /**
+   * Publishes a new frame after a write to the memory.
+   *
+   * Only the cells which are outdated in the buffer of the writer are copied,
+   * which usually are just the written ones.
+   *
+   * \param memory The cells of the whole memory, one byte per cell.
+   * \param address The first written cell.
+   * \param amount The number of written cells.
+   */
+  void publish(const std::uint8_t *memory, size_t address, size_t amount);
+
+  /**
+   * Publishes a new frame after a write to the memory, like above, for a
+   * memory that is not stored in one piece.
+   *
+   * \param read Copies the cells [address, address + amount) of the memory to
+   *        a destination, called as read(address, amount, destination).
+   * \param address The first written cell.
+   * \param amount The number of written cells.
+   */
+  void publish(const Reader &read, size_t address, size_t amount);
+
+  /**
+   * Takes the newest published frame, if there is one.
+   *
+   * \return true if a new frame was taken, false if the current frame is
+   *         still the newest one.
+   */
+  bool consume();
+
+  /**
+   * Returns the contents of the frame taken by the last call to consume().
+   */
+  const Buffer &getFrame() const noexcept;
+
+  /**
+   * Returns the first cell (relative to the area) which may have changed
+   * since the frame consumed before.
+   */
+  size_t getDirtyBegin() const noexcept;
+
+  /**
+   * Returns the end of the cells (relative to the area) which may have
+   * changed since the frame consumed before.
+   */
+  size_t getDirtyEnd() const noexcept;
+
+ private:
+  struct Range {
+    size_t begin;
+    size_t end;
+
+    bool isEmpty() const noexcept;
+    Range unite(const Range &other) const noexcept;
+  };
+
+  struct Slot {
+    Buffer data;
+    Range dirty;
+  };
+
+  // The exchanged slot is stored together with a flag telling whether it
+  // holds a frame the reader has not seen yet.
+  static constexpr std::uint8_t _fresh = 4;
+  static constexpr std::uint8_t _indexMask = 3;
+
+  size_t _address;
+  size_t _size;
+  std::array<Slot, 3> _slots;
+  std::atomic<std::uint8_t> _exchange;
+
+  // only accessed by the writer
+  std::uint8_t _back;
+  std::array<Range, 3> _outdated;
+  Range _unseen;
+
+  // only accessed by the reader
+  std::uint8_t _front;
+};
+
+#endif  // ERAGPSIM_CORE_FRAMEBUFFER_CHANNEL_HPP
@@ -0,0 +1,115 @@
+/* C++ Assembler Interpreter
+ * Copyright (C) 2016 Chair of Computer Architecture
+ * at Technical University of Munich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef ERAGPSIM_CORE_HART_GROUP_HPP
+#define ERAGPSIM_CORE_HART_GROUP_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "core/condition-timer.hpp"
+#include "core/memory-access.hpp"
+
+/**
+ * Runs the harts 1 to n-1 of a program, every hart on its own thread, while
+ * hart 0 is executed by the ParsingAndExecutionUnit.
+ *
+ * The harts only talk to the project through their own MemoryAccess, see
+ * MemoryAccess::forHart(). Sleep requests of a hart only delay that hart.
+ */
+class HartGroup {
+ public:
+  using size_t = std::size_t;
+
+  /**
+   * Executes the next instruction of a hart.
+   *
+   * Must be safe to call from several threads at once. Returns false if the
+   * hart is done, e.g. because it left the program.
+   */
+  using Step = std::function<bool(MemoryAccess&)>;
+
+  HartGroup();
+
+  HartGroup(const HartGroup&) = delete;
+  HartGroup& operator=(const HartGroup&) = delete;
+
+  /**
+   * Stops the harts.
+   */
+  ~HartGroup();
+
+  /**
+   * Starts a thread for each of the harts 1 to hartCount-1. Running harts are
+   * stopped first.
+   *
+   * \param hartCount The number of harts, including hart 0.
+   * \param memoryAccess A proxy of the project, it is copied for each hart.
+   * \param virtualTime Whether sleeps only advance the virtual time instead
+   * of delaying the hart.
+   * \param step The function executing an instruction.
+   */
+  void start(size_t hartCount,
+             const MemoryAccess& memoryAccess,
+             bool virtualTime,
+             Step step);
+
+  /**
+   * Stops the harts after their current instruction and waits for them.
+   *
+   * \return true if harts were started since the last stop.
+   */
+  bool stop();
+
+  /**
+   * Waits until every hart is done or the timeout is over, whichever comes
+   * first. The harts keep running afterwards.
+   *
+   * \param timeout The longest time to wait.
+   * \return true if no hart is running any more.
+   */
+  bool waitUntilDone(std::chrono::milliseconds timeout);
+
+ private:
+  /**
+   * Executes a hart until it is done or stopped.
+   */
+  void _run(MemoryAccess memoryAccess, std::shared_ptr<SleepTimer> sleepTimer);
+
+  /** The threads of the harts. */
+  std::vector<std::thread> _threads;
+
+  /** Set to stop the harts, also interrupts their sleeps. */
+  ConditionTimer _stop;
+
+  /** Set once the last running hart is done. */
+  ConditionTimer _done;
+
+  /** The number of harts which are not done yet. */
+  std::atomic<size_t> _running;
+
+  /** Executes the instructions. */
+  Step _step;
+};
+
+#endif /* ERAGPSIM_CORE_HART_GROUP_HPP */
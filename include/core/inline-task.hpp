@@ -0,0 +1,194 @@
+/* C++ Assembler Interpreter
+ * Copyright (C) 2016 Chair of Computer Architecture
+ * at Technical University of Munich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ERAGPSIM_CORE_INLINE_TASK_HPP
+#define ERAGPSIM_CORE_INLINE_TASK_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * \brief A move-only function object without arguments or return value.
+ *
+ * Unlike std::function, callables up to bufferSize bytes are stored inside the
+ * task itself, so creating and moving a task does not allocate. Larger
+ * callables are moved to the heap. As the task does not have to be copyable,
+ * it can also hold move-only callables, e.g. a lambda capturing a
+ * std::promise.
+ */
+class InlineTask {
+ public:
+  /** The number of bytes a callable may have to be stored inline. */
+  static constexpr std::size_t bufferSize = 8 * sizeof(void*);
+
+  /** Creates an empty task, which must not be called. */
+  InlineTask() noexcept : _operations(nullptr) {
+  }
+
+  /**
+   * Creates a task from a callable.
+   *
+   * \param function A callable with the signature void().
+   */
+  template <typename Function,
+            typename Decayed = typename std::decay<Function>::type,
+            typename = typename std::enable_if<
+                !std::is_same<Decayed, InlineTask>::value>::type>
+  InlineTask(Function&& function) {
+    using Holder = typename std::conditional<_fitsInline<Decayed>(),
+                                             InlineHolder<Decayed>,
+                                             HeapHolder<Decayed>>::type;
+    Holder::create(&_buffer, std::forward<Function>(function));
+    _operations = &Holder::operations;
+  }
+
+  InlineTask(InlineTask&& other) noexcept : _operations(other._operations) {
+    if (_operations) {
+      _operations->move(&other._buffer, &_buffer);
+      other._operations = nullptr;
+    }
+  }
+
+  InlineTask& operator=(InlineTask&& other) noexcept {
+    if (this != &other) {
+      _reset();
+      if (other._operations) {
+        other._operations->move(&other._buffer, &_buffer);
+        _operations = other._operations;
+        other._operations = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  InlineTask(const InlineTask& other) = delete;
+  InlineTask& operator=(const InlineTask& other) = delete;
+
+  ~InlineTask() {
+    _reset();
+  }
+
+  /** Calls the stored callable. */
+  void operator()() {
+    _operations->invoke(&_buffer);
+  }
+
+  /** \returns True if the task holds a callable. */
+  explicit operator bool() const noexcept {
+    return _operations != nullptr;
+  }
+
+ private:
+  using Buffer =
+      std::aligned_storage<bufferSize, alignof(std::max_align_t)>::type;
+
+  /** The functions of a stored callable, one static table for every type. */
+  struct Operations {
+    void (*invoke)(void* buffer);
+    /** Moves the callable into another buffer and destroys the old one. */
+    void (*move)(void* from, void* to);
+    void (*destroy)(void* buffer);
+  };
+
+  /** Stores the callable in the buffer. */
+  template <typename Function>
+  struct InlineHolder {
+    template <typename Argument>
+    static void create(void* buffer, Argument&& function) {
+      new (buffer) Function(std::forward<Argument>(function));
+    }
+
+    static Function* get(void* buffer) {
+      return static_cast<Function*>(buffer);
+    }
+
+    static void invoke(void* buffer) {
+      (*get(buffer))();
+    }
+
+    static void move(void* from, void* to) {
+      new (to) Function(std::move(*get(from)));
+      get(from)->~Function();
+    }
+
+    static void destroy(void* buffer) {
+      get(buffer)->~Function();
+    }
+
+    static constexpr Operations operations = {invoke, move, destroy};
+  };
+
+  /** Stores a pointer to the callable in the buffer. */
+  template <typename Function>
+  struct HeapHolder {
+    template <typename Argument>
+    static void create(void* buffer, Argument&& function) {
+      *static_cast<Function**>(buffer) =
+          new Function(std::forward<Argument>(function));
+    }
+
+    static Function*& get(void* buffer) {
+      return *static_cast<Function**>(buffer);
+    }
+
+    static void invoke(void* buffer) {
+      (*get(buffer))();
+    }
+
+    static void move(void* from, void* to) {
+      *static_cast<Function**>(to) = get(from);
+    }
+
+    static void destroy(void* buffer) {
+      delete get(buffer);
+    }
+
+    static constexpr Operations operations = {invoke, move, destroy};
+  };
+
+  /** Whether a callable can be stored inside the task. */
+  template <typename Function>
+  static constexpr bool _fitsInline() {
+    return sizeof(Function) <= sizeof(Buffer) &&
+           alignof(Function) <= alignof(Buffer) &&
+           std::is_nothrow_move_constructible<Function>::value;
+  }
+
+  void _reset() noexcept {
+    if (_operations) {
+      _operations->destroy(&_buffer);
+      _operations = nullptr;
+    }
+  }
+
+  /** The functions of the stored callable, nullptr if there is none. */
+  const Operations* _operations;
+
+  /** Holds the callable or a pointer to it. */
+  Buffer _buffer;
+};
+
+template <typename Function>
+constexpr InlineTask::Operations InlineTask::InlineHolder<Function>::operations;
+
+template <typename Function>
+constexpr InlineTask::Operations InlineTask::HeapHolder<Function>::operations;
+
+#endif /* ERAGPSIM_CORE_INLINE_TASK_HPP */
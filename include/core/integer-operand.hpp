@@ -0,0 +1,87 @@
+/* C++ Assembler Interpreter
+ * Copyright (C) 2016 Chair of Computer Architecture
+ * at Technical University of Munich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef ERAGPSIM_CORE_INTEGER_OPERAND_HPP
+#define ERAGPSIM_CORE_INTEGER_OPERAND_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "core/conversions.hpp"
+#include "core/memory-value.hpp"
+
+/**
+ * \brief The value of an operand of at most 64 bit as a native integer.
+ *
+ * Instructions read their operands like this instead of as MemoryValues, so
+ * that reading an operand needs no heap allocation. The bits are stored little
+ * endian and with 8 bit bytes, like MemoryValues of such architectures.
+ */
+struct IntegerOperand {
+  /**
+   * \brief Constructs an empty operand.
+   */
+  IntegerOperand() : bits(0), size(0) {
+  }
+
+  /**
+   * \brief Constructs an operand from bits.
+   * \param bits The bits of the value, higher bits must be zero.
+   * \param size The number of bits of the value.
+   */
+  IntegerOperand(std::uint64_t bits, std::size_t size)
+  : bits(bits), size(size) {
+  }
+
+  /**
+   * \brief Constructs an operand holding the lower 64 bits of a MemoryValue.
+   * \param value The little endian value.
+   */
+  explicit IntegerOperand(const MemoryValue& value)
+  : bits(conversions::detail::loadLittleEndian<std::uint64_t>(value))
+  , size(std::min<std::size_t>(value.getSize(), 64)) {
+  }
+
+  /**
+   * \brief Converts this operand like riscv::convert converts a MemoryValue:
+   *        sign extended if T is signed, zero extended otherwise and
+   *        truncated to T.
+   * \tparam T The desired type of the output
+   * \returns The value of this operand as T
+   */
+  template <typename T>
+  T as() const {
+    auto value = bits;
+    if (std::is_signed<T>::value && size > 0 && size < 64 &&
+        ((bits >> (size - 1)) & 1)) {
+      value |= ~((std::uint64_t(1) << size) - 1);
+    }
+    return static_cast<T>(value);
+  }
+
+  /** The bits of the value. */
+  std::uint64_t bits;
+
+  /** The number of bits of the value. */
+  std::size_t size;
+};
+
+#endif /* ERAGPSIM_CORE_INTEGER_OPERAND_HPP */
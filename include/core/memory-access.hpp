@@ -20,11 +20,17 @@
 #ifndef ERAGPSIM_CORE_MEMORY_ACCESS_HPP
 #define ERAGPSIM_CORE_MEMORY_ACCESS_HPP
 
+#include <atomic>
+#include <cstddef>
+#include <future>
 #include <memory>
+#include <string>
+#include <utility>
 
 #include "core/condition-timer.hpp"
 #include "core/project.hpp"
 #include "core/proxy.hpp"
+#include "core/sleep-timer.hpp"
 
 /**
  * A Proxy to access the memory and register components of a project safely.
@@ -33,24 +39,35 @@
 class MemoryAccess : public Proxy<Project> {
  public:
   using SharedCondition = std::shared_ptr<ConditionTimer>;
+  using SharedSleepTimer = std::shared_ptr<SleepTimer>;
+  using SharedMemorySize = std::shared_ptr<const std::atomic<std::size_t>>;
 
   /**
    * Constructs a new MemoryAccess.
    *
    */
-  MemoryAccess(const Proxy<Project>& proxy, SharedCondition conditionTimer)
-  : Proxy(proxy), _conditionTimer(conditionTimer) {
+  MemoryAccess(const Proxy<Project>& proxy, SharedSleepTimer sleepTimer);
+
+  /**
+   * Returns the number of memory cells(number of bytes) without waiting for
+   * the project, as it was last published.
+   *
+   */
+  std::size_t getCachedMemorySize() const {
+    return _memorySize->load();
   }
 
   /**
-   * Lets the thread that calls this sleep for a specified amount of time.
-   * The sleep is interruptible through a stop flag.
+   * Requests that the execution sleeps for a specified amount of time before
+   * the next instruction. This does not block, the execution is suspended
+   * after the current instruction.
    *
    * \param sleepDuration (minimum)duration of the sleep.
    */
   template <typename Rep, typename Period>
   void sleep(const std::chrono::duration<Rep, Period> sleepDuration) {
-    _conditionTimer->waitFor(sleepDuration);
+    _sleepTimer->request(
+        std::chrono::duration_cast<SleepTimer::Duration>(sleepDuration));
   }
 
   /**
@@ -67,6 +84,16 @@ class MemoryAccess : public Proxy<Project> {
    */
   POST_FUTURE_CONST(tryGetMemoryValueAt)
 
+  /**
+   * Calls Memory::tryGet without blocking, see POST_ASYNC.
+   *
+   * \param executor Runs the continuation, e.g. in the gui thread.
+   * \param continuation Called with the cells as MemoryValue.
+   * \param address address of the memory cells.
+   * \param length number of memory cells to return.
+   */
+  POST_ASYNC(tryGetMemoryValueAt)
+
   /**
    * Returns a number of memory cells at a given address as
    * MemoryValue through a callback.
@@ -125,6 +152,17 @@ class MemoryAccess : public Proxy<Project> {
    */
   POST_FUTURE_CONST(isMemoryProtectedAt)
 
+  /**
+   * Checks if any memory cells in the given area are protected, without
+   * blocking, see POST_ASYNC.
+   *
+   * \param executor Runs the continuation, e.g. in the gui thread.
+   * \param continuation Called with the result as bool.
+   * \param address The first address of the area to check
+   * \param amount The amount of cells to check
+   */
+  POST_ASYNC(isMemoryProtectedAt)
+
   /**
    * Checks if any memory cells in the given area are protected.
    *
@@ -153,12 +191,154 @@ class MemoryAccess : public Proxy<Project> {
   POST(removeMemoryProtection)
 
   /**
-   * Returns the content of a register as MemoryValue.
+   * Mirrors an area of the memory into a FramebufferChannel, which can be
+   * read without going through the project.
+   *
+   * \param address The first address of the area
+   * \param amount The amount of cells of the area
+   * \returns std::future<std::shared_ptr<FramebufferChannel>>, holding
+   * nullptr if the area cannot be mapped.
+   */
+  POST_FUTURE(mapFramebuffer)
+
+  /**
+   * Maps an area of the memory into a FramebufferChannel without blocking,
+   * see mapFramebuffer and POST_ASYNC.
+   *
+   * \param executor Runs the continuation, e.g. in the gui thread.
+   * \param continuation Called with the channel, nullptr if the area cannot
+   * be mapped.
+   * \param address The first address of the area
+   * \param amount The amount of cells of the area
+   */
+  POST_ASYNC(mapFramebuffer)
+
+  /**
+   * Stops updating a channel created by mapFramebuffer.
+   *
+   * \param channel The channel
+   */
+  POST(unmapFramebuffer)
+
+  /**
+   * Takes all bytes out of a ring buffer in memory, see MemoryRingBuffer.
+   *
+   * \param address The address of the ring buffer.
+   * \param capacity The number of data bytes of the ring buffer.
+   * \returns std::future<std::string>, empty if the buffer does not fit into
+   * the memory.
+   */
+  POST_FUTURE(drainRingBuffer)
+
+  /**
+   * Takes all bytes out of a ring buffer in memory without blocking, see
+   * drainRingBuffer and POST_ASYNC.
+   *
+   * \param executor Runs the continuation, e.g. in the gui thread.
+   * \param continuation Called with the bytes as std::string.
+   * \param address The address of the ring buffer.
+   * \param capacity The number of data bytes of the ring buffer.
+   */
+  POST_ASYNC(drainRingBuffer)
+
+  /**
+   * Puts bytes into a ring buffer in memory, see MemoryRingBuffer. Either all
+   * bytes are written or none.
+   *
+   * \param address The address of the ring buffer.
+   * \param capacity The number of data bytes of the ring buffer.
+   * \param data The bytes as std::string.
+   * \returns std::future<bool>, true if the bytes were written.
+   */
+  POST_FUTURE(fillRingBuffer)
+
+  /**
+   * Puts bytes into a ring buffer in memory without blocking, see
+   * fillRingBuffer and POST_ASYNC.
+   *
+   * \param executor Runs the continuation, e.g. in the gui thread.
+   * \param continuation Called with true if the bytes were written.
+   * \param address The address of the ring buffer.
+   * \param capacity The number of data bytes of the ring buffer.
+   * \param data The bytes as std::string.
+   */
+  POST_ASYNC(fillRingBuffer)
+
+  /**
+   * Returns a proxy which accesses the registers of another hart, the memory
+   * is shared by all harts.
+   *
+   * \param hart The index of the hart.
+   */
+  MemoryAccess forHart(std::size_t hart) const {
+    MemoryAccess memoryAccess(*this);
+    memoryAccess._hart = hart;
+    return memoryAccess;
+  }
+
+  /**
+   * Returns the index of the hart whose registers this proxy accesses.
+   *
+   */
+  std::size_t getHart() const noexcept {
+    return _hart;
+  }
+
+  /**
+   * Returns the number of harts of the project.
+   *
+   */
+  POST_FUTURE_CONST(getHartCount)
+
+  /**
+   * \copydoc Project::setHartCount()
+   */
+  POST(setHartCount)
+
+  /**
+   * Returns the content of a register of the hart of this proxy as
+   * MemoryValue.
+   *
+   * \param name The name of the register as std::string.
+   *
+   */
+  std::future<MemoryValue> getRegisterValue(const std::string& name) const;
+
+  /**
+   * Returns the content of a register of a hart as MemoryValue.
+   *
+   * \param hart The index of the hart.
+   * \param name The name of the register as std::string.
+   *
+   */
+  POST_FUTURE_CONST(getHartRegisterValue)
+
+  /**
+   * Returns the RegisterID of a register, to read it with
+   * getRegisterOperand().
    *
    * \param name The name of the register as std::string.
    *
    */
-  POST_FUTURE_CONST(getRegisterValue)
+  POST_FUTURE_CONST(getRegisterID)
+
+  /**
+   * Returns the content of a register of the hart of this proxy as integer,
+   * without looking up its name.
+   *
+   * \param id The RegisterID of the register, see getRegisterID().
+   *
+   */
+  std::future<IntegerOperand> getRegisterOperand(const RegisterID& id) const;
+
+  /**
+   * Returns the content of a register of a hart as integer.
+   *
+   * \param hart The index of the hart.
+   * \param id The RegisterID of the register, see getRegisterID().
+   *
+   */
+  POST_FUTURE_CONST(getHartRegisterOperand)
 
   /**
    * Returns the content of a register as a MemoryValue through a callback.
@@ -171,22 +351,44 @@ class MemoryAccess : public Proxy<Project> {
   POST_CALLBACK_SAFE(getRegisterValue)
 
   /**
-   * Puts a value in a register.
+   * Puts a value in a register of the hart of this proxy.
+   *
+   * \param name The name of the register as std::string.
+   * \param value The MemoryValue which is written in the register.
+   *
+   */
+  void putRegisterValue(const std::string& name, MemoryValue value);
+
+  /**
+   * Puts a value in a register of a hart.
    *
+   * \param hart The index of the hart.
    * \param name The name of the register as std::string.
    * \param value The MemoryValue which is written in the register.
    *
    */
-  POST(putRegisterValue)
+  POST(putHartRegisterValue)
+
+  /**
+   * Sets a register of the hart of this proxy to a value and returns the old
+   * value
+   *
+   * \param name The name of the register as std::string.
+   * \param value MemoryValue object which is
+   * written to the register.
+   */
+  std::future<MemoryValue>
+  setRegisterValue(const std::string& name, MemoryValue value);
 
   /**
-   * Sets a register to a value and returns the old value
+   * Sets a register of a hart to a value and returns the old value.
    *
+   * \param hart The index of the hart.
    * \param name The name of the register as std::string.
    * \param value MemoryValue object which is
    * written to the register.
    */
-  POST_FUTURE(setRegisterValue)
+  POST_FUTURE(setHartRegisterValue)
 
   /**
    * Sets a register to a value and returns the old value through a callback.
@@ -200,16 +402,225 @@ class MemoryAccess : public Proxy<Project> {
    */
   POST_CALLBACK_SAFE(setRegisterValue)
 
+  /**
+   * Returns the channel through which the project publishes a copy of all
+   * registers. Reading from it never waits for the project.
+   *
+   */
+  POST_FUTURE_CONST(getRegisterSnapshots)
+
   /**
    * Returns the number of memory cells(number of bytes)
    *
    */
   POST_FUTURE_CONST(getMemorySize)
 
+  /**
+   * Returns the number of bits in a byte
+   *
+   */
+  POST_FUTURE_CONST(getByteSize)
+
+  /**
+   * Returns the memory size published by the project, see
+   * getCachedMemorySize().
+   *
+   */
+  POST_FUTURE_CONST(getPublishedMemorySize)
+
+  /**
+   * Runs a batch of reads and writes of this hart as a single task on the
+   * project thread, see Project::hartTransaction(). Instead of one round trip
+   * for every access, there is one for the whole batch.
+   *
+   * \code
+   * auto future = memoryAccess.transaction([address](Transaction& batch) {
+   *   auto size = batch.getMemorySize();
+   *   return size > address && !batch.isMemoryProtectedAt(address, 4);
+   * });
+   * \endcode
+   *
+   * \param function A callable taking a Transaction& and returning a value.
+   * It must not use a MemoryAccess or any other proxy of the project.
+   * \returns std::future holding the result of the callable.
+   */
+  template <typename Function>
+  auto transaction(Function&& function) {
+    return hartTransaction(_hart, std::forward<Function>(function));
+  }
+
+  /**
+   * Runs a batch of reads and writes without blocking, see transaction() and
+   * POST_ASYNC.
+   *
+   * \param executor Runs the continuation, e.g. in the gui thread.
+   * \param continuation Called with the result of the batch.
+   * \param function A callable taking a Transaction& and returning a value.
+   */
+  template <typename Executor, typename Continuation, typename Function>
+  void transactionAsync(Executor&& executor,
+                        Continuation&& continuation,
+                        Function&& function) const {
+    hartTransactionAsync(std::forward<Executor>(executor),
+                         std::forward<Continuation>(continuation),
+                         _hart,
+                         std::forward<Function>(function));
+  }
+
+  /**
+   * Runs a batch of writes (or reads and writes) whose result is not needed,
+   * without waiting for it, see transaction().
+   *
+   * \param function A callable taking a Transaction&.
+   */
+  template <typename Function>
+  void runTransaction(Function&& function) {
+    runHartTransaction(_hart, std::forward<Function>(function));
+  }
+
+  /**
+   * Runs a batch of reads and writes of a hart, see transaction().
+   *
+   * \param hart The index of the hart.
+   * \param function A callable taking a Transaction& and returning a value.
+   */
+  POST_FUTURE(hartTransaction)
+
+  /**
+   * Runs a batch of reads and writes of a hart without blocking, see
+   * transactionAsync().
+   *
+   * \param executor Runs the continuation, e.g. in the gui thread.
+   * \param continuation Called with the result of the batch.
+   * \param hart The index of the hart.
+   * \param function A callable taking a Transaction& and returning a value.
+   */
+  POST_ASYNC(hartTransaction)
+
+  /**
+   * Runs a batch of a hart without waiting for it, see runTransaction().
+   *
+   * \param hart The index of the hart.
+   * \param function A callable taking a Transaction&.
+   */
+  POST(runHartTransaction)
+
+  /**
+   * Starts collecting memory and register changes, which are then reported
+   * to the ui in merged batches.
+   *
+   */
+  POST(beginChangeBatch)
+
+  /**
+   * Reports all collected changes and stops collecting them.
+   *
+   */
+  POST(endChangeBatch)
+
+  /**
+   * Reports all collected changes, at most once per frame.
+   *
+   */
+  POST(flushChanges)
+
+  /**
+   * Starts recording the values overwritten by the next instruction.
+   *
+   */
+  POST(beginUndoStep)
+
+  /**
+   * Stops recording the values overwritten by the current instruction.
+   *
+   */
+  POST(endUndoStep)
+
+  /**
+   * Restores the state before the last recorded instruction.
+   *
+   * \returns std::future<bool>, false if there was nothing to undo.
+   */
+  POST_FUTURE(undoStep)
+
+  /**
+   * Returns the number of instructions which can be undone.
+   *
+   */
+  POST_FUTURE_CONST(getUndoStepCount)
+
+  /**
+   * Removes all recorded instructions.
+   *
+   */
+  POST(clearUndoLog)
+
+  /**
+   * Starts writing an execution trace to a file.
+   *
+   * \param path The path of the trace file.
+   * \param compress Whether to compress the trace.
+   *
+   * \returns std::future<bool>, false if the file could not be created.
+   */
+  POST_FUTURE(startTrace)
+
+  /**
+   * Records the instructions of the program in the trace.
+   *
+   */
+  POST(traceProgram)
+
+  /**
+   * Records the start of an instruction in the trace.
+   *
+   */
+  POST(traceStep)
+
+  /**
+   * Stops tracing.
+   *
+   * \returns std::future<std::uint64_t>, the number of traced instructions.
+   */
+  POST_FUTURE(stopTrace)
+
  private:
-  /** Condition timer which can block this thread for a specified time, but
-   * wakes up on notification. */
-  SharedCondition _conditionTimer;
+  /** Collects the sleep requests of the executed program. */
+  SharedSleepTimer _sleepTimer;
+
+  /** The memory size published by the project. */
+  SharedMemorySize _memorySize;
+
+  /** The hart whose registers are accessed. */
+  std::size_t _hart;
 };
 
+// Defined after the class, as the return type of getPublishedMemorySize is only
+// deduced there.
+inline MemoryAccess::MemoryAccess(const Proxy<Project>& proxy,
+                                  SharedSleepTimer sleepTimer)
+: Proxy(proxy), _sleepTimer(sleepTimer), _hart(0) {
+  _memorySize = getPublishedMemorySize().get();
+}
+
+inline std::future<MemoryValue>
+MemoryAccess::getRegisterValue(const std::string& name) const {
+  return getHartRegisterValue(_hart, name);
+}
+
+inline std::future<IntegerOperand>
+MemoryAccess::getRegisterOperand(const RegisterID& id) const {
+  return getHartRegisterOperand(_hart, id);
+}
+
+inline void
+MemoryAccess::putRegisterValue(const std::string& name, MemoryValue value) {
+  putHartRegisterValue(_hart, name, std::move(value));
+}
+
+inline std::future<MemoryValue>
+MemoryAccess::setRegisterValue(const std::string& name, MemoryValue value) {
+  return setHartRegisterValue(_hart, name, std::move(value));
+}
+
 #endif /* ERAGPSIM_CORE_MEMORY_ACCESS_HPP */
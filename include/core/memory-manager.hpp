@@ -91,6 +91,51 @@ class MemoryManager : public Proxy<Project> {
    * \return A future to the generated json object.
    */
   POST_FUTURE_CONST(generateSnapshot)
+
+  /**
+   * Loads a full binary snapshot and sets memory and registers accordingly.
+   *
+   * \param snapshot The binary snapshot.
+   */
+  POST(loadBinarySnapshot)
+
+  /**
+   * Loads a delta snapshot on top of its base.
+   *
+   * \param base The full snapshot the delta was created against.
+   * \param delta The delta snapshot.
+   */
+  POST(loadDeltaSnapshot)
+
+  /**
+   * Generates a full binary snapshot of memory and registers.
+   *
+   * \return A future to the generated snapshot.
+   */
+  POST_FUTURE_CONST(generateBinarySnapshot)
+
+  /**
+   * Generates a binary snapshot which only stores what changed since a full
+   * snapshot or a checkpoint.
+   *
+   * \param base The full snapshot or the checkpoint to compare against.
+   * \return A future to the generated delta snapshot.
+   */
+  POST_FUTURE_CONST(generateDeltaSnapshot)
+
+  /**
+   * Creates a checkpoint of memory and registers, which forks the memory.
+   *
+   * \return A future to the checkpoint.
+   */
+  POST_FUTURE_CONST(createCheckpoint)
+
+  /**
+   * Resets memory and registers to a checkpoint.
+   *
+   * \param checkpoint The checkpoint.
+   */
+  POST(restoreCheckpoint)
 };
 
 #endif /* ERAGPSIM_CORE_MEMORY_MANAGER_HPP */
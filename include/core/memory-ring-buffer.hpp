@@ -0,0 +1,123 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ERAGPSIM_CORE_MEMORY_RING_BUFFER_HPP
+#define ERAGPSIM_CORE_MEMORY_RING_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class Memory;
+
+/**
+ * A ring buffer in memory, used to exchange a stream of bytes between a
+ * simulated program and a device of the GUI (e.g. the console).
+ *
+ * Layout, starting at the address of the buffer:
+ *
+ *   offset 0: head, 4 bytes little endian. The index the producer writes the
+ *             next byte to.
+ *   offset 4: tail, 4 bytes little endian. The index the consumer reads the
+ *             next byte from.
+ *   offset 8: capacity bytes of data.
+ *
+ * The buffer is empty if head equals tail and full if head is just in front
+ * of tail, so it holds at most capacity - 1 bytes. The producer only ever
+ * writes head, the consumer only ever writes tail.
+ *
+ * The device side of the protocol runs on the thread of the project, so a
+ * whole transfer takes only a single request from the GUI.
+ */
+class MemoryRingBuffer {
+ public:
+  using size_t = std::size_t;
+
+  /** The number of bytes in front of the data. */
+  static constexpr size_t headerSize = 8;
+
+  /**
+   * Describes a ring buffer.
+   *
+   * \param address The address of the head.
+   * \param capacity The number of data bytes, at least 2.
+   */
+  MemoryRingBuffer(size_t address, size_t capacity);
+
+  /**
+   * Returns the address of the head.
+   */
+  size_t getAddress() const noexcept;
+
+  /**
+   * Returns the number of data bytes.
+   */
+  size_t getCapacity() const noexcept;
+
+  /**
+   * Returns the number of cells the buffer occupies, including the header.
+   */
+  size_t getTotalSize() const noexcept;
+
+  /**
+   * Returns true if the buffer fits into the memory, which has to consist of
+   * 8 bit cells.
+   */
+  bool fitsInto(const Memory &memory) const;
+
+  /**
+   * Takes all bytes out of the buffer, as its consumer.
+   *
+   * Indices outside of the buffer, which only a faulty program can produce,
+   * are wrapped around.
+   *
+   * \param memory The memory containing the buffer.
+   * \return The bytes in the order they were written.
+   */
+  std::string drain(Memory &memory) const;
+
+  /**
+   * Puts bytes into the buffer, as its producer. Either all bytes fit and are
+   * written, or nothing is written at all, so a message is never torn apart.
+   *
+   * \param memory The memory containing the buffer.
+   * \param data The bytes to write.
+   * \return True if the bytes were written.
+   */
+  bool fill(Memory &memory, const std::string &data) const;
+
+ private:
+  /**
+   * Reads an index from the header, wrapped into the buffer.
+   */
+  size_t _readIndex(const Memory &memory, size_t offset) const;
+
+  /**
+   * Writes an index into the header.
+   */
+  void _writeIndex(Memory &memory, size_t offset, size_t index) const;
+
+  /** The address of the head. */
+  size_t _address;
+
+  /** The number of data bytes. */
+  size_t _capacity;
+};
+
+#endif /* ERAGPSIM_CORE_MEMORY_RING_BUFFER_HPP */
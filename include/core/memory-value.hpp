@@ -454,6 +454,36 @@ class MemoryValue {
    */
   bool back() const;
 
+  /**
+   * \brief counts the zero bits above the highest set bit
+   * \return the number of leading zeros, getSize() if no bit is set
+   */
+  address_t countLeadingZeros() const;
+
+  /**
+   * \brief counts the set bits above the highest zero bit
+   * \return the number of leading ones, getSize() if all bits are set
+   */
+  address_t countLeadingOnes() const;
+
+  /**
+   * \brief returns the address of the highest set bit
+   * \return the address of the highest set bit, getSize() if no bit is set
+   */
+  address_t highestSetBit() const;
+
+  /**
+   * \brief counts the set bits
+   * \return the number of set bits
+   */
+  address_t countOnes() const;
+
+  /**
+   * \brief copies the bit at signBit into all bits above it
+   * \param signBit address of the bit to extend
+   */
+  void signExtend(address_t signBit);
+
 
   /**
    * \brief returns a reference to the data vector. For internal purposes only.
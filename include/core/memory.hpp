@@ -19,13 +19,18 @@
 #ifndef ERAGPSIM_CORE_MEMORY_HPP
 #define ERAGPSIM_CORE_MEMORY_HPP
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "core/framebuffer-channel.hpp"
 #include "core/memory-value.hpp"
 #include "third-party/json/json.hpp"
 
@@ -38,6 +43,12 @@ class Memory {
   using RawMapPair = std::pair<std::map<std::string, size_t>,
                                std::map<std::string, std::string>>;
   using ProtectionMap = std::map<size_t, size_t>;
+
+  /**
+   * \brief number of bytes of the packed data in a page
+   */
+  static constexpr size_t pageSize = 4096;
+
   /**
    * \brief Default constructor. Constructs an empty Memory with default size
    *        (64 Bytes � 8 Bit)
@@ -59,18 +70,23 @@ class Memory {
 
   /**
    * \brief Copy constructor. Constructs the Memory with the copy of the
-   *        contents of other.
+   *        contents of other. The data is shared page by page until one of
+   *        the memories writes to a page, so this takes time in the number of
+   *        pages only. The framebuffers mapped in other are not copied, they
+   *        keep mirroring other only.
    * \param other another Memory to be used as source to initialize the elements
    *        of the Memory with
    */
-  Memory(const Memory &other) = default;
+  Memory(const Memory &other);
   /**
-   * \brief Copy constructor. Constructs the Memory with the copy of the
-   *        contents of other.
+   * \brief Copy assignment. Replaces the cells and the protection of the
+   *        Memory by a copy of the ones of other, sharing the data page by
+   *        page. The callbacks and the framebuffers stay the ones of this
+   *        memory and are notified about the new contents.
    * \param other another Memory to be used as source to initialize the elements
    *        of the Memory with
    */
-  Memory &operator=(const Memory &other) = default;
+  Memory &operator=(const Memory &other);
   /**
    * \brief Move constructor. Constructs the Memory with the contents of other
    *        using move semantics.
@@ -206,6 +222,59 @@ class Memory {
    */
   void deserializeJSON(const Json &json);
 
+  /**
+   * \brief returns a copy of this memory that shares its data page by page,
+   *        but neither its callbacks nor its framebuffers; writes to either
+   *        memory are not visible in the other one
+   * \returns the fork of this memory
+   */
+  Memory fork() const;
+
+  /**
+   * \brief returns the cells of the whole memory one after another, packed
+   *        like the data of a MemoryValue
+   * \returns a copy of the raw data
+   */
+  MemoryValue::Underlying getRawData() const;
+
+  /**
+   * \brief replaces the whole memory by raw data; like deserializeJSON the
+   *        memory grows if byteCount is bigger, but never shrinks
+   * \param byteCount the number of cells stored in data
+   * \param data the cells packed like the data of a MemoryValue, padded with
+   *        zeros up to the size of the memory
+   */
+  void setRawData(size_t byteCount, MemoryValue::Underlying &&data);
+
+  /**
+   * \brief returns the number of pages holding the packed data, see getPage()
+   * \returns the number of pages
+   */
+  size_t getPageCount() const;
+
+  /**
+   * \brief returns the packed data of a page without copying it; the bytes
+   *        behind the last cell are zero
+   * \param index index of the page, less than getPageCount()
+   * \returns pageSize bytes, valid until the next write to this memory
+   */
+  const std::uint8_t *getPage(size_t index) const;
+
+  /**
+   * \brief returns true iff a page was never written, so all of its bytes are
+   *        zero without having to compare them
+   * \param index index of the page, less than getPageCount()
+   */
+  bool isZeroPage(size_t index) const;
+
+  /**
+   * \brief returns true iff a page is still shared with the same page of
+   *        another memory, e.g. a fork, so both pages hold the same bytes
+   * \param index index of the page
+   * \param other the other memory
+   */
+  bool sharesPage(size_t index, const Memory &other) const;
+
   /**
    * \brief returns true iff this == other
    * \returns the equality of this and other
@@ -250,6 +319,23 @@ class Memory {
    */
   void removeAllProtection();
 
+  /**
+   * \brief mirrors an area of the memory into a FramebufferChannel, which is
+   *        updated after every write to the area
+   * \param address first address of the area
+   * \param amount of cells of the area
+   * \returns the channel, nullptr if the area is not inside the memory or
+   *          the cells are not 8 bit wide
+   */
+  std::shared_ptr<FramebufferChannel>
+  mapFramebuffer(size_t address, size_t amount);
+
+  /**
+   * \brief stops updating a channel created by mapFramebuffer()
+   * \param channel the channel
+   */
+  void unmapFramebuffer(const std::shared_ptr<FramebufferChannel> &channel);
+
  private:
   /**
    * \brief character defaulty separating serialized cells
@@ -266,12 +352,75 @@ class Memory {
   static const std::string _dataMapStringIdentifier;
 
   /**
-   * \brief appends a string represenation of value to stream
-   * \param strm stringstream so append value to
-   * \param value value to append to strm
+   * \brief shorthand of pageSize
    */
-  static void
-  _appendMemoryValue(std::stringstream &strm, const MemoryValue &value);
+  static constexpr size_t _pageSize = pageSize;
+
+  using Page = std::array<std::uint8_t, _pageSize>;
+
+  /**
+   * \brief returns the page all pages start out as; it is never written
+   */
+  static const std::shared_ptr<Page> &_zeroPage();
+
+  /**
+   * \brief returns the number of bytes of the packed data
+   */
+  size_t _rawSize() const;
+
+  /**
+   * \brief adds zero pages until the pages cover the packed data
+   */
+  void _growPages();
+
+  /**
+   * \brief returns a page for writing, which is copied first if it is shared
+   * \param index index of the page
+   */
+  Page &_writablePage(size_t index);
+
+  /**
+   * \brief copies packed data out of the pages
+   * \param offset index of the first byte
+   * \param size number of bytes
+   * \param destination where to copy the bytes to
+   */
+  void _readRaw(size_t offset, size_t size, std::uint8_t *destination) const;
+
+  /**
+   * \brief copies packed data into the pages
+   * \param offset index of the first byte
+   * \param size number of bytes
+   * \param source the bytes to copy
+   */
+  void _writeRaw(size_t offset, size_t size, const std::uint8_t *source);
+
+  /**
+   * \brief updates the framebuffers overlapping with an area
+   * \param address first address of the area
+   * \param amount of cells of the area
+   */
+  void _publishFramebuffers(size_t address, size_t amount) const;
+
+  /**
+   * \brief writes value into the memory starting with the begin-th bit
+   * \param value the value to write
+   * \param begin the index of the first bit to be written to
+   */
+  void _write(const MemoryValue &value, size_t begin);
+
+  /**
+   * \brief appends the hex represenation of every cell of line to string, each
+   *        followed by separator
+   * \param string string to append the cells to
+   * \param line the cells of a line, converted as a whole
+   * \param byteSize Size of a memory cell in bit
+   * \param separator char separating different cells
+   */
+  static void _appendLine(std::string &string,
+                          const MemoryValue &line,
+                          size_t byteSize,
+                          char separator);
 
   /**
    * \brief converts a line of hex values to a MemoryValue
@@ -360,9 +509,11 @@ class Memory {
    */
   size_t _byteCount;
   /**
-   * \brief MemoryValue holding all the data
+   * \brief the data of all cells, packed like the data of a MemoryValue, in
+   *        pages which are shared with copies of this memory until they are
+   *        written; pages that were never written share one zero page
    */
-  MemoryValue _data;
+  std::vector<std::shared_ptr<Page>> _pages;
   /**
    * \brief This function gets called for every changed area in Memory
    */
@@ -377,6 +528,11 @@ class Memory {
    * some binary search, or using some indexed algorithm
    */
   ProtectionMap _protection{};
+
+  /**
+   * \brief the channels of all mapped areas
+   */
+  std::vector<std::shared_ptr<FramebufferChannel>> _framebuffers{};
 };
 
 #endif  // ERAGPSIM_CORE_MEMORY_HPP
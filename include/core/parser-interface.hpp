@@ -41,6 +41,14 @@ class ParserInterface : public Proxy<ParsingAndExecutionUnit> {
    */
   POST_FUTURE_CONST(getSyntaxRegex)
 
+  /** Access to the lexer of the parser.
+   *
+   * \return The lexer, empty if the parser only provides regexes.
+   *
+   * \see SyntaxInformation
+   */
+  POST_FUTURE_CONST(getSyntaxLexer)
+
   /**
    * Set the callback which is used to signal the gui that context information
    * for a memory cell was changed/added
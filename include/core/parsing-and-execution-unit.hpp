@@ -20,14 +20,17 @@
 #ifndef ERAGPSIM_CORE_PARSING_AND_EXECUTION_UNIT_HPP
 #define ERAGPSIM_CORE_PARSING_AND_EXECUTION_UNIT_HPP
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <unordered_set>
 
 #include "arch/common/register-information.hpp"
 #include "arch/common/validation-result.hpp"
+#include "core/hart-group.hpp"
 #include "core/memory-access.hpp"
 #include "core/servant.hpp"
+#include "core/timer-queue.hpp"
 #include "parser/common/final-representation.hpp"
 #include "parser/common/parser.hpp"
 #include "parser/common/syntax-information.hpp"
@@ -43,6 +46,7 @@ class ParsingAndExecutionUnit : public Servant {
  public:
   using size_t = std::size_t;
   using SharedCondition = MemoryAccess::SharedCondition;
+  using SharedSleepTimer = MemoryAccess::SharedSleepTimer;
   template <typename... T>
   using Callback = std::function<void(T...)>;
   template <typename T>
@@ -57,7 +61,8 @@ class ParsingAndExecutionUnit : public Servant {
                           Architecture architecture,
                           std::string parserName,
                           SharedCondition stopCondition,
-                          SharedCondition syncCondition);
+                          SharedCondition syncCondition,
+                          SharedSleepTimer sleepTimer);
 
   /**
    * Execute the whole assembler program
@@ -77,6 +82,60 @@ class ParsingAndExecutionUnit : public Servant {
    */
   void executeToBreakpoint();
 
+  /**
+   * Undo the last executed line of the assembler program
+   *
+   */
+  void executePreviousLine();
+
+  /**
+   * Undo executed instructions until a breakpoint or the oldest recorded
+   * instruction is reached
+   *
+   */
+  void executeBackwardsToBreakpoint();
+
+  /**
+   * Resumes a program which is suspended by a sleep instruction immediately.
+   * Does nothing if the program is not sleeping.
+   *
+   */
+  void interruptSleep();
+
+  /**
+   * Starts writing an instruction-level trace of the execution to a file.
+   *
+   * For every executed instruction, its address, the registers it wrote and
+   * the memory it accessed are recorded, see TraceWriter. The encodings of
+   * the instructions are recorded now and after every successful parse.
+   *
+   * \param path The path of the trace file, it is overwritten.
+   * \param compress Whether to compress the trace.
+   * \return false if the trace file could not be created.
+   */
+  bool startTrace(const std::string &path, bool compress);
+
+  /**
+   * Stops the trace, the trace file is complete once this returns.
+   *
+   * \return The number of traced instructions.
+   */
+  std::uint64_t stopTrace();
+
+  /**
+   * Sets the number of harts which execute the program. Hart 0 is executed
+   * like a single hart, with breakpoints and synchronization with the ui.
+   * The other harts run freely on their own threads while execute() or
+   * executeToBreakpoint() runs. The execution ends once every hart left the
+   * program, or when the user stops it, hart 0 reaches a breakpoint or a
+   * hart causes an error. With more than one hart, no undo steps are
+   * recorded and stepping back reports an error.
+   *
+   * The program counters of all harts are set to the one of hart 0.
+   *
+   * \param count The number of harts, at least one.
+   */
+  void setHartCount(size_t count);
 
   /**
    * Set the line which should be executed with any execute...() method
@@ -121,6 +180,14 @@ class ParsingAndExecutionUnit : public Servant {
   SyntaxInformation::TokenIterable
   getSyntaxRegex(SyntaxInformation::Token token) const;
 
+  /** Access to the lexer of the parser.
+   *
+   * \return The lexer, empty if the parser only provides regexes.
+   *
+   * \see SyntaxInformation
+   */
+  SyntaxInformation::Lexer getSyntaxLexer() const;
+
   /**
    * Set the callback which is used to signal the gui that context information
    * for a memory cell was changed/added
@@ -181,6 +248,48 @@ class ParsingAndExecutionUnit : public Servant {
    */
   size_t _findNextNode();
 
+  /**
+   * Calculates the index of the next node of a hart according to its program
+   * counter.
+   *
+   * \param memoryAccess The MemoryAccess of the hart.
+   * \return index of the next node.
+   */
+  size_t _findNextNode(MemoryAccess &memoryAccess) const;
+
+  /**
+   * Executes the next instruction of a hart other than hart 0, this is called
+   * on the threads of the harts.
+   *
+   * \param memoryAccess The MemoryAccess of the hart.
+   * \return false if the hart left the program or caused an error.
+   */
+  bool _stepHart(MemoryAccess &memoryAccess) const;
+
+  /**
+   * Starts the harts 1 to n-1, if there are any.
+   */
+  void _startHarts();
+
+  /**
+   * Stops the harts 1 to n-1.
+   */
+  void _stopHarts();
+
+  /**
+   * Keeps the ui up to date until the harts 1 to n-1 are done or the
+   * execution is stopped, called once hart 0 left the program.
+   */
+  void _waitForHarts();
+
+  /**
+   * Checks whether executed instructions can be undone, reports an error to
+   * the ui if not.
+   *
+   * \return false if there is more than one hart.
+   */
+  bool _canUndo();
+
   /**
    * Executes a syntax tree node.
    *
@@ -196,6 +305,76 @@ class ParsingAndExecutionUnit : public Servant {
    */
   size_t _updateLineNumber(size_t currentNode);
 
+  /**
+   * Undoes the last executed instruction and updates the line number in the
+   * ui.
+   *
+   * \return the index of the node which is executed next, or the number of
+   * nodes if there was nothing to undo.
+   */
+  size_t _undoNode();
+
+  /**
+   * Executes nodes until the end of the program, a stop request or,
+   * optionally, a breakpoint is reached.
+   *
+   * \param stopAtBreakpoint true if the execution stops in front of
+   * breakpoints.
+   */
+  void _run(bool stopAtBreakpoint);
+
+  /**
+   * Suspends the execution if the last instruction requested a sleep. The
+   * servant keeps processing other tasks, the continuation is called once the
+   * sleep is over.
+   *
+   * \param continuation The function which continues the execution.
+   * \return true if the execution was suspended.
+   */
+  bool _suspendForSleep(Callback<> &&continuation);
+
+  /**
+   * Continues a suspended execution.
+   *
+   * \param suspension The number of the suspension to continue, outdated
+   * suspensions are ignored.
+   */
+  void _resume(size_t suspension);
+
+  /**
+   * Drops a suspended execution and pending sleep requests, called before a
+   * new execution starts.
+   */
+  void _cancelSuspension();
+
+  /**
+   * Cancels a suspended execution and reports it as stopped, if the program
+   * is sleeping. Called before the program or its position is replaced.
+   */
+  void _abortSuspension();
+
+  /**
+   * Lets the project collect memory and register changes, so that the ui
+   * gets them in merged batches instead of one by one.
+   */
+  void _beginChangeBatch();
+
+  /**
+   * Lets the project report all collected changes.
+   */
+  void _endChangeBatch();
+
+  /**
+   * Reports the collected changes and tells the ui that the execution
+   * stopped.
+   */
+  void _finishExecution();
+
+  /**
+   * Sends the addresses and encodings of all commands to the trace.
+   */
+  void _traceProgram();
+
   /** A unique_ptr to the parser. */
   std::unique_ptr<Parser> _parser;
 
@@ -206,6 +385,28 @@ class ParsingAndExecutionUnit : public Servant {
    * execution. */
   SharedCondition _syncCondition;
 
+  /** Collects the sleep requests of the executed instructions. */
+  SharedSleepTimer _sleepTimer;
+
+  /** Wakes up suspended executions. */
+  TimerQueue _timerQueue;
+
+  /** The function to continue a suspended execution, empty if the execution
+   * is not suspended. */
+  Callback<> _continuation;
+
+  /** Counts the suspensions, to tell outdated wake-ups apart. */
+  size_t _suspensionCount;
+
+  /** True if the execution is traced. */
+  bool _tracing;
+
+  /** True if the project collects the changes of this execution. */
+  bool _batchingChanges;
+
+  /** The number of harts executing the program. */
+  size_t _hartCount;
+
   /** A FinalRepresentation created by the parser. */
   FinalRepresentation _finalRepresentation;
 
@@ -245,6 +446,10 @@ class ParsingAndExecutionUnit : public Servant {
 
   /** This callback is used to synchronize the ui during execution. */
   Callback<> _syncCallback;
+
+  /** Runs the harts 1 to n-1. It is the last member, so that the harts are
+   * stopped before anything they use is destroyed. */
+  HartGroup _harts;
 };
 
 #endif /* ERAGPSIM_CORE_PARSING_AND_EXECUTION_UNIT_HPP */
@@ -0,0 +1,106 @@
+/* C++ Assembler Interpreter
+ * Copyright (C) 2016 Chair of Computer Architecture
+ * at Technical University of Munich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef ERAGPSIM_CORE_PROJECT_FACTORY_HPP
+#define ERAGPSIM_CORE_PROJECT_FACTORY_HPP
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "arch/common/architecture-formula.hpp"
+#include "arch/common/architecture.hpp"
+#include "core/register-set.hpp"
+
+/**
+ * Keeps the parts of a project that only depend on its architecture formula.
+ *
+ * Brewing an architecture loads and merges all of its extensions, creates the
+ * node factories and loads the instruction documentation; creating the
+ * registers walks all units of the architecture. This is the same for every
+ * project of a formula, so it is done once and kept as a template, from which
+ * every further project is copied. The node factories and the documentation
+ * are shared between all copies, as they are never changed after brewing.
+ *
+ * Templates are created on first use, or in advance by calling prewarm(), and
+ * are kept until clear() is called. All functions are thread-safe.
+ */
+class ProjectFactory {
+ public:
+  /**
+   * The state a project of a formula starts with.
+   */
+  struct Template {
+    /**
+     * Brews the architecture and creates its registers.
+     *
+     * \param formula The formula of the architecture.
+     */
+    explicit Template(const ArchitectureFormula& formula);
+
+    /** The validated architecture, including its node factories. */
+    Architecture architecture;
+
+    /** The registers of the first hart, before anything was executed. */
+    RegisterSet registers;
+  };
+
+  using TemplatePointer = std::shared_ptr<const Template>;
+
+  /**
+   * Returns the template of a formula, creating it if it does not exist yet.
+   *
+   * \param formula The formula of the architecture.
+   * \return The template, which stays valid even if clear() is called.
+   */
+  static TemplatePointer getTemplate(const ArchitectureFormula& formula);
+
+  /**
+   * Creates the template of a formula, so that the first project of it is
+   * created as fast as all following ones.
+   *
+   * \param formula The formula of the architecture.
+   */
+  static void prewarm(const ArchitectureFormula& formula);
+
+  /**
+   * Removes all templates, e.g. after the architecture files changed.
+   */
+  static void clear();
+
+ private:
+  using Key = std::vector<std::string>;
+
+  /**
+   * Returns the key of a formula, its name followed by its extensions.
+   *
+   * \param formula The formula of the architecture.
+   */
+  static Key _key(const ArchitectureFormula& formula);
+
+  /** Protects the templates. */
+  static std::mutex _mutex;
+
+  /** The templates of all formulas that were used so far. */
+  static std::map<Key, TemplatePointer> _templates;
+};
+
+#endif /* ERAGPSIM_CORE_PROJECT_FACTORY_HPP */
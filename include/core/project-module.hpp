@@ -43,6 +43,7 @@ class ArchitectureFormula;
 class ProjectModule {
  public:
   using SharedCondition = MemoryAccess::SharedCondition;
+  using SharedSleepTimer = MemoryAccess::SharedSleepTimer;
   template <typename... T>
   using Callback = ParsingAndExecutionUnit::Callback<T...>;
 
@@ -98,6 +99,13 @@ class ProjectModule {
    */
   void guiReady();
 
+  /**
+   * Returns the timer which collects the sleeps of the executed program, e.g.
+   * to enable the virtual time mode.
+   *
+   */
+  SleepTimer& getSleepTimer();
+
  private:
   /** This object encapsulates a condition variable with a stop flag and a
    * mutex. It is used to stop the execution on a user request.*/
@@ -107,6 +115,9 @@ class ProjectModule {
    * often slower. */
   SharedCondition _syncCondition;
 
+  /** Collects the sleep requests of the executed program. */
+  SharedSleepTimer _sleepTimer;
+
   /** Scheduler for the project servant (active-object). */
   std::shared_ptr<Scheduler> _schedulerProject;
 
@@ -20,19 +20,33 @@
 #ifndef ERAGPSIM_CORE_PROJECT_HPP
 #define ERAGPSIM_CORE_PROJECT_HPP
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "arch/common/architecture-formula.hpp"
 #include "arch/common/architecture.hpp"
 #include "arch/common/instruction-set.hpp"
 #include "arch/common/unit-container.hpp"
+#include "core/binary-snapshot.hpp"
+#include "core/change-tracker.hpp"
+#include "core/integer-operand.hpp"
 #include "core/memory-value.hpp"
 #include "core/memory.hpp"
+#include "core/project-factory.hpp"
+#include "core/register-id.hpp"
 #include "core/register-set.hpp"
+#include "core/register-snapshot.hpp"
 #include "core/servant.hpp"
 #include "core/snapshot.hpp"
+#include "core/trace-writer.hpp"
+#include "core/transaction.hpp"
+#include "core/undo-log.hpp"
 
 class RegisterInformation;
 class UnitInformation;
@@ -58,9 +72,27 @@ class Project : public Servant {
 
   using Json = Snapshot::Json;
 
+  /**
+   * The state of memory and registers at one point, see createCheckpoint().
+   */
+  struct Checkpoint {
+    /** A fork of the memory, which shares its pages with the project. */
+    Memory memory;
+
+    /** The values of the registers. */
+    std::vector<std::pair<std::string, MemoryValue>> registers;
+
+    /** A full snapshot of the state, the base of delta snapshots. */
+    BinarySnapshot snapshot;
+  };
+
   /**
    * Creates a new Project
    *
+   * The architecture and the initial registers are copied from the template
+   * of the ProjectFactory, the architecture is only brewed for the first
+   * project of a formula.
+   *
    * \scheduler A scheduler to create this active object.
    *
    * \param architectureFormula A formula to brew the architecture of this
@@ -73,6 +105,17 @@ class Project : public Servant {
           const ArchitectureFormula &architectureFormula,
           size_t memorySize);
 
+  /**
+   * Creates all registers of an architecture.
+   *
+   * \param architecture The architecture to create the registers of.
+   * \param registerSet The set to create the registers in.
+   * \param hart The index of the hart owning the registers.
+   */
+  static void createRegisters(const Architecture &architecture,
+                              RegisterSet &registerSet,
+                              size_t hart);
+
   /**
    * \copydoc Memory::get()
    */
@@ -106,6 +149,38 @@ class Project : public Servant {
    */
   void removeMemoryProtection(size_t address, size_t amount = 1);
 
+  /**
+   * \copydoc Memory::mapFramebuffer()
+   */
+  std::shared_ptr<FramebufferChannel>
+  mapFramebuffer(size_t address, size_t amount);
+
+  /**
+   * \copydoc Memory::unmapFramebuffer()
+   */
+  void unmapFramebuffer(const std::shared_ptr<FramebufferChannel> &channel);
+
+  /**
+   * Takes all bytes out of a ring buffer in memory, see MemoryRingBuffer.
+   *
+   * \param address The address of the ring buffer.
+   * \param capacity The number of data bytes of the ring buffer.
+   * \return The bytes, nothing if the buffer does not fit into the memory.
+   */
+  std::string drainRingBuffer(size_t address, size_t capacity);
+
+  /**
+   * Puts bytes into a ring buffer in memory, see MemoryRingBuffer.
+   *
+   * \param address The address of the ring buffer.
+   * \param capacity The number of data bytes of the ring buffer.
+   * \param data The bytes to write.
+   * \return True if all bytes were written, false if they did not fit into
+   * the buffer or the buffer does not fit into the memory.
+   */
+  bool
+  fillRingBuffer(size_t address, size_t capacity, const std::string &data);
+
   /**
    * \copydoc Memory::get()
    */
@@ -143,12 +218,107 @@ class Project : public Servant {
   MemoryValue
   setRegisterValue(const std::string &name, const MemoryValue &value);
 
+  /**
+   * Returns the number of harts (hardware threads) of this project.
+   *
+   */
+  size_t getHartCount() const;
+
+  /**
+   * Sets the number of harts. All harts share the memory, but every hart has
+   * its own registers. Hart 0 owns the registers shown in the ui, the
+   * registers of the other harts are created anew with their reset values
+   * and the hart id register holding the index of the hart.
+   *
+   * The project thread serializes all accesses of all harts, so every hart
+   * sees the memory accesses of the others in one global order.
+   *
+   * \param count The number of harts, at least one.
+   */
+  void setHartCount(size_t count);
+
+  /**
+   * Returns the content of a register of a hart, for hart 0 this is
+   * getRegisterValue().
+   *
+   * \param hart The index of the hart.
+   * \param name The name of the register.
+   */
+  MemoryValue
+  getHartRegisterValue(size_t hart, const std::string &name) const;
+
+  /**
+   * Puts a value into a register of a hart, for hart 0 this is
+   * putRegisterValue(). The registers of the other harts are not recorded for
+   * undo or traces.
+   *
+   * \param hart The index of the hart.
+   * \param name The name of the register.
+   * \param value The new value of the register.
+   */
+  void putHartRegisterValue(size_t hart,
+                            const std::string &name,
+                            const MemoryValue &value);
+
+  /**
+   * Like putHartRegisterValue(), but returns the old value.
+   */
+  MemoryValue setHartRegisterValue(size_t hart,
+                                   const std::string &name,
+                                   const MemoryValue &value);
+
+  /**
+   * \copydoc RegisterSet::getID()
+   *
+   * The IDs are the same for all harts.
+   */
+  RegisterID getRegisterID(const std::string &name) const;
+
+  /**
+   * Returns the content of a register of a hart as integer operand.
+   *
+   * \param hart The index of the hart.
+   * \param id The RegisterID of the register, see getRegisterID().
+   */
+  IntegerOperand
+  getHartRegisterOperand(size_t hart, const RegisterID &id) const;
+
+  /**
+   * Reads memory and reserves it for the hart, like the RISC-V load-reserved
+   * instruction. A hart holds at most one reservation, which is broken by any
+   * later write to the reserved memory.
+   *
+   * \param hart The index of the hart.
+   * \param address The address of the memory.
+   * \param amount The number of memory cells.
+   */
+  MemoryValue loadReserved(size_t hart, size_t address, size_t amount);
+
+  /**
+   * Writes memory only if the hart still holds a reservation of exactly this
+   * memory, like the RISC-V store-conditional instruction. The reservation of
+   * the hart is released in any case.
+   *
+   * \param hart The index of the hart.
+   * \param address The address of the memory.
+   * \param value The value to write.
+   * \return true if the value was written.
+   */
+  bool storeConditional(size_t hart, size_t address, const MemoryValue &value);
+
   /**
    * Returns a container of all registers
    *
    */
   UnitContainer getRegisterUnits() const;
 
+  /**
+   * Returns the channel through which a copy of all registers is published
+   * before every register change is reported to the ui.
+   *
+   */
+  std::shared_ptr<RegisterSnapshotChannel> getRegisterSnapshots() const;
+
   /**
    * Returns the number of bits in a byte
    *
@@ -163,6 +333,13 @@ class Project : public Servant {
    */
   size_t getMemorySize() const;
 
+  /**
+   * Returns the memory size as published by the project, which the ui can
+   * read at any time without waiting for the project.
+   *
+   */
+  std::shared_ptr<const std::atomic<size_t>> getPublishedMemorySize() const;
+
   /**
    * Returns a set of all instructions of the architecture
    *
@@ -181,6 +358,72 @@ class Project : public Servant {
    */
   void resetRegisters();
 
+  /**
+   * Starts recording the values overwritten by the next instruction.
+   *
+   * \see UndoLog::beginStep()
+   */
+  void beginUndoStep();
+
+  /**
+   * Stops recording the values overwritten by the current instruction.
+   *
+   * \see UndoLog::endStep()
+   */
+  void endUndoStep();
+
+  /**
+   * Restores memory and registers to the state before the last recorded
+   * instruction.
+   *
+   * \return false if there was nothing to undo, true otherwise.
+   */
+  bool undoStep();
+
+  /**
+   * Returns the number of instructions which can be undone.
+   */
+  size_t getUndoStepCount() const;
+
+  /**
+   * Removes all recorded instructions, e.g. after the program changed.
+   */
+  void clearUndoLog();
+
+  /**
+   * Starts writing an execution trace, replacing a running trace.
+   *
+   * While tracing, every write to registers or memory and every memory read
+   * in an instruction step (between beginUndoStep() and endUndoStep()) is
+   * recorded.
+   *
+   * \param path The path of the trace file.
+   * \param compress Whether to compress the trace.
+   * \return false if the trace file could not be created.
+   */
+  bool startTrace(const std::string &path, bool compress);
+
+  /**
+   * Records the instructions of the program in the trace, if tracing.
+   *
+   * \param program The addresses and encodings of all instructions.
+   */
+  void traceProgram(const TraceWriter::Program &program);
+
+  /**
+   * Records the start of an instruction in the trace, if tracing.
+   *
+   * \param address The address of the instruction.
+   */
+  void traceStep(size_t address);
+
+  /**
+   * Stops tracing and waits until the trace file is complete.
+   *
+   * \return The number of traced instructions.
+   */
+  std::uint64_t stopTrace();
+
   /**
    * Loads a snapshot object and sets memory and registers accordingly.
    *
@@ -195,6 +438,70 @@ class Project : public Servant {
    */
   Snapshot generateSnapshot() const;
 
+  /**
+   * Loads a full binary snapshot and sets memory and registers accordingly.
+   *
+   * \param snapshot The binary snapshot.
+   */
+  void loadBinarySnapshot(const BinarySnapshot &snapshot);
+
+  /**
+   * Loads a delta snapshot on top of its base and sets memory and registers
+   * accordingly.
+   *
+   * \param base The full snapshot the delta was created against.
+   * \param delta The delta snapshot.
+   */
+  void loadDeltaSnapshot(const BinarySnapshot &base,
+                         const BinarySnapshot &delta);
+
+  /**
+   * Generates a full binary snapshot of the current state of memory and
+   * registers.
+   *
+   * \return The generated snapshot.
+   */
+  BinarySnapshot generateBinarySnapshot() const;
+
+  /**
+   * Generates a binary snapshot which only stores what changed since a full
+   * snapshot.
+   *
+   * \param base A full snapshot of this project to compare against.
+   * \return The generated delta snapshot.
+   */
+  BinarySnapshot generateDeltaSnapshot(const BinarySnapshot &base) const;
+
+  /**
+   * Creates a checkpoint of the current state of memory and registers.
+   *
+   * The memory is forked, so this takes time in the number of pages only,
+   * besides storing the pages which were written in the full snapshot. Every
+   * page is only copied once it is written afterwards.
+   *
+   * \return The checkpoint.
+   */
+  Checkpoint createCheckpoint() const;
+
+  /**
+   * Resets memory and registers to a checkpoint of this project, which takes
+   * time in the number of pages only.
+   *
+   * \param checkpoint The checkpoint.
+   */
+  void restoreCheckpoint(const Checkpoint &checkpoint);
+
+  /**
+   * Generates a binary snapshot which only stores what changed since a
+   * checkpoint. The pages which were not written since are skipped without
+   * comparing them.
+   *
+   * \param checkpoint A checkpoint of this project, whose snapshot is the
+   * base of the delta.
+   * \return The generated delta snapshot.
+   */
+  BinarySnapshot generateDeltaSnapshot(const Checkpoint &checkpoint) const;
+
   /**
    * Returns the callback used for conversion from a MemoryValue to a signed
    * decimal integer as a std::string
@@ -262,6 +569,54 @@ class Project : public Servant {
    */
   void setUpdateMemorySizeCallback(Callback<size_t> callback);
 
+  /**
+   * Starts collecting memory and register changes instead of reporting each
+   * one right away. They are reported in merged batches by flushChanges()
+   * and endChangeBatch().
+   */
+  void beginChangeBatch();
+
+  /**
+   * Reports all collected changes and goes back to reporting each change
+   * right away.
+   */
+  void endChangeBatch();
+
+  /**
+   * Reports all collected changes, but at most once per frame while a batch
+   * is open.
+   */
+  void flushChanges();
+
+  /**
+   * Runs a batch of reads and writes of a hart at once, so that they see a
+   * consistent state and cost a single task on the project thread. The
+   * changes made by the batch are reported together when it is done, unless a
+   * change batch is open anyway.
+   *
+   * \param hart The index of the hart, whose registers are accessed.
+   * \param function A callable taking a Transaction&. It must not use a proxy
+   * of this project, as that would wait for the batch to finish.
+   * \returns What the callable returns.
+   */
+  template <typename Function>
+  auto hartTransaction(size_t hart, Function&& function) {
+    TransactionScope scope(*this);
+    Transaction transaction(*this, hart);
+    return function(transaction);
+  }
+
+  /**
+   * Same as hartTransaction(), but discards the result.
+   *
+   * \param hart The index of the hart, whose registers are accessed.
+   * \param function A callable taking a Transaction&.
+   */
+  template <typename Function>
+  void runHartTransaction(size_t hart, Function&& function) {
+    hartTransaction(hart, std::forward<Function>(function));
+  }
+
   /**
    * Set the callback which is used to notify the gui of an error.
    *
@@ -277,23 +632,79 @@ class Project : public Servant {
 
 
  private:
+  /** Collects the changes of a transaction while it exists. */
+  class TransactionScope {
+   public:
+    explicit TransactionScope(Project &project)
+    : _project(project), _enclosed(project._batchingChanges) {
+      if (!_enclosed) _project.beginChangeBatch();
+    }
+
+    ~TransactionScope() {
+      if (!_enclosed) _project.endChangeBatch();
+    }
+
+   private:
+    Project &_project;
+
+    /** Whether a change batch was open before, which reports the changes. */
+    bool _enclosed;
+  };
+
+  /** The memory a hart reserved with loadReserved(). */
+  struct Reservation {
+    size_t address = 0;
+    size_t amount = 0;
+    bool valid = false;
+  };
+
+  /**
+   * Creates a project from the template of its formula.
+   *
+   * \scheduler A scheduler to create this active object.
+   * \param architectureFormula The formula of the template.
+   * \param memorySize The number of memory cells
+   * \param projectTemplate The architecture and registers to start with.
+   */
+  Project(std::weak_ptr<Scheduler> &&scheduler,
+          const ArchitectureFormula &architectureFormula,
+          size_t memorySize,
+          const ProjectFactory::TemplatePointer &projectTemplate);
+
   /**
    * Creates a register.
    *
+   * \param registerSet The set to create the register in.
    * \param registerInfo The RegisterInformation Object of the register.
+   * \param hart The index of the hart owning the register.
    */
-  void
-  _createRegister(RegisterInformation registerInfo, UnitInformation unitInfo);
+  static void _createRegister(RegisterSet &registerSet,
+                              const RegisterInformation &registerInfo,
+                              const UnitInformation &unitInfo,
+                              size_t hart);
 
   /**
    * Creates all constituents of a register and recursively all constituents of
    * the constituents.
    *
+   * \param registerSet The set to create the constituents in.
    * \param enclosingRegister The register whos constituents are created
    *
    */
-  void _createConstituents(RegisterInformation enclosingRegister,
-                           UnitInformation unitInfo);
+  static void _createConstituents(RegisterSet &registerSet,
+                                  const RegisterInformation &enclosingRegister,
+                                  const UnitInformation &unitInfo);
+
+  /**
+   * Returns the registers of a hart other than hart 0.
+   */
+  RegisterSet &_hartRegisters(size_t hart);
+  const RegisterSet &_hartRegisters(size_t hart) const;
+
+  /**
+   * Breaks all reservations which overlap the given memory.
+   */
+  void _breakReservations(size_t address, size_t amount);
 
   /**
    * Sets the specified register to 0, if it is a top level register (no
@@ -303,6 +714,31 @@ class Project : public Servant {
    */
   void _setRegisterToZero(RegisterInformation registerInfo);
 
+  /**
+   * Returns true if accesses should be written to the trace.
+   */
+  bool _isTracing() const noexcept;
+
+  /**
+   * Reports a memory change or collects it if a batch is open.
+   */
+  void _memoryChanged(size_t address, size_t amount);
+
+  /**
+   * Reports a register change or collects it if a batch is open.
+   */
+  void _registerChanged(const std::string &name);
+
+  /**
+   * Reports and forgets all collected changes.
+   */
+  void _reportChanges();
+
+  /**
+   * Publishes a new snapshot of all registers.
+   */
+  void _publishRegisters();
+
   /** An Architecture object, stores all information about the architecture of
    * this project. */
   Architecture _architecture;
@@ -313,11 +749,47 @@ class Project : public Servant {
   /** A set of registers, manages the registers of this project. */
   RegisterSet _registerSet;
 
+  /** The registers of the harts 1 to n-1, hart 0 uses _registerSet. */
+  std::vector<RegisterSet> _otherHarts;
+
+  /** The reservation of every hart. */
+  std::vector<Reservation> _reservations;
+
+  /** Stores the values overwritten by executed instructions. */
+  UndoLog _undoLog;
+
+  /** The trace writer, null if not tracing. */
+  std::unique_ptr<TraceWriter> _traceWriter;
+
   /** Stores the architecture formula for serialization purposes. */
   ArchitectureFormula _architectureFormula;
 
   /** A callback to signal a error to the ui. */
   ErrorCallback _errorCallback;
+
+  /** The callback to signal a changed register to the ui. */
+  Callback<const std::string &> _registerCallback;
+
+  /** The callback to signal changed memory cells to the ui. */
+  Callback<size_t, size_t> _memoryCallback;
+
+  /** Collects the changes while a batch is open. */
+  ChangeTracker _changes;
+
+  /** True while a batch is open. */
+  bool _batchingChanges;
+
+  /** The last time the collected changes were reported. */
+  std::chrono::steady_clock::time_point _lastReport;
+
+  /** Hands the register snapshots to the ui. */
+  std::shared_ptr<RegisterSnapshotChannel> _registerSnapshots;
+
+  /** The version of the last published register snapshot. */
+  size_t _registerVersion;
+
+  /** Hands the memory size to the ui, updated whenever it changes. */
+  std::shared_ptr<std::atomic<size_t>> _publishedMemorySize;
 };
 
 #endif /* ERAGPSIM_CORE_PROJECT_HPP */
@@ -21,8 +21,11 @@
 #include <functional>
 #include <future>
 #include <memory>
+#include <type_traits>
 
 #include "common/tuple.hpp"
+#include "core/block-pool.hpp"
+#include "core/result.hpp"
 #include "core/scheduler.hpp"
 
 #ifndef ERAGPSIM_CORE_PROXY_HPP
@@ -165,7 +168,8 @@
     /* create a task lambda and capture the functionLambda, a tuple of the  \
      * arguments and a promise. In the lambda, the tuple is applied to the  \
      * function and the promise is set with the result of the function */   \
-    std::promise<decltype(servant->functionName(args...))> promise;         \
+    using R = decltype(servant->functionName(args...));                     \
+    std::promise<R> promise(std::allocator_arg, PoolAllocator<char>());     \
     auto task = [                                                           \
       functionLambda = std::move(functionLambda),                           \
       tuple = std::make_tuple(std::forward<Args>(args)...),                 \
@@ -214,27 +218,25 @@
     auto functionLambda = [servant](auto&&... args) {                          \
       return servant->functionName(std::forward<decltype(args)>(args)...);     \
     };                                                                         \
-    /* unique_ptr can't be used, because the task (a std::function object) has \
-     * to be copyable*/                                                        \
-    std::shared_ptr<std::promise<decltype(servant->functionName(args...))>>    \
-        promiseShared = std::make_shared<                                      \
-            std::promise<decltype(servant->functionName(args...))>>();         \
-    auto future = promiseShared->get_future();                                 \
+    /* the task is move-only, so the promise can be moved into it. Its         \
+     * shared state is taken from the BlockPool */                             \
+    using R = decltype(servant->functionName(args...));                        \
+    std::promise<R> promise(std::allocator_arg, PoolAllocator<char>());        \
+    auto future = promise.get_future();                                        \
     /* create a task lambda and capture the functionLambda, a tuple of the     \
-     * arguments and the shared_ptr to the promise. In the lambda, the tuple   \
-     * is applied to the function and the promise is set with the result of    \
-     * the function  */                                                        \
+     * arguments and the promise. In the lambda, the tuple is applied to       \
+     * the function and the promise is set with the result of the function */  \
     auto task = [                                                              \
       function = std::move(functionLambda),                                    \
       tuple = std::make_tuple(std::forward<Args>(args)...),                    \
-      promise = std::move(promiseShared)                                       \
+      promise = std::move(promise)                                             \
     ]() mutable {                                                              \
       try {                                                                    \
         auto result =                                                          \
             TupleApply::apply(std::move(function), std::move(tuple));          \
-        promise->set_value(result);                                            \
+        promise.set_value(result);                                             \
       } catch (std::exception & e) {                                           \
-        promise->set_exception(std::make_exception_ptr(e));                    \
+        promise.set_exception(std::make_exception_ptr(e));                     \
       }                                                                        \
     };                                                                         \
                                                                                \
@@ -256,27 +258,25 @@
     auto functionLambda = [servant](auto&&... args) {                          \
       return servant->functionName(std::forward<decltype(args)>(args)...);     \
     };                                                                         \
-    /* unique_ptr can't be used, because the task (a std::function object) has \
-     * to be copyable*/                                                        \
-    std::shared_ptr<std::promise<decltype(servant->functionName(args...))>>    \
-        promiseShared = std::make_shared<                                      \
-            std::promise<decltype(servant->functionName(args...))>>();         \
-    auto future = promiseShared->get_future();                                 \
+    /* the task is move-only, so the promise can be moved into it. Its         \
+     * shared state is taken from the BlockPool */                             \
+    using R = decltype(servant->functionName(args...));                        \
+    std::promise<R> promise(std::allocator_arg, PoolAllocator<char>());        \
+    auto future = promise.get_future();                                        \
     /* create a task lambda and capture the functionLambda, a tuple of the     \
-     * arguments and the shared_ptr to the promise. In the lambda, the tuple   \
-     * is applied to the function and the promise is set with the result of    \
-     * the function  */                                                        \
+     * arguments and the promise. In the lambda, the tuple is applied to       \
+     * the function and the promise is set with the result of the function */  \
     auto task = [                                                              \
       function = std::move(functionLambda),                                    \
       tuple = std::make_tuple(std::forward<Args>(args)...),                    \
-      promise = std::move(promiseShared)                                       \
+      promise = std::move(promise)                                             \
     ]() mutable {                                                              \
       try {                                                                    \
         auto result =                                                          \
             TupleApply::apply(std::move(function), std::move(tuple));          \
-        promise->set_value(result);                                            \
+        promise.set_value(result);                                             \
       } catch (std::exception & e) {                                           \
-        promise->set_exception(std::make_exception_ptr(e));                    \
+        promise.set_exception(std::make_exception_ptr(e));                     \
       }                                                                        \
     };                                                                         \
                                                                                \
@@ -452,6 +452,69 @@
     servant->push(std::move(task));                                           \
   }
 
+/**
+ * \def POST_ASYNC(functionName)
+ * Creates a const function functionNameAsync(executor, continuation, args...)
+ * that never blocks the caller: no future is created and nothing waits.
+ *
+ * When the servant has computed the result, the continuation is wrapped into
+ * a std::function<void()> and handed to the executor, which decides where it
+ * runs. The executor is any callable taking such a function, e.g. one that
+ * posts into an event loop of the calling thread:
+ *
+ * \code
+ * //in the proxy, same servant as in POST_FUTURE_BLOCKING
+ * POST_ASYNC(bar)
+ *
+ * //somewhere else
+ * proxy.barAsync(GuiExecutor::forObject(this), [this](Result<int> y) {
+ *   //runs in the gui thread once bar() has finished
+ *   if (y.hasException()) return;
+ *   use(y.get());
+ * });
+ * \endcode
+ *
+ * Like with POST_CALLBACK_SAFE, the continuation receives a Result<R>, which
+ * holds the exception if the servant function throws, so the continuation is
+ * always invoked (unless the executor drops it). Only functions with a
+ * return value can be used with this macro.
+ *
+ * \see POST_FUTURE_CONST(functionName)
+ */
+#define POST_ASYNC(functionName)                                             \
+  template <typename Executor, typename Continuation, typename... Args>     \
+  void functionName##Async(                                                 \
+      Executor executor, Continuation continuation, Args&&... args) const { \
+    /* wrap the servant function in a lambda, return result */              \
+    auto servant = _servant.get();                                          \
+    auto functionLambda = [servant](auto&&... args) {                       \
+      return servant->functionName(std::forward<decltype(args)>(args)...);  \
+    };                                                                      \
+    /* the result is moved into the continuation, which is handed to the    \
+     * executor instead of being called in the servant thread */            \
+    auto task = [                                                           \
+      function = std::move(functionLambda),                                 \
+      tuple = std::make_tuple(std::forward<Args>(args)...),                 \
+      executor = std::move(executor),                                       \
+      continuation = std::move(continuation)                                \
+    ]() mutable {                                                           \
+      using R = std::decay_t<decltype(                                      \
+          TupleApply::apply(std::move(function), std::move(tuple)))>;       \
+      Result<R> result;                                                     \
+      try {                                                                 \
+        result.setValue(                                                    \
+            R(TupleApply::apply(std::move(function), std::move(tuple))));   \
+      } catch (...) {                                                       \
+        result.setException(std::current_exception());                      \
+      }                                                                     \
+      executor([                                                            \
+        continuation = std::move(continuation),                             \
+        result = std::move(result)                                          \
+      ]() mutable { continuation(std::move(result)); });                    \
+    };                                                                      \
+    servant->push(std::move(task));                                         \
+  }
+
 /**
  * \brief Proxy class which can be used to access a servant. Create a proxy
  * class for every servant class and inherit from this, the servant is then
@@ -464,7 +527,8 @@
  *
  * \see POST(functionName) POST_FUTURE_BLOCKING(functionName)
  * POST_FUTURE(functionName) POST_CALLBACK_UNSAFE(functionName)
- * POST_CALLBACK_SAFE(functionName) task-scheduler-tests.cpp
+ * POST_CALLBACK_SAFE(functionName) POST_ASYNC(functionName)
+ * task-scheduler-tests.cpp
  *
  * For complete, working code, you can look at the task-scheduler-tests.
  */
@@ -21,13 +21,16 @@
 
 #include <cstddef>
 #include <functional>
+#include <memory>
 #include <set>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "core/integer-operand.hpp"
 #include "core/memory-value.hpp"
 #include "core/register-id.hpp"
+#include "core/register-snapshot.hpp"
 #include "third-party/json/json.hpp"
 
 
@@ -106,6 +109,20 @@ class RegisterSet {
    */
   MemoryValue set(const std::string &name, const MemoryValue &value);
 
+  /**
+   * \brief Returns the RegisterID of the Register with the name name
+   * \param name String uniquely representing the Register
+   * \returns the RegisterID, which stays valid until registers are created
+   */
+  RegisterID getID(const std::string &name) const;
+  /**
+   * \brief Returns the data stored in a Register as integer, without looking
+   *        up its name or allocating
+   * \param id The RegisterID of the Register, see getID()
+   * \returns the lower 64 bit of the data stored in the Register
+   */
+  IntegerOperand getOperand(const RegisterID &id) const;
+
   /**
    * \brief returns the size of a Register in bit
    * \param name String uniquely representing the Register
@@ -242,6 +259,20 @@ class RegisterSet {
    */
   bool existsRegister(const std::string &name) const;
 
+  /**
+   * \brief returns the names of all Registers with no parent, in the order
+   *        they were created
+   */
+  const std::vector<std::string> &getParentNames() const noexcept;
+
+  /**
+   * \brief copies the current value of all registers
+   * \param version the version of the snapshot
+   * \returns a snapshot sharing the register names with all other snapshots
+   *          of this
+   */
+  RegisterSnapshot takeSnapshot(std::size_t version) const;
+
   /**
    * \brief sets the memory to the data stored in json
    * \param json the json object to holding the data
@@ -285,6 +316,12 @@ class RegisterSet {
    * \brief Vector mapping RegisterID.address -> parent name of this Register
    */
   std::vector<std::string> _parentVector;
+  /**
+   * \brief Copy of _dict shared by all snapshots, created by takeSnapshot and
+   *        reset whenever a Register is created or aliased
+   */
+  mutable std::shared_ptr<const RegisterSnapshot::Dictionary>
+      _snapshotDictionary;
   /**
    * \brief This function gets called for every changed Register
    */
@@ -0,0 +1,130 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ERAGPSIM_CORE_REGISTER_SNAPSHOT_HPP
+#define ERAGPSIM_CORE_REGISTER_SNAPSHOT_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/memory-value.hpp"
+#include "core/register-id.hpp"
+
+/**
+ * An immutable copy of all registers at one point in time.
+ *
+ * Snapshots are taken by the project and handed to the GUI through a
+ * RegisterSnapshotChannel. As nothing can change them once they are
+ * published, any thread may read them without synchronization.
+ *
+ * Only the top-level registers are copied; the map from names (including
+ * aliases and constituents) to their location is shared by all snapshots of
+ * the same register set.
+ */
+class RegisterSnapshot {
+ public:
+  using size_t = std::size_t;
+  using Dictionary = std::unordered_map<std::string, RegisterID>;
+
+  /**
+   * Creates an empty snapshot with version 0, which contains no registers.
+   */
+  RegisterSnapshot();
+
+  /**
+   * Creates a snapshot.
+   *
+   * \param version The version of the snapshot, newer snapshots have higher
+   * versions.
+   * \param dictionary Maps the name of every register to its location.
+   * \param registers The values of all top-level registers.
+   */
+  RegisterSnapshot(size_t version,
+                   std::shared_ptr<const Dictionary> dictionary,
+                   std::vector<MemoryValue> registers);
+
+  /**
+   * Returns the version of this snapshot.
+   */
+  size_t getVersion() const noexcept;
+
+  /**
+   * Returns true if this snapshot contains a register with the given name.
+   */
+  bool hasRegister(const std::string &name) const;
+
+  /**
+   * Returns the value of a register. The register has to exist.
+   *
+   * \param name The name of the register.
+   */
+  MemoryValue get(const std::string &name) const;
+
+ private:
+  /** The version of this snapshot. */
+  size_t _version;
+
+  /** Maps all register names to their location in _registers. */
+  std::shared_ptr<const Dictionary> _dictionary;
+
+  /** The values of all top-level registers. */
+  std::vector<MemoryValue> _registers;
+};
+
+/**
+ * Hands the newest register snapshot from the project to the GUI.
+ *
+ * Publishing and loading swap a shared pointer atomically, so neither side
+ * ever waits for the other. A reader keeps the snapshot it loaded alive as
+ * long as it needs it, even if newer ones are published in the meantime.
+ */
+class RegisterSnapshotChannel {
+ public:
+  using Pointer = std::shared_ptr<const RegisterSnapshot>;
+
+  /**
+   * Creates a channel holding an empty snapshot.
+   */
+  RegisterSnapshotChannel();
+
+  RegisterSnapshotChannel(const RegisterSnapshotChannel &other) = delete;
+  RegisterSnapshotChannel &
+  operator=(const RegisterSnapshotChannel &other) = delete;
+
+  /**
+   * Replaces the current snapshot.
+   *
+   * \param snapshot The new snapshot.
+   */
+  void publish(RegisterSnapshot snapshot);
+
+  /**
+   * Returns the current snapshot, never a null pointer.
+   */
+  Pointer load() const;
+
+ private:
+  /** The current snapshot, only accessed through the atomic functions. */
+  Pointer _snapshot;
+};
+
+#endif /* ERAGPSIM_CORE_REGISTER_SNAPSHOT_HPP */
@@ -23,11 +23,15 @@
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <mutex>
-#include <queue>
 #include <thread>
 
+#include "core/bounded-queue.hpp"
+#include "core/inline-task.hpp"
+#include "core/spin-wait.hpp"
+
 /**
  * This class is a task-scheduler, to be used by a servant
  *
@@ -36,11 +40,21 @@
  * If all calls to the servant are pushed into the queue, which can be easily
  * done by using a proxy, this ensures thread safety for the servant, as only
  * one task can be executed at any given moment.
+ *
+ * Tasks are kept in a lockfree ring buffer, so pushing and popping neither
+ * allocates nor locks as long as the ring has room. If it is full, the tasks
+ * go into a locked overflow list until the scheduler caught up. The mutex is
+ * otherwise only taken to wake up the scheduler thread when it is asleep.
+ * Before falling asleep, the thread polls the queue for a moment (see
+ * SpinWait).
  */
 class Scheduler {
  public:
-  using Task = std::function<void()>;
-  using Queue = std::queue<Task>;
+  using Task = InlineTask;
+  using Queue = BoundedQueue<Task>;
+
+  /** The number of tasks fitting into the ring buffer. */
+  static constexpr std::size_t queueCapacity = 1024;
 
   /**
    * \brief creates new Scheduler
@@ -86,10 +100,44 @@ class Scheduler {
    */
   void _shutdown();
 
+  /**
+   * Takes the next task, the ring buffer before the overflow list.
+   *
+   * \param task Receives the task.
+   * \returns false if there is no task.
+   */
+  bool _pop(Task& task);
+
+  /** Whether there is a task, including tasks which are still being pushed. */
+  bool _hasTask() const;
+
+  /**
+   * Waits until a task is pushed, first spinning for a moment, then sleeping.
+   */
+  void _wait();
+
+  /** Wakes up the scheduler thread if it is asleep. */
+  void _wake();
+
   /** A queue to store Task objects. */
   Queue _taskQueue;
 
-  /** A mutex to control access to the queue. */
+  /** Tasks which did not fit into the queue, in order. */
+  std::deque<Task> _overflow;
+
+  /**
+   * Whether there are tasks in the overflow list. As long as there are, new
+   * tasks go there too, so that the order of the tasks of a thread is kept.
+   */
+  std::atomic<bool> _overflowing;
+
+  /** Whether the scheduler thread is asleep or about to sleep. */
+  std::atomic<bool> _sleeping;
+
+  /** Decides how long to spin before sleeping. */
+  SpinWait _spinWait;
+
+  /** A mutex to control access to the overflow list and the sleep. */
   std::mutex _mutex;
 
   /** A condition variable to notify the scheduler of new tasks. */
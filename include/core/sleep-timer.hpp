@@ -0,0 +1,101 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ERAGPSIM_CORE_SLEEP_TIMER_HPP
+#define ERAGPSIM_CORE_SLEEP_TIMER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+/**
+ * Collects sleep requests of the executed program.
+ *
+ * A sleeping instruction does not block the thread it is executed on, it only
+ * requests a sleep. The execution loop picks the request up after the
+ * instruction was executed and suspends itself until the requested time has
+ * passed, so that other tasks of the execution servant can still run.
+ *
+ * In virtual time mode requests are not passed on, the sleeps are only added
+ * up. Execution then continues immediately, which is useful for headless runs.
+ *
+ * hasRequest() is asked after every instruction, so it reads an atomic flag
+ * instead of locking.
+ */
+class SleepTimer {
+ public:
+  using Clock = std::chrono::steady_clock;
+  using Duration = Clock::duration;
+
+  SleepTimer();
+
+  /**
+   * Requests a sleep of the given duration. Multiple requests before the
+   * request is taken add up.
+   *
+   * \param duration The (minimum) duration of the sleep.
+   */
+  void request(Duration duration);
+
+  /**
+   * Returns true if a sleep was requested and not yet taken.
+   */
+  bool hasRequest();
+
+  /**
+   * Returns the requested duration and clears the request.
+   */
+  Duration takeRequest();
+
+  /**
+   * Enables or disables the virtual time mode.
+   *
+   * \param enabled True if sleeps should be skipped.
+   */
+  void setVirtualTime(bool enabled);
+
+  /**
+   * Returns true if the virtual time mode is enabled.
+   */
+  bool isVirtualTime();
+
+  /**
+   * Returns the time skipped in virtual time mode.
+   */
+  Duration getVirtualTime();
+
+ private:
+  /** Mutex for all members but the flag, requests and queries come from
+   * different threads. */
+  std::mutex _mutex;
+
+  /** The requested duration. */
+  Duration _requested;
+
+  /** True if there is a request, only written with the mutex held. */
+  std::atomic<bool> _hasRequest;
+
+  /** True if sleeps are skipped. */
+  bool _virtualTimeEnabled;
+
+  /** The sum of all skipped sleeps. */
+  Duration _virtualTime;
+};
+
+#endif /* ERAGPSIM_CORE_SLEEP_TIMER_HPP */
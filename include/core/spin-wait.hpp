@@ -0,0 +1,78 @@
+/* C++ Assembler Interpreter
+ * Copyright (C) 2016 Chair of Computer Architecture
+ * at Technical University of Munich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ERAGPSIM_CORE_SPIN_WAIT_HPP
+#define ERAGPSIM_CORE_SPIN_WAIT_HPP
+
+#include <atomic>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+    defined(_M_IX86)
+#include <immintrin.h>
+#define ERAGPSIM_CORE_SPIN_PAUSE() _mm_pause()
+#else
+#define ERAGPSIM_CORE_SPIN_PAUSE()
+#endif
+
+/**
+ * The first phase of a wait: polls a condition for a short while before the
+ * caller blocks on a condition variable.
+ *
+ * Blocking and waking up a thread takes microseconds, while an answer from
+ * another thread often arrives within a few hundred nanoseconds. The number of
+ * polls adapts: it doubles whenever spinning paid off and halves whenever the
+ * caller had to block anyway, so a thread that is usually idle for long does
+ * not burn its core.
+ */
+class SpinWait {
+ public:
+  /** The lower and upper bound of the number of polls. */
+  static constexpr std::uint32_t minimumSpins = 16;
+  static constexpr std::uint32_t maximumSpins = 4096;
+
+  /**
+   * Polls the condition until it holds or the current limit is reached.
+   *
+   * \param condition A callable returning bool, e.g. an atomic load.
+   * \returns Whether the condition holds, otherwise the caller should block.
+   */
+  template <typename Condition>
+  bool spinUntil(Condition&& condition) {
+    auto limit = _limit.load(std::memory_order_relaxed);
+    for (std::uint32_t spin = 0; spin < limit; ++spin) {
+      if (condition()) {
+        auto grown = limit * 2;
+        _limit.store(grown < maximumSpins ? grown : maximumSpins,
+                     std::memory_order_relaxed);
+        return true;
+      }
+      ERAGPSIM_CORE_SPIN_PAUSE();
+    }
+    auto shrunk = limit / 2;
+    _limit.store(shrunk > minimumSpins ? shrunk : minimumSpins,
+                 std::memory_order_relaxed);
+    return condition();
+  }
+
+ private:
+  /** The current number of polls, it may be shared by waiting threads. */
+  std::atomic<std::uint32_t> _limit{256};
+};
+
+#endif /* ERAGPSIM_CORE_SPIN_WAIT_HPP */
@@ -0,0 +1,97 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ERAGPSIM_CORE_TIMER_QUEUE_HPP
+#define ERAGPSIM_CORE_TIMER_QUEUE_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * Runs tasks once their deadline has passed.
+ *
+ * All tasks share one thread, which sleeps until the earliest deadline. The
+ * tasks are run on this thread, so they should be short, e.g. only post a task
+ * to a servant.
+ */
+class TimerQueue {
+ public:
+  using Clock = std::chrono::steady_clock;
+  using Task = std::function<void()>;
+
+  /**
+   * Creates the queue and starts its thread.
+   */
+  TimerQueue();
+
+  /**
+   * Stops the thread, tasks which are still waiting are dropped.
+   */
+  ~TimerQueue();
+
+  TimerQueue(const TimerQueue&) = delete;
+  TimerQueue& operator=(const TimerQueue&) = delete;
+
+  /**
+   * Runs a task after a delay.
+   *
+   * \param delay The (minimum) time to wait before the task is run.
+   * \param task The task.
+   */
+  void schedule(Clock::duration delay, Task&& task);
+
+ private:
+  /**
+   * The state shared with the timer thread. It is kept alive by the thread, so
+   * the thread can be detached safely.
+   */
+  struct State {
+    /** Mutex for the task map and the shutdown flag. */
+    std::mutex mutex;
+
+    /** Signals new tasks and the shutdown. */
+    std::condition_variable condition;
+
+    /** All waiting tasks, ordered by their deadline. */
+    std::multimap<Clock::time_point, Task> tasks;
+
+    /** True if the thread should stop. */
+    bool shutdown = false;
+  };
+
+  /**
+   * The loop of the timer thread.
+   *
+   * \param state The shared state of the queue.
+   */
+  static void _run(std::shared_ptr<State> state);
+
+  /** The state shared with the timer thread. */
+  std::shared_ptr<State> _state;
+
+  /** The timer thread. */
+  std::thread _thread;
+};
+
+#endif /* ERAGPSIM_CORE_TIMER_QUEUE_HPP */
@@ -0,0 +1,165 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ERAGPSIM_CORE_TRACE_FORMAT_HPP
+#define ERAGPSIM_CORE_TRACE_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * The binary format of execution traces, shared by TraceWriter and
+ * TraceReader.
+ *
+ * A trace file starts with a fixed header:
+ *
+ * `magic (8 bytes) | version (2 bytes) | flags (2 bytes)`
+ *
+ * (little endian), followed by blocks. Every block is stored as
+ *
+ * `rawSize | storedSize | data`
+ *
+ * where the sizes are varints. If the trace is compressed and the stored size
+ * differs from the raw size, `data` is compressed with `compress()`, else it is
+ * stored as is. Records never span two blocks.
+ *
+ * A block is a sequence of records, each starting with a `Tag` byte. All
+ * integers are unsigned varints, memory values are stored as their size in
+ * bits followed by their bytes:
+ *
+ * - Program: `count | (address | value)*`, the instructions of the program.
+ *   Steps refer to instructions by address, the encoding is looked up here.
+ * - Step: `addressDelta`, opens the record of one executed instruction. The
+ *   address is stored zigzag encoded relative to the previous step.
+ * - RegisterName: `id | length | characters`, declares the id used for a
+ *   register in the following writes.
+ * - RegisterWrite: `id | value`, the new value of a register.
+ * - MemoryRead: `address | amount`, memory cells read by the instruction.
+ * - MemoryWrite: `address | value`, the new value of memory cells.
+ */
+namespace TraceFormat {
+
+/** The magic bytes at the start of every trace file. */
+constexpr char magic[] = "ERATRACE";
+
+/** The size of the magic bytes, without the terminating null character. */
+constexpr std::size_t magicSize = sizeof(magic) - 1;
+
+/** The size of the file header in bytes. */
+constexpr std::size_t headerSize = magicSize + 4;
+
+/** The version written by this implementation. */
+constexpr std::uint16_t version = 1;
+
+/** Header flags. */
+enum Flags : std::uint16_t { COMPRESSED = 1 };
+
+/** The record tags. */
+enum class Tag : std::uint8_t {
+  PROGRAM = 1,
+  STEP = 2,
+  REGISTER_NAME = 3,
+  REGISTER_WRITE = 4,
+  MEMORY_READ = 5,
+  MEMORY_WRITE = 6
+};
+
+using Buffer = std::vector<std::uint8_t>;
+
+/**
+ * Appends an unsigned varint (7 bits per byte, least significant first).
+ *
+ * \param buffer The buffer to append to.
+ * \param value The value.
+ */
+inline void writeVarint(Buffer& buffer, std::uint64_t value) {
+  while (value >= 0x80) {
+    buffer.push_back(static_cast<std::uint8_t>(value) | 0x80);
+    value >>= 7;
+  }
+  buffer.push_back(static_cast<std::uint8_t>(value));
+}
+
+/**
+ * Reads an unsigned varint.
+ *
+ * \param data The data to read from.
+ * \param size The size of the data.
+ * \param position The position to start reading at, is advanced past the
+ *                 varint.
+ * \param value Receives the value.
+ * \return False if the data ended before the varint or the varint is too
+ *         long.
+ */
+inline bool readVarint(const std::uint8_t* data,
+                       std::size_t size,
+                       std::size_t& position,
+                       std::uint64_t& value) {
+  value = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    if (position >= size) return false;
+    auto byte = data[position++];
+    value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) return true;
+  }
+  return false;
+}
+
+/** Maps signed values to unsigned ones, keeping small magnitudes small. */
+inline std::uint64_t zigzag(std::int64_t value) {
+  return (static_cast<std::uint64_t>(value) << 1) ^
+         static_cast<std::uint64_t>(value >> 63);
+}
+
+/** Inverts `zigzag()`. */
+inline std::int64_t unzigzag(std::uint64_t value) {
+  return static_cast<std::int64_t>(value >> 1) ^
+         -static_cast<std::int64_t>(value & 1);
+}
+
+/**
+ * Compresses a block with a simple LZ77 scheme.
+ *
+ * The output is a sequence of `literalCount | literals | matchLength |
+ * matchOffset`, the last sequence has a match length of zero and no offset.
+ * It is meant to be fast rather than small, traces are very repetitive.
+ *
+ * \param data The data to compress.
+ * \param size The size of the data.
+ * \return The compressed data.
+ */
+Buffer compress(const std::uint8_t* data, std::size_t size);
+
+/**
+ * Decompresses a block compressed with `compress()`.
+ *
+ * \param data The compressed data.
+ * \param size The size of the compressed data.
+ * \param rawSize The size of the uncompressed data.
+ * \param output Receives the uncompressed data.
+ * \return False if the data is corrupt.
+ */
+bool decompress(const std::uint8_t* data,
+                std::size_t size,
+                std::size_t rawSize,
+                Buffer& output);
+}
+
+#endif /* ERAGPSIM_CORE_TRACE_FORMAT_HPP */
@@ -0,0 +1,141 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ERAGPSIM_CORE_TRACE_READER_HPP
+#define ERAGPSIM_CORE_TRACE_READER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/memory-value.hpp"
+#include "core/trace-format.hpp"
+
+/**
+ * Iterates the steps of a trace file written by TraceWriter.
+ *
+ * The file is read block by block, so traces of any length can be processed
+ * with constant memory:
+ *
+ * \code
+ * TraceReader reader(path);
+ * TraceReader::Step step;
+ * while (reader.next(step)) {
+ *   // step.address, step.encoding, step.registerWrites, ...
+ * }
+ * \endcode
+ *
+ * Malformed files raise a DeserializationError.
+ */
+class TraceReader {
+ public:
+  using size_t = std::size_t;
+
+  /** The new value of a register. */
+  struct RegisterWrite {
+    std::string name;
+    MemoryValue value;
+  };
+
+  /** Memory cells read by an instruction. */
+  struct MemoryRead {
+    size_t address;
+    size_t amount;
+  };
+
+  /** The new value of memory cells. */
+  struct MemoryWrite {
+    size_t address;
+    MemoryValue value;
+  };
+
+  /** Everything recorded for one executed instruction. */
+  struct Step {
+    /** The address of the instruction. */
+    size_t address;
+
+    /** The encoding of the instruction, empty if it is not in the program. */
+    MemoryValue encoding;
+
+    std::vector<RegisterWrite> registerWrites;
+    std::vector<MemoryRead> memoryReads;
+    std::vector<MemoryWrite> memoryWrites;
+  };
+
+  /**
+   * Opens a trace file and reads its header.
+   *
+   * \param path The path of the trace file.
+   * \throws DeserializationError if the file cannot be opened, is no trace or
+   *         has an unsupported version.
+   */
+  explicit TraceReader(const std::string &path);
+
+  /**
+   * Reads the next step.
+   *
+   * \param step Receives the step.
+   * \return False if the trace has ended.
+   * \throws DeserializationError if the file is corrupt.
+   */
+  bool next(Step &step);
+
+  /**
+   * Returns the format version of the file.
+   */
+  std::uint16_t getVersion() const noexcept;
+
+  /**
+   * Returns true if the blocks of the file are compressed.
+   */
+  bool isCompressed() const noexcept;
+
+ private:
+  using Buffer = TraceFormat::Buffer;
+
+  /**
+   * Loads the next block, returns false at the end of the file.
+   */
+  bool _loadBlock();
+
+  /**
+   * Returns true if there is another record, loading blocks as needed.
+   */
+  bool _hasRecord();
+
+  std::uint64_t _readVarint();
+  MemoryValue _readValue();
+  void _readProgram();
+  void _readRegisterName();
+
+  std::ifstream _file;
+  std::uint16_t _version;
+  std::uint16_t _flags;
+  Buffer _block;
+  Buffer _stored;
+  size_t _position;
+  std::unordered_map<size_t, MemoryValue> _program;
+  std::vector<std::string> _registerNames;
+  size_t _lastAddress;
+};
+
+#endif /* ERAGPSIM_CORE_TRACE_READER_HPP */
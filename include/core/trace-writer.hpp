@@ -0,0 +1,206 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ERAGPSIM_CORE_TRACE_WRITER_HPP
+#define ERAGPSIM_CORE_TRACE_WRITER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "core/memory-value.hpp"
+#include "core/trace-format.hpp"
+
+/**
+ * Writes an instruction-level execution trace to a file.
+ *
+ * For every executed instruction the trace holds its address, the registers
+ * it wrote with their new values and the memory it read and wrote (see
+ * TraceFormat for the layout). The encodings of the instructions are written
+ * once per program, not once per step.
+ *
+ * Records are appended to an in-memory block. Full blocks are handed to a
+ * writer thread, which compresses them (optionally) and writes them to the
+ * file, so the caller usually does not wait for the disk. If the disk is
+ * slower than the simulation, at most a fixed number of blocks queue up in
+ * memory; once that many are pending, the caller waits until the writer has
+ * taken one, so the trace stays complete and the memory stays bounded.
+ *
+ * All methods except the constructor and destructor must be called from the
+ * same thread.
+ */
+class TraceWriter {
+ public:
+  using size_t = std::size_t;
+
+  /** An instruction of the traced program. */
+  struct Instruction {
+    size_t address;
+    MemoryValue encoding;
+  };
+
+  using Program = std::vector<Instruction>;
+
+  /** The default size of a block in bytes. */
+  static constexpr size_t defaultBlockSize = 1 << 20;
+
+  /** The default number of full blocks waiting for the writer thread. */
+  static constexpr size_t defaultMaximumPendingBlocks = 16;
+
+  /**
+   * Opens the trace file and starts the writer thread.
+   *
+   * \param path The path of the trace file, it is overwritten.
+   * \param compress Whether to compress the blocks.
+   * \param blockSize The size at which a block is handed to the writer.
+   * \param maximumPendingBlocks The number of blocks which may wait for the
+   * writer before handing over another one blocks, at least 1.
+   */
+  explicit TraceWriter(const std::string &path,
+                       bool compress = false,
+                       size_t blockSize = defaultBlockSize,
+                       size_t maximumPendingBlocks =
+                           defaultMaximumPendingBlocks);
+
+  /**
+   * Writes the remaining records and closes the file.
+   */
+  ~TraceWriter();
+
+  TraceWriter(const TraceWriter &) = delete;
+  TraceWriter &operator=(const TraceWriter &) = delete;
+
+  /**
+   * Returns true if the file could be opened and all writes succeeded so far.
+   */
+  bool isGood() const;
+
+  /**
+   * Records the instructions of the (new) program.
+   *
+   * \param program The addresses and encodings of all instructions.
+   */
+  void writeProgram(const Program &program);
+
+  /**
+   * Records the execution of the instruction at an address. All following
+   * records up to the next step belong to this instruction.
+   *
+   * \param address The address of the instruction.
+   */
+  void beginStep(size_t address);
+
+  /**
+   * Records the new value of a register.
+   *
+   * \param name The name of the register.
+   * \param value The value written.
+   */
+  void writeRegister(const std::string &name, const MemoryValue &value);
+
+  /**
+   * Records a memory read.
+   *
+   * \param address The address of the first cell read.
+   * \param amount The number of cells read.
+   */
+  void readMemory(size_t address, size_t amount);
+
+  /**
+   * Records the new value of memory cells.
+   *
+   * \param address The address of the first cell written.
+   * \param value The value written.
+   */
+  void writeMemory(size_t address, const MemoryValue &value);
+
+  /**
+   * Hands the current block to the writer thread, even if it is not full.
+   * Waits first if the maximum number of blocks is pending already.
+   */
+  void flush();
+
+  /**
+   * Flushes, waits until everything is on disk and closes the file. Further
+   * records are dropped.
+   */
+  void close();
+
+  /**
+   * Returns the number of steps recorded so far.
+   */
+  std::uint64_t getStepCount() const noexcept;
+
+ private:
+  using Buffer = TraceFormat::Buffer;
+
+  /** The state shared with the writer thread. */
+  struct State {
+    std::mutex mutex;
+    std::condition_variable condition;
+    /** Notified whenever the writer takes a pending block. */
+    std::condition_variable drained;
+    std::deque<Buffer> pending;
+    size_t maximumPending;
+    std::vector<Buffer> spare;
+    std::ofstream file;
+    bool compress;
+    bool closing = false;
+    bool good = true;
+  };
+
+  /**
+   * The loop of the writer thread.
+   */
+  static void _run(State &state);
+
+  /**
+   * Writes a tag and opens a new block first if the current one is full.
+   */
+  void _beginRecord(TraceFormat::Tag tag);
+
+  /**
+   * Appends a memory value (size in bits, then its bytes).
+   */
+  void _writeValue(const MemoryValue &value);
+
+  /**
+   * Returns the id of a register, declaring it first if necessary.
+   */
+  std::uint64_t _registerID(const std::string &name);
+
+  std::unique_ptr<State> _state;
+  std::thread _thread;
+  size_t _blockSize;
+  Buffer _block;
+  std::unordered_map<std::string, std::uint64_t> _registerIDs;
+  size_t _lastAddress;
+  std::uint64_t _stepCount;
+  bool _closed;
+};
+
+#endif /* ERAGPSIM_CORE_TRACE_WRITER_HPP */
@@ -0,0 +1,124 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ERAGPSIM_CORE_TRANSACTION_HPP
+#define ERAGPSIM_CORE_TRANSACTION_HPP
+
+#include <cstddef>
+#include <string>
+
+#include "core/memory-value.hpp"
+
+class Project;
+
+/**
+ * The view of the project a transaction works on, see
+ * Project::hartTransaction().
+ *
+ * Like a MemoryAccess, it belongs to a hart: the registers are those of that
+ * hart and reservations are made for it. Unlike a MemoryAccess, every call is
+ * made directly on the project thread, so a transaction must never be kept
+ * beyond the callable it was handed to.
+ */
+class Transaction {
+ public:
+  using size_t = std::size_t;
+
+  /**
+   * Creates the view of a hart.
+   *
+   * \param project The project, which must be used on the current thread.
+   * \param hart The index of the hart.
+   */
+  Transaction(Project& project, size_t hart);
+
+  /**
+   * Returns the index of the hart of this transaction.
+   */
+  size_t getHart() const noexcept;
+
+  /**
+   * \copydoc Project::getMemorySize()
+   */
+  size_t getMemorySize() const;
+
+  /**
+   * \copydoc Project::getMemoryValueAt()
+   */
+  MemoryValue getMemoryValueAt(size_t address, size_t amount = 1) const;
+
+  /**
+   * \copydoc Project::tryGetMemoryValueAt()
+   */
+  MemoryValue tryGetMemoryValueAt(size_t address, size_t amount = 1) const;
+
+  /**
+   * \copydoc Project::putMemoryValueAt()
+   */
+  void putMemoryValueAt(size_t address, const MemoryValue& value);
+
+  /**
+   * \copydoc Project::isMemoryProtectedAt()
+   */
+  bool isMemoryProtectedAt(size_t address, size_t amount = 1) const;
+
+  /**
+   * Returns the content of a register of the hart, see
+   * Project::getHartRegisterValue().
+   *
+   * \param name The name of the register.
+   */
+  MemoryValue getRegisterValue(const std::string& name) const;
+
+  /**
+   * Puts a value into a register of the hart, see
+   * Project::putHartRegisterValue().
+   *
+   * \param name The name of the register.
+   * \param value The new value of the register.
+   */
+  void putRegisterValue(const std::string& name, const MemoryValue& value);
+
+  /**
+   * Reads memory and reserves it for the hart, see Project::loadReserved().
+   *
+   * \param address The address of the memory.
+   * \param amount The number of memory cells.
+   */
+  MemoryValue loadReserved(size_t address, size_t amount);
+
+  /**
+   * Writes memory if the hart still holds the reservation, see
+   * Project::storeConditional().
+   *
+   * \param address The address of the memory.
+   * \param value The value to write.
+   * \return true if the value was written.
+   */
+  bool storeConditional(size_t address, const MemoryValue& value);
+
+ private:
+  /** The project, only valid during the transaction. */
+  Project& _project;
+
+  /** The hart whose registers are accessed. */
+  size_t _hart;
+};
+
+#endif /* ERAGPSIM_CORE_TRANSACTION_HPP */
@@ -0,0 +1,146 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ERAGPSIM_CORE_UNDO_LOG_HPP
+#define ERAGPSIM_CORE_UNDO_LOG_HPP
+
+#include <cstddef>
+#include <deque>
+#include <string>
+
+#include "core/memory-value.hpp"
+
+class Memory;
+class RegisterSet;
+
+/**
+ * An append-only log of the values overwritten by executed instructions.
+ *
+ * Every executed instruction opens a step. While a step is open, each write
+ * to the memory or the registers records the value it replaced. Undoing a step
+ * writes these values back in reverse order, so going back one instruction
+ * only costs as much as the instruction wrote, independent of the size of the
+ * memory.
+ *
+ * The number of steps is bounded, the oldest steps are dropped once the limit
+ * is reached.
+ */
+class UndoLog {
+ public:
+  using size_t = std::size_t;
+
+  /**
+   * Creates a new, empty UndoLog.
+   *
+   * \param maximumSteps The maximum number of steps kept in the log.
+   */
+  explicit UndoLog(size_t maximumSteps = defaultMaximumSteps);
+
+  /**
+   * Opens a new step, all following records belong to this step.
+   */
+  void beginStep();
+
+  /**
+   * Closes the current step, nothing is recorded until the next step begins.
+   */
+  void endStep();
+
+  /**
+   * Returns true if a step is open and writes should be recorded.
+   */
+  bool isRecording() const noexcept;
+
+  /**
+   * Records the previous value of a memory area.
+   *
+   * \param address The address of the overwritten memory cells.
+   * \param previous The value the memory held before the write.
+   */
+  void recordMemory(size_t address, const MemoryValue &previous);
+
+  /**
+   * Records the previous value of a register.
+   *
+   * \param name The name of the overwritten register.
+   * \param previous The value the register held before the write.
+   */
+  void recordRegister(const std::string &name, const MemoryValue &previous);
+
+  /**
+   * Restores the state before the last step and removes it from the log.
+   *
+   * \param memory The memory to restore.
+   * \param registerSet The registers to restore.
+   * \return false if there was no step to undo, true otherwise.
+   */
+  bool undoStep(Memory &memory, RegisterSet &registerSet);
+
+  /**
+   * Returns the number of steps which can be undone.
+   */
+  size_t getStepCount() const noexcept;
+
+  /**
+   * Returns the maximum number of steps kept in the log.
+   */
+  size_t getMaximumSteps() const noexcept;
+
+  /**
+   * Removes all steps from the log.
+   */
+  void clear();
+
+  /** The default maximum number of steps. */
+  static constexpr size_t defaultMaximumSteps = 100000;
+
+ private:
+  /**
+   * A single overwritten value, either a memory area or a register.
+   */
+  struct Record {
+    /** The name of the register, empty for memory records. */
+    std::string name;
+
+    /** The address of the memory area, unused for register records. */
+    size_t address;
+
+    /** The overwritten value. */
+    MemoryValue previous;
+  };
+
+  /**
+   * Drops the oldest steps until the log fits its maximum size.
+   */
+  void _trim();
+
+  /** All records of all steps, oldest first. */
+  std::deque<Record> _records;
+
+  /** The number of records of each step, oldest first. */
+  std::deque<size_t> _stepSizes;
+
+  /** The maximum number of steps. */
+  size_t _maximumSteps;
+
+  /** True while a step is open. */
+  bool _recording;
+};
+
+#endif /* ERAGPSIM_CORE_UNDO_LOG_HPP */
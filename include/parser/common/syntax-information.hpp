@@ -20,6 +20,8 @@
 #ifndef ERAGPSIM_PARSER_COMMON_SYNTAX_INFORMATION_HPP
 #define ERAGPSIM_PARSER_COMMON_SYNTAX_INFORMATION_HPP
 
+#include <cstddef>
+#include <functional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -40,6 +42,29 @@ class SyntaxInformation {
    */
   using TokenRegex = std::pair<const std::string, const Token>;
 
+  /**
+   * A part of a line classified by a lexer.
+   */
+  struct TokenSpan {
+    /** The index of the first character. */
+    std::size_t begin;
+
+    /** The number of characters. */
+    std::size_t length;
+
+    /** The kind of token. */
+    Token token;
+  };
+
+  using TokenSpanList = std::vector<TokenSpan>;
+
+  /**
+   * Classifies all tokens of a single line in one pass, as an alternative to
+   * matching every regex against the line. It has to be safe to call from any
+   * thread.
+   */
+  using Lexer = std::function<TokenSpanList(const std::string &line)>;
+
   /**
    * Helper class which iterates through all regexes for a specified token.
    */
@@ -143,12 +168,28 @@ class SyntaxInformation {
    */
   const std::vector<TokenRegex> &getEntries() const;
 
+  /**
+   * Sets a lexer, which should be preferred over the regexes.
+   *
+   * \param lexer The lexer of the parser.
+   */
+  void setLexer(Lexer lexer);
+
+  /**
+   * \return The lexer, empty if the parser only provides regexes.
+   */
+  const Lexer &getLexer() const noexcept;
 
  private:
   /**
    * Saves all regexes and their token.
    */
   std::vector<TokenRegex> _entries;
+
+  /**
+   * The lexer of the parser, may be empty.
+   */
+  Lexer _lexer;
 };
 
 #endif /* ERAGPSIM_PARSER_COMMON_SYNTAX_INFORMATION_HPP */
@@ -0,0 +1,79 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef ERAGPSIM_PARSER_RISCV_RISCV_SYNTAX_LEXER_HPP
+#define ERAGPSIM_PARSER_RISCV_RISCV_SYNTAX_LEXER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+#include "parser/common/syntax-information.hpp"
+
+class Architecture;
+
+/**
+ * Classifies the tokens of a RISC-V line for syntax highlighting.
+ *
+ * The line is split by the same tokenizer the parser uses
+ * (RiscvParser::RiscvRegex) into label, instruction and parameters, which are
+ * then scanned once from left to right. Register names are looked up in a
+ * hash set instead of matching one regex per register.
+ *
+ * Copies share the register names and the lexer does not change after its
+ * construction, so it can be used from any thread.
+ */
+class RiscvSyntaxLexer {
+ public:
+  using size_t = std::size_t;
+  using Token = SyntaxInformation::Token;
+  using TokenSpanList = SyntaxInformation::TokenSpanList;
+
+  /**
+   * Creates a lexer knowing the registers of an architecture.
+   *
+   * \param architecture The architecture of the parser.
+   */
+  explicit RiscvSyntaxLexer(const Architecture &architecture);
+
+  /**
+   * Classifies the tokens of a line.
+   *
+   * \param line The line, without a line break.
+   * \return The classified tokens, ordered and not overlapping.
+   */
+  TokenSpanList operator()(const std::string &line) const;
+
+ private:
+  /**
+   * Classifies the operands in [begin, end) of the line, the rest of the line
+   * is a comment if a ';' is found outside of a string.
+   */
+  void _lexOperands(const std::string &line,
+                    size_t begin,
+                    size_t end,
+                    TokenSpanList &spans) const;
+
+  /** The lower case names of all registers. */
+  std::shared_ptr<const std::unordered_set<std::string>> _registers;
+};
+
+#endif /* ERAGPSIM_PARSER_RISCV_RISCV_SYNTAX_LEXER_HPP */
@@ -50,10 +50,11 @@ class ConsoleComponent : public QObject {
   Q_INVOKABLE void appendText(QString text);
 
   /**
-    * Gets the Text from the Memory until a Nullbyte
-    * or end of Memory is reached
-    */
-  Q_INVOKABLE QString getText();
+   * Fetches the text from the memory until a nullbyte or the end of the
+   * memory is reached, in a single request to the core. Does not wait for
+   * the core, the text arrives through textFetched.
+   */
+  Q_INVOKABLE void fetchText();
 
   /**
    * Sets the new startindex.
@@ -98,18 +99,67 @@ class ConsoleComponent : public QObject {
    */
   Q_INVOKABLE bool deleteBuffer();
 
-  /** Checks wether or not the simulated console interrupt is set. */
-  Q_INVOKABLE bool checkInterrupt();
+  /**
+   * Checks wether or not the simulated console interrupt is set. Does not
+   * wait for the core, a set interrupt is reported through interruptRaised.
+   */
+  Q_INVOKABLE void checkInterrupt();
 
-  /** Sets the simulated interrupt. */
+  /** Sets the simulated interrupt, without waiting for the core. */
   Q_INVOKABLE void setInterrupt();
 
-  /** Resets the simulated interrupt. */
+  /** Resets the simulated interrupt, without waiting for the core. */
   Q_INVOKABLE void resetInterrupt();
 
   /** Deletes the text data in the memory. */
   Q_INVOKABLE void deleteTextInMemory();
 
+  /**
+   * Sets the ring mode. In ring mode, the start address holds an output ring
+   * buffer the program writes to, directly followed by an input ring buffer
+   * the console writes to (see MemoryRingBuffer).
+   *
+   * \param ringBuffer True to enable the ring mode.
+   */
+  Q_INVOKABLE void setRingBuffer(bool ringBuffer);
+
+  /**
+   * \return True if the console is in ring mode.
+   */
+  Q_INVOKABLE bool ringBuffer();
+
+  /**
+   * Sets the number of data bytes of each of the two ring buffers.
+   *
+   * \param capacity The capacity, at least 2.
+   */
+  Q_INVOKABLE void setRingCapacity(size_t capacity);
+
+  /**
+   * \return The number of data bytes of each of the two ring buffers.
+   */
+  Q_INVOKABLE size_t getRingCapacity();
+
+  /**
+   * \return The address of the input ring buffer.
+   */
+  Q_INVOKABLE size_t getInputRingAddress();
+
+  /**
+   * Takes all text the program wrote to the output ring buffer, with a single
+   * request to the core. Does not wait for the core, the text arrives through
+   * outputDrained.
+   */
+  Q_INVOKABLE void drainOutput();
+
+  /**
+   * Passes text to the program through the input ring buffer. Does not wait
+   * for the core, whether the text fit arrives through inputPushed.
+   *
+   * \param text The text, it is either written completely or not at all.
+   */
+  Q_INVOKABLE void pushInput(QString text);
+
  private:
   /** The start address in memory. */
   size_t _start;
@@ -126,17 +176,54 @@ class ConsoleComponent : public QObject {
   /** The current mode. */
   bool _deleteBuffer;
 
+  /** True if the console is in ring mode, overrides _deleteBuffer. */
+  bool _ringBuffer;
+
+  /** The number of data bytes of each of the two ring buffers. */
+  size_t _ringCapacity;
+
   /** Flag to save wether or not the interrupt was already accepted.
    * Assures that the interrupt is edge triggered.
    */
   bool _interruptTriggered;
 
+  /** Counts the changes of the text made by the console itself, a fetched
+   * length is only taken over if there was none since the fetch.
+   */
+  size_t _textVersion;
+
+  /** Sets or resets the simulated interrupt in a single transaction. */
+  void _writeInterrupt(bool set);
+
  signals:
 
   /**
    * Called when the settings have changed.
    */
   void settingsChanged();
+
+  /**
+   * Called with the text taken out of the output ring buffer by drainOutput.
+   */
+  void outputDrained(QString text);
+
+  /**
+   * Called with the text fetched from memory by fetchText.
+   */
+  void textFetched(QString text);
+
+  /**
+   * Called when checkInterrupt found the interrupt set.
+   */
+  void interruptRaised();
+
+  /**
+   * Called when pushInput is done.
+   *
+   * \param text The text that was passed to pushInput.
+   * \param accepted True if the text fit into the input ring buffer.
+   */
+  void inputPushed(QString text, bool accepted);
 };
 
 #endif  // ERASIM_UI_CONSOLE_COMPONENT_HPP
@@ -0,0 +1,81 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ERAGPSIM_UI_GUI_EXECUTOR_HPP
+#define ERAGPSIM_UI_GUI_EXECUTOR_HPP
+
+#include <QMetaType>
+#include <QObject>
+#include <QPointer>
+#include <functional>
+
+/**
+ * Runs functions posted from any thread in the gui thread.
+ *
+ * This is the executor for the continuations of POST_ASYNC proxy functions,
+ * so that components get their results from the core without waiting on a
+ * future in the gui thread. The functions are delivered through a queued
+ * signal, which works with every Qt 5 version.
+ *
+ * The instance has to be created in the gui thread, before the first core
+ * result arrives.
+ */
+class GuiExecutor : public QObject {
+  Q_OBJECT
+
+ public:
+  using Function = std::function<void()>;
+  using Executor = std::function<void(Function)>;
+
+  /**
+   * \returns The executor of the gui thread, which is created on the first
+   *          call.
+   */
+  static GuiExecutor& instance();
+
+  /**
+   * Creates an executor which drops functions whose context was destroyed
+   * before they could run.
+   *
+   * \param context The object a continuation belongs to, usually `this`.
+   * \returns An executor to pass to a POST_ASYNC proxy function.
+   */
+  static Executor forObject(QObject* context);
+
+  /**
+   * Runs the function in the gui thread. Thread safe.
+   *
+   * \param function The function to run.
+   */
+  void post(Function function);
+
+ signals:
+  /** Carries a posted function into the gui thread. */
+  void functionPosted(GuiExecutor::Function function);
+
+ private slots:
+  void _run(GuiExecutor::Function function);
+
+ private:
+  GuiExecutor();
+};
+
+Q_DECLARE_METATYPE(GuiExecutor::Function)
+
+#endif /* ERAGPSIM_UI_GUI_EXECUTOR_HPP */
@@ -67,7 +67,10 @@ class GuiProject : QObject {
       std::function<std::string(const MemoryValue&)>;
   using StringToMemoryConverter =
       std::function<Optional<MemoryValue>(const std::string&, std::size_t)>;
+  using MemoryToStringsConverter = std::function<std::vector<std::string>(
+      const MemoryValue&, std::size_t)>;
   using MemoryToStringConverterMap = QHash<QString, MemoryToStringConverter>;
+  using MemoryToStringsConverterMap = QHash<QString, MemoryToStringsConverter>;
   using StringToMemoryConverterMap = QHash<QString, StringToMemoryConverter>;
 
   /**
@@ -144,6 +147,16 @@ class GuiProject : QObject {
    */
   void runBreakpoint();
 
+  /**
+   * undoes the last executed line
+   */
+  void stepBack();
+
+  /**
+   * undoes executed lines until a breakpoint is found
+   */
+  void stepBackToBreakpoint();
+
   /**
    * stops execution
    */
@@ -262,6 +275,14 @@ class GuiProject : QObject {
    */
   static const MemoryToStringConverterMap& getMemoryToStringConversions();
 
+  /**
+   * A map of functions for converting a range of memory cells to strings at
+   * once. Only contains the formats that have such a conversion.
+   *
+   * \return The map.
+   */
+  static const MemoryToStringsConverterMap& getMemoryToStringsConversions();
+
   /**
    *  A map of functions for converting strings to MemoryValues.
    *
@@ -429,6 +450,9 @@ class GuiProject : QObject {
   /** A map of conversion functions from memory values to strings. */
   static MemoryToStringConverterMap _memoryToStringMap;
 
+  /** A map of conversion functions from memory ranges to strings. */
+  static MemoryToStringsConverterMap _memoryToStringsMap;
+
   /** A map of conversion functions from strings to memory values. */
   static StringToMemoryConverterMap _stringToMemoryMap;
 
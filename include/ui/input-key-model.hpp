@@ -47,6 +47,20 @@ class InputKeyModel : public QObject {
    */
   Q_INVOKABLE void setStart(unsigned int start);
 
+  /**
+   * Returns the capacity of the input ring buffer, 0 if pressed keys simply
+   * overwrite the value at start.
+   */
+  Q_INVOKABLE unsigned int getRingCapacity();
+
+  /**
+   * Sets the capacity of the input ring buffer at start (see
+   * MemoryRingBuffer). Every pressed key is queued as 4 bytes, so the program
+   * does not miss keys pressed in quick succession.
+   * \param capacity The number of data bytes, 0 to disable the ring buffer.
+   */
+  Q_INVOKABLE void setRingCapacity(unsigned int capacity);
+
   /**
     Returns a human-readble description of the given key.
     \param key Key requested to describe.
@@ -59,6 +73,10 @@ class InputKeyModel : public QObject {
    * @brief the base addresss in the memory
    */
   unsigned int _start;
+  /**
+   * @brief the capacity of the input ring buffer, 0 if there is none
+   */
+  unsigned int _ringCapacity;
   MemoryAccess _memoryAccess;
 };
 
@@ -21,14 +21,21 @@
 #define ERAGPSIM_UI_MEMORY_COMPONENT_PRESENTER_HPP
 
 #include <QAbstractListModel>
+#include <QByteArray>
 #include <QHash>
 #include <QModelIndex>
 #include <QObject>
 #include <QQmlContext>
 #include <QVariant>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
 
 #include "core/memory-access.hpp"
 #include "core/memory-manager.hpp"
+#include "core/memory-value.hpp"
+#include "core/result.hpp"
 
 class MemoryComponentPresenter : public QAbstractListModel {
   Q_OBJECT
@@ -57,6 +64,8 @@ class MemoryComponentPresenter : public QAbstractListModel {
   /**
    * Returns whether the memory cell is write protected.
    * A memory cell is considered protected if it contains executable code.
+   * The answer is cached, a cell that was not asked for before is reported as
+   * unprotected until the core answered and the row changed.
    * \param address The address of the memory cell.
    * \return true, if the cell is protected, otherwise false.
    */
@@ -118,16 +127,6 @@ class MemoryComponentPresenter : public QAbstractListModel {
    */
   QVariant dataInfo(const QModelIndex &index, int role = Qt::DisplayRole) const;
 
-  /**
-   * Gets a MemoryValue at the given position either from the core or by using a
-   * cache.
-   * \param address Address of the MemoryValue
-   * \param length Size of the MemoryValue
-   * \return The requested MemoryValue
-   */
-  MemoryValue
-  getMemoryValueCached(const size_t address, const size_t length) const;
-
   /**
    * Returns the number of rows in this table
    * Inherited from QAbstractListModel
@@ -148,9 +147,32 @@ class MemoryComponentPresenter : public QAbstractListModel {
   QHash<int, QByteArray> roleNames() const Q_DECL_OVERRIDE;
 
   /**
-   * Updates the memory cache. Has to be const as the data method is const.
+   * Asks the core for a window of memory around the given address, unless the
+   * window that is currently fetched already contains it. Only one request is
+   * in flight at a time, newer requests replace older ones that were not sent
+   * yet.
+   *
+   * \param address The address that has to be contained in the window.
    */
-  void _updateCache() const;
+  void _requestWindow(size_t address) const;
+
+  /**
+   * Sends a request for a window of memory to the core. The answer arrives
+   * in the gui thread through _onWindowFetched.
+   *
+   * \param address The first address of the window.
+   * \param size The number of cells of the window.
+   */
+  void _fetchWindow(size_t address, size_t size) const;
+
+  /**
+   * Replaces the window by a newly fetched one and sends the next request if
+   * there is one.
+   *
+   * \param address The first address of the window.
+   * \param window The cells of the window, or the exception of the fetch.
+   */
+  void _onWindowFetched(size_t address, const Result<MemoryValue> &window);
 
   /**
    * Turns a role string into the data format string by removing the number
@@ -172,31 +194,75 @@ class MemoryComponentPresenter : public QAbstractListModel {
    * rowCount causes a deadlock. */
   size_t _memorySize;
 
+  /** Number of cells that are fetched from the core at once. */
+  static constexpr size_t _windowSize = 4096;
+
+  /** Number of cells that are fetched in front of a requested address. */
+  static constexpr size_t _windowMargin = 1024;
+
   /**
-   * Cache for core memory on updates. When the memory is updates every view
-   * has to fetch values multiple times. In order to decrease the number of
-   * calls to the core this cache has been introduced.
+   * A converter from memory to string and the number of bits it displays, one
+   * for every value role. If the format can convert a whole range of cells at
+   * once, the window is converted with rangeConverter instead.
    */
-  mutable MemoryValue _memoryCache;
+  struct Format {
+    std::function<std::string(const MemoryValue &)> converter;
+    int numberOfBits;
+    std::function<std::vector<std::string>(const MemoryValue &, size_t)>
+        rangeConverter;
+  };
+
+  /** The formats of all value roles, indexed by role - ValueRoleBin8. */
+  std::vector<Format> _formats;
 
   /**
-   * Size of core memory that is hold in cache.
+   * Converts all cells of the window to strings of the given format at once.
+   *
+   * \param format The format, which has to have a range converter.
+   * \param strings The strings of the format, indexed by address -
+   *        _windowAddress.
    */
-  mutable size_t _memoryCacheSize = 0;
+  void _convertWindow(const Format &format,
+                      std::vector<QString> &strings) const;
 
   /**
-   * Starting address of the memory hold in cache.
-   * Just one block of memory will be kept in the cache.
+   * The window of memory that is currently displayed. data() is only ever
+   * served from here, the core is never asked synchronously.
    */
-  mutable size_t _memoryCacheBaseAddress = 0;
+  MemoryValue _window;
 
-  /** An offset for the cache. */
-  mutable size_t _memoryCacheOffset;
+  /** The address of the first cell in the window. */
+  size_t _windowAddress = 0;
+
+  /** The number of cells in the window, zero if there is no window yet. */
+  size_t _windowCells = 0;
 
   /**
-   * Determines whether the current cache is valid or outdated.
+   * The strings of the window, converted lazily and only once for every
+   * format. Indexed like _formats, then by address - _windowAddress. A null
+   * string has not been converted yet.
    */
-  mutable bool _memoryCacheValid = false;
+  mutable std::vector<std::vector<QString>> _formatted;
+
+  /**
+   * Whether cells are protected, by address. Entries of changed cells are
+   * removed, answers of the core are only stored while their entry exists.
+   */
+  std::map<size_t, bool> _protection;
+
+  /** Whether a window was requested from the core and has not arrived. */
+  mutable bool _fetching = false;
+
+  /** The first address and the size of the window that is being fetched. */
+  mutable size_t _fetchingAddress = 0;
+  mutable size_t _fetchingCells = 0;
+
+  /** Whether a window is waiting to be sent once the current one arrived. */
+  mutable bool _nextPending = false;
+
+  /** The first address and the size of the window that is waiting. */
+  mutable size_t _nextAddress = 0;
+  mutable size_t _nextCells = 0;
 
   /** enumeration of all roles of the columns */
   enum ColumnRoles {
@@ -236,6 +302,7 @@ class MemoryComponentPresenter : public QAbstractListModel {
    * \param newSize The new size of the memory.
    */
   void onMemorySizeChanged(size_t newSize);
+
 };
 
 #endif /* ERAGPSIM_UI_MEMORY_COMPONENT_PRESENTER_HPP */
@@ -19,8 +19,13 @@
 #ifndef ERAGPSIM_UI_OUTPUTCOMPONENT_HPP
 #define ERAGPSIM_UI_OUTPUTCOMPONENT_HPP
 
+#include <QByteArray>
 #include <QDebug>
+#include <QList>
 #include <QQmlContext>
+#include <unordered_map>
+#include <utility>
+
 #include "core/memory-access.hpp"
 
 class MemoryManager;
@@ -53,6 +58,14 @@ class OutputComponent : public QObject {
    */
   void memoryChanged(QVariant address, QVariant length);
 
+  /**
+   * \brief rangeChanged Signal that is only sent for changes inside the range
+   * of a subscription (see subscribe()).
+   * \param subscription The identifier of the subscription whose range
+   * changed.
+   */
+  void rangeChanged(int subscription);
+
   /**
    * \brief outputItemSettingsChanged Signal the the output component calls to
    * signal its QML output item instances that the settings of some output
@@ -60,6 +73,22 @@ class OutputComponent : public QObject {
    */
   void outputItemSettingsChanged();
 
+  /**
+   \brief memoryBytesFetched Signal carrying the answer to fetchMemoryBytes.
+   \param request The identifier returned by fetchMemoryBytes.
+   \param bytes The bytes in memory order (an ArrayBuffer in QML), empty if a
+   byte of the architecture does not have 8 bits.
+   */
+  void memoryBytesFetched(int request, QByteArray bytes);
+
+  /**
+   \brief memoryWordsFetched Signal carrying the answer to fetchMemoryWords.
+   \param request The identifier returned by fetchMemoryWords.
+   \param words The value of every word (a plain array of numbers in QML),
+   empty if a byte of the architecture does not have 8 bits.
+   */
+  void memoryWordsFetched(int request, QList<qreal> words);
+
  public:
   OutputComponent(MemoryManager &memoryManager,
                   MemoryAccess &memoryAccess,
@@ -86,6 +115,69 @@ class OutputComponent : public QObject {
    */
   Q_INVOKABLE QList<bool> getMemoryContent(int address, int length) const;
 
+  /**
+   \brief fetchMemoryBytes Fetches a range of memory in one piece, without
+   waiting for the core. The bytes arrive through memoryBytesFetched.
+   \param address The address of the first byte.
+   \param length The number of bytes.
+   \return The identifier of the request.
+   */
+  Q_INVOKABLE int fetchMemoryBytes(int address, int length);
+
+  /**
+   \brief fetchMemoryWords Fetches a range of memory as unsigned little endian
+   words, without waiting for the core. The words arrive through
+   memoryWordsFetched.
+   \param address The address of the first word.
+   \param count The number of words.
+   \param wordSize The number of bytes of each word, between 1 and 4.
+   \return The identifier of the request.
+   */
+  Q_INVOKABLE int fetchMemoryWords(int address, int count, int wordSize = 1);
+
+  /**
+   \brief putMemoryBytes Writes a range of memory in one piece. Does nothing
+   if a byte of the architecture does not have 8 bits.
+   \param address The address of the first byte.
+   \param bytes The new bytes in memory order.
+   */
+  Q_INVOKABLE void putMemoryBytes(int address, const QByteArray &bytes);
+
+  /**
+   \brief putMemoryWords Writes unsigned little endian words to memory. Does
+   nothing if a byte of the architecture does not have 8 bits.
+   \param address The address of the first word.
+   \param words The new value of every word, clamped to the range of a word.
+   \param wordSize The number of bytes of each word, between 1 and 4.
+   */
+  Q_INVOKABLE void
+  putMemoryWords(int address, const QList<qreal> &words, int wordSize = 1);
+
+  /**
+   \brief subscribe Registers an output item for changes in a range of
+   memory. Changes inside the range are signaled through rangeChanged.
+   \param address The first address of the range.
+   \param length The number of bytes of the range.
+   \return The identifier of the subscription.
+   */
+  Q_INVOKABLE int subscribe(int address, int length);
+
+  /**
+   \brief setSubscriptionRange Moves the range of a subscription, e.g. after
+   the settings of an output item changed.
+   \param subscription The identifier returned by subscribe().
+   \param address The new first address of the range.
+   \param length The new number of bytes of the range.
+   */
+  Q_INVOKABLE void
+  setSubscriptionRange(int subscription, int address, int length);
+
+  /**
+   \brief unsubscribe Removes a subscription.
+   \param subscription The identifier returned by subscribe().
+   */
+  Q_INVOKABLE void unsubscribe(int subscription);
+
   /**
    \brief getOutputItem Returns the model data of the output item with the given
    index.
@@ -122,10 +214,23 @@ class OutputComponent : public QObject {
   /// Interface for accessing memory content.
   MemoryAccess _memoryAccess;
 
+  /// The number of bits in a byte. The byte and word accessors only work with
+  /// 8 bit bytes.
+  size_t _byteSize;
+
   /// The underlying model of each output item. Mostly used for savings output
   /// item settings (e.g. baseAddress in memory) as actual data is fetched
   /// dynamically.
   QVariantList _outputItemsInformation;
+
+  /// The ranges of memory the output items subscribed to, by identifier.
+  std::unordered_map<int, std::pair<size_t, size_t>> _subscriptions;
+
+  /// The identifier of the next subscription.
+  int _nextSubscription = 0;
+
+  /// The identifier of the next fetchMemoryBytes/fetchMemoryWords request.
+  int _nextRequest = 0;
 };
 
 #endif  // ERAGPSIM_UI_OUTPUTCOMPONENT_HPP
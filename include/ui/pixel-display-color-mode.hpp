@@ -23,64 +23,48 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <utility>
 
 #include "common/optional.hpp"
-class OutputComponent;
+#include "core/memory-value.hpp"
 class QImage;
-class MemoryValue;
+class Transaction;
 
 namespace colormode {
 class Options;
 struct ColorMode {
   using size_t = std::size_t;
-  using GetPixelFunction = std::function<std::uint32_t(
-      Optional<OutputComponent *>, Options &, size_t, size_t)>;
-  using GetColorFunction = std::function<std::uint32_t(
-      Optional<OutputComponent *>, Options &, size_t)>;
+  struct Frame;
   using GetPixelFromBufferFunction = std::function<std::uint32_t(
       const MemoryValue &, size_t, Options &, size_t, size_t)>;
   using GetColorFromBufferFunction = std::function<std::uint32_t(
       const MemoryValue &, size_t, Options &, size_t)>;
-  using UpdateMemoryFunction = std::function<void(Optional<OutputComponent *>,
-                                                  Options &,
-                                                  std::shared_ptr<QImage>,
-                                                  size_t,
-                                                  size_t)>;
-  using UpdateAllPixelsFunction = std::function<void(
-      Optional<OutputComponent *>, Options &, std::shared_ptr<QImage>)>;
-  using UpdateAllColorsFunction = std::function<void(
-      Optional<OutputComponent *>, Options &, std::shared_ptr<QImage>)>;
-  using CheckErrorsFunction =
-      std::function<void(Optional<OutputComponent *>, Options &)>;
+  using UpdateMemoryFunction = std::function<void(
+      Transaction &, Options &, Frame &, size_t, size_t)>;
+  using UpdateAllPixelsFunction =
+      std::function<void(Transaction &, Options &, Frame &)>;
+  using UpdateAllColorsFunction =
+      std::function<void(Transaction &, Options &, Frame &)>;
+  using CheckErrorsFunction = std::function<void(size_t, Options &)>;
+  using DrawFunction =
+      std::function<void(const Frame &, Options &, QImage &)>;
 
   // RGB:
-  const static GetPixelFunction RGBGetPixel;
-  const static GetColorFunction RGBGetColor;
   const static GetPixelFromBufferFunction RGBGetPixelFromBuffer;
   const static GetColorFromBufferFunction RGBGetColorFromBuffer;
   const static UpdateMemoryFunction RGBUpdateMemory;
   const static UpdateAllPixelsFunction RGBUpdateAllPixels;
   const static UpdateAllColorsFunction RGBUpdateAllColors;
   const static CheckErrorsFunction RGBCheckErrors;
+  const static DrawFunction RGBDraw;
   // Monochrome
-  const static GetPixelFunction MonochromeGetPixel;
-  const static GetColorFunction MonochromeGetColor;
   const static GetPixelFromBufferFunction MonochromeGetPixelFromBuffer;
   const static GetColorFromBufferFunction MonochromeGetColorFromBuffer;
   const static UpdateMemoryFunction MonochromeUpdateMemory;
   const static UpdateAllPixelsFunction MonochromeUpdateAllPixels;
   const static UpdateAllColorsFunction MonochromeUpdateAllColors;
   const static CheckErrorsFunction MonochromeCheckErrors;
-
-  /**
-   * \brief returns the color of the pixel at (x,y)
-   */
-  GetPixelFunction getPixel;
-
-  /**
-   * \brief returns the color from the color Table at the index index
-   */
-  GetColorFunction getColor;
+  const static DrawFunction MonochromeDraw;
 
   /**
    * \brief returns the color of the pixel at (x,y) fetching the data from the
@@ -95,53 +79,153 @@ struct ColorMode {
   GetColorFromBufferFunction getColorFromBuffer;
 
   /**
-   * \brief updates the image wherever the given change in memory modified the
-   *        image
+   * \brief fetches into the frame whatever the given change in memory
+   *        modified in the image, runs on the project thread
    */
   UpdateMemoryFunction updateMemory;
 
   /**
-   * \brief updates all pixels of the image
+   * \brief fetches all pixels of the image into the frame, runs on the
+   *        project thread
    */
   UpdateAllPixelsFunction updateAllPixels;
 
   /**
-   * \brief updates all colors of the image
+   * \brief fetches all colors of the image into the frame, runs on the
+   *        project thread
    */
   UpdateAllColorsFunction updateAllColors;
 
   /**
-   * checks for errors
+   * checks for errors, given the size of the memory
    */
   CheckErrorsFunction checkErrors;
 
   /**
-   * \brief loads a pointer from memory
-   * \param memoryAccess The access to the memory
-   * \param address Address of the pointer
-   * \param indirect ponter is at address : pointer is address
-   * \param cellSize size of a cell in memory
-   * \param pointerSize size of a pointer in Bits
-   * \return the pointer
-   */
-  static size_t loadPointer(Optional<OutputComponent *> memoryAccess,
-                            size_t address,
-                            bool indirect,
-                            size_t cellSize,
-                            size_t pointerSize,
-                            Options &o);
-  /**
-   * \brief returns the memoryValue from memory at address
-   * \param memoryAccess The access to the memory
-   * \param address address of the value
-   * \param length length of the value in byte
-   * \param defaultLength length of the output if there is no memoryAccess
-   * \return the memoryValue from memory at address
-   */
-  static MemoryValue getMemoryValueAt(Optional<OutputComponent *> memoryAccess,
-                                      size_t address,
-                                      size_t length,
-                                      Options &o);
+   * \brief draws a fetched frame into the image, runs on the gui thread
+   */
+  DrawFunction draw;
+
+  /**
+   * \brief Everything a redraw needs from memory, fetched in one transaction.
+   */
+  struct Frame {
+    /** Size of the memory in cells. */
+    size_t memorySize = 0;
+    /** Address of the pixel buffer, pointers already followed. */
+    size_t pixelBufferPointer = 0;
+    /** Address of the color table, pointers already followed. */
+    size_t colorTablePointer = 0;
+    /** Offset of pixels within the pixel buffer in cells. */
+    size_t pixelOffset = 0;
+    /** The fetched part of the pixel buffer, if any. */
+    Optional<MemoryValue> pixels;
+    /** The fetched color table, if any. */
+    Optional<MemoryValue> colors;
+    /** The rows [firstRow, lastRow) of the image to be redrawn. */
+    size_t firstRow = 0;
+    /** The end of the rows of the image to be redrawn. */
+    size_t lastRow = 0;
+    /** Whether the color table of the image is to be redrawn. */
+    bool redrawColors = false;
+  };
+
+  /**
+   * \brief loads the memory size and follows the pointers to the pixel buffer
+   *        and the color table
+   * \param transaction The transaction to read the memory with
+   * \param frame The frame to fill in
+   * \param pixels whether the pixel buffer pointer is needed
+   * \param colors whether the color table pointer is needed
+   */
+  static void locateFrame(Transaction &transaction,
+                          Options &o,
+                          Frame &frame,
+                          bool pixels,
+                          bool colors);
+
+  /**
+   * \brief fetches part of the pixel buffer and the color table of a located
+   *        frame
+   * \param transaction The transaction to read the memory with
+   * \param frame The located frame
+   * \param pixelOffset offset into the pixel buffer in cells
+   * \param pixelLength number of cells of the pixel buffer to fetch
+   * \param colorLength number of cells of the color table to fetch
+   */
+  static void fetchFrame(Transaction &transaction,
+                         Options &o,
+                         Frame &frame,
+                         size_t pixelOffset,
+                         size_t pixelLength,
+                         size_t colorLength);
+
+  /**
+   * \brief returns the size of the pixel buffer in cells
+   */
+  static size_t getPixelBufferSize(const Options &o);
+
+  /**
+   * \brief returns the rows [first, last) showing the cells [begin, end) of
+   *        the pixel buffer
+   */
+  static std::pair<size_t, size_t>
+  rowsOf(const Options &o, size_t begin, size_t end);
+
+  /**
+   * \brief converts the rows [firstRow, lastRow) of a fetched RGB frame
+   *        directly into the scanlines of image
+   */
+  static void convertRGB(const Frame &frame,
+                         Options &o,
+                         QImage &image,
+                         size_t firstRow,
+                         size_t lastRow);
+
+  /**
+   * \brief converts the rows [firstRow, lastRow) of a RGB pixel buffer
+   *        directly into the scanlines of image
+   * \param data the pixel buffer, beginning pixelOffset cells into it
+   * \param bufferSize the size of data in bit
+   * \param pixelOffset offset of data within the pixel buffer in cells
+   */
+  static void convertRGB(const std::uint8_t *data,
+                         size_t bufferSize,
+                         size_t pixelOffset,
+                         Options &o,
+                         QImage &image,
+                         size_t firstRow,
+                         size_t lastRow);
+
+  /**
+   * \brief converts the rows [firstRow, lastRow) of a fetched monochrome
+   *        frame directly into the scanlines of image
+   */
+  static void convertMonochrome(const Frame &frame,
+                                Options &o,
+                                QImage &image,
+                                size_t firstRow,
+                                size_t lastRow);
+
+  /**
+   * \brief converts the rows [firstRow, lastRow) of a monochrome pixel
+   *        buffer directly into the scanlines of image
+   * \param data the pixel buffer, beginning pixelOffset cells into it
+   * \param bufferSize the size of data in bit
+   * \param pixelOffset offset of data within the pixel buffer in cells
+   */
+  static void convertMonochrome(const std::uint8_t *data,
+                                size_t bufferSize,
+                                size_t pixelOffset,
+                                Options &o,
+                                QImage &image,
+                                size_t firstRow,
+                                size_t lastRow);
+
+  /**
+   * \brief sets the color table of image from a fetched frame
+   */
+  static void convertColors(const Frame &frame, Options &o, QImage &image);
 };
 }
 
@@ -24,14 +24,14 @@
 #include <memory>
 #include <vector>
 
-#include "common/optional.hpp"
+#include "ui/pixel-display-color-mode.hpp"
 
-class OutputComponent;
+class FramebufferChannel;
 class QImage;
 class MemoryValue;
+class Transaction;
 
 namespace colormode {
-struct ColorMode;
 struct Options {
   using size_t = std::size_t;
   using pixelDisplayErrorFunction =
@@ -88,23 +88,6 @@ struct Options {
    */
   ColorMode getColorMode() const;
 
-  /**
-   * \brief returns the color of the pixel at (x,y)
-   * \param memoryAccess source to load the data from
-   * \param x X position of the Pixel
-   * \param y Y position of the Pixel
-   */
-  std::uint32_t
-  getPixel(Optional<OutputComponent *> memoryAccess, size_t x, size_t y);
-
-  /**
-   * \brief returns the color from the color Table at the index index
-   * \param memoryAccess source to load the data from
-   * \param index index of the entry in the color Table
-   */
-  std::uint32_t
-  getColor(Optional<OutputComponent *> memoryAccess, size_t index);
-
   /**
    * \brief returns the color of the pixel at (x,y) fetching the data from the
    *        prefetched Buffer buffer
@@ -131,56 +114,49 @@ struct Options {
   getColorFromBuffer(const MemoryValue &buffer, size_t offset, size_t index);
 
   /**
-   * \brief redraws the Pixel at (x,y)
-   * \param memoryAccess source to load the data from
-   * \param image the image to be graced with the pixel at (x,y)
-   * \param x X position of the Pixel
-   * \param y Y position of the Pixel
-   */
-  void updatePixel(Optional<OutputComponent *> memoryAccess,
-                   std::shared_ptr<QImage> image,
-                   size_t x,
-                   size_t y);
-  /**
-   * \brief updates the color from the color Table at the index index
-   * \param memoryAccess source to load the data from
-   * \param image Image whichs color table at entry index should be updated
-   * \param index index of the entry in the color Table
-   */
-  void updateColor(Optional<OutputComponent *> memoryAccess,
-                   std::shared_ptr<QImage> image,
-                   size_t index);
-  /**
-   * \brief updates all pixels of the image
-   * \param memoryAccess source to load the data from
-   * \param image Image to be be updated
+   * \brief fetches whatever the given change in memory modified in the image,
+   *        runs on the project thread
+   * \param transaction source to load the data from
+   * \param frame the frame to be filled in
    * \param address begin address in the memory that has changed
    * \param amount length of the area that has changed memory cells in it
    */
-  void updateMemory(Optional<OutputComponent *> memoryAccess,
-                    std::shared_ptr<QImage> image,
+  void updateMemory(Transaction &transaction,
+                    ColorMode::Frame &frame,
                     size_t address,
                     size_t amount);
   /**
-   * \brief updates all pixels of the image
-   * \param memoryAccess source to load the data from
+   * \brief fetches all pixels of the image, runs on the project thread
+   * \param transaction source to load the data from
+   * \param frame the frame to be filled in
+   */
+  void updateAllPixels(Transaction &transaction, ColorMode::Frame &frame);
+  /**
+   * \brief fetches all colors of the image, runs on the project thread
+   * \param transaction source to load the data from
+   * \param frame the frame to be filled in
+   */
+  void updateAllColors(Transaction &transaction, ColorMode::Frame &frame);
+  /**
+   * \brief draws a fetched frame into the image, runs on the gui thread
+   * \param frame the fetched frame
    * \param image Image to be be updated
    */
-  void updateAllPixels(Optional<OutputComponent *> memoryAccess,
-                       std::shared_ptr<QImage> image);
+  void draw(const ColorMode::Frame &frame, QImage &image);
   /**
-   * \brief updates all colors of the image
-   * \param memoryAccess source to load the data from
+   * \brief redraws the rows of the image which changed in the last frame
+   *        consumed from a channel mirroring the pixel buffer
+   * \param channel channel holding the whole pixel buffer
    * \param image Image to be be updated
    */
-  void updateAllColors(Optional<OutputComponent *> memoryAccess,
-                       std::shared_ptr<QImage> image);
+  void updateFromFramebuffer(const FramebufferChannel &channel,
+                             std::shared_ptr<QImage> image);
 
   /**
    * checks whether there may occure some errors in drawing
-   * \param memoryAccess source to load the data from
+   * \param memorySize size of the memory in cells
    */
-  void checkErrors(Optional<OutputComponent *> memoryAccess);
+  void checkErrors(size_t memorySize);
 
   /**
    * \brief sets the error with the index index to true
@@ -188,6 +164,12 @@ struct Options {
    */
   void setError(size_t index);
 
+  /**
+   * \brief sets all errors which are set in other
+   * \param other options whose errors are to be taken over
+   */
+  void mergeErrors(const Options &other);
+
   /**
    * \brief Handles all errors and resets the error vector
    */
@@ -25,12 +25,15 @@
 #include <QQuickPaintedItem>
 #include <QString>
 #include <cstdint>
+#include <functional>
 #include <memory>
 
 #include "common/optional.hpp"
 #include "ui/pixel-display-options.hpp"
 
+class FramebufferChannel;
 class OutputComponent;
+class Transaction;
 
 class PixelDisplayPaintedItem : public QQuickPaintedItem {
   Q_OBJECT
@@ -309,6 +312,9 @@ class PixelDisplayPaintedItem : public QQuickPaintedItem {
   void doUpdate();
 
  private:
+  using FetchFunction = std::function<void(
+      colormode::Options &, Transaction &, colormode::ColorMode::Frame &)>;
+
   /**
    * gives the index of a given name of a colorMode
    * \param colorMode Name of the colorMode
@@ -321,6 +327,26 @@ class PixelDisplayPaintedItem : public QQuickPaintedItem {
    */
   static QString colorModeToString(size_t colorMode);
 
+  /**
+   * mirrors the pixel buffer into a FramebufferChannel if it is at a fixed
+   * address, so that paint can read it without going through the project
+   */
+  void remapFramebuffer();
+
+  /**
+   * redraws all pixels and/or all colors, see requestFrame
+   * \param pixels whether the pixels are to be redrawn
+   * \param colors whether the colors are to be redrawn
+   */
+  void redraw(bool pixels, bool colors);
+
+  /**
+   * fetches what a redraw needs from memory in one transaction on the project
+   * thread, without blocking, and draws it once it arrives
+   * \param fetch fills in the frame, given a copy of the options
+   */
+  void requestFrame(const FetchFunction &fetch);
+
   /**
    * calls the appropiate error related signal
    * \param resolved activates the resolved signal
@@ -335,6 +361,10 @@ class PixelDisplayPaintedItem : public QQuickPaintedItem {
   colormode::Options _options;
   /** pointer to the OutputComponent used to get the memoryAccess */
   Optional<OutputComponent *> _outputComponentPointer;
+  /** channel mirroring the pixel buffer, if it is mapped */
+  std::shared_ptr<FramebufferChannel> _framebuffer;
+  /** counts the requests for a channel, only the latest one is used */
+  std::size_t _framebufferRequest = 0;
 };
 
 #endif  // ERAGPSIM_UI_PIXEL_DISPLAY_PAINTED_ITEM_HPP
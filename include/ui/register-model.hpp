@@ -22,11 +22,15 @@
 #include <QAbstractItemModel>
 #include <QQmlContext>
 #include <map>
+#include <memory>
+#include <set>
 #include <string>
+#include <unordered_map>
 
 #include "arch/common/register-information.hpp"
 #include "common/optional.hpp"
 #include "core/memory-access.hpp"
+#include "core/register-snapshot.hpp"
 
 class ArchitectureAccess;
 class MemoryManager;
@@ -42,8 +46,8 @@ class MemoryManager;
  * The RegisterModel only uses a single column containing the register itself.
  * Data that won't change over the lifetime of the model (e.g. register's title)
  * is stored locally within the model inside the RegisterInformation objects.
- * Dynamic data (i.e. register's content) is fetched from core when requested
- * (see data method).
+ * Dynamic data (i.e. register's content) is read from the newest snapshot the
+ * core published (see data method), so the model never waits for the core.
  *
  * Registers of all levels are being held inside the _items-pointer-map where
  * they are identified by a unique register identifier. These pointers are
@@ -179,9 +183,18 @@ class RegisterModel : public QAbstractItemModel {
   /// Map of all registers each identified by a unique register identifier.
   std::map<id_t, std::unique_ptr<RegisterInformation>> _items;
 
+  /// Registers by their name, to find the ones the core reports as changed.
+  std::unordered_map<std::string, RegisterInformation *> _itemsByName;
+
   /// Interface for communicating register data changes to core.
   MemoryAccess _memoryAccess;
 
+  /// The snapshots of all registers published by the core.
+  std::shared_ptr<RegisterSnapshotChannel> _registerSnapshots;
+
+  /// Registers that changed since the view was notified the last time.
+  std::set<id_t> _changedItems;
+
   /**
    * Returns the row of a given register relative
    * to its parent register.
@@ -201,6 +214,13 @@ class RegisterModel : public QAbstractItemModel {
    * \param registerContent The new register value.
    */
   void updateContent(const QString &registerTitle);
+
+ private slots:
+  /**
+   * Notifies the view about all registers that changed since the last call,
+   * with one signal for each parent register.
+   */
+  void _emitChanges();
 };
 
 #endif  // ERAGPSIM_UI_REGISTERMODEL_HPP
@@ -21,6 +21,8 @@
 #define INCLUDE_UI_EDITOR_SYNTAXHIGHLIGHTER_H
 
 #include <QSyntaxHighlighter>
+#include <QTextCharFormat>
+#include <map>
 #include <vector>
 
 #include "parser/common/syntax-information.hpp"
@@ -28,10 +30,12 @@
 
 class ParserInterface;
 class QQuickTextDocument;
-class QTextCharFormat;
 
 /**
  * An implementation of a syntax highlighter for qml.
+ *
+ * If the parser provides a lexer, every line is classified by it in a single
+ * pass. Otherwise all regexes of the parser are matched against every line.
  */
 class SyntaxHighlighter : public QSyntaxHighlighter {
   Q_OBJECT
@@ -102,8 +106,14 @@ class SyntaxHighlighter : public QSyntaxHighlighter {
    */
   void _addLabelRegexToSyntaxHighlighter(ParserInterface &parserInterface);
 
-  /** A list of all keywords to highlight. */
+  /** A list of all keywords to highlight, empty if the lexer is used. */
   std::vector<KeywordRule> _keywords;
+
+  /** The lexer of the parser, may be empty. */
+  SyntaxInformation::Lexer _lexer;
+
+  /** The format of every kind of token. */
+  std::map<SyntaxInformation::Token, QTextCharFormat> _formats;
 };
 
 #endif  // INCLUDE_UI_EDITOR_SYNTAXHIGHLIGHTER_H
@@ -28,6 +28,8 @@
 #include <QQuickItem>
 #include <QString>
 #include <QStringList>
+#include <atomic>
+#include <future>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -67,6 +69,12 @@ class Ui : public QObject {
    */
   Ui(int& argc, char** argv);
 
+  /**
+   * Stops brewing architectures in the background and waits for the formula
+   * that is currently brewed.
+   */
+  ~Ui();
+
   /**
    * Starts and runs the qml application
    *
@@ -155,6 +163,20 @@ class Ui : public QObject {
    */
   Q_INVOKABLE void runBreakpoint(id_t id);
 
+  /**
+   * Call stepBack on the specified project.
+   *
+   * \param id The id of the project.
+   */
+  Q_INVOKABLE void stepBack(id_t id);
+
+  /**
+   * Call stepBackToBreakpoint on the specified project.
+   *
+   * \param id The id of the project.
+   */
+  Q_INVOKABLE void stepBackToBreakpoint(id_t id);
+
   /**
    * Call stop on the specified project.
    *
@@ -255,6 +277,13 @@ class Ui : public QObject {
   /** loads the architectures and extensions from a json file. */
   void _loadArchitectures();
 
+  /**
+   * Creates the project templates of all architecture options in the
+   * background, so that opening the first project of an option does not have
+   * to brew its architecture.
+   */
+  void _prewarmArchitectures();
+
   /**
    * Returns a list of extensions to create a specific architecture version.
    *
@@ -348,6 +377,12 @@ class Ui : public QObject {
   /** A shared pointer to a config json object. */
   std::shared_ptr<SnapshotComponent> _snapshots;
 
+  /** Brews the architectures in the background, waited for on destruction. */
+  std::future<void> _prewarming;
+
+  /** Tells the background brewing to stop after the current formula. */
+  std::atomic<bool> _stopPrewarming{false};
+
   /** An id which is incremented for each project which is created. */
   static id_t _rollingProjectId;
 };
@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.*/
 
 #include <QtGlobal>
+#include <mutex>
 #include <string>
 
 #include "arch/common/abstract-register-node.hpp"
@@ -33,8 +34,15 @@ MemoryValue AbstractRegisterNode::getValue(MemoryAccess& memoryAccess) const {
   return memoryAccess.getRegisterValue(_name).get();
 }
 
+IntegerOperand
+AbstractRegisterNode::getOperand(MemoryAccess& memoryAccess) const {
+  _resolveID(memoryAccess);
+  return memoryAccess.getRegisterOperand(_id).get();
+}
+
 ValidationResult
 AbstractRegisterNode::validate(MemoryAccess& memoryAccess) const {
+  _resolveID(memoryAccess);
   // Registers can't have any children
   if (AbstractSyntaxTreeNode::_children.size() == 0) {
     return ValidationResult::success();
@@ -47,3 +55,9 @@ AbstractRegisterNode::validate(MemoryAccess& memoryAccess) const {
 const std::string& AbstractRegisterNode::getIdentifier() const {
   return _name;
 }
+
+void AbstractRegisterNode::_resolveID(MemoryAccess& memoryAccess) const {
+  std::call_once(_resolved, [this, &memoryAccess] {
+    _id = memoryAccess.getRegisterID(_name).get();
+  });
+}
@@ -21,6 +21,7 @@
 
 #include "arch/common/validation-result.hpp"
 #include "common/assert.hpp"
+#include "core/integer-operand.hpp"
 #include "core/memory-access.hpp"
 #include "core/memory-value.hpp"
 
@@ -33,6 +34,11 @@ operator()(MemoryAccess& memoryAccess) const {
   return getValue(memoryAccess);
 }
 
+IntegerOperand
+AbstractSyntaxTreeNode::getOperand(MemoryAccess& memoryAccess) const {
+  return IntegerOperand{getValue(memoryAccess)};
+}
+
 ValidationResult
 AbstractSyntaxTreeNode::validateRuntime(MemoryAccess& memoryAccess) const {
   return ValidationResult::success();
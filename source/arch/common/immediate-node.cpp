@@ -24,17 +24,22 @@
 const std::string ImmediateNode::IMMEDIATE_IDENTIFIER = "Imm";
 
 ImmediateNode::ImmediateNode(const MemoryValue& value)
-: AbstractSyntaxTreeNode(Type::IMMEDIATE), _value(value) {
+: AbstractSyntaxTreeNode(Type::IMMEDIATE), _value(value), _operand(value) {
 }
 
 void ImmediateNode::setValue(const MemoryValue& value) {
   _value = value;
+  _operand = IntegerOperand{value};
 }
 
 MemoryValue ImmediateNode::getValue(MemoryAccess& memoryAccess) const {
   return _value;
 }
 
+IntegerOperand ImmediateNode::getOperand(MemoryAccess& memoryAccess) const {
+  return _operand;
+}
+
 ValidationResult ImmediateNode::validate(MemoryAccess& memoryAccess) const {
   // Immediate values can't have any children
   return AbstractSyntaxTreeNode::_children.size() == 0
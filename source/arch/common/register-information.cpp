@@ -25,7 +25,7 @@
 #include "common/string-conversions.hpp"
 #include "common/utility.hpp"
 
-typename RegisterInformation::id_t RegisterInformation::_rollingID = 0;
+std::atomic<RegisterInformation::id_t> RegisterInformation::_rollingID{0};
 
 bool RegisterInformation::isSpecialType(Type type) noexcept {
   return type != Type::INTEGER && type != Type::FLOAT && type != Type::VECTOR;
@@ -282,6 +282,8 @@ void RegisterInformation::_parseType(InformationInterface::Format& data) {
     _type = Type::LINK;
   } else if (*type == "program-counter") {
     _type = Type::PROGRAM_COUNTER;
+  } else if (*type == "hart-id") {
+    _type = Type::HART_ID;
   } else {
     assert::that(false);
   }
@@ -15,6 +15,7 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.*/
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 
@@ -23,7 +24,6 @@
 #include "arch/riscv/properties.hpp"
 #include "arch/riscv/utility.hpp"
 #include "common/assert.hpp"
-#include "common/bit-builder.hpp"
 #include "common/utility.hpp"
 #include "core/memory-value.hpp"
 
@@ -59,17 +59,85 @@ MemoryValue assemble(const InstructionInformation& instructionInformation,
   return assembler(instructionInformation.getKey(), operands);
 }
 
+MemoryValue
+assemble(const InstructionTable::Entry& entry, const Operands& operands) {
+  using Detail::convert;
+  using Format = InstructionTable::InstructionFormat;
+
+  assert::that(isSupported(entry));
+
+  // Fields which are not part of the key are encoded as zero
+  const auto field = [](std::int32_t value) {
+    return value == InstructionTable::none ? 0 : unsigned32_t(value);
+  };
+
+  unsigned32_t bits = 0;
+  switch (entry.format) {
+    case Format::R:
+      bits = Encoding::R(field(entry.opcode),
+                         field(entry.funct3),
+                         field(entry.funct7),
+                         convert(operands[0]),
+                         convert(operands[1]),
+                         convert(operands[2]));
+      break;
+    case Format::I:
+      bits = Encoding::I(field(entry.opcode),
+                         field(entry.funct3),
+                         convert(operands[0]),
+                         convert(operands[1]),
+                         convert(operands[2]));
+      break;
+    case Format::S:
+      bits = Encoding::S(field(entry.opcode),
+                         field(entry.funct3),
+                         convert(operands[0]),
+                         convert(operands[1]),
+                         convert(operands[2]));
+      break;
+    case Format::SB:
+      bits = Encoding::SB(field(entry.opcode),
+                          field(entry.funct3),
+                          convert(operands[0]),
+                          convert(operands[1]),
+                          convert(operands[2]));
+      break;
+    case Format::U:
+      bits = Encoding::U(
+          field(entry.opcode), convert(operands[0]), convert(operands[1]));
+      break;
+    case Format::UJ:
+      bits = Encoding::UJ(
+          field(entry.opcode), convert(operands[0]), convert(operands[1]));
+      break;
+    default: assert::that(false);
+  }
+
+  return riscv::convert(bits, 32);
+}
+
+bool isSupported(const InstructionTable::Entry& entry) noexcept {
+  using Format = InstructionTable::InstructionFormat;
+  switch (entry.format) {
+    case Format::R:
+    case Format::I:
+    case Format::S:
+    case Format::SB:
+    case Format::U:
+    case Format::UJ: return true;
+    default: return false;
+  }
+}
+
 MemoryValue R(const InstructionKey& key, const Operands& operands) {
   using Detail::convert;
 
-  auto bits = BitBuilder<riscv::unsigned32_t>()
-                  .addUpTo(key["opcode"], 6)
-                  .addUpTo(convert(operands[0]), 4)
-                  .addUpTo(key["funct3"], 2)
-                  .addUpTo(convert(operands[1]), 4)
-                  .addUpTo(convert(operands[2]), 4)
-                  .addUpTo(key["funct7"], 6)
-                  .build();
+  auto bits = Encoding::R(key["opcode"],
+                          key["funct3"],
+                          key["funct7"],
+                          convert(operands[0]),
+                          convert(operands[1]),
+                          convert(operands[2]));
 
   return riscv::convert(bits, 32);
 }
@@ -77,13 +145,11 @@ MemoryValue R(const InstructionKey& key, const Operands& operands) {
 MemoryValue I(const InstructionKey& key, const Operands& operands) {
   using Detail::convert;
 
-  auto bits = BitBuilder<riscv::unsigned32_t>()
-                  .addUpTo(key["opcode"], 6)
-                  .addUpTo(convert(operands[0]), 4)
-                  .addUpTo(key["funct3"], 2)
-                  .addUpTo(convert(operands[1]), 4)
-                  .addUpTo(convert(operands[2]), 11)
-                  .build();
+  auto bits = Encoding::I(key["opcode"],
+                          key["funct3"],
+                          convert(operands[0]),
+                          convert(operands[1]),
+                          convert(operands[2]));
 
   return riscv::convert(bits, 32);
 }
@@ -91,16 +157,11 @@ MemoryValue I(const InstructionKey& key, const Operands& operands) {
 MemoryValue S(const InstructionKey& key, const Operands& operands) {
   using Detail::convert;
 
-  const auto immediate = convert(operands[2]);
-
-  auto bits = BitBuilder<riscv::unsigned32_t>()
-                  .addUpTo(key["opcode"], 6)
-                  .addUpTo(immediate, 4)
-                  .addUpTo(key["funct3"], 2)
-                  .addUpTo(convert(operands[0]), 4)
-                  .addUpTo(convert(operands[1]), 4)
-                  .addRange(immediate, 5, 11)
-                  .build();
+  auto bits = Encoding::S(key["opcode"],
+                          key["funct3"],
+                          convert(operands[0]),
+                          convert(operands[1]),
+                          convert(operands[2]));
 
   return riscv::convert(bits, 32);
 }
@@ -108,18 +169,11 @@ MemoryValue S(const InstructionKey& key, const Operands& operands) {
 MemoryValue SB(const InstructionKey& key, const Operands& operands) {
   using Detail::convert;
 
-  const auto immediate = convert(operands[2]);
-
-  auto bits = BitBuilder<riscv::unsigned32_t>()
-                  .addUpTo(key["opcode"], 6)
-                  .addBit(immediate, 10)
-                  .addRange(immediate, 0, 3)
-                  .addUpTo(key["funct3"], 2)
-                  .addUpTo(convert(operands[0]), 4)
-                  .addUpTo(convert(operands[1]), 4)
-                  .addRange(immediate, 4, 9)
-                  .addBit(immediate, 11)
-                  .build();
+  auto bits = Encoding::SB(key["opcode"],
+                           key["funct3"],
+                           convert(operands[0]),
+                           convert(operands[1]),
+                           convert(operands[2]));
 
   return riscv::convert(bits, 32);
 }
@@ -127,11 +181,8 @@ MemoryValue SB(const InstructionKey& key, const Operands& operands) {
 MemoryValue U(const InstructionKey& key, const Operands& operands) {
   using Detail::convert;
 
-  auto bits = BitBuilder<riscv::unsigned32_t>()
-                  .addUpTo(key["opcode"], 6)
-                  .addUpTo(convert(operands[0]), 4)
-                  .addUpTo(convert(operands[1]), 19)
-                  .build();
+  auto bits =
+      Encoding::U(key["opcode"], convert(operands[0]), convert(operands[1]));
 
   return riscv::convert(bits, 32);
 }
@@ -139,16 +190,8 @@ MemoryValue U(const InstructionKey& key, const Operands& operands) {
 MemoryValue UJ(const InstructionKey& key, const Operands& operands) {
   using Detail::convert;
 
-  const auto immediate = convert(operands[1]);
-
-  auto bits = BitBuilder<riscv::unsigned32_t>()
-                  .addUpTo(key["opcode"], 6)
-                  .addUpTo(convert(operands[0]), 4)
-                  .addRange(immediate, 11, 18)
-                  .addBit(immediate, 10)
-                  .addRange(immediate, 0, 9)
-                  .addBit(immediate, 19)
-                  .build();
+  auto bits =
+      Encoding::UJ(key["opcode"], convert(operands[0]), convert(operands[1]));
 
   return riscv::convert(bits, 32);
 }
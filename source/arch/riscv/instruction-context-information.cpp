@@ -16,6 +16,7 @@
 * along with this program. If not, see <http://www.gnu.org/licenses/>.*/
 
 #include <string>
+#include <utility>
 
 #include "arch/riscv/documentation-builder.hpp"
 #include "arch/riscv/instruction-context-information.hpp"
@@ -444,6 +445,14 @@ void InstructionContextInformation::_fill(const Architecture &architecture) {
                     RISCV_TR("register used as divisor"));
     }
   }
+
+  // A-Extension
+  if (architecture.getInstructions().hasInstruction("lr.w")) {
+    _atomicInstructions(".w", RISCV_TR("word"), 32);
+    if (_is64BitArchitecture) {
+      _atomicInstructions(".d", RISCV_TR("double-word"), 64);
+    }
+  }
 }
 
 void InstructionContextInformation::_arithmeticInstructionI(
@@ -583,6 +592,90 @@ void InstructionContextInformation::_storeInstruction(
   _add(mnemonic, builder.build());
 }
 
+void InstructionContextInformation::_atomicInstructions(
+    const std::string &suffix,
+    const std::string &sizeDescription,
+    size_t size) {
+  const auto address = RISCV_TR("A register holding the memory address, "
+                                "which must be aligned to the accessed size");
+
+  DocumentationBuilder loadReserved;
+  loadReserved.instruction("lr" + suffix);
+  loadReserved.shortSyntax({"rd", "address"})
+      .shortDescription("rd = [address]");
+  loadReserved
+      .operandDescription(
+          "rd", RISCV_TR("The register, the loaded value is stored to"))
+      .operandDescription("address", address);
+  auto loadDetail = std::make_shared<Translateable>(
+      RISCV_TR("Loads one %1(%2 bit) into the register rd, performing a sign "
+               "extension on the whole register if needed, and reserves the "
+               "memory for the hart. The reservation is lost as soon as the "
+               "memory is written by another instruction"));
+  loadDetail->addOperand(sizeDescription);
+  loadDetail->addOperand(std::to_string(size));
+  loadReserved.detailDescription(loadDetail);
+  _add("lr" + suffix, loadReserved.build());
+
+  DocumentationBuilder storeConditional;
+  storeConditional.instruction("sc" + suffix);
+  storeConditional.shortSyntax({"rd", "source", "address"})
+      .shortDescription("[address] = source");
+  storeConditional
+      .operandDescription("rd",
+                          RISCV_TR("The register, zero is stored to if the "
+                                   "store succeeded, one otherwise"))
+      .operandDescription("source",
+                          RISCV_TR("The register whose value will be stored"))
+      .operandDescription("address", address);
+  auto storeDetail = std::make_shared<Translateable>(
+      RISCV_TR("Stores a %1 from the source register (using bit 0 to %2), if "
+               "the hart still holds the reservation of a preceding lr%3 on "
+               "the same address. The reservation is released in any case"));
+  storeDetail->addOperand(sizeDescription);
+  storeDetail->addOperand(std::to_string(size - 1));
+  storeDetail->addOperand(suffix);
+  storeConditional.detailDescription(storeDetail);
+  _add("sc" + suffix, storeConditional.build());
+
+  // clang-format off
+  const std::pair<std::string, std::string> operations[] = {
+    {"amoswap", RISCV_TR("source")},
+    {"amoadd", RISCV_TR("the sum of both values")},
+    {"amoxor", RISCV_TR("the bitwise xor of both values")},
+    {"amoand", RISCV_TR("the bitwise and of both values")},
+    {"amoor", RISCV_TR("the bitwise or of both values")},
+    {"amomin", RISCV_TR("the signed minimum of both values")},
+    {"amomax", RISCV_TR("the signed maximum of both values")},
+    {"amominu", RISCV_TR("the unsigned minimum of both values")},
+    {"amomaxu", RISCV_TR("the unsigned maximum of both values")}
+  };
+  // clang-format on
+
+  for (const auto &operation : operations) {
+    DocumentationBuilder builder;
+    builder.instruction(operation.first + suffix);
+    builder.shortSyntax({"rd", "source", "address"})
+        .shortDescription("rd = [address], [address] = f([address], source)");
+    builder
+        .operandDescription(
+            "rd", RISCV_TR("The register, the loaded value is stored to"))
+        .operandDescription(
+            "source", RISCV_TR("The register combined with the loaded value"))
+        .operandDescription("address", address);
+    auto detail = std::make_shared<Translateable>(
+        RISCV_TR("Atomically loads one %1(%2 bit) into the register rd, "
+                 "performing a sign extension on the whole register if "
+                 "needed, and stores %3 in its place. No other hart can "
+                 "access the memory in between"));
+    detail->addOperand(sizeDescription);
+    detail->addOperand(std::to_string(size));
+    detail->addOperand(operation.second);
+    builder.detailDescription(detail);
+    _add(operation.first + suffix, builder.build());
+  }
+}
+
 void InstructionContextInformation::_branchInstruction(
     const std::string &mnemonic,
     const std::string &condition,
@@ -15,10 +15,13 @@
  * You should have received a copy of the GNU General Public License
 * along with this program. If not, see <http://www.gnu.org/licenses/>.*/
 
+#include <cstddef>
 #include <string>
+#include <utility>
 
 #include "arch/common/architecture.hpp"
 #include "arch/riscv/architecture-only-instructions.hpp"
+#include "arch/riscv/atomic-instructions.hpp"
 #include "arch/riscv/instruction-node-factory.hpp"
 #include "arch/riscv/instruction-node.hpp"
 #include "arch/riscv/integer-instructions.hpp"
@@ -201,6 +204,59 @@ void _addExtensionMIfPresent(const InstructionSet& instructionSet,
   }
 }
 
+/**
+ * Sets up the instructions of the "A" extension.
+ *
+ * The doubleword variants are only added for 64 bit architectures.
+ *
+ * \tparam UnsignedWord An unsigned word type.
+ * \tparam SignedWord A signed word type.
+ */
+template <typename UnsignedWord, typename SignedWord>
+void _setupExtensionA(FactoryMap& _factories) {
+  using Operation = typename AtomicMemoryOperationInstructionNode<
+      UnsignedWord,
+      SignedWord>::Operation;
+  auto facade = _factories.typeFacade<UnsignedWord, SignedWord>();
+
+  auto addWidth = [&facade](const std::string& suffix, std::size_t bytes) {
+    facade.template add<LoadReservedInstructionNode>("lr" + suffix, bytes);
+    facade.template add<StoreConditionalInstructionNode>("sc" + suffix, bytes);
+
+    // clang-format off
+    const std::pair<std::string, Operation> operations[] = {
+      {"amoswap", Operation::SWAP},
+      {"amoadd", Operation::ADD},
+      {"amoxor", Operation::XOR},
+      {"amoand", Operation::AND},
+      {"amoor", Operation::OR},
+      {"amomin", Operation::MIN},
+      {"amomax", Operation::MAX},
+      {"amominu", Operation::MIN_UNSIGNED},
+      {"amomaxu", Operation::MAX_UNSIGNED}
+    };
+    // clang-format on
+
+    for (const auto& operation : operations) {
+      facade.template add<AtomicMemoryOperationInstructionNode>(
+          operation.first + suffix, bytes, operation.second);
+    }
+  };
+
+  addWidth(".w", 4);
+  if (sizeof(UnsignedWord) * CHAR_BIT == 64) {
+    addWidth(".d", 8);
+  }
+}
+
+template <typename UnsignedWord, typename SignedWord>
+void _addExtensionAIfPresent(const InstructionSet& instructionSet,
+                             FactoryMap& _factories) {
+  if (instructionSet.hasInstruction("lr.w")) {
+    _setupExtensionA<UnsignedWord, SignedWord>(_factories);
+  }
+}
+
 /**
  * Struct that returns the incremented program counter
  */
@@ -232,6 +288,8 @@ InstructionNodeFactory::InstructionNodeFactory(
     _setupLuiAuipcInstructions<riscv::unsigned32_t>(_factories);
     _addExtensionMIfPresent<riscv::unsigned32_t, riscv::signed32_t>(
         instructions, _factories);
+    _addExtensionAIfPresent<riscv::unsigned32_t, riscv::signed32_t>(
+        instructions, _factories);
 
   } else if (wordSize == 64) {
     _setupIntegerInstructions<riscv::unsigned64_t, riscv::signed64_t>(
@@ -244,6 +302,8 @@ InstructionNodeFactory::InstructionNodeFactory(
     _setupLuiAuipcInstructions<riscv::unsigned64_t>(_factories);
     _addExtensionMIfPresent<riscv::unsigned64_t, riscv::signed64_t>(
         instructions, _factories);
+    _addExtensionAIfPresent<riscv::unsigned64_t, riscv::signed64_t>(
+        instructions, _factories);
     _setup64BitOnlyInstructions();
   }
 
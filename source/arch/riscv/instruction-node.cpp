@@ -22,12 +22,17 @@
 #include "arch/common/instruction-key.hpp"
 #include "arch/riscv/format.hpp"
 #include "arch/riscv/instruction-node.hpp"
+#include "arch/riscv/instruction-table.hpp"
 #include "common/assert.hpp"
 
 namespace riscv {
 
 InstructionNode::InstructionNode(const InstructionInformation& information)
-: super(information) {
+: super(information), _tableID(InstructionTable::find(information)) {
+  if (_tableID != InstructionTable::invalidID &&
+      !Format::isSupported(InstructionTable::get(_tableID))) {
+    _tableID = InstructionTable::invalidID;
+  }
 }
 
 bool InstructionNode::_requireChildren(Type type,
@@ -63,6 +68,14 @@ MemoryValue InstructionNode::assemble() const {
     operands.emplace_back(child->assemble());
   }
 
+  return _assemble(operands);
+}
+
+MemoryValue InstructionNode::_assemble(const Format::Operands& operands) const {
+  if (_tableID != InstructionTable::invalidID) {
+    return Format::assemble(InstructionTable::get(_tableID), operands);
+  }
+
   return Format::assemble(_information, operands);
 }
 
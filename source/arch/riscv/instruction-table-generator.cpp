@@ -0,0 +1,165 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Build step which turns the RISC-V ISA description into the constexpr
+ * instruction table included by arch/riscv/instruction-table.hpp.
+ *
+ * Usage: era-sim-riscv-table-generator <output> <config.json>...
+ *
+ * This is a standalone program, it must not depend on the simulator libraries
+ * (they need the generated table).
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "third-party/json/json.hpp"
+
+namespace {
+
+using Json = nlohmann::json;
+
+/** The key fields in the order of InstructionTable::Entry. */
+const std::vector<std::string> keyFields = {
+    "opcode", "funct3", "funct7", "funct2", "rs1", "rs2"};
+
+struct Row {
+  std::string mnemonic;
+  std::string extension;
+  std::string format;
+  std::vector<std::int64_t> key;
+  std::size_t length;
+};
+
+std::string toFormatEnumerator(const std::string& format) {
+  if (format == "custom") return "CUSTOM";
+  return format;
+}
+
+void readConfig(const std::string& path, std::vector<Row>& rows) {
+  std::ifstream stream(path);
+  if (!stream) {
+    throw std::runtime_error("Could not open " + path);
+  }
+  Json config;
+  stream >> config;
+
+  const auto extension = config.at("name").get<std::string>();
+  if (config.find("instructions") == config.end()) return;
+
+  for (const auto& instruction : config.at("instructions")) {
+    Row row;
+    row.mnemonic = instruction.at("mnemonic").get<std::string>();
+    std::transform(row.mnemonic.begin(),
+                   row.mnemonic.end(),
+                   row.mnemonic.begin(),
+                   ::tolower);
+    row.extension = extension;
+    row.format = instruction.at("format").get<std::string>();
+    row.length = instruction.at("length").get<std::size_t>();
+
+    const auto& key = instruction.at("key");
+    for (const auto& field : keyFields) {
+      auto value = key.find(field);
+      // negative values (custom instructions) are not part of the encoding
+      if (value == key.end() || value->get<std::int64_t>() < 0) {
+        row.key.push_back(-1);
+      } else {
+        row.key.push_back(value->get<std::int64_t>());
+      }
+    }
+    rows.push_back(row);
+  }
+}
+
+std::string generate(std::vector<Row> rows) {
+  std::sort(rows.begin(), rows.end(), [](const Row& first, const Row& second) {
+    return std::tie(first.mnemonic, first.extension) <
+           std::tie(second.mnemonic, second.extension);
+  });
+
+  std::ostringstream output;
+  output << "// Generated by era-sim-riscv-table-generator from the RISC-V "
+         << "ISA\n// description. Do not edit, changes will be overwritten.\n\n"
+         << "#ifndef ERAGPSIM_ARCH_RISCV_INSTRUCTION_TABLE_DATA_HPP\n"
+         << "#define ERAGPSIM_ARCH_RISCV_INSTRUCTION_TABLE_DATA_HPP\n\n"
+         << "namespace riscv {\n"
+         << "namespace InstructionTable {\n\n"
+         << "constexpr std::size_t size = " << rows.size() << ";\n\n"
+         << "// clang-format off\n"
+         << "constexpr Entry entries[size + 1] = {\n";
+  for (const auto& row : rows) {
+    output << "  {\"" << row.mnemonic << "\", \"" << row.extension
+           << "\", InstructionFormat::" << toFormatEnumerator(row.format);
+    for (auto field : row.key) {
+      output << ", " << field;
+    }
+    output << ", " << row.length << "},\n";
+  }
+  // sentinel, so that the array is never empty
+  output << "  {\"\", \"\", InstructionFormat::CUSTOM, -1, -1, -1, -1, -1, -1, "
+            "0}\n"
+         << "};\n"
+         << "// clang-format on\n\n"
+         << "}\n"
+         << "}\n\n"
+         << "#endif /* ERAGPSIM_ARCH_RISCV_INSTRUCTION_TABLE_DATA_HPP */\n";
+
+  return output.str();
+}
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 3) {
+    std::cerr << "Usage: " << argv[0] << " <output> <config.json>..."
+              << std::endl;
+    return 1;
+  }
+
+  std::vector<Row> rows;
+  try {
+    for (int index = 2; index < argc; ++index) {
+      readConfig(argv[index], rows);
+    }
+  } catch (const std::exception& exception) {
+    std::cerr << exception.what() << std::endl;
+    return 1;
+  }
+
+  auto table = generate(rows);
+
+  // only touch the output if it changed, to avoid needless rebuilds
+  std::ifstream existing(argv[1]);
+  std::stringstream existingContent;
+  existingContent << existing.rdbuf();
+  if (existing && existingContent.str() == table) return 0;
+
+  std::ofstream output(argv[1]);
+  output << table;
+  return output ? 0 : 1;
+}
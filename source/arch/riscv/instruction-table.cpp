@@ -0,0 +1,75 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "arch/riscv/instruction-table.hpp"
+
+#include <string>
+
+#include "arch/common/instruction-information.hpp"
+#include "arch/common/instruction-key.hpp"
+
+namespace riscv {
+namespace InstructionTable {
+namespace {
+
+InstructionFormat toFormat(const std::string& format) {
+  if (format == "R") return InstructionFormat::R;
+  if (format == "R4") return InstructionFormat::R4;
+  if (format == "I") return InstructionFormat::I;
+  if (format == "S") return InstructionFormat::S;
+  if (format == "SB") return InstructionFormat::SB;
+  if (format == "U") return InstructionFormat::U;
+  if (format == "UJ") return InstructionFormat::UJ;
+  return InstructionFormat::CUSTOM;
+}
+
+bool matches(const InstructionKey& key, const char* name, std::int32_t field) {
+  if (field == none) return true;
+  return key.hasKey(name) && key[name] == static_cast<std::size_t>(field);
+}
+
+bool matches(const Entry& entry, const InstructionInformation& information) {
+  if (entry.format != toFormat(information.getFormat())) return false;
+  const auto& key = information.getKey();
+  // clang-format off
+  return matches(key, "opcode", entry.opcode) &&
+         matches(key, "funct3", entry.funct3) &&
+         matches(key, "funct7", entry.funct7) &&
+         matches(key, "funct2", entry.funct2) &&
+         matches(key, "rs1", entry.rs1) &&
+         matches(key, "rs2", entry.rs2);
+  // clang-format on
+}
+}
+
+std::size_t find(const InstructionInformation& information) {
+  if (!information.hasMnemonic() || !information.hasKey() ||
+      !information.hasFormat()) {
+    return invalidID;
+  }
+  const auto& mnemonic = information.getMnemonic();
+  for (auto id = find(mnemonic.c_str());
+       id < size && mnemonic == entries[id].mnemonic;
+       ++id) {
+    if (matches(entries[id], information)) return id;
+  }
+  return invalidID;
+}
+}
+}
@@ -19,12 +19,15 @@
 
 #include "common/string-conversions.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cctype>
 #include <cstdint>
-#include <iomanip>
-#include <sstream>
+#include <cstring>
 #include <string>
 #include <vector>
 
+#include "common/assert.hpp"
 #include "core/conversions.hpp"
 
 namespace StringConversions {
@@ -39,47 +42,158 @@ template <typename T>
 std::string _toDecString(T value) {
   return std::to_string(value);
 }
+
+/** The hex digit of every nibble. */
+const char _hexDigits[] = "0123456789abcdef";
+
+/**
+ * \brief _binaryDigits Returns the eight binary digits of every byte, most
+ * significant bit first.
+ * \return A table indexed by the byte value.
+ */
+const std::array<std::array<char, 8>, 256>& _binaryDigits() {
+  static const auto table = [] {
+    std::array<std::array<char, 8>, 256> result;
+    for (std::size_t byte = 0; byte < result.size(); ++byte) {
+      for (std::size_t bit = 0; bit < 8; ++bit) {
+        result[byte][7 - bit] = ((byte >> bit) & 1) ? '1' : '0';
+      }
+    }
+    return result;
+  }();
+  return table;
+}
+
+/**
+ * \brief _hexDigitValue Looks up the value of a hex digit.
+ * \param digit The character to look up.
+ * \return The value of the digit or -1, if it is no hex digit.
+ */
+int _hexDigitValue(char digit) {
+  static const auto table = [] {
+    std::array<std::int8_t, 256> result;
+    result.fill(-1);
+    for (int value = 0; value < 16; ++value) {
+      result[static_cast<unsigned char>(_hexDigits[value])] = value;
+      result[static_cast<unsigned char>(std::toupper(_hexDigits[value]))] =
+          value;
+    }
+    return result;
+  }();
+  return table[static_cast<unsigned char>(digit)];
+}
+
+/**
+ * \brief _bitsAt Reads up to eight bits at an arbitrary bit address.
+ * \param bytes The internal representation of a memory value.
+ * \param bit The address of the lowest bit to read.
+ * \param count The number of bits to read, at most eight.
+ * \return The bits, aligned to the least significant bit.
+ */
+unsigned _bitsAt(const MemoryValue::Underlying& bytes,
+                 std::size_t bit,
+                 std::size_t count) {
+  unsigned value = bytes[bit / 8] >> (bit % 8);
+  if (bit % 8 + count > 8) {
+    value |= static_cast<unsigned>(bytes[bit / 8 + 1]) << (8 - bit % 8);
+  }
+  return value & ((1u << count) - 1);
+}
+
+/**
+ * \brief _writeBinDigits Writes the binary digits of a range of bits, most
+ * significant bit first. Whole bytes are copied from a table, only the bits
+ * of bytes that are covered partly are converted one by one.
+ * \param bytes The internal representation of a memory value.
+ * \param begin The address of the lowest bit of the range.
+ * \param end The address behind the highest bit of the range.
+ * \param destination Where to write the end - begin digits to.
+ */
+void _writeBinDigits(const MemoryValue::Underlying& bytes,
+                     std::size_t begin,
+                     std::size_t end,
+                     char* destination) {
+  const auto& table = _binaryDigits();
+  for (auto bit = end; bit > begin;) {
+    if (bit % 8 == 0 && bit - begin >= 8) {
+      bit -= 8;
+      std::memcpy(destination, table[bytes[bit / 8]].data(), 8);
+      destination += 8;
+    } else {
+      --bit;
+      *destination++ = ((bytes[bit / 8] >> (bit % 8)) & 1) ? '1' : '0';
+    }
+  }
+}
+
+/**
+ * \brief _writeHexDigits Writes the hex digits of a range of bits, most
+ * significant digit first. The topmost digit covers the remaining bits, if
+ * the range is not a multiple of four bits long.
+ * \param bytes The internal representation of a memory value.
+ * \param begin The address of the lowest bit of the range.
+ * \param end The address behind the highest bit of the range.
+ * \param destination Where to write the digits to.
+ */
+void _writeHexDigits(const MemoryValue::Underlying& bytes,
+                     std::size_t begin,
+                     std::size_t end,
+                     char* destination) {
+  for (auto digit = (end - begin + 3) / 4; digit-- > 0;) {
+    auto bit = begin + digit * 4;
+    auto nibble = _bitsAt(bytes, bit, std::min<std::size_t>(4, end - bit));
+    *destination++ = _hexDigits[nibble];
+  }
+}
 }  // anonymous namespace
 
 
 std::string toBinString(const MemoryValue& memoryValue) {
-  std::string result;
-  result.reserve(memoryValue.getSize());
-  // Iterate over each bit of the memory value and insert the corresponding
-  // binary digit.
-  for (std::size_t currentBitAddress = 0;
-       currentBitAddress < memoryValue.getSize();
-       ++currentBitAddress) {
-    auto address = memoryValue.getSize() - 1 - currentBitAddress;
-    bool currentBitValue = memoryValue.get(address);
-    result.push_back(currentBitValue ? '1' : '0');
+  std::string result(memoryValue.getSize(), '0');
+  if (!result.empty()) {
+    _writeBinDigits(memoryValue.internal(), 0, result.size(), &result[0]);
   }
-
   return result;
 }
 
 
 std::string toHexString(const MemoryValue& memoryValue) {
-  const auto& internal = memoryValue.internal();
-  std::stringstream stream;
-
-  // Iterate over the 8bit-values of the internal representation to convert each
-  // into hex-values.
-  // In order to be able to conveniently push the hex-digits into the stream,
-  // the internal representation is iterated in reverse, starting with the most
-  // significant bit.
-  for (auto it = internal.rbegin(); it != internal.rend(); ++it) {
-    // The current 8bit-value.
-    std::uint8_t currentValue = *it;
-    // Convert the current 8bit-value into hex (= two digits) and push it into
-    // the stream, inserting leading zeros where required.
-    stream << std::setfill('0') << std::setw(sizeof(uint8_t) * 2) << std::hex
-           << static_cast<int>(currentValue);
+  std::string result((memoryValue.getSize() + 3) / 4, '0');
+  if (!result.empty()) {
+    _writeHexDigits(
+        memoryValue.internal(), 0, memoryValue.getSize(), &result[0]);
+  }
+  return result;
+}
+
+
+std::vector<std::string>
+toBinStrings(const MemoryValue& memoryValue, std::size_t cellSize) {
+  assert::that(cellSize > 0);
+  assert::that(memoryValue.getSize() % cellSize == 0);
+  const auto& bytes = memoryValue.internal();
+  std::vector<std::string> result(memoryValue.getSize() / cellSize,
+                                  std::string(cellSize, '0'));
+  for (std::size_t cell = 0; cell < result.size(); ++cell) {
+    auto begin = cell * cellSize;
+    _writeBinDigits(bytes, begin, begin + cellSize, &result[cell][0]);
   }
-  auto result = stream.str();
+  return result;
+}
 
-  // Remove leading digits that exceed the memory value's specified bit-size.
-  return result.substr((result.length() * 4 - memoryValue.getSize()) / 4);
+
+std::vector<std::string>
+toHexStrings(const MemoryValue& memoryValue, std::size_t cellSize) {
+  assert::that(cellSize > 0);
+  assert::that(memoryValue.getSize() % cellSize == 0);
+  const auto& bytes = memoryValue.internal();
+  std::vector<std::string> result(memoryValue.getSize() / cellSize,
+                                  std::string((cellSize + 3) / 4, '0'));
+  for (std::size_t cell = 0; cell < result.size(); ++cell) {
+    auto begin = cell * cellSize;
+    _writeHexDigits(bytes, begin, begin + cellSize, &result[cell][0]);
+  }
+  return result;
 }
 
 
@@ -113,14 +227,19 @@ binStringToMemoryValue(std::string stringValue, size_t memoryValueSize) {
   for (size_t index = stringValue.length();; index -= 8) {
     size_t startPos = (index >= 8) ? index - 8 : 0;
     size_t length = (index >= 8) ? 8 : index;
-    // Try to parse the string-byte to an 8bit-integer value.
-    uint8_t currentValue;
-    try {
-      currentValue =
-          std::stoi(stringValue.substr(startPos, length), nullptr, 2);
-    } catch (const std::invalid_argument& e) {
+    // Parse the string-byte to an 8bit-integer value, an empty string is no
+    // valid binary number either.
+    if (length == 0) {
       return Optional<MemoryValue>();
     }
+    uint8_t currentValue = 0;
+    for (size_t position = startPos; position < startPos + length; ++position) {
+      auto digit = stringValue[position];
+      if (digit != '0' && digit != '1') {
+        return Optional<MemoryValue>();
+      }
+      currentValue = (currentValue << 1) | (digit - '0');
+    }
 
     resultingInternal.push_back(currentValue);
 
@@ -151,28 +270,23 @@ hexStringToMemoryValue(std::string stringValue, size_t memoryValueSize) {
   }
 
   std::vector<uint8_t> resultingInternal;
+  resultingInternal.reserve((memoryValueSize + 7) / 8);
   // Iterate over the input string in 8bit-steps (= 2 hex digits), starting with
   // the least significant bit.
   for (auto it = stringValue.rbegin(); it < stringValue.rend(); ++it) {
-    // Initializes the string representing the current 8bit with the first 4bit
-    // directly behind the iterator.
-    std::string currentValueString(1, *it);
-
-    // If another 4 bit following the first 4 bit are available, add them as
-    // well.
+    // The first 4bit directly behind the iterator and, if available, the 4 bit
+    // following them.
+    int lower = _hexDigitValue(*it);
+    int upper = 0;
     if ((it + 1) != stringValue.rend()) {
-      currentValueString = *(it + 1) + currentValueString;
       ++it;
+      upper = _hexDigitValue(*it);
     }
 
-    // currentValueString has a maximum of two hex digits which results in a
-    // 8bit-integer.
-    uint8_t currentValue;
-    try {
-      currentValue = std::stoi(currentValueString, nullptr, 16);
-    } catch (const std::invalid_argument& e) {
+    if (lower < 0 || upper < 0) {
       return Optional<MemoryValue>();
     }
+    uint8_t currentValue = (upper << 4) | lower;
 
     resultingInternal.push_back(currentValue);
     // Stop iterating when pushing the next internal value would result in the
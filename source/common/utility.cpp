@@ -31,32 +31,20 @@ namespace Utility {
 namespace Detail {
 bool performSignedBitWidthCheck(const MemoryValue& memory,
                                 std::size_t numberOfBits) {
-  // Get the sign bit
-  bool sign = memory.get(memory.getSize() - 1);
-
   // When the value is signed, all bits after the sign bit should be
   // equal to the sign bit. That is, for unsigned values all bits after
   // the sign bit should be zero and for signed values all should be one.
-  // As such, we will start checking the bits at the sign bit of the immediate
-  // (i.e. where we want the sign bit to be) and move up to one bit before the
-  // sign bit of the memory value.
-  auto range = Utility::range(numberOfBits - 1, memory.getSize() - 1);
-
-  // clang-format off
-  return Utility::anyOf(range, [&memory, sign] (auto index) {
-    return memory[index] != sign;
-  });
-  // clang-format on
+  // As such, the leading run of copies of the sign bit has to reach down to
+  // where we want the sign bit of the immediate to be.
+  bool sign = memory.back();
+  auto leading = sign ? memory.countLeadingOnes() : memory.countLeadingZeros();
+  return leading < memory.getSize() - numberOfBits + 1;
 }
 
 bool performUnsignedBitWidthCheck(const MemoryValue& memory,
                                   std::size_t numberOfBits) {
-  // clang-format off
-  auto range = Utility::range(numberOfBits, memory.getSize());
-  return Utility::anyOf(range, [&memory](auto index) {
-    return memory[index] == 1;
-  });
-  // clang-format on
+  // No bit at or above numberOfBits may be set.
+  return memory.countLeadingZeros() < memory.getSize() - numberOfBits;
 }
 }
 
@@ -107,7 +95,7 @@ std::string joinPaths(const std::string& single) {
 
 std::string loadFromFile(const std::string& filePath) {
   std::string input;
-  std::ifstream file(filePath);
+  std::ifstream file(filePath, std::ios::binary);
   file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
 
   std::copy(std::istreambuf_iterator<char>{file},
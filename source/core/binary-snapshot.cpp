@@ -0,0 +1,511 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "core/binary-snapshot.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/assert.hpp"
+#include "core/deserialization-error.hpp"
+#include "core/memory.hpp"
+#include "core/register-set.hpp"
+
+namespace {
+constexpr char magic[8] = {'E', 'R', 'A', 'S', 'N', 'A', 'P', '\0'};
+constexpr std::uint32_t formatVersion = 1;
+constexpr std::uint32_t deltaFlag = 1;
+constexpr std::size_t checksumSize = 8;
+
+/** PackBits never repeats or copies more than 128 bytes at once. */
+constexpr std::size_t maximumPackBitsRun = 128;
+
+[[noreturn]] void fail(const std::string& message) {
+  throw DeserializationError("Could not deserialize binary snapshot: " +
+                             message);
+}
+
+BinarySnapshot::checksum_t
+fnv1a(const std::string& data, std::size_t size) {
+  BinarySnapshot::checksum_t hash = 14695981039346656037ull;
+  for (std::size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<std::uint8_t>(data[i]);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+std::size_t rawSize(std::size_t cellCount, std::size_t cellSize) {
+  return (cellCount * cellSize + 7) / 8;
+}
+
+/**
+ * Appends little endian numbers and length-prefixed strings to a string.
+ */
+class Writer {
+ public:
+  explicit Writer(std::string& data) : _data(data) {
+  }
+
+  template <typename T>
+  void integer(T value) {
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+      _data.push_back(static_cast<char>(value & 0xFF));
+      value = static_cast<T>(value >> 4 >> 4);
+    }
+  }
+
+  /** Writes a 32 bit zero, to be patched later, and returns its offset. */
+  std::size_t reserve() {
+    auto offset = _data.size();
+    integer<std::uint32_t>(0);
+    return offset;
+  }
+
+  void patch(std::size_t offset, std::uint32_t value) {
+    for (std::size_t i = 0; i < 4; ++i) {
+      _data[offset + i] = static_cast<char>(value & 0xFF);
+      value >>= 8;
+    }
+  }
+
+  void string(const std::string& value) {
+    integer(static_cast<std::uint32_t>(value.size()));
+    _data.append(value);
+  }
+
+  void bytes(const std::uint8_t* begin, std::size_t size) {
+    _data.append(reinterpret_cast<const char*>(begin), size);
+  }
+
+ private:
+  std::string& _data;
+};
+
+/**
+ * Reads what the Writer wrote, throwing instead of reading past the end.
+ */
+class Reader {
+ public:
+  Reader(const std::string& data, std::size_t offset, std::size_t end)
+  : _data(data), _offset(offset), _end(end) {
+  }
+
+  template <typename T>
+  T integer() {
+    _require(sizeof(T));
+    T value = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+      auto byte = static_cast<std::uint8_t>(_data[_offset + i]);
+      value |= static_cast<T>(static_cast<T>(byte) << (8 * i));
+    }
+    _offset += sizeof(T);
+    return value;
+  }
+
+  std::string string() {
+    auto size = integer<std::uint32_t>();
+    _require(size);
+    auto value = _data.substr(_offset, size);
+    _offset += size;
+    return value;
+  }
+
+  const std::uint8_t* bytes(std::size_t size) {
+    _require(size);
+    auto begin = reinterpret_cast<const std::uint8_t*>(_data.data() + _offset);
+    _offset += size;
+    return begin;
+  }
+
+  std::size_t offset() const noexcept {
+    return _offset;
+  }
+
+ private:
+  void _require(std::size_t size) const {
+    if (size > _end - _offset) fail("unexpected end of data");
+  }
+
+  const std::string& _data;
+  std::size_t _offset;
+  std::size_t _end;
+};
+
+/**
+ * Compresses bytes with PackBits: a header byte n < 128 is followed by n + 1
+ * literal bytes, a header byte n > 128 by one byte to repeat 257 - n times.
+ */
+void packBits(const std::uint8_t* input, std::size_t size, std::string& out) {
+  std::size_t index = 0;
+  while (index < size) {
+    std::size_t run = 1;
+    while (index + run < size && run < maximumPackBitsRun &&
+           input[index + run] == input[index]) {
+      ++run;
+    }
+    if (run >= 3) {
+      out.push_back(static_cast<char>(257 - run));
+      out.push_back(static_cast<char>(input[index]));
+      index += run;
+      continue;
+    }
+    // copy literals up to the next run worth repeating
+    auto begin = index;
+    while (index < size && index - begin < maximumPackBitsRun) {
+      if (index + 2 < size && input[index] == input[index + 1] &&
+          input[index] == input[index + 2]) {
+        break;
+      }
+      ++index;
+    }
+    out.push_back(static_cast<char>(index - begin - 1));
+    out.append(reinterpret_cast<const char*>(input + begin), index - begin);
+  }
+}
+
+/**
+ * Decompresses PackBits, the output has to be filled exactly.
+ */
+void unpackBits(const std::uint8_t* input,
+                std::size_t size,
+                std::uint8_t* output,
+                std::size_t outputSize) {
+  std::size_t index = 0;
+  std::size_t written = 0;
+  while (index < size) {
+    auto header = input[index++];
+    if (header < 128) {
+      std::size_t count = header + 1;
+      if (count > size - index || count > outputSize - written) {
+        fail("corrupt memory run");
+      }
+      std::memcpy(output + written, input + index, count);
+      index += count;
+      written += count;
+    } else if (header > 128) {
+      std::size_t count = 257 - header;
+      if (index == size || count > outputSize - written) {
+        fail("corrupt memory run");
+      }
+      std::memset(output + written, input[index++], count);
+      written += count;
+    }
+  }
+  if (written != outputSize) fail("corrupt memory run");
+}
+}
+
+constexpr BinarySnapshot::size_t BinarySnapshot::pageSize;
+static_assert(BinarySnapshot::pageSize == Memory::pageSize,
+              "snapshot pages are memory pages");
+
+BinarySnapshot::BinarySnapshot(const ArchitectureFormula& architectureFormula,
+                               const Memory& memory,
+                               const RegisterSet& registerSet) {
+  static const std::uint8_t zeroPage[pageSize] = {};
+  _encode(architectureFormula,
+          memory,
+          registerSet,
+          0,
+          [&](std::size_t index, const std::uint8_t* page, std::size_t size) {
+            return !memory.isZeroPage(index) &&
+                   std::memcmp(page, zeroPage, size) != 0;
+          });
+}
+
+BinarySnapshot::BinarySnapshot(const ArchitectureFormula& architectureFormula,
+                               const Memory& memory,
+                               const RegisterSet& registerSet,
+                               const BinarySnapshot& base) {
+  static const std::uint8_t zeroPage[pageSize] = {};
+  assert::that(base.isValid() && !base.isDelta());
+  assert::that(base._cellSize == memory.getByteSize());
+  assert::that(base._memorySize <= memory.getByteCount());
+
+  MemoryValue::Underlying baseRaw(rawSize(base._memorySize, base._cellSize));
+  base._decodePages(baseRaw);
+
+  _encode(architectureFormula,
+          memory,
+          registerSet,
+          base.getChecksum(),
+          [&](std::size_t index, const std::uint8_t* page, std::size_t size) {
+            auto offset = index * pageSize;
+            if (offset >= baseRaw.size()) {
+              return !memory.isZeroPage(index) &&
+                     std::memcmp(page, zeroPage, size) != 0;
+            }
+            auto inBase = std::min(size, baseRaw.size() - offset);
+            return std::memcmp(page, baseRaw.data() + offset, inBase) != 0 ||
+                   std::memcmp(page + inBase, zeroPage, size - inBase) != 0;
+          });
+}
+
+BinarySnapshot::BinarySnapshot(const ArchitectureFormula& architectureFormula,
+                               const Memory& memory,
+                               const RegisterSet& registerSet,
+                               const BinarySnapshot& base,
+                               const Memory& baseMemory) {
+  static const std::uint8_t zeroPage[pageSize] = {};
+  assert::that(base.isValid() && !base.isDelta());
+  assert::that(base._cellSize == memory.getByteSize());
+  assert::that(base._memorySize == baseMemory.getByteCount());
+  assert::that(base._memorySize <= memory.getByteCount());
+
+  _encode(architectureFormula,
+          memory,
+          registerSet,
+          base.getChecksum(),
+          [&](std::size_t index, const std::uint8_t* page, std::size_t size) {
+            if (memory.sharesPage(index, baseMemory)) return false;
+            // pages behind the base memory are compared against zero
+            auto basePage = index < baseMemory.getPageCount()
+                                ? baseMemory.getPage(index)
+                                : zeroPage;
+            return std::memcmp(page, basePage, size) != 0;
+          });
+}
+
+BinarySnapshot::BinarySnapshot(std::string data) : _data(std::move(data)) {
+  _parseHeader();
+}
+
+bool BinarySnapshot::isBinarySnapshot(const std::string& data) {
+  return data.size() >= sizeof magic &&
+         std::memcmp(data.data(), magic, sizeof magic) == 0;
+}
+
+bool BinarySnapshot::isValid() const noexcept {
+  return !_data.empty();
+}
+
+bool BinarySnapshot::isDelta() const noexcept {
+  return (_flags & deltaFlag) != 0;
+}
+
+BinarySnapshot::checksum_t BinarySnapshot::getChecksum() const noexcept {
+  return _checksum;
+}
+
+BinarySnapshot::checksum_t BinarySnapshot::getBaseChecksum() const noexcept {
+  return _baseChecksum;
+}
+
+ArchitectureFormula BinarySnapshot::getArchitectureFormula() const {
+  assert::that(isValid());
+  return ArchitectureFormula(_architectureName, _extensions);
+}
+
+BinarySnapshot::size_t BinarySnapshot::getMemorySize() const {
+  assert::that(isValid());
+  return _memorySize;
+}
+
+const std::string& BinarySnapshot::getData() const noexcept {
+  return _data;
+}
+
+void BinarySnapshot::restore(Memory& memory, RegisterSet& registerSet) const {
+  assert::that(isValid());
+  if (isDelta()) fail("a delta snapshot can only be loaded with its base");
+  _checkMemory(memory);
+
+  // decode everything before changing anything
+  auto registers = _decodeRegisters(registerSet);
+  MemoryValue::Underlying raw(rawSize(_memorySize, _cellSize));
+  _decodePages(raw);
+
+  memory.setRawData(_memorySize, std::move(raw));
+  for (const auto& entry : registers) {
+    registerSet.put(entry.first, entry.second);
+  }
+}
+
+void BinarySnapshot::restore(const BinarySnapshot& base,
+                             Memory& memory,
+                             RegisterSet& registerSet) const {
+  assert::that(isValid());
+  if (!isDelta()) return restore(memory, registerSet);
+  if (!base.isValid() || base.getChecksum() != _baseChecksum) {
+    fail("the delta snapshot was not created against this base");
+  }
+  _checkMemory(memory);
+
+  auto registers = _decodeRegisters(registerSet);
+  auto cellCount = std::max(base._memorySize, _memorySize);
+  MemoryValue::Underlying raw(rawSize(cellCount, _cellSize));
+  base._decodePages(raw);
+  _decodePages(raw);
+
+  memory.setRawData(cellCount, std::move(raw));
+  for (const auto& entry : registers) {
+    registerSet.put(entry.first, entry.second);
+  }
+}
+
+template <typename PagePredicate>
+void BinarySnapshot::_encode(const ArchitectureFormula& architectureFormula,
+                             const Memory& memory,
+                             const RegisterSet& registerSet,
+                             checksum_t baseChecksum,
+                             PagePredicate storePage) {
+  Writer writer(_data);
+  _data.append(magic, sizeof magic);
+  writer.integer(formatVersion);
+  writer.integer(baseChecksum == 0 ? std::uint32_t{0} : deltaFlag);
+  writer.integer(baseChecksum);
+  writer.string(architectureFormula.getArchitectureName());
+  writer.integer(static_cast<std::uint32_t>(
+      architectureFormula.getUnderlying().size()));
+  for (const auto& extension : architectureFormula.getUnderlying()) {
+    writer.string(extension);
+  }
+
+  const auto& parents = registerSet.getParentNames();
+  writer.integer(static_cast<std::uint32_t>(parents.size()));
+  for (const auto& name : parents) {
+    auto value = registerSet.get(name);
+    writer.string(name);
+    writer.integer(static_cast<std::uint32_t>(value.getSize()));
+    writer.bytes(value.internal().data(), value.internal().size());
+  }
+
+  const auto raw = rawSize(memory.getByteCount(), memory.getByteSize());
+  const auto pageCount = memory.getPageCount();
+  writer.integer(static_cast<std::uint64_t>(memory.getByteCount()));
+  writer.integer(static_cast<std::uint32_t>(memory.getByteSize()));
+  writer.integer(static_cast<std::uint32_t>(pageSize));
+  auto runCountOffset = writer.reserve();
+  std::uint32_t runCount = 0;
+
+  auto pageSizeAt = [&](std::size_t page) {
+    return std::min(pageSize, raw - page * pageSize);
+  };
+  auto pageStored = [&](std::size_t page) {
+    return storePage(page, memory.getPage(page), pageSizeAt(page));
+  };
+  for (std::size_t first = 0; first < pageCount;) {
+    if (!pageStored(first)) {
+      ++first;
+      continue;
+    }
+    auto end = first + 1;
+    while (end < pageCount && pageStored(end)) ++end;
+
+    // the pages are not adjacent in memory, but PackBits streams can be
+    // concatenated, so every page is compressed on its own
+    writer.integer(static_cast<std::uint64_t>(first));
+    writer.integer(static_cast<std::uint32_t>(end - first));
+    auto sizeOffset = writer.reserve();
+    auto begin = _data.size();
+    for (auto page = first; page < end; ++page) {
+      packBits(memory.getPage(page), pageSizeAt(page), _data);
+    }
+    writer.patch(sizeOffset, static_cast<std::uint32_t>(_data.size() - begin));
+    ++runCount;
+    first = end;
+  }
+  writer.patch(runCountOffset, runCount);
+
+  writer.integer(fnv1a(_data, _data.size()));
+  _parseHeader();
+}
+
+void BinarySnapshot::_parseHeader() {
+  if (!isBinarySnapshot(_data)) fail("not a binary snapshot");
+  if (_data.size() < sizeof magic + checksumSize) fail("too short");
+  auto end = _data.size() - checksumSize;
+  _checksum = Reader(_data, end, _data.size()).integer<checksum_t>();
+  if (_checksum != fnv1a(_data, end)) fail("checksum does not match");
+
+  Reader reader(_data, sizeof magic, end);
+  if (reader.integer<std::uint32_t>() != formatVersion) {
+    fail("unknown version");
+  }
+  _flags = reader.integer<std::uint32_t>();
+  _baseChecksum = reader.integer<checksum_t>();
+  _architectureName = reader.string();
+  if (_architectureName.empty()) fail("no architecture");
+  _extensions.clear();
+  for (auto count = reader.integer<std::uint32_t>(); count > 0; --count) {
+    _extensions.emplace_back(reader.string());
+  }
+
+  _registerOffset = reader.offset();
+  for (auto count = reader.integer<std::uint32_t>(); count > 0; --count) {
+    reader.string();
+    reader.bytes((reader.integer<std::uint32_t>() + 7) / 8);
+  }
+
+  _memorySize = reader.integer<std::uint64_t>();
+  _cellSize = reader.integer<std::uint32_t>();
+  if (reader.integer<std::uint32_t>() != pageSize) fail("unknown page size");
+  _runCount = reader.integer<std::uint32_t>();
+  _runOffset = reader.offset();
+  if (_memorySize == 0 || _cellSize == 0) fail("empty memory");
+}
+
+void BinarySnapshot::_decodePages(MemoryValue::Underlying& raw) const {
+  const auto size = rawSize(_memorySize, _cellSize);
+  assert::that(raw.size() >= size);
+  Reader reader(_data, _runOffset, _data.size() - checksumSize);
+  for (std::size_t run = 0; run < _runCount; ++run) {
+    auto first = reader.integer<std::uint64_t>();
+    auto pageCount = reader.integer<std::uint32_t>();
+    auto encodedSize = reader.integer<std::uint32_t>();
+    auto encoded = reader.bytes(encodedSize);
+    if (pageCount == 0 || first >= (size + pageSize - 1) / pageSize ||
+        pageCount > (size + pageSize - 1) / pageSize - first) {
+      fail("memory run outside of the memory");
+    }
+    auto offset = first * pageSize;
+    auto decodedSize = std::min(offset + pageCount * pageSize, size) - offset;
+    unpackBits(encoded, encodedSize, raw.data() + offset, decodedSize);
+  }
+}
+
+std::vector<std::pair<std::string, MemoryValue>>
+BinarySnapshot::_decodeRegisters(const RegisterSet& registerSet) const {
+  std::vector<std::pair<std::string, MemoryValue>> registers;
+  Reader reader(_data, _registerOffset, _runOffset);
+  for (auto count = reader.integer<std::uint32_t>(); count > 0; --count) {
+    auto name = reader.string();
+    auto size = reader.integer<std::uint32_t>();
+    auto bytes = reader.bytes((size + 7) / 8);
+    if (!registerSet.existsRegister(name)) {
+      fail("there is no such register: \"" + name + "\"");
+    }
+    if (size == 0 || registerSet.getSize(name) != size) {
+      fail("the size of register \"" + name + "\" does not match");
+    }
+    MemoryValue::Underlying value(bytes, bytes + (size + 7) / 8);
+    registers.emplace_back(name, MemoryValue(std::move(value), size));
+  }
+  return registers;
+}
+
+void BinarySnapshot::_checkMemory(const Memory& memory) const {
+  if (memory.getByteSize() != _cellSize) {
+    fail("the cell size does not match: expected " +
+         std::to_string(memory.getByteSize()) + ", got " +
+         std::to_string(_cellSize));
+  }
+}
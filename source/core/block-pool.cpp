@@ -0,0 +1,50 @@
+/* C++ Assembler Interpreter
+ * Copyright (C) 2016 Chair of Computer Architecture
+ * at Technical University of Munich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/block-pool.hpp"
+
+#include <new>
+
+#include "core/bounded-queue.hpp"
+
+namespace {
+/**
+ * The free blocks. The queue is never destroyed, as blocks may still be
+ * returned by static objects while the program exits.
+ */
+BoundedQueue<void*>& freeBlocks() {
+  static auto* blocks = new BoundedQueue<void*>(BlockPool::capacity);
+  return *blocks;
+}
+}
+
+constexpr std::size_t BlockPool::blockSize;
+constexpr std::size_t BlockPool::capacity;
+
+void* BlockPool::allocate(std::size_t size) {
+  if (size > blockSize) return ::operator new(size);
+  void* block;
+  if (freeBlocks().pop(block)) return block;
+  return ::operator new(blockSize);
+}
+
+void BlockPool::deallocate(void* block, std::size_t size) noexcept {
+  if (size > blockSize || !freeBlocks().tryPush(block)) {
+    ::operator delete(block);
+  }
+}
@@ -0,0 +1,134 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/change-tracker.hpp"
+
+#include <algorithm>
+
+namespace {
+using Word = std::uint64_t;
+
+std::size_t countTrailingZeros(Word word) {
+#if defined(__GNUC__)
+  return __builtin_ctzll(word);
+#else
+  std::size_t count = 0;
+  while (!(word & 1)) {
+    word >>= 1;
+    ++count;
+  }
+  return count;
+#endif
+}
+}
+
+ChangeTracker::ChangeTracker(size_t pageSize)
+: _pageSize(std::max<size_t>(pageSize, 1))
+, _pages()
+, _firstWord(0)
+, _lastWord(0)
+, _registers()
+, _registerIndices()
+, _registerNames()
+, _registersDirty(false) {
+}
+
+void ChangeTracker::markMemory(size_t address, size_t amount) {
+  if (amount == 0) return;
+  size_t firstPage = address / _pageSize;
+  size_t lastPage = (address + amount - 1) / _pageSize;
+  size_t firstWord = firstPage / _wordSize;
+  size_t lastWord = lastPage / _wordSize + 1;
+  if (_pages.size() < lastWord) _pages.resize(lastWord, 0);
+
+  for (size_t word = firstWord; word < lastWord; ++word) {
+    Word mask = ~Word(0);
+    if (word == firstWord) mask &= ~Word(0) << (firstPage % _wordSize);
+    if (word == lastWord - 1 && lastPage % _wordSize != _wordSize - 1) {
+      mask &= (Word(1) << (lastPage % _wordSize + 1)) - 1;
+    }
+    _pages[word] |= mask;
+  }
+
+  if (_firstWord == _lastWord) {
+    _firstWord = firstWord;
+    _lastWord = lastWord;
+  } else {
+    _firstWord = std::min(_firstWord, firstWord);
+    _lastWord = std::max(_lastWord, lastWord);
+  }
+}
+
+void ChangeTracker::markRegister(const std::string &name) {
+  auto iterator = _registerIndices.find(name);
+  if (iterator == _registerIndices.end()) {
+    iterator = _registerIndices.emplace(name, _registerNames.size()).first;
+    _registerNames.push_back(name);
+    _registers.resize((_registerNames.size() + _wordSize - 1) / _wordSize, 0);
+  }
+  size_t index = iterator->second;
+  _registers[index / _wordSize] |= Word(1) << (index % _wordSize);
+  _registersDirty = true;
+}
+
+bool ChangeTracker::isDirty() const noexcept {
+  return _firstWord != _lastWord || _registersDirty;
+}
+
+void ChangeTracker::flush(size_t memorySize,
+                          const MemoryCallback &memoryCallback,
+                          const RegisterCallback &registerCallback) {
+  size_t end = _lastWord * _wordSize;
+  size_t page = _findPage(_firstWord * _wordSize, end, true);
+  while (page < end) {
+    size_t runEnd = _findPage(page, end, false);
+    size_t address = page * _pageSize;
+    if (address >= memorySize) break;
+    memoryCallback(address, std::min(runEnd * _pageSize, memorySize) - address);
+    page = _findPage(runEnd, end, true);
+  }
+  std::fill(_pages.begin() + _firstWord, _pages.begin() + _lastWord, 0);
+  _firstWord = _lastWord = 0;
+
+  if (!_registersDirty) return;
+  for (size_t word = 0; word < _registers.size(); ++word) {
+    Word bits = _registers[word];
+    _registers[word] = 0;
+    while (bits != 0) {
+      size_t bit = countTrailingZeros(bits);
+      registerCallback(_registerNames[word * _wordSize + bit]);
+      bits &= bits - 1;
+    }
+  }
+  _registersDirty = false;
+}
+
+ChangeTracker::size_t
+ChangeTracker::_findPage(size_t page, size_t end, bool dirty) const noexcept {
+  while (page < end) {
+    size_t word = page / _wordSize;
+    Word bits = dirty ? _pages[word] : ~_pages[word];
+    bits &= ~Word(0) << (page % _wordSize);
+    if (bits != 0) {
+      return std::min(word * _wordSize + countTrailingZeros(bits), end);
+    }
+    page = (word + 1) * _wordSize;
+  }
+  return end;
+}
@@ -20,44 +20,53 @@
 #include "core/condition-timer.hpp"
 
 ConditionTimer::ConditionTimer()
-: _mutex(), _flag(false), _conditionVariable() {
+: _mutex(), _flag(false), _blocked(0), _spinWait(), _conditionVariable() {
 }
 
 void ConditionTimer::notifyAll() {
-  {
-    std::lock_guard<std::mutex> lock(_mutex);
-    _flag = true;
-  }
-  _conditionVariable.notify_all();
+  _notify(true);
 }
 
 void ConditionTimer::notifyOne() {
-  {
-    std::lock_guard<std::mutex> lock(_mutex);
-    _flag = true;
-  }
-  _conditionVariable.notify_one();
+  _notify(false);
 }
 
 void ConditionTimer::reset() {
-  std::lock_guard<std::mutex> lock(_mutex);
-  _flag = false;
+  _flag.store(false, std::memory_order_release);
 }
 
 bool ConditionTimer::getFlag() {
-  std::lock_guard<std::mutex> lock(_mutex);
-  return _flag;
+  return _flag.load(std::memory_order_relaxed);
 }
 
 void ConditionTimer::wait() {
-  std::unique_lock<std::mutex> lock(_mutex);
-  // wait while flag is not set.
-  _conditionVariable.wait(lock, [this] { return _flag; });
+  _wait();
 }
 
 void ConditionTimer::waitAndReset() {
+  _wait();
+  _flag.store(false, std::memory_order_relaxed);
+}
+
+void ConditionTimer::_notify(bool all) {
+  // both this and the registration of a blocked thread are sequentially
+  // consistent: either the thread sees the flag or this sees the thread
+  _flag.store(true, std::memory_order_seq_cst);
+  if (_blocked.load(std::memory_order_seq_cst) == 0) return;
+  // taking the lock makes sure the thread either has not checked the flag yet
+  // or is already waiting
+  { std::lock_guard<std::mutex> lock(_mutex); }
+  if (all) {
+    _conditionVariable.notify_all();
+  } else {
+    _conditionVariable.notify_one();
+  }
+}
+
+void ConditionTimer::_wait() {
+  if (_spinWait.spinUntil([this] { return _isSet(); })) return;
+  BlockedThread blocked(*this);
   std::unique_lock<std::mutex> lock(_mutex);
   // wait while flag is not set.
-  _conditionVariable.wait(lock, [this] { return _flag; });
-  _flag = false;
+  _conditionVariable.wait(lock, [this] { return _isSet(); });
 }
@@ -0,0 +1,120 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/framebuffer-channel.hpp"
+
+#include <algorithm>
+
+FramebufferChannel::FramebufferChannel(size_t address, size_t amount)
+: _address(address)
+, _size(amount)
+, _exchange(1)
+, _back(0)
+, _unseen{0, amount}
+, _front(2) {
+  for (auto &slot : _slots) {
+    slot.data.assign(amount, 0);
+    slot.dirty = Range{0, amount};
+  }
+  // nothing has been copied into any of the buffers yet
+  _outdated.fill(Range{0, amount});
+}
+
+FramebufferChannel::size_t FramebufferChannel::getAddress() const noexcept {
+  return _address;
+}
+
+FramebufferChannel::size_t FramebufferChannel::getSize() const noexcept {
+  return _size;
+}
+
+bool FramebufferChannel::overlaps(size_t address, size_t amount) const
+    noexcept {
+  return address < _address + _size && address + amount > _address;
+}
+
+void FramebufferChannel::publish(const std::uint8_t *memory,
+                                 size_t address,
+                                 size_t amount) {
+  publish(
+      [memory](size_t begin, size_t cells, std::uint8_t *destination) {
+        std::copy(memory + begin, memory + begin + cells, destination);
+      },
+      address,
+      amount);
+}
+
+void FramebufferChannel::publish(const Reader &read,
+                                 size_t address,
+                                 size_t amount) {
+  if (!overlaps(address, amount)) return;
+  Range written{std::max(address, _address) - _address,
+                std::min(address + amount, _address + _size) - _address};
+  for (auto &outdated : _outdated) {
+    outdated = outdated.unite(written);
+  }
+
+  // bring the buffer of the writer up to date, it only misses what was
+  // written while the other buffers were handed out
+  auto &outdated = _outdated[_back];
+  auto &slot = _slots[_back];
+  read(_address + outdated.begin,
+       outdated.end - outdated.begin,
+       slot.data.data() + outdated.begin);
+  outdated = Range{0, 0};
+
+  _unseen = _unseen.unite(written);
+  slot.dirty = _unseen;
+  auto previous = _exchange.exchange(_back | _fresh, std::memory_order_acq_rel);
+  _back = previous & _indexMask;
+  if (!(previous & _fresh)) {
+    // the reader took the previous frame, so it only misses this write
+    _unseen = written;
+  }
+}
+
+bool FramebufferChannel::consume() {
+  if (!(_exchange.load(std::memory_order_relaxed) & _fresh)) return false;
+  _front = _exchange.exchange(_front, std::memory_order_acq_rel) & _indexMask;
+  return true;
+}
+
+const FramebufferChannel::Buffer &FramebufferChannel::getFrame() const
+    noexcept {
+  return _slots[_front].data;
+}
+
+FramebufferChannel::size_t FramebufferChannel::getDirtyBegin() const noexcept {
+  return _slots[_front].dirty.begin;
+}
+
+FramebufferChannel::size_t FramebufferChannel::getDirtyEnd() const noexcept {
+  return _slots[_front].dirty.end;
+}
+
+bool FramebufferChannel::Range::isEmpty() const noexcept {
+  return begin >= end;
+}
+
+FramebufferChannel::Range
+FramebufferChannel::Range::unite(const Range &other) const noexcept {
+  if (isEmpty()) return other;
+  if (other.isEmpty()) return *this;
+  return Range{std::min(begin, other.begin), std::max(end, other.end)};
+}
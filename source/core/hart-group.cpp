@@ -0,0 +1,78 @@
+/* C++ Assembler Interpreter
+ * Copyright (C) 2016 Chair of Computer Architecture
+ * at Technical University of Munich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "core/hart-group.hpp"
+
+#include <memory>
+#include <utility>
+
+#include "core/sleep-timer.hpp"
+
+HartGroup::HartGroup() : _threads(), _stop(), _done(), _running(0), _step() {
+}
+
+HartGroup::~HartGroup() {
+  stop();
+}
+
+void HartGroup::start(size_t hartCount,
+                      const MemoryAccess& memoryAccess,
+                      bool virtualTime,
+                      Step step) {
+  stop();
+  _stop.reset();
+  _done.reset();
+  _step = std::move(step);
+  _running = hartCount > 1 ? hartCount - 1 : 0;
+  for (size_t hart = 1; hart < hartCount; ++hart) {
+    // every hart sleeps on its own
+    auto sleepTimer = std::make_shared<SleepTimer>();
+    sleepTimer->setVirtualTime(virtualTime);
+    MemoryAccess hartAccess(memoryAccess, sleepTimer);
+    _threads.emplace_back(
+        &HartGroup::_run, this, hartAccess.forHart(hart), sleepTimer);
+  }
+}
+
+bool HartGroup::stop() {
+  if (_threads.empty()) return false;
+  _stop.notifyAll();
+  for (auto& thread : _threads) {
+    thread.join();
+  }
+  _threads.clear();
+  return true;
+}
+
+bool HartGroup::waitUntilDone(std::chrono::milliseconds timeout) {
+  if (_running == 0) return true;
+  _done.waitFor(timeout);
+  return _running == 0;
+}
+
+void HartGroup::_run(MemoryAccess memoryAccess,
+                     std::shared_ptr<SleepTimer> sleepTimer) {
+  while (!_stop.getFlag()) {
+    if (!_step(memoryAccess)) break;
+    if (sleepTimer->hasRequest()) {
+      _stop.waitFor(sleepTimer->takeRequest());
+    }
+  }
+  if (--_running == 0) _done.notifyAll();
+}
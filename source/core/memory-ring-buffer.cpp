@@ -0,0 +1,112 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/memory-ring-buffer.hpp"
+
+#include <algorithm>
+
+#include "common/assert.hpp"
+#include "core/conversions.hpp"
+#include "core/memory-value.hpp"
+#include "core/memory.hpp"
+
+namespace {
+constexpr std::size_t headOffset = 0;
+constexpr std::size_t tailOffset = 4;
+constexpr std::size_t indexSize = 4;
+}
+
+MemoryRingBuffer::MemoryRingBuffer(size_t address, size_t capacity)
+: _address(address), _capacity(capacity) {
+  assert::that(capacity >= 2);
+}
+
+MemoryRingBuffer::size_t MemoryRingBuffer::getAddress() const noexcept {
+  return _address;
+}
+
+MemoryRingBuffer::size_t MemoryRingBuffer::getCapacity() const noexcept {
+  return _capacity;
+}
+
+MemoryRingBuffer::size_t MemoryRingBuffer::getTotalSize() const noexcept {
+  return headerSize + _capacity;
+}
+
+bool MemoryRingBuffer::fitsInto(const Memory &memory) const {
+  return memory.getByteSize() == 8 && _address <= memory.getByteCount() &&
+         getTotalSize() <= memory.getByteCount() - _address;
+}
+
+std::string MemoryRingBuffer::drain(Memory &memory) const {
+  auto head = _readIndex(memory, headOffset);
+  auto tail = _readIndex(memory, tailOffset);
+  if (head == tail) return std::string();
+
+  std::string bytes;
+  auto append = [&](size_t begin, size_t end) {
+    if (begin == end) return;
+    auto value = memory.get(_address + headerSize + begin, end - begin);
+    const auto &cells = value.internal();
+    bytes.append(cells.begin(), cells.begin() + (end - begin));
+  };
+  if (tail < head) {
+    append(tail, head);
+  } else {
+    // the bytes wrap around the end of the buffer
+    append(tail, _capacity);
+    append(0, head);
+  }
+
+  _writeIndex(memory, tailOffset, head);
+  return bytes;
+}
+
+bool MemoryRingBuffer::fill(Memory &memory, const std::string &data) const {
+  if (data.empty()) return true;
+  auto head = _readIndex(memory, headOffset);
+  auto tail = _readIndex(memory, tailOffset);
+  auto used = (head + _capacity - tail) % _capacity;
+  if (data.size() > _capacity - 1 - used) return false;
+
+  auto first = std::min(data.size(), _capacity - head);
+  auto dataAddress = _address + headerSize;
+  MemoryValue::Underlying cells(data.begin(), data.begin() + first);
+  memory.put(dataAddress + head, MemoryValue(std::move(cells), first * 8));
+  if (first < data.size()) {
+    MemoryValue::Underlying rest(data.begin() + first, data.end());
+    auto size = rest.size() * 8;
+    memory.put(dataAddress, MemoryValue(std::move(rest), size));
+  }
+
+  _writeIndex(memory, headOffset, (head + data.size()) % _capacity);
+  return true;
+}
+
+MemoryRingBuffer::size_t
+MemoryRingBuffer::_readIndex(const Memory &memory, size_t offset) const {
+  auto value = memory.get(_address + offset, indexSize);
+  return conversions::convert<std::uint32_t>(value) % _capacity;
+}
+
+void MemoryRingBuffer::_writeIndex(Memory &memory,
+                                   size_t offset,
+                                   size_t index) const {
+  memory.put(_address + offset, conversions::convert(index, indexSize * 8));
+}
@@ -16,6 +16,9 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <vector>
@@ -179,10 +182,7 @@ MemoryValue::address_t MemoryValue::getSize() const {
 }
 
 bool MemoryValue::isZero() {
-  for (address_t i = 0; i < getSize(); ++i) {
-    if (get(i)) return false;
-  }
-  return true;
+  return countLeadingZeros() == getSize();
 }
 
 bool MemoryValue::front() const {
@@ -193,6 +193,109 @@ bool MemoryValue::back() const {
   return get(_size - 1);
 }
 
+namespace {
+using Word = std::uint64_t;
+
+std::size_t bitLength(std::uint8_t byte) {
+#if defined(__GNUC__)
+  return byte == 0 ? 0 : 32 - __builtin_clz(byte);
+#else
+  std::size_t length = 0;
+  while (byte != 0) {
+    byte >>= 1;
+    ++length;
+  }
+  return length;
+#endif
+}
+
+std::size_t countOnesOf(Word word) {
+#if defined(__GNUC__)
+  return __builtin_popcountll(word);
+#else
+  std::size_t count = 0;
+  for (; word != 0; word &= word - 1) {
+    ++count;
+  }
+  return count;
+#endif
+}
+
+// the bits of the last byte that belong to a value of size bits
+std::uint8_t lastByteMask(std::size_t size) {
+  return size % 8 == 0 ? 0xFF : (1 << (size % 8)) - 1;
+}
+
+// counts the leading bits equal to bit, comparing whole words at once where
+// possible; this does not depend on the byte order of the words
+std::size_t countLeading(const MemoryValue::Underlying &data,
+                         std::size_t size,
+                         bool bit) {
+  if (size == 0) return 0;
+  const std::uint8_t invert = bit ? 0xFF : 0x00;
+  const std::size_t last = (size - 1) / 8;
+  const std::size_t lastBits = size - last * 8;
+  std::uint8_t byte = (data[last] ^ invert) & lastByteMask(size);
+  if (byte != 0) return lastBits - bitLength(byte);
+
+  std::size_t count = lastBits;
+  std::size_t end = last;
+  Word equal;
+  std::memset(&equal, invert, sizeof(Word));
+  for (; end >= sizeof(Word); end -= sizeof(Word), count += 64) {
+    Word word;
+    std::memcpy(&word, &data[end - sizeof(Word)], sizeof(Word));
+    if (word != equal) break;
+  }
+  while (end-- > 0) {
+    byte = data[end] ^ invert;
+    if (byte != 0) return count + 8 - bitLength(byte);
+    count += 8;
+  }
+  return count;
+}
+}
+
+MemoryValue::address_t MemoryValue::countLeadingZeros() const {
+  return countLeading(_data, _size, false);
+}
+
+MemoryValue::address_t MemoryValue::countLeadingOnes() const {
+  return countLeading(_data, _size, true);
+}
+
+MemoryValue::address_t MemoryValue::highestSetBit() const {
+  auto zeros = countLeadingZeros();
+  return zeros == _size ? _size : _size - 1 - zeros;
+}
+
+MemoryValue::address_t MemoryValue::countOnes() const {
+  if (_size == 0) return 0;
+  const std::size_t last = (_size - 1) / 8;
+  std::size_t count = countOnesOf(_data[last] & lastByteMask(_size));
+  std::size_t index = 0;
+  for (; index + sizeof(Word) <= last; index += sizeof(Word)) {
+    Word word;
+    std::memcpy(&word, &_data[index], sizeof(Word));
+    count += countOnesOf(word);
+  }
+  for (; index < last; ++index) {
+    count += countOnesOf(_data[index]);
+  }
+  return count;
+}
+
+void MemoryValue::signExtend(address_t signBit) {
+  assert::that(signBit < _size);
+  const std::uint8_t fill = get(signBit) ? 0xFF : 0x00;
+  const std::size_t byte = signBit / 8;
+  // the bits above signBit in its own byte, then all following bytes
+  const std::uint8_t above = 0xFF << (signBit % 8 + 1);
+  _data[byte] = (_data[byte] & ~above) | (fill & above);
+  std::fill(_data.begin() + byte + 1, _data.end(), fill);
+  _data.back() &= lastByteMask(_size);
+}
+
 const MemoryValue::Underlying &MemoryValue::internal() const {
   return _data;
 }
@@ -17,9 +17,12 @@
 */
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
 #include <set>
 #include <sstream>
-#include <unordered_map>
 
 #include "common/assert.hpp"
 #include "core/deserialization-error.hpp"
@@ -37,13 +40,41 @@ const std::string Memory::_dataMapStringIdentifier = "memory_map";
 Memory::Memory() : Memory(64, 8) {
 }
 
+constexpr Memory::size_t Memory::pageSize;
+constexpr Memory::size_t Memory::_pageSize;
+
 Memory::Memory(size_t byteCount, size_t byteSize)
 : _byteCount{byteCount}
 , _byteSize{byteSize}
-, _data{byteCount * byteSize}
-, _callback{[](size_t, size_t) {}} {
+, _pages{}
+, _callback{[](size_t, size_t) {}}
+, _sizeCallback{[](size_t) {}} {
   assert::that(byteCount > 0);
   assert::that(byteSize > 0);
+  _growPages();
+}
+
+Memory::Memory(const Memory& other)
+: _byteSize{other._byteSize}
+, _byteCount{other._byteCount}
+, _pages{other._pages}
+, _callback{other._callback}
+, _sizeCallback{other._sizeCallback}
+, _protection{other._protection} {
+}
+
+Memory& Memory::operator=(const Memory& other) {
+  if (this == &other) return *this;
+  const bool resized = _byteCount != other._byteCount;
+  _byteSize = other._byteSize;
+  _byteCount = other._byteCount;
+  _pages = other._pages;
+  _protection = other._protection;
+  if (resized) {
+    _sizeCallback(_byteCount);
+  }
+  _wasUpdated();
+  return *this;
 }
 
 Memory::Memory(const Json& json)
@@ -68,8 +99,93 @@ void Memory::setSizeCallback(const SizeCallback& callback) {
   _sizeCallback = callback;
 }
 
+const std::shared_ptr<Memory::Page>& Memory::_zeroPage() {
+  static const auto page = std::make_shared<Page>(Page{});
+  return page;
+}
+
+Memory::size_t Memory::_rawSize() const {
+  return (_byteCount * _byteSize + 7) / 8;
+}
+
+void Memory::_growPages() {
+  const size_t pageCount = (_rawSize() + _pageSize - 1) / _pageSize;
+  if (_pages.size() < pageCount) {
+    _pages.resize(pageCount, _zeroPage());
+  }
+}
+
+Memory::Page& Memory::_writablePage(size_t index) {
+  auto& page = _pages[index];
+  if (page.use_count() != 1) {
+    // shared with another memory or the zero page
+    page = std::make_shared<Page>(*page);
+  } else {
+    // the last other owner might just have read the page on another thread
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+  return *page;
+}
+
+void Memory::_readRaw(size_t offset,
+                      size_t size,
+                      std::uint8_t* destination) const {
+  while (size > 0) {
+    const size_t index = offset / _pageSize;
+    const size_t begin = offset % _pageSize;
+    const size_t length = std::min(size, _pageSize - begin);
+    std::memcpy(destination, _pages[index]->data() + begin, length);
+    offset += length;
+    destination += length;
+    size -= length;
+  }
+}
+
+void Memory::_writeRaw(size_t offset,
+                       size_t size,
+                       const std::uint8_t* source) {
+  while (size > 0) {
+    const size_t index = offset / _pageSize;
+    const size_t begin = offset % _pageSize;
+    const size_t length = std::min(size, _pageSize - begin);
+    std::memcpy(_writablePage(index).data() + begin, source, length);
+    offset += length;
+    source += length;
+    size -= length;
+  }
+}
+
+void Memory::_write(const MemoryValue& value, size_t begin) {
+  const size_t size = value.getSize();
+  if (size == 0) return;
+  if (begin % 8 == 0 && size % 8 == 0) {
+    _writeRaw(begin / 8, size / 8, value.internal().data());
+    return;
+  }
+  // merge the value into the bytes it covers partly
+  const size_t first = begin / 8;
+  const size_t last = (begin + size + 7) / 8;
+  MemoryValue::Underlying bytes(last - first);
+  _readRaw(first, bytes.size(), bytes.data());
+  MemoryValue merged{std::move(bytes), (last - first) * 8};
+  merged.write(value, begin % 8);
+  _writeRaw(first, last - first, merged.internal().data());
+}
+
 MemoryValue Memory::_get(size_t address, size_t amount) const {
-  return _data.subSet(address * _byteSize, (address + amount) * _byteSize);
+  const size_t begin = address * _byteSize;
+  const size_t end = (address + amount) * _byteSize;
+  const size_t first = begin / 8;
+  MemoryValue::Underlying bytes((end + 7) / 8 - first);
+  _readRaw(first, bytes.size(), bytes.data());
+  if (begin % 8 == 0) {
+    if (end % 8 != 0) {
+      bytes.back() &= static_cast<std::uint8_t>((1u << (end % 8)) - 1);
+    }
+    return MemoryValue{std::move(bytes), end - begin};
+  }
+  MemoryValue covering{std::move(bytes), ((end + 7) / 8 - first) * 8};
+  return covering.subSet(begin % 8, begin % 8 + end - begin);
 }
 
 MemoryValue Memory::get(size_t address, size_t amount) const {
@@ -94,7 +210,7 @@ void Memory::_put(size_t address,
                   size_t amount,
                   bool ignoreProtection) {
   if (ignoreProtection || !isProtected(address, amount)) {
-    _data.write(value, address * _byteSize);
+    _write(value, address * _byteSize);
   }
   // always send update signal even if update was refused due to protection in
   // order to give feedback to the caller
@@ -151,10 +267,33 @@ MemoryValue Memory::trySet(size_t address,
   return prev;
 }
 
-void Memory::_appendMemoryValue(std::stringstream& strm,
-                                const MemoryValue& value) {
-  std::string s = value.toHexString(false, true);
-  strm << s;
+void Memory::_appendLine(std::string& string,
+                         const MemoryValue& line,
+                         size_t byteSize,
+                         char separator) {
+  static const char hex[] = "0123456789ABCDEF";
+  const size_t cellCount = line.getSize() / byteSize;
+  if (byteSize % 8 != 0) {
+    for (size_t cell = 0; cell < cellCount; ++cell) {
+      MemoryValue value = line.subSet(cell * byteSize, (cell + 1) * byteSize);
+      string += value.toHexString(false, true);
+      string.push_back(separator);
+    }
+    return;
+  }
+  // cells are whole bytes of the internal representation, which can be
+  // formatted directly, two digits per byte starting with the highest one
+  const size_t bytesPerCell = byteSize / 8;
+  const auto& bytes = line.internal();
+  string.reserve(string.size() + cellCount * (bytesPerCell * 2 + 1));
+  for (size_t cell = 0; cell < cellCount; ++cell) {
+    const size_t first = cell * bytesPerCell;
+    for (size_t byte = first + bytesPerCell; byte-- > first;) {
+      string.push_back(hex[bytes[byte] >> 4]);
+      string.push_back(hex[bytes[byte] & 0xF]);
+    }
+    string.push_back(separator);
+  }
 }
 
 Memory::RawMapPair
@@ -172,20 +311,15 @@ Memory::_serializeRaw(char separator, size_t lineLength) const {
   const MemoryValue empty{_byteSize * lineLength};
   // iterate over all lines in memory
   for (size_t i = 0; i < lineCount; ++i) {
+    // every line is read once and converted as a whole
+    MemoryValue line{tryGet(i * lineLength, lineLength)};
     // if this line == 0x00 do not do anything at all
-    if (tryGet(i * lineLength, lineLength) != empty) {
+    if (line != empty) {
       // the key is _lineStringIdentifier and the cell address
-      std::stringstream name{};
-      name << _lineStringIdentifier;
-      name << (i * lineLength);
-      // iterate over all the cells in a line to get the value
-      std::stringstream value{};
-      for (size_t j = 0; j < lineLength; ++j) {
-        MemoryValue v{tryGet(i * lineLength + j)};
-        _appendMemoryValue(value, v);
-        value.put(separator);
-      }
-      data[name.str()] = value.str();
+      std::string value{};
+      _appendLine(value, line, _byteSize, separator);
+      data[_lineStringIdentifier + std::to_string(i * lineLength)] =
+          std::move(value);
     }
   }
   return make_pair(std::move(meta), std::move(data));
@@ -213,13 +347,17 @@ MemoryValue Memory::_deserializeLine(const std::string& line,
                                      size_t byteSize,
                                      size_t lineLength,
                                      char separator) {
-  static const std::unordered_map<char, std::uint8_t> reverseHexMap{
-      {'0', 0},  {'1', 1},  {'2', 2},  {'3', 3},  {'4', 4},  {'5', 5},
-      {'6', 6},  {'7', 7},  {'8', 8},  {'9', 9},  {'a', 10}, {'b', 11},
-      {'c', 12}, {'d', 13}, {'e', 14}, {'f', 15}, {'A', 10}, {'B', 11},
-      {'C', 12}, {'D', 13}, {'E', 14}, {'F', 15},
-  };
-  MemoryValue ret{byteSize * lineLength};
+  static const auto reverseHexMap = [] {
+    std::array<std::int8_t, 256> table;
+    table.fill(-1);
+    for (int value = 0; value < 16; ++value) {
+      table["0123456789ABCDEF"[value]] = value;
+      table["0123456789abcdef"[value]] = value;
+    }
+    return table;
+  }();
+  // the bits are collected in the internal representation directly
+  MemoryValue::Underlying bytes((byteSize * lineLength + 7) / 8, 0);
   size_t byte = lineLength;
   size_t bit = 0;
   // iterate reversely over line
@@ -236,31 +374,31 @@ MemoryValue Memory::_deserializeLine(const std::string& line,
       bit = 0;
     } else {
       // if hex hex into number
-      auto h = reverseHexMap.find(*i);
-      if (h == reverseHexMap.end()) {
+      auto hex = reverseHexMap[static_cast<unsigned char>(*i)];
+      if (hex < 0) {
         std::string badCharacter{*i};
         throw DeserializationError(
             "Could not deserialize Memory: Unexpected Character '" +
             badCharacter + "' in \"" + line + "\"");
       }
-      std::uint8_t hex = h->second;
-      // write all 4 bit of number into memoryvalue
-      for (size_t j = 0; j < 4; ++j) {
-        if (hex % 2 == 1) {
-          if (bit >= byteSize) {
-            throw DeserializationError(
-                "Could not deserialize Memory: There is a byte > max(byte)");
-          }
-          ret.put(byte * byteSize + bit);
+      if (hex != 0) {
+        // the highest bit of the digit must still be part of the cell
+        size_t highest = hex >= 8 ? 3 : hex >= 4 ? 2 : hex >= 2 ? 1 : 0;
+        if (bit + highest >= byteSize || byte >= lineLength) {
+          throw DeserializationError(
+              "Could not deserialize Memory: There is a byte > max(byte)");
+        }
+        // write all 4 bit of the digit, they might span two bytes
+        size_t address = byte * byteSize + bit;
+        bytes[address / 8] |= hex << (address % 8);
+        if (address % 8 + highest >= 8) {
+          bytes[address / 8 + 1] |= hex >> (8 - address % 8);
         }
-        ++bit;      // increment bit counter
-        hex >>= 1;  // could make this faster using long switch case
       }
+      bit += 4;
     }
-    // TODO::make actual useful assert
-    assert::that(byte >= 0);
   }
-  return ret;
+  return MemoryValue{std::move(bytes), byteSize * lineLength};
 }
 
 void Memory::deserializeJSON(const Json& json) {
@@ -299,7 +437,7 @@ void Memory::deserializeJSON(const Json& json) {
     // have to adapt to a smaller size before the size is actually reduced.
     // Otherwise there is a high chance of invalid calls to the memory.
     _byteCount = byteCount;
-    _data = MemoryValue(byteCount * _byteSize);
+    _pages.assign((_rawSize() + _pageSize - 1) / _pageSize, _zeroPage());
     _sizeCallback(_byteCount);
   } else {
     // If the snapshot has the same size or is smaller, clear the current memory
@@ -344,18 +482,91 @@ void Memory::deserializeJSON(const Json& json) {
   _wasUpdated();
 }
 
+Memory Memory::fork() const {
+  // the copy already leaves out the framebuffers
+  Memory result{*this};
+  result._callback = [](size_t, size_t) {};
+  result._sizeCallback = [](size_t) {};
+  return result;
+}
+
+MemoryValue::Underlying Memory::getRawData() const {
+  MemoryValue::Underlying data(_rawSize());
+  _readRaw(0, data.size(), data.data());
+  return data;
+}
+
+void Memory::setRawData(size_t byteCount, MemoryValue::Underlying&& data) {
+  const bool grows = _byteCount < byteCount;
+  if (grows) {
+    _byteCount = byteCount;
+  }
+  const size_t bitCount = _byteCount * _byteSize;
+  data.resize((bitCount + 7) / 8, 0);
+  if (bitCount % 8 != 0) {
+    // the bits behind the last cell have to stay zero
+    data.back() &= static_cast<std::uint8_t>((1u << (bitCount % 8)) - 1);
+  }
+  // pages without data stay shared with the zero page
+  const auto& zero = *_zeroPage();
+  _pages.assign((data.size() + _pageSize - 1) / _pageSize, _zeroPage());
+  for (size_t index = 0; index < _pages.size(); ++index) {
+    const size_t offset = index * _pageSize;
+    const size_t length = std::min(_pageSize, data.size() - offset);
+    if (!std::equal(data.begin() + offset,
+                    data.begin() + offset + length,
+                    zero.begin())) {
+      _writeRaw(offset, length, data.data() + offset);
+    }
+  }
+  if (grows) {
+    _sizeCallback(_byteCount);
+  }
+  _wasUpdated();
+}
+
+Memory::size_t Memory::getPageCount() const {
+  return (_rawSize() + _pageSize - 1) / _pageSize;
+}
+
+const std::uint8_t* Memory::getPage(size_t index) const {
+  assert::that(index < getPageCount());
+  return _pages[index]->data();
+}
+
+bool Memory::isZeroPage(size_t index) const {
+  assert::that(index < getPageCount());
+  return _pages[index] == _zeroPage();
+}
+
+bool Memory::sharesPage(size_t index, const Memory& other) const {
+  return index < getPageCount() && index < other.getPageCount() &&
+         _pages[index] == other._pages[index];
+}
+
 bool Memory::operator==(const Memory& other) const {
-  return _byteSize == other._byteSize && _byteCount == other._byteCount &&
-         _data == other._data;
+  if (_byteSize != other._byteSize || _byteCount != other._byteCount) {
+    return false;
+  }
+  // the bytes behind the data are zero in every page
+  const size_t pageCount = getPageCount();
+  for (size_t index = 0; index < pageCount; ++index) {
+    if (_pages[index] != other._pages[index] &&
+        *_pages[index] != *other._pages[index]) {
+      return false;
+    }
+  }
+  return true;
 }
 
 std::ostream& operator<<(std::ostream& stream, const Memory& value) {
+  MemoryValue data{value.getRawData(), value._byteCount * value._byteSize};
   return stream << value._byteCount << " * " << value._byteSize << "; "
-                << value._data;
+                << data;
 }
 
 void Memory::clear() {
-  _data.clear();
+  _pages.assign(_pages.size(), _zeroPage());
   _wasUpdated();
 }
 
@@ -364,9 +575,24 @@ void Memory::_wasUpdated() const {
 }
 
 void Memory::_wasUpdated(size_t address, size_t amount) const {
+  _publishFramebuffers(address, amount);
   _callback(address, amount);
 }
 
+void Memory::_publishFramebuffers(size_t address, size_t amount) const {
+  for (const auto &channel : _framebuffers) {
+    // the memory might have shrunk since the area was mapped
+    if (channel->getAddress() + channel->getSize() <= _byteCount) {
+      channel->publish(
+          [this](size_t begin, size_t cells, std::uint8_t* destination) {
+            _readRaw(begin, cells, destination);
+          },
+          address,
+          amount);
+    }
+  }
+}
+
 bool Memory::isProtected(size_t address, size_t amount) const {
   // search for any pair overlapping with the area
   auto it = _protection.lower_bound(address);
@@ -443,3 +669,26 @@ void Memory::removeProtection(size_t address, size_t amount) {
 void Memory::removeAllProtection() {
   _protection.clear();
 }
+
+std::shared_ptr<FramebufferChannel>
+Memory::mapFramebuffer(size_t address, size_t amount) {
+  if (_byteSize != 8 || amount == 0 || address + amount > _byteCount) {
+    return nullptr;
+  }
+  auto channel = std::make_shared<FramebufferChannel>(address, amount);
+  channel->publish(
+      [this](size_t begin, size_t cells, std::uint8_t* destination) {
+        _readRaw(begin, cells, destination);
+      },
+      address,
+      amount);
+  _framebuffers.push_back(channel);
+  return channel;
+}
+
+void Memory::unmapFramebuffer(
+    const std::shared_ptr<FramebufferChannel> &channel) {
+  _framebuffers.erase(
+      std::remove(_framebuffers.begin(), _framebuffers.end(), channel),
+      _framebuffers.end());
+}
@@ -19,23 +19,61 @@
 
 #include "core/parsing-and-execution-unit.hpp"
 
+#include <chrono>
+
 #include "arch/common/architecture.hpp"
 #include "arch/common/unit-information.hpp"
 #include "common/assert.hpp"
 #include "core/conversions.hpp"
 #include "parser/factory/parser-factory.hpp"
 
+namespace {
+/** How often the ui is updated while only the harts 1 to n-1 run. */
+constexpr std::chrono::milliseconds hartSyncInterval(10);
+
+/**
+ * Records an undo step for the lifetime of the object, so the step is also
+ * ended if executing the instruction throws.
+ */
+class UndoStepScope {
+ public:
+  UndoStepScope(MemoryAccess &memoryAccess, bool record)
+  : _memoryAccess(memoryAccess), _record(record) {
+    if (_record) _memoryAccess.beginUndoStep();
+  }
+
+  UndoStepScope(const UndoStepScope &) = delete;
+  UndoStepScope &operator=(const UndoStepScope &) = delete;
+
+  ~UndoStepScope() {
+    if (_record) _memoryAccess.endUndoStep();
+  }
+
+ private:
+  MemoryAccess &_memoryAccess;
+  bool _record;
+};
+}
+
 ParsingAndExecutionUnit::ParsingAndExecutionUnit(
     std::weak_ptr<Scheduler> &&scheduler,
     MemoryAccess memoryAccess,
     Architecture architecture,
     std::string parserName,
     SharedCondition stopCondition,
-    SharedCondition syncCondition)
+    SharedCondition syncCondition,
+    SharedSleepTimer sleepTimer)
 : Servant(std::move(scheduler))
 , _parser(ParserFactory::createParser(architecture, memoryAccess, parserName))
 , _stopCondition(stopCondition)
 , _syncCondition(syncCondition)
+, _sleepTimer(sleepTimer)
+, _timerQueue()
+, _continuation()
+, _suspensionCount(0)
+, _tracing(false)
+, _batchingChanges(false)
+, _hartCount(1)
 , _finalRepresentation()
 , _addressCommandMap()
 , _lineCommandCache()
@@ -47,7 +85,8 @@ ParsingAndExecutionUnit::ParsingAndExecutionUnit(
 , _throwError(([](const Translateable &) {}))
 , _setCurrentLine([](size_t) {})
 , _executionStopped([] {})
-, _syncCallback([] { assert::that(false); }) {
+, _syncCallback([] { assert::that(false); })
+, _harts() {
   // find the RegisterInformation object of the program counter
   for (UnitInformation unitInfo : architecture.getUnits()) {
     if (unitInfo.hasSpecialRegister(
@@ -59,24 +98,18 @@ ParsingAndExecutionUnit::ParsingAndExecutionUnit(
 }
 
 void ParsingAndExecutionUnit::execute() {
+  _cancelSuspension();
   if (_finalRepresentation.errorList().hasErrors()) {
-    _executionStopped();
+    _finishExecution();
     return;
   }
   _stopCondition->reset();
-  size_t nextNode = _findNextNode();
-  while (true) {
-    if (_stopCondition->getFlag()) break;
-    if (nextNode >= _finalRepresentation.commandList().size()) break;
-    if (!_executeNode(nextNode)) break;
-    nextNode = _updateLineNumber(nextNode);
-    _syncCallback();
-    _syncCondition->waitAndReset();
-  }
-  _executionStopped();
+  _startHarts();
+  _run(false);
 }
 
 void ParsingAndExecutionUnit::executeNextLine() {
+  _cancelSuspension();
   _stopCondition->reset();
   size_t nextNode = _findNextNode();
   do {
@@ -88,40 +121,99 @@ void ParsingAndExecutionUnit::executeNextLine() {
 
     // Skip nodes that aren't part of the user's program
   } while (_finalRepresentation.commandList()[nextNode].position().isEmpty());
-  _executionStopped();
+  // the user triggers the next step, a sleep would only delay the ui
+  _sleepTimer->takeRequest();
+  _finishExecution();
 }
 
 void ParsingAndExecutionUnit::executeToBreakpoint() {
+  _cancelSuspension();
   // check if there are parser errors
   if (_finalRepresentation.errorList().hasErrors()) {
-    _executionStopped();
+    _finishExecution();
     return;
   }
   // reset stop flag
   _stopCondition->reset();
-  // find the index of the next node and loop through the instructions
-  size_t nextNode = _findNextNode();
+  _startHarts();
+  _run(true);
+}
+
+void ParsingAndExecutionUnit::executePreviousLine() {
+  _cancelSuspension();
+  if (_finalRepresentation.errorList().hasErrors() || !_canUndo()) {
+    _finishExecution();
+    return;
+  }
+  _stopCondition->reset();
+  size_t currentNode;
+  do {
+    currentNode = _undoNode();
+    if (currentNode >= _finalRepresentation.commandList().size()) break;
+
+    // Skip nodes that aren't part of the user's program
+  } while (
+      _finalRepresentation.commandList()[currentNode].position().isEmpty());
+  _finishExecution();
+}
+
+void ParsingAndExecutionUnit::executeBackwardsToBreakpoint() {
+  _cancelSuspension();
+  if (_finalRepresentation.errorList().hasErrors() || !_canUndo()) {
+    _finishExecution();
+    return;
+  }
+  _stopCondition->reset();
   while (true) {
     if (_stopCondition->getFlag()) break;
-    if (nextNode >= _finalRepresentation.commandList().size()) break;
-    if (!_executeNode(nextNode)) break;
-    nextNode = _updateLineNumber(nextNode);
-    // check if there is a brekpoint on the next line
-    if (nextNode < _finalRepresentation.commandList().size()) {
-      const auto &nextCommand = _finalRepresentation.commandList()[nextNode];
-      size_t nextLine = nextCommand.position().startLine();
-      if (_breakpoints.count(nextLine) > 0) {
-        // we reached a breakpoint
-        break;
-      }
-      _syncCallback();
-      _syncCondition->waitAndReset();
-    }
+    size_t currentNode = _undoNode();
+    if (currentNode >= _finalRepresentation.commandList().size()) break;
+    // stop in front of the breakpoint, like executeToBreakpoint() does
+    const auto &currentCommand =
+        _finalRepresentation.commandList()[currentNode];
+    if (_breakpoints.count(currentCommand.position().startLine()) > 0) break;
+    _memoryAccess.flushChanges();
+    _syncCallback();
+    _syncCondition->waitAndReset();
+  }
+  _finishExecution();
+}
+
+void ParsingAndExecutionUnit::interruptSleep() {
+  _resume(_suspensionCount);
+}
+
+bool ParsingAndExecutionUnit::startTrace(const std::string &path,
+                                          bool compress) {
+  _tracing = _memoryAccess.startTrace(path, compress).get();
+  if (_tracing) _traceProgram();
+  return _tracing;
+}
+
+std::uint64_t ParsingAndExecutionUnit::stopTrace() {
+  _tracing = false;
+  return _memoryAccess.stopTrace().get();
+}
+
+void ParsingAndExecutionUnit::setHartCount(size_t count) {
+  assert::that(count > 0);
+  _stopHarts();
+  _memoryAccess.setHartCount(count);
+  _hartCount = count;
+  // the steps of hart 0 would not include the writes of the other harts
+  if (_hartCount > 1) _memoryAccess.clearUndoLog();
+  // all harts start where hart 0 is
+  auto programCounter =
+      _memoryAccess.getRegisterValue(_programCounter.getName()).get();
+  for (size_t hart = 1; hart < _hartCount; ++hart) {
+    _memoryAccess.forHart(hart).putRegisterValue(_programCounter.getName(),
+                                                 programCounter);
   }
-  _executionStopped();
 }
 
 void ParsingAndExecutionUnit::setExecutionPoint(size_t line) {
+  // a sleeping program must not wake up at the new execution point
+  _abortSuspension();
   MemoryValue address;
   bool foundMatchingLine = false;
   int displayLine = line;
@@ -151,11 +243,18 @@ void ParsingAndExecutionUnit::setExecutionPoint(size_t line) {
   }
   // a command on this line was found, set the program counter and the line in
   // the ui.
-  _memoryAccess.putRegisterValue(_programCounter.getName(), address);
+  for (size_t hart = 0; hart < _hartCount; ++hart) {
+    _memoryAccess.forHart(hart).putRegisterValue(_programCounter.getName(),
+                                                 address);
+  }
   _setCurrentLine(displayLine);
 }
 
 void ParsingAndExecutionUnit::parse(std::string code) {
+  // the harts must not execute the old program while it is replaced, and a
+  // sleeping program must not wake up in the new one
+  _abortSuspension();
+  _stopHarts();
   // delete old assembled program in memory
   if (!_finalRepresentation.errorList().hasErrors()) {
     for (const auto &command : _finalRepresentation.commandList()) {
@@ -170,6 +269,8 @@ void ParsingAndExecutionUnit::parse(std::string code) {
   _finalRepresentation = _parser->parse(code);
   _addressCommandMap = _finalRepresentation.createMapping();
   _lineCommandCache.clear();
+  // the recorded instructions belong to the old program
+  _memoryAccess.clearUndoLog();
   // update the final representation of the ui
   _setFinalRepresentation(_finalRepresentation);
   // assemble commands into memory
@@ -180,6 +281,7 @@ void ParsingAndExecutionUnit::parse(std::string code) {
       _memoryAccess.makeMemoryProtected(command.address(),
                                         assemble.getSize() / 8);
     }
+    if (_tracing) _traceProgram();
     // update the execution marker if a node is found
     auto nextNode = _findNextNode();
     if (nextNode < _finalRepresentation.commandList().size()) {
@@ -206,6 +308,10 @@ ParsingAndExecutionUnit::getSyntaxRegex(SyntaxInformation::Token token) const {
   return _syntaxInformation.getSyntaxRegex(token);
 }
 
+SyntaxInformation::Lexer ParsingAndExecutionUnit::getSyntaxLexer() const {
+  return _syntaxInformation.getLexer();
+}
+
 void ParsingAndExecutionUnit::setSetContextInformationCallback(
     ListCallback<ContextInformation> callback) {
   _setContextInformation = callback;
@@ -235,10 +341,15 @@ void ParsingAndExecutionUnit::setSyncCallback(const Callback<> &callback) {
 }
 
 size_t ParsingAndExecutionUnit::_findNextNode() {
+  return _findNextNode(_memoryAccess);
+}
+
+size_t
+ParsingAndExecutionUnit::_findNextNode(MemoryAccess &memoryAccess) const {
   // get the value of the program counter and convert it to a std::size_t
   std::string programCounterName = _programCounter.getName();
   MemoryValue programCounterValue =
-      _memoryAccess.getRegisterValue(programCounterName).get();
+      memoryAccess.getRegisterValue(programCounterName).get();
   size_t nextInstructionAddress =
       conversions::convert<size_t>(programCounterValue);
   // find the instruction address from the program counter value
@@ -267,6 +378,11 @@ bool ParsingAndExecutionUnit::_executeNode(size_t nodeIndex) {
   // update the current line in the ui (pre-execution)
   _setCurrentLine(currentCommand.position().startLine());
 
+  _beginChangeBatch();
+  if (_tracing) _memoryAccess.traceStep(currentCommand.address());
+  // record everything this instruction overwrites, including the pc, unless
+  // other harts write to the memory as well
+  UndoStepScope undoStep(_memoryAccess, _hartCount == 1);
   MemoryValue programCounterValue =
       currentCommand.node()->getValue(_memoryAccess);
   _memoryAccess.putRegisterValue(_programCounter.getName(),
@@ -274,6 +390,24 @@ bool ParsingAndExecutionUnit::_executeNode(size_t nodeIndex) {
   return true;
 }
 
+bool ParsingAndExecutionUnit::_stepHart(MemoryAccess &memoryAccess) const {
+  if (_stopCondition->getFlag()) return false;
+  size_t nodeIndex = _findNextNode(memoryAccess);
+  if (nodeIndex >= _finalRepresentation.commandList().size()) return false;
+
+  auto &currentCommand = _finalRepresentation.commandList()[nodeIndex];
+  auto validationResult = currentCommand.node()->validateRuntime(memoryAccess);
+  if (!validationResult.isSuccess()) {
+    _throwError(validationResult.getMessage());
+    return false;
+  }
+  MemoryValue programCounterValue =
+      currentCommand.node()->getValue(memoryAccess);
+  memoryAccess.putRegisterValue(_programCounter.getName(),
+                                programCounterValue);
+  return true;
+}
+
 size_t ParsingAndExecutionUnit::_updateLineNumber(size_t currentNode) {
   assert::that(currentNode < _finalRepresentation.commandList().size());
 
@@ -289,3 +423,139 @@ size_t ParsingAndExecutionUnit::_updateLineNumber(size_t currentNode) {
   _setCurrentLine(nextLine);
   return nextNode;
 }
+
+size_t ParsingAndExecutionUnit::_undoNode() {
+  _beginChangeBatch();
+  if (!_memoryAccess.undoStep().get()) {
+    return _finalRepresentation.commandList().size();
+  }
+  size_t currentNode = _findNextNode();
+  if (currentNode < _finalRepresentation.commandList().size()) {
+    auto &currentCommand = _finalRepresentation.commandList()[currentNode];
+    _setCurrentLine(currentCommand.position().startLine());
+  }
+  return currentNode;
+}
+
+void ParsingAndExecutionUnit::_run(bool stopAtBreakpoint) {
+  // find the index of the next node and loop through the instructions
+  size_t nextNode = _findNextNode();
+  while (true) {
+    if (_stopCondition->getFlag()) break;
+    if (nextNode >= _finalRepresentation.commandList().size()) {
+      // hart 0 left the program, the other harts may still be running
+      _waitForHarts();
+      break;
+    }
+    if (!_executeNode(nextNode)) break;
+    nextNode = _updateLineNumber(nextNode);
+    // check if there is a brekpoint on the next line
+    if (stopAtBreakpoint &&
+        nextNode < _finalRepresentation.commandList().size()) {
+      const auto &nextCommand = _finalRepresentation.commandList()[nextNode];
+      size_t nextLine = nextCommand.position().startLine();
+      if (_breakpoints.count(nextLine) > 0) {
+        // we reached a breakpoint
+        break;
+      }
+    }
+    _memoryAccess.flushChanges();
+    _syncCallback();
+    _syncCondition->waitAndReset();
+    // yield to other tasks while the program sleeps
+    auto continuation = [this, stopAtBreakpoint] { _run(stopAtBreakpoint); };
+    if (_suspendForSleep(continuation)) return;
+  }
+  _finishExecution();
+}
+
+bool ParsingAndExecutionUnit::_suspendForSleep(Callback<> &&continuation) {
+  if (!_sleepTimer->hasRequest()) return false;
+  auto duration = _sleepTimer->takeRequest();
+  _continuation = std::move(continuation);
+  // show the state of the program while it sleeps
+  _endChangeBatch();
+  auto suspension = ++_suspensionCount;
+  // the timer thread only posts the wake-up into this servant's queue
+  _timerQueue.schedule(duration,
+                       makeSafeCallback(std::function<void()>(
+                           [this, suspension] { _resume(suspension); })));
+  return true;
+}
+
+void ParsingAndExecutionUnit::_resume(size_t suspension) {
+  if (suspension != _suspensionCount || !_continuation) return;
+  auto continuation = std::move(_continuation);
+  _continuation = nullptr;
+  continuation();
+}
+
+void ParsingAndExecutionUnit::_cancelSuspension() {
+  _stopHarts();
+  _continuation = nullptr;
+  ++_suspensionCount;
+  _sleepTimer->takeRequest();
+}
+
+void ParsingAndExecutionUnit::_abortSuspension() {
+  if (!_continuation) return;
+  _cancelSuspension();
+  _finishExecution();
+}
+
+void ParsingAndExecutionUnit::_beginChangeBatch() {
+  if (_batchingChanges) return;
+  _memoryAccess.beginChangeBatch();
+  _batchingChanges = true;
+}
+
+void ParsingAndExecutionUnit::_endChangeBatch() {
+  if (!_batchingChanges) return;
+  _memoryAccess.endChangeBatch();
+  _batchingChanges = false;
+}
+
+void ParsingAndExecutionUnit::_startHarts() {
+  if (_hartCount < 2) return;
+  _harts.start(_hartCount,
+               _memoryAccess,
+               _sleepTimer->isVirtualTime(),
+               [this](MemoryAccess &memoryAccess) {
+                 return _stepHart(memoryAccess);
+               });
+}
+
+void ParsingAndExecutionUnit::_stopHarts() {
+  _harts.stop();
+}
+
+void ParsingAndExecutionUnit::_waitForHarts() {
+  while (!_stopCondition->getFlag() &&
+         !_harts.waitUntilDone(hartSyncInterval)) {
+    _memoryAccess.flushChanges();
+    _syncCallback();
+    _syncCondition->waitAndReset();
+  }
+}
+
+bool ParsingAndExecutionUnit::_canUndo() {
+  if (_hartCount == 1) return true;
+  _throwError(Translateable(QT_TRANSLATE_NOOP(
+      "Execution", "Stepping back is not possible with more than one hart.")));
+  return false;
+}
+
+void ParsingAndExecutionUnit::_finishExecution() {
+  _stopHarts();
+  _endChangeBatch();
+  _executionStopped();
+}
+
+void ParsingAndExecutionUnit::_traceProgram() {
+  if (_finalRepresentation.errorList().hasErrors()) return;
+  TraceWriter::Program program;
+  for (const auto &command : _finalRepresentation.commandList()) {
+    program.push_back({command.address(), command.node()->assemble()});
+  }
+  _memoryAccess.traceProgram(program);
+}
@@ -0,0 +1,59 @@
+/* C++ Assembler Interpreter
+ * Copyright (C) 2016 Chair of Computer Architecture
+ * at Technical University of Munich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "core/project-factory.hpp"
+
+#include "core/project.hpp"
+
+std::mutex ProjectFactory::_mutex;
+std::map<ProjectFactory::Key, ProjectFactory::TemplatePointer>
+    ProjectFactory::_templates;
+
+ProjectFactory::Template::Template(const ArchitectureFormula& formula)
+: architecture(Architecture::Brew(formula)), registers() {
+  Project::createRegisters(architecture, registers, 0);
+}
+
+ProjectFactory::TemplatePointer
+ProjectFactory::getTemplate(const ArchitectureFormula& formula) {
+  auto key = _key(formula);
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto iterator = _templates.find(key);
+  if (iterator == _templates.end()) {
+    // projects of other formulas wait as well, brewing happens rarely
+    auto created = std::make_shared<const Template>(formula);
+    iterator = _templates.emplace(std::move(key), std::move(created)).first;
+  }
+  return iterator->second;
+}
+
+void ProjectFactory::prewarm(const ArchitectureFormula& formula) {
+  getTemplate(formula);
+}
+
+void ProjectFactory::clear() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _templates.clear();
+}
+
+ProjectFactory::Key ProjectFactory::_key(const ArchitectureFormula& formula) {
+  Key key{formula.getArchitectureName()};
+  key.insert(key.end(), formula.begin(), formula.end());
+  return key;
+}
@@ -26,10 +26,11 @@ ProjectModule::ProjectModule(const ArchitectureFormula& architectureFormula,
                              const std::string& parserName)
 : _stopCondition(std::make_shared<ConditionTimer>())
 , _syncCondition(std::make_shared<ConditionTimer>())
+, _sleepTimer(std::make_shared<SleepTimer>())
 , _schedulerProject(std::make_shared<Scheduler>())
 , _schedulerParsingAndExecution(std::make_shared<Scheduler>())
 , _proxyProject(std::move(_schedulerProject), architectureFormula, memorySize)
-, _memoryAccess(_proxyProject, _stopCondition)
+, _memoryAccess(_proxyProject, _sleepTimer)
 , _memoryManager(_proxyProject)
 , _architectureAccess(_proxyProject)
 , _proxyParsingAndExecution(std::move(_schedulerParsingAndExecution),
@@ -37,7 +38,8 @@ ProjectModule::ProjectModule(const ArchitectureFormula& architectureFormula,
                             _architectureAccess.getArchitecture().get(),
                             parserName,
                             _stopCondition,
-                            _syncCondition)
+                            _syncCondition,
+                            _sleepTimer)
 , _commandInterface(_proxyParsingAndExecution)
 , _parserInterface(_proxyParsingAndExecution) {
 }
@@ -71,8 +73,14 @@ void ProjectModule::reset() {
 
 void ProjectModule::stopExecution() {
   _stopCondition->notifyAll();
+  // a sleeping program would only notice the stop flag after the sleep
+  _commandInterface.interruptSleep();
 }
 
 void ProjectModule::guiReady() {
   _syncCondition->notifyOne();
 }
+
+SleepTimer& ProjectModule::getSleepTimer() {
+  return *_sleepTimer;
+}
@@ -22,50 +22,94 @@
 #include "arch/common/register-information.hpp"
 #include "arch/common/unit-information.hpp"
 #include "common/assert.hpp"
+#include "core/conversions.hpp"
 #include "core/deserialization-error.hpp"
+#include "core/memory-ring-buffer.hpp"
 
 Project::Project(std::weak_ptr<Scheduler> &&scheduler,
                  const ArchitectureFormula &architectureFormula,
                  size_t memorySize)
+: Project(std::move(scheduler),
+          architectureFormula,
+          memorySize,
+          ProjectFactory::getTemplate(architectureFormula)) {
+}
+
+Project::Project(std::weak_ptr<Scheduler> &&scheduler,
+                 const ArchitectureFormula &architectureFormula,
+                 size_t memorySize,
+                 const ProjectFactory::TemplatePointer &projectTemplate)
 : Servant(std::move(scheduler))
-, _architecture(Architecture::Brew(architectureFormula))
+, _architecture(projectTemplate->architecture)
 , _memory(memorySize, _architecture.getByteSize())
-, _registerSet()
+, _registerSet(projectTemplate->registers)
+, _otherHarts()
+, _reservations(1)
+, _undoLog()
+, _traceWriter()
 , _architectureFormula(architectureFormula)
-, _errorCallback([](const Translateable &) {}) {
+, _errorCallback([](const Translateable &) {})
+, _registerCallback([](const std::string &) {})
+, _memoryCallback([](size_t, size_t) {})
+, _changes()
+, _batchingChanges(false)
+, _lastReport()
+, _registerSnapshots(std::make_shared<RegisterSnapshotChannel>())
+, _registerVersion(0)
+, _publishedMemorySize(
+      std::make_shared<std::atomic<size_t>>(_memory.getByteCount())) {
   _architecture.validate();
+  _memory.setCallback([this](size_t address, size_t amount) {
+    _memoryChanged(address, amount);
+  });
+  setUpdateMemorySizeCallback([](size_t) {});
+  _registerSet.setCallback(
+      [this](const std::string &name) { _registerChanged(name); });
 
-  for (UnitInformation unitInfo : _architecture.getUnits()) {
+  // the registers were created without callbacks, they are published at once
+  _publishRegisters();
+}
+
+void Project::createRegisters(const Architecture &architecture,
+                              RegisterSet &registerSet,
+                              size_t hart) {
+  for (const auto &unitInfo : architecture.getUnits()) {
     for (const auto &registerPair : unitInfo) {
       // create all top level registers
-      _createRegister(registerPair.second, unitInfo);
+      _createRegister(registerSet, registerPair.second, unitInfo, hart);
     }
     // create special registers
     for (const auto &registerPair : unitInfo.getSpecialRegisters()) {
-      _createRegister(registerPair.second, unitInfo);
+      _createRegister(registerSet, registerPair.second, unitInfo, hart);
     }
   }
 }
 
-void Project::_createRegister(RegisterInformation registerInfo,
-                              UnitInformation unitInfo) {
+void Project::_createRegister(RegisterSet &registerSet,
+                              const RegisterInformation &registerInfo,
+                              const UnitInformation &unitInfo,
+                              size_t hart) {
   if (!registerInfo.hasEnclosing()) {
     MemoryValue startValue{registerInfo.getSize()};
     // if this register is hardwired to some constant
     if (registerInfo.isConstant()) {
       startValue = registerInfo.getConstant();
     }
-    _registerSet.createRegister(
+    if (registerInfo.getType() == RegisterInformation::Type::HART_ID) {
+      startValue = conversions::convert(hart, registerInfo.getSize());
+    }
+    registerSet.createRegister(
         registerInfo.getName(), startValue, registerInfo.isConstant());
-    _registerSet.aliasRegister(
+    registerSet.aliasRegister(
         registerInfo.getAliases(), registerInfo.getName(), 0, true);
     // create all constituents and their constituents
-    _createConstituents(registerInfo, unitInfo);
+    _createConstituents(registerSet, registerInfo, unitInfo);
   }
 }
 
-void Project::_createConstituents(RegisterInformation enclosingRegister,
-                                  UnitInformation unitInfo) {
+void Project::_createConstituents(RegisterSet &registerSet,
+                                  const RegisterInformation &enclosingRegister,
+                                  const UnitInformation &unitInfo) {
   for (const auto &constituentInformation :
        enclosingRegister.getConstituents()) {
     // find RegisterInformation of the constituent
@@ -76,7 +120,7 @@ void Project::_createConstituents(RegisterInformation enclosingRegister,
     // clang-format off
     auto startOffset = constituentInformation.getEnclosingOffset();
     auto endOffset = startOffset + constituentRegisterInfo.getSize();
-    _registerSet.aliasRegister(
+    registerSet.aliasRegister(
       constituentRegisterInfo.getName(),
       enclosingRegister.getName(),
       startOffset,
@@ -84,7 +128,7 @@ void Project::_createConstituents(RegisterInformation enclosingRegister,
       false
     );
 
-    _registerSet.aliasRegister(
+    registerSet.aliasRegister(
       constituentRegisterInfo.getAliases(),
       constituentRegisterInfo.getName(),
       0,
@@ -94,41 +138,65 @@ void Project::_createConstituents(RegisterInformation enclosingRegister,
 
     // recursive call to create constituents of this constituent
     if (constituentRegisterInfo.hasConstituents()) {
-      _createConstituents(constituentRegisterInfo, unitInfo);
+      _createConstituents(registerSet, constituentRegisterInfo, unitInfo);
     }
   }
 }
 
 MemoryValue Project::getMemoryValueAt(size_t address, size_t amount) const {
+  if (_isTracing()) _traceWriter->readMemory(address, amount);
   return _memory.get(address, amount);
 }
 
 MemoryValue Project::tryGetMemoryValueAt(size_t address, size_t amount) const {
+  if (_isTracing()) _traceWriter->readMemory(address, amount);
   return _memory.tryGet(address, amount);
 }
 
 void Project::putMemoryValueAt(size_t address,
                                const MemoryValue &value,
                                bool ignoreProtection) {
-  _memory.put(address, value, ignoreProtection);
+  if (_isTracing()) _traceWriter->writeMemory(address, value);
+  if (_undoLog.isRecording()) {
+    _undoLog.recordMemory(address,
+                          _memory.set(address, value, ignoreProtection));
+  } else {
+    _memory.put(address, value, ignoreProtection);
+  }
 }
 
 void Project::tryPutMemoryValueAt(size_t address,
                                   const MemoryValue &value,
                                   bool ignoreProtection) {
-  _memory.tryPut(address, value, ignoreProtection);
+  if (_isTracing()) _traceWriter->writeMemory(address, value);
+  if (_undoLog.isRecording()) {
+    _undoLog.recordMemory(address,
+                          _memory.trySet(address, value, ignoreProtection));
+  } else {
+    _memory.tryPut(address, value, ignoreProtection);
+  }
 }
 
 MemoryValue Project::setMemoryValueAt(size_t address,
                                       const MemoryValue &value,
                                       bool ignoreProtection) {
-  return _memory.set(address, value, ignoreProtection);
+  if (_isTracing()) _traceWriter->writeMemory(address, value);
+  auto previous = _memory.set(address, value, ignoreProtection);
+  if (_undoLog.isRecording()) {
+    _undoLog.recordMemory(address, previous);
+  }
+  return previous;
 }
 
 MemoryValue Project::trySetMemoryValueAt(size_t address,
                                          const MemoryValue &value,
                                          bool ignoreProtection) {
-  return _memory.trySet(address, value, ignoreProtection);
+  if (_isTracing()) _traceWriter->writeMemory(address, value);
+  auto previous = _memory.trySet(address, value, ignoreProtection);
+  if (_undoLog.isRecording()) {
+    _undoLog.recordMemory(address, previous);
+  }
+  return previous;
 }
 
 bool Project::isMemoryProtectedAt(size_t address, size_t amount) const {
@@ -143,24 +211,129 @@ void Project::removeMemoryProtection(size_t address, size_t amount) {
   return _memory.removeProtection(address, amount);
 }
 
+std::shared_ptr<FramebufferChannel>
+Project::mapFramebuffer(size_t address, size_t amount) {
+  return _memory.mapFramebuffer(address, amount);
+}
+
+void Project::unmapFramebuffer(
+    const std::shared_ptr<FramebufferChannel> &channel) {
+  _memory.unmapFramebuffer(channel);
+}
+
+std::string Project::drainRingBuffer(size_t address, size_t capacity) {
+  if (capacity < 2) return std::string();
+  MemoryRingBuffer buffer(address, capacity);
+  if (!buffer.fitsInto(_memory)) return std::string();
+  return buffer.drain(_memory);
+}
+
+bool Project::fillRingBuffer(size_t address,
+                             size_t capacity,
+                             const std::string &data) {
+  if (capacity < 2) return false;
+  MemoryRingBuffer buffer(address, capacity);
+  if (!buffer.fitsInto(_memory)) return false;
+  return buffer.fill(_memory, data);
+}
+
 MemoryValue Project::getRegisterValue(const std::string &name) const {
   return _registerSet.get(name);
 }
 
 void Project::putRegisterValue(const std::string &name,
                                const MemoryValue &value) {
-  _registerSet.put(name, value);
+  if (_isTracing()) _traceWriter->writeRegister(name, value);
+  if (_undoLog.isRecording()) {
+    _undoLog.recordRegister(name, _registerSet.set(name, value));
+  } else {
+    _registerSet.put(name, value);
+  }
 }
 
 MemoryValue
 Project::setRegisterValue(const std::string &name, const MemoryValue &value) {
-  return _registerSet.set(name, value);
+  if (_isTracing()) _traceWriter->writeRegister(name, value);
+  auto previous = _registerSet.set(name, value);
+  if (_undoLog.isRecording()) {
+    _undoLog.recordRegister(name, previous);
+  }
+  return previous;
+}
+
+size_t Project::getHartCount() const {
+  return _reservations.size();
+}
+
+void Project::setHartCount(size_t count) {
+  assert::that(count > 0);
+  _otherHarts.clear();
+  _otherHarts.resize(count - 1);
+  for (size_t hart = 1; hart < count; ++hart) {
+    createRegisters(_architecture, _hartRegisters(hart), hart);
+  }
+  _reservations.assign(count, Reservation());
+}
+
+MemoryValue
+Project::getHartRegisterValue(size_t hart, const std::string &name) const {
+  if (hart == 0) return getRegisterValue(name);
+  return _hartRegisters(hart).get(name);
+}
+
+void Project::putHartRegisterValue(size_t hart,
+                                   const std::string &name,
+                                   const MemoryValue &value) {
+  if (hart == 0) {
+    putRegisterValue(name, value);
+  } else {
+    _hartRegisters(hart).put(name, value);
+  }
+}
+
+MemoryValue Project::setHartRegisterValue(size_t hart,
+                                          const std::string &name,
+                                          const MemoryValue &value) {
+  if (hart == 0) return setRegisterValue(name, value);
+  return _hartRegisters(hart).set(name, value);
+}
+
+RegisterID Project::getRegisterID(const std::string &name) const {
+  return _registerSet.getID(name);
+}
+
+IntegerOperand
+Project::getHartRegisterOperand(size_t hart, const RegisterID &id) const {
+  if (hart == 0) return _registerSet.getOperand(id);
+  return _hartRegisters(hart).getOperand(id);
+}
+
+MemoryValue Project::loadReserved(size_t hart, size_t address, size_t amount) {
+  auto value = getMemoryValueAt(address, amount);
+  _reservations.at(hart) = Reservation{address, amount, true};
+  return value;
+}
+
+bool Project::storeConditional(size_t hart,
+                               size_t address,
+                               const MemoryValue &value) {
+  auto &reservation = _reservations.at(hart);
+  auto amount = value.getSize() / _architecture.getByteSize();
+  bool reserved = reservation.valid && reservation.address == address &&
+                  reservation.amount == amount;
+  reservation.valid = false;
+  if (reserved) putMemoryValueAt(address, value);
+  return reserved;
 }
 
 UnitContainer Project::getRegisterUnits() const {
   return _architecture.getUnits();
 }
 
+std::shared_ptr<RegisterSnapshotChannel> Project::getRegisterSnapshots() const {
+  return _registerSnapshots;
+}
+
 Architecture::byte_size_t Project::getByteSize() const {
   return _architecture.getByteSize();
 }
@@ -169,15 +342,24 @@ size_t Project::getMemorySize() const {
   return _memory.getByteCount();
 }
 
+std::shared_ptr<const std::atomic<size_t>>
+Project::getPublishedMemorySize() const {
+  return _publishedMemorySize;
+}
+
 InstructionSet Project::getInstructionSet() const {
   return _architecture.getInstructions();
 }
 
 void Project::resetMemory() {
   _memory.clear();
+  _undoLog.clear();
 }
 
 void Project::resetRegisters() {
+  _undoLog.clear();
+  // the other harts are created anew
+  setHartCount(getHartCount());
   for (UnitInformation unitInfo : _architecture.getUnits()) {
     // set the normal registers to zero
     for (const auto &registerPair : unitInfo) {
@@ -190,6 +372,51 @@ void Project::resetRegisters() {
   }
 }
 
+void Project::beginUndoStep() {
+  _undoLog.beginStep();
+}
+
+void Project::endUndoStep() {
+  _undoLog.endStep();
+}
+
+bool Project::undoStep() {
+  return _undoLog.undoStep(_memory, _registerSet);
+}
+
+size_t Project::getUndoStepCount() const {
+  return _undoLog.getStepCount();
+}
+
+void Project::clearUndoLog() {
+  _undoLog.clear();
+}
+
+bool Project::startTrace(const std::string &path, bool compress) {
+  _traceWriter = std::make_unique<TraceWriter>(path, compress);
+  if (!_traceWriter->isGood()) {
+    _traceWriter.reset();
+    return false;
+  }
+  return true;
+}
+
+void Project::traceProgram(const TraceWriter::Program &program) {
+  if (_traceWriter) _traceWriter->writeProgram(program);
+}
+
+void Project::traceStep(size_t address) {
+  if (_traceWriter) _traceWriter->beginStep(address);
+}
+
+std::uint64_t Project::stopTrace() {
+  if (!_traceWriter) return 0;
+  _traceWriter->close();
+  auto steps = _traceWriter->getStepCount();
+  _traceWriter.reset();
+  return steps;
+}
+
 void Project::loadSnapshot(const Snapshot &snapshot) {
   if (!snapshot.isValid()) {
     _errorCallback("Snapshot format is not valid.");
@@ -199,6 +426,7 @@ void Project::loadSnapshot(const Snapshot &snapshot) {
     _errorCallback("This snapshot was created with a different architecture.");
     return;
   }
+  _undoLog.clear();
   try {
     _memory.deserializeJSON(snapshot.getMemoryJson());
     _registerSet.deserializeJSON(snapshot.getRegisterJson());
@@ -207,11 +435,72 @@ void Project::loadSnapshot(const Snapshot &snapshot) {
   }
 }
 
+bool Project::_isTracing() const noexcept {
+  return _traceWriter && _undoLog.isRecording();
+}
+
 Snapshot Project::generateSnapshot() const {
   Snapshot snapshot(_architectureFormula, _memory, _registerSet);
   return snapshot;
 }
 
+void Project::loadBinarySnapshot(const BinarySnapshot &snapshot) {
+  loadDeltaSnapshot(BinarySnapshot(), snapshot);
+}
+
+void Project::loadDeltaSnapshot(const BinarySnapshot &base,
+                                const BinarySnapshot &delta) {
+  if (!delta.isValid()) {
+    _errorCallback("Snapshot format is not valid.");
+    return;
+  }
+  if (delta.getArchitectureFormula() != _architectureFormula) {
+    _errorCallback("This snapshot was created with a different architecture.");
+    return;
+  }
+  _undoLog.clear();
+  try {
+    delta.restore(base, _memory, _registerSet);
+  } catch (const DeserializationError &exception) {
+    _errorCallback(exception.what());
+  }
+}
+
+BinarySnapshot Project::generateBinarySnapshot() const {
+  return BinarySnapshot(_architectureFormula, _memory, _registerSet);
+}
+
+BinarySnapshot
+Project::generateDeltaSnapshot(const BinarySnapshot &base) const {
+  return BinarySnapshot(_architectureFormula, _memory, _registerSet, base);
+}
+
+Project::Checkpoint Project::createCheckpoint() const {
+  Checkpoint checkpoint{_memory.fork(), {}, generateBinarySnapshot()};
+  for (const auto &name : _registerSet.getParentNames()) {
+    checkpoint.registers.emplace_back(name, _registerSet.get(name));
+  }
+  return checkpoint;
+}
+
+void Project::restoreCheckpoint(const Checkpoint &checkpoint) {
+  _undoLog.clear();
+  // keeps the callbacks and framebuffers of the memory
+  _memory = checkpoint.memory;
+  for (const auto &entry : checkpoint.registers) {
+    _registerSet.put(entry.first, entry.second);
+  }
+}
+
+BinarySnapshot
+Project::generateDeltaSnapshot(const Checkpoint &checkpoint) const {
+  return BinarySnapshot(_architectureFormula,
+                        _memory,
+                        _registerSet,
+                        checkpoint.snapshot,
+                        checkpoint.memory);
+}
+
 void Project::_setRegisterToZero(RegisterInformation registerInfo) {
   if (!registerInfo.isConstant() && !registerInfo.hasEnclosing()) {
     // create a empty MemoryValue as long as the register
@@ -246,21 +535,90 @@ Project::StringToMemoryValue Project::getFloatToMemoryValue() const {
 
 void Project::setUpdateRegisterCallback(
     Callback<const std::string &> callback) {
-  _registerSet.setCallback(callback);
+  _registerCallback = callback;
 }
 
 void Project::setUpdateMemoryCallback(Callback<size_t, size_t> callback) {
-  _memory.setCallback(callback);
+  _memoryCallback = callback;
 }
 
 void Project::setUpdateMemorySizeCallback(Callback<size_t> callback) {
-  _memory.setSizeCallback(callback);
+  _memory.setSizeCallback([this, callback](size_t size) {
+    _publishedMemorySize->store(size);
+    callback(size);
+  });
 }
 
 void Project::setErrorCallback(ErrorCallback callback) {
   _errorCallback = callback;
 }
 
+void Project::beginChangeBatch() {
+  _batchingChanges = true;
+}
+
+void Project::endChangeBatch() {
+  _batchingChanges = false;
+  _reportChanges();
+}
+
+void Project::flushChanges() {
+  // about the refresh rate of a screen, the ui cannot show more anyways
+  static const auto frame = std::chrono::milliseconds(16);
+  if (!_changes.isDirty()) return;
+  if (std::chrono::steady_clock::now() - _lastReport < frame) return;
+  _reportChanges();
+}
+
+void Project::_memoryChanged(size_t address, size_t amount) {
+  _breakReservations(address, amount);
+  if (_batchingChanges) {
+    _changes.markMemory(address, amount);
+  } else {
+    _memoryCallback(address, amount);
+  }
+}
+
+void Project::_registerChanged(const std::string &name) {
+  if (_batchingChanges) {
+    _changes.markRegister(name);
+  } else {
+    _publishRegisters();
+    _registerCallback(name);
+  }
+}
+
+void Project::_reportChanges() {
+  _lastReport = std::chrono::steady_clock::now();
+  if (!_changes.isDirty()) return;
+  _publishRegisters();
+  _changes.flush(_memory.getByteCount(), _memoryCallback, _registerCallback);
+}
+
+RegisterSet &Project::_hartRegisters(size_t hart) {
+  assert::that(hart > 0);
+  return _otherHarts.at(hart - 1);
+}
+
+const RegisterSet &Project::_hartRegisters(size_t hart) const {
+  assert::that(hart > 0);
+  return _otherHarts.at(hart - 1);
+}
+
+void Project::_breakReservations(size_t address, size_t amount) {
+  for (auto &reservation : _reservations) {
+    auto end = reservation.address + reservation.amount;
+    if (reservation.valid && address < end &&
+        reservation.address < address + amount) {
+      reservation.valid = false;
+    }
+  }
+}
+
+void Project::_publishRegisters() {
+  _registerSnapshots->publish(_registerSet.takeSnapshot(++_registerVersion));
+}
+
 Architecture Project::getArchitecture() const {
   return _architecture;
 }
@@ -76,6 +76,20 @@ RegisterSet::set(const std::string &name, const MemoryValue &value) {
   return previous;
 }
 
+RegisterID RegisterSet::getID(const std::string &name) const {
+  auto registerIterator = _dict.find(name);
+  assert::that(registerIterator != _dict.end());
+  return registerIterator->second;
+}
+
+IntegerOperand RegisterSet::getOperand(const RegisterID &id) const {
+  const auto &parent = _register[id.address];
+  if (id.begin == 0 && static_cast<std::size_t>(id.end) == parent.getSize()) {
+    return IntegerOperand{parent};
+  }
+  return IntegerOperand{parent.subSet(id.begin, id.end)};
+}
+
 std::size_t RegisterSet::getSize(const std::string &name) const {
   assert::that(existsRegister(name));
   auto registerIterator = _dict.find(name);
@@ -94,6 +108,7 @@ void RegisterSet::createRegister(const std::string &name,
                                  const MemoryValue &value,
                                  bool constant) {
   assert::that(_dict.find(name) == _dict.end());
+  _snapshotDictionary.reset();
   _dict.emplace(name, RegisterID(_register.size(), 0, value.getSize()));
   _register.emplace_back(MemoryValue(value));
   _updateSet.push_back(std::set<std::string>{name});
@@ -131,6 +146,7 @@ void RegisterSet::aliasRegister(const std::string &name,
   assert::that(begin >= 0);
   assert::that(end <= _register[parentID.address].getSize());
   assert::that(end - begin > 0);
+  _snapshotDictionary.reset();
   _dict.emplace(name,
                 RegisterID(parentID.address,
                            begin + parentID.begin,
@@ -150,6 +166,7 @@ void RegisterSet::aliasRegister(const std::string &name,
   auto parentID = parentIterator->second;
   assert::that(begin >= 0);
   assert::that(_register[parentID.address].getSize() - begin > 0);
+  _snapshotDictionary.reset();
   _dict.emplace(name,
                 RegisterID(parentID.address,
                            begin + parentID.begin,
@@ -243,6 +260,18 @@ void RegisterSet::_wasUpdated(const std::size_t address) {
   }
 }
 
+const std::vector<std::string> &RegisterSet::getParentNames() const noexcept {
+  return _parentVector;
+}
+
+RegisterSnapshot RegisterSet::takeSnapshot(std::size_t version) const {
+  if (!_snapshotDictionary) {
+    _snapshotDictionary =
+        std::make_shared<const RegisterSnapshot::Dictionary>(_dict);
+  }
+  return RegisterSnapshot(version, _snapshotDictionary, _register);
+}
+
 void RegisterSet::deserializeJSON(const Json &json) {
   const auto registerNameListIt = json.find(_registerNameListStringIdentifier);
   const auto dataMapIt = json.find(_registerDataMapStringIdentifier);
@@ -0,0 +1,64 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/register-snapshot.hpp"
+
+#include <utility>
+
+#include "common/assert.hpp"
+
+RegisterSnapshot::RegisterSnapshot()
+: _version(0), _dictionary(std::make_shared<Dictionary>()), _registers() {
+}
+
+RegisterSnapshot::RegisterSnapshot(size_t version,
+                                   std::shared_ptr<const Dictionary> dictionary,
+                                   std::vector<MemoryValue> registers)
+: _version(version)
+, _dictionary(std::move(dictionary))
+, _registers(std::move(registers)) {
+}
+
+RegisterSnapshot::size_t RegisterSnapshot::getVersion() const noexcept {
+  return _version;
+}
+
+bool RegisterSnapshot::hasRegister(const std::string &name) const {
+  return _dictionary->count(name) > 0;
+}
+
+MemoryValue RegisterSnapshot::get(const std::string &name) const {
+  auto iterator = _dictionary->find(name);
+  assert::that(iterator != _dictionary->end());
+  const auto &id = iterator->second;
+  return _registers[id.address].subSet(id.begin, id.end);
+}
+
+RegisterSnapshotChannel::RegisterSnapshotChannel()
+: _snapshot(std::make_shared<const RegisterSnapshot>()) {
+}
+
+void RegisterSnapshotChannel::publish(RegisterSnapshot snapshot) {
+  auto pointer = std::make_shared<const RegisterSnapshot>(std::move(snapshot));
+  std::atomic_store(&_snapshot, std::move(pointer));
+}
+
+RegisterSnapshotChannel::Pointer RegisterSnapshotChannel::load() const {
+  return std::atomic_load(&_snapshot);
+}
@@ -19,8 +19,14 @@
 
 #include "core/scheduler.hpp"
 
+constexpr std::size_t Scheduler::queueCapacity;
+
 Scheduler::Scheduler()
-: _taskQueue()
+: _taskQueue(queueCapacity)
+, _overflow()
+, _overflowing(false)
+, _sleeping(false)
+, _spinWait()
 , _mutex()
 , _conditionVariable()
 , _interrupt(false)
@@ -33,13 +39,15 @@ Scheduler::~Scheduler() {
 }
 
 void Scheduler::push(Scheduler::Task&& task) {
-  {
+  // once a task went into the overflow list, the following ones have to
+  // follow it there, otherwise they could overtake it
+  if (_overflowing.load(std::memory_order_acquire) ||
+      !_taskQueue.tryPush(std::move(task))) {
     std::lock_guard<std::mutex> lock(_mutex);
-    _taskQueue.emplace(std::move(task));
+    _overflow.emplace_back(std::move(task));
+    _overflowing.store(true, std::memory_order_release);
   }
-  // the lock is destroyed before this to avoid waking the scheduler up and
-  // blocking again immediately
-  _conditionVariable.notify_one();
+  _wake();
 }
 
 std::thread::id Scheduler::getThreadId() {
@@ -50,14 +58,11 @@ void Scheduler::_run() {
   _interrupt = false;
 
   while (!_interrupt) {
-    std::unique_lock<std::mutex> lock(_mutex);
-    // wait while there is nothing in the queue, guards for spurious wakeups.
-    _conditionVariable.wait(lock, [this] { return !_taskQueue.empty(); });
-    // The mutex is reacquired after wait() ends. Now pop an element from the
-    // queue (which is guaranteed to not be empty)
-    Task task = _taskQueue.front();
-    _taskQueue.pop();
-    lock.unlock();
+    Task task;
+    if (!_pop(task)) {
+      _wait();
+      continue;
+    }
     // there was something in the queue, execute the task
     task();
   }
@@ -66,3 +71,50 @@ void Scheduler::_run() {
 void Scheduler::_shutdown() {
   this->push([this] { _interrupt = true; });
 }
+
+bool Scheduler::_pop(Task& task) {
+  while (!_taskQueue.isEmpty()) {
+    if (_taskQueue.pop(task)) return true;
+    // a producer claimed the next cell, but did not finish writing it
+    std::this_thread::yield();
+  }
+  if (!_overflowing.load(std::memory_order_acquire)) return false;
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  task = std::move(_overflow.front());
+  _overflow.pop_front();
+  if (_overflow.empty()) {
+    _overflowing.store(false, std::memory_order_release);
+  }
+  return true;
+}
+
+bool Scheduler::_hasTask() const {
+  return !_taskQueue.isEmpty() ||
+         _overflowing.load(std::memory_order_acquire);
+}
+
+void Scheduler::_wait() {
+  // an answer to a request often follows within nanoseconds
+  if (_spinWait.spinUntil([this] { return _hasTask(); })) return;
+  _sleeping.store(true, std::memory_order_relaxed);
+  // pairs with the fence in _wake(): either this thread sees the new task or
+  // the pushing thread sees that this one is asleep
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (!_hasTask()) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    // guards for spurious wakeups
+    _conditionVariable.wait(lock, [this] { return _hasTask(); });
+  }
+  _sleeping.store(false, std::memory_order_relaxed);
+}
+
+void Scheduler::_wake() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (_sleeping.load(std::memory_order_relaxed)) {
+    // taking the lock makes sure the scheduler either has not checked for
+    // tasks yet or is already waiting
+    { std::lock_guard<std::mutex> lock(_mutex); }
+    _conditionVariable.notify_one();
+  }
+}
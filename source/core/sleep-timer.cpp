@@ -0,0 +1,66 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/sleep-timer.hpp"
+
+SleepTimer::SleepTimer()
+: _mutex()
+, _requested(Duration::zero())
+, _hasRequest(false)
+, _virtualTimeEnabled(false)
+, _virtualTime(Duration::zero()) {
+}
+
+void SleepTimer::request(Duration duration) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_virtualTimeEnabled) {
+    _virtualTime += duration;
+  } else {
+    _requested += duration;
+    _hasRequest.store(true, std::memory_order_relaxed);
+  }
+}
+
+bool SleepTimer::hasRequest() {
+  // takeRequest() reads the duration with the mutex held
+  return _hasRequest.load(std::memory_order_relaxed);
+}
+
+SleepTimer::Duration SleepTimer::takeRequest() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto requested = _requested;
+  _requested = Duration::zero();
+  _hasRequest.store(false, std::memory_order_relaxed);
+  return requested;
+}
+
+void SleepTimer::setVirtualTime(bool enabled) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _virtualTimeEnabled = enabled;
+}
+
+bool SleepTimer::isVirtualTime() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _virtualTimeEnabled;
+}
+
+SleepTimer::Duration SleepTimer::getVirtualTime() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _virtualTime;
+}
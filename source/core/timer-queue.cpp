@@ -0,0 +1,67 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/timer-queue.hpp"
+
+TimerQueue::TimerQueue()
+: _state(std::make_shared<State>()), _thread(_run, _state) {
+}
+
+TimerQueue::~TimerQueue() {
+  {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    _state->shutdown = true;
+  }
+  _state->condition.notify_all();
+  // the last owner might be released by a task on the timer thread itself
+  if (std::this_thread::get_id() == _thread.get_id()) {
+    _thread.detach();
+  } else {
+    _thread.join();
+  }
+}
+
+void TimerQueue::schedule(Clock::duration delay, Task&& task) {
+  {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    _state->tasks.emplace(Clock::now() + delay, std::move(task));
+  }
+  _state->condition.notify_one();
+}
+
+void TimerQueue::_run(std::shared_ptr<State> state) {
+  std::unique_lock<std::mutex> lock(state->mutex);
+  while (!state->shutdown) {
+    if (state->tasks.empty()) {
+      state->condition.wait(lock);
+      continue;
+    }
+    auto first = state->tasks.begin();
+    if (first->first > Clock::now()) {
+      state->condition.wait_until(lock, first->first);
+      continue;
+    }
+    auto task = std::move(first->second);
+    state->tasks.erase(first);
+    // do not hold the lock while running the task, it might schedule again
+    lock.unlock();
+    task();
+    lock.lock();
+  }
+}
@@ -0,0 +1,112 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/trace-format.hpp"
+
+#include <cstring>
+
+namespace TraceFormat {
+namespace {
+constexpr std::size_t minimumMatch = 4;
+constexpr std::size_t hashBits = 14;
+
+std::uint32_t hash(const std::uint8_t* data) {
+  std::uint32_t value;
+  std::memcpy(&value, data, sizeof value);
+  return (value * 2654435761u) >> (32 - hashBits);
+}
+}
+
+Buffer compress(const std::uint8_t* data, std::size_t size) {
+  Buffer output;
+  output.reserve(size / 2 + 16);
+
+  // the last position (+ 1) where each hashed 4-byte sequence occurred
+  std::vector<std::size_t> table(std::size_t(1) << hashBits, 0);
+  std::size_t literalStart = 0;
+  std::size_t position = 0;
+
+  while (position + minimumMatch <= size) {
+    auto& entry = table[hash(data + position)];
+    auto candidate = entry;
+    entry = position + 1;
+
+    if (candidate == 0 ||
+        std::memcmp(data + candidate - 1, data + position, minimumMatch) != 0) {
+      ++position;
+      continue;
+    }
+
+    auto match = candidate - 1;
+    auto length = minimumMatch;
+    while (position + length < size &&
+           data[match + length] == data[position + length]) {
+      ++length;
+    }
+
+    writeVarint(output, position - literalStart);
+    output.insert(output.end(), data + literalStart, data + position);
+    writeVarint(output, length);
+    writeVarint(output, position - match);
+
+    position += length;
+    literalStart = position;
+  }
+
+  writeVarint(output, size - literalStart);
+  output.insert(output.end(), data + literalStart, data + size);
+  writeVarint(output, 0);
+
+  return output;
+}
+
+bool decompress(const std::uint8_t* data,
+                std::size_t size,
+                std::size_t rawSize,
+                Buffer& output) {
+  output.clear();
+  output.reserve(rawSize);
+  std::size_t position = 0;
+
+  while (true) {
+    std::uint64_t literals;
+    if (!readVarint(data, size, position, literals)) return false;
+    if (literals > size - position) return false;
+    if (output.size() + literals > rawSize) return false;
+    output.insert(output.end(), data + position, data + position + literals);
+    position += literals;
+
+    std::uint64_t length;
+    if (!readVarint(data, size, position, length)) return false;
+    if (length == 0) break;
+
+    std::uint64_t offset;
+    if (!readVarint(data, size, position, offset)) return false;
+    if (offset == 0 || offset > output.size()) return false;
+    if (output.size() + length > rawSize) return false;
+    // matches may overlap their own output, so copy byte by byte
+    auto source = output.size() - offset;
+    for (std::uint64_t index = 0; index < length; ++index) {
+      output.push_back(output[source + index]);
+    }
+  }
+
+  return position == size && output.size() == rawSize;
+}
+}
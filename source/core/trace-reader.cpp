@@ -0,0 +1,212 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/trace-reader.hpp"
+
+#include <cstring>
+#include <utility>
+
+#include "core/deserialization-error.hpp"
+
+using Tag = TraceFormat::Tag;
+
+namespace {
+void fail(const std::string &message) {
+  throw DeserializationError("Could not read trace: " + message);
+}
+
+std::uint16_t readUint16(const char *data) {
+  return static_cast<std::uint8_t>(data[0]) |
+         (static_cast<std::uint8_t>(data[1]) << 8);
+}
+}
+
+TraceReader::TraceReader(const std::string &path)
+: _file(path, std::ios::binary)
+, _version(0)
+, _flags(0)
+, _block()
+, _stored()
+, _position(0)
+, _program()
+, _registerNames()
+, _lastAddress(0) {
+  if (!_file) fail("cannot open " + path);
+
+  char header[TraceFormat::headerSize];
+  if (!_file.read(header, sizeof header)) fail("missing header");
+  if (std::memcmp(header, TraceFormat::magic, TraceFormat::magicSize) != 0) {
+    fail("not a trace file");
+  }
+
+  _version = readUint16(header + TraceFormat::magicSize);
+  _flags = readUint16(header + TraceFormat::magicSize + 2);
+  if (_version != TraceFormat::version) {
+    fail("unsupported version " + std::to_string(_version));
+  }
+}
+
+bool TraceReader::next(Step &step) {
+  // skip everything up to the next step
+  while (true) {
+    if (!_hasRecord()) return false;
+    auto tag = static_cast<Tag>(_block[_position++]);
+    if (tag == Tag::STEP) break;
+    if (tag == Tag::PROGRAM) {
+      _readProgram();
+    } else if (tag == Tag::REGISTER_NAME) {
+      _readRegisterName();
+    } else {
+      fail("record outside of a step");
+    }
+  }
+
+  auto delta = TraceFormat::unzigzag(_readVarint());
+  _lastAddress += delta;
+  step.address = _lastAddress;
+  auto instruction = _program.find(step.address);
+  step.encoding =
+      instruction != _program.end() ? instruction->second : MemoryValue();
+  step.registerWrites.clear();
+  step.memoryReads.clear();
+  step.memoryWrites.clear();
+
+  // the step ends at the next step, program or the end of the trace
+  while (_hasRecord()) {
+    auto tag = static_cast<Tag>(_block[_position]);
+    if (tag == Tag::STEP || tag == Tag::PROGRAM) break;
+    ++_position;
+    switch (tag) {
+      case Tag::REGISTER_NAME: _readRegisterName(); break;
+      case Tag::REGISTER_WRITE: {
+        auto id = _readVarint();
+        if (id >= _registerNames.size()) fail("undeclared register");
+        auto value = _readValue();
+        step.registerWrites.push_back({_registerNames[id], std::move(value)});
+        break;
+      }
+      case Tag::MEMORY_READ: {
+        auto address = _readVarint();
+        auto amount = _readVarint();
+        step.memoryReads.push_back({address, amount});
+        break;
+      }
+      case Tag::MEMORY_WRITE: {
+        auto address = _readVarint();
+        step.memoryWrites.push_back({address, _readValue()});
+        break;
+      }
+      default: fail("unknown record");
+    }
+  }
+
+  return true;
+}
+
+std::uint16_t TraceReader::getVersion() const noexcept {
+  return _version;
+}
+
+bool TraceReader::isCompressed() const noexcept {
+  return (_flags & TraceFormat::COMPRESSED) != 0;
+}
+
+bool TraceReader::_loadBlock() {
+  // the block header is read byte by byte, it is only a few bytes long
+  auto readSize = [this](std::uint64_t &value) {
+    value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+      auto byte = _file.get();
+      if (byte == std::char_traits<char>::eof()) return false;
+      value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) return true;
+    }
+    fail("invalid block size");
+    return false;
+  };
+
+  std::uint64_t rawSize, storedSize;
+  if (!readSize(rawSize)) return false;
+  if (!readSize(storedSize)) fail("truncated block");
+
+  _position = 0;
+  if (storedSize == rawSize) {
+    _block.resize(rawSize);
+    if (!_file.read(reinterpret_cast<char *>(_block.data()), rawSize)) {
+      fail("truncated block");
+    }
+    return true;
+  }
+
+  if (!isCompressed()) fail("invalid block size");
+  _stored.resize(storedSize);
+  if (!_file.read(reinterpret_cast<char *>(_stored.data()), storedSize)) {
+    fail("truncated block");
+  }
+  if (!TraceFormat::decompress(
+          _stored.data(), _stored.size(), rawSize, _block)) {
+    fail("corrupt block");
+  }
+  return true;
+}
+
+bool TraceReader::_hasRecord() {
+  while (_position >= _block.size()) {
+    if (!_loadBlock()) return false;
+  }
+  return true;
+}
+
+std::uint64_t TraceReader::_readVarint() {
+  std::uint64_t value;
+  auto size = _block.size();
+  if (!TraceFormat::readVarint(_block.data(), size, _position, value)) {
+    fail("truncated record");
+  }
+  return value;
+}
+
+MemoryValue TraceReader::_readValue() {
+  auto bits = _readVarint();
+  auto bytes = (bits + 7) / 8;
+  if (bytes > _block.size() - _position) fail("truncated value");
+  auto first = _block.begin() + _position;
+  MemoryValue::Underlying data(first, first + bytes);
+  _position += bytes;
+  return MemoryValue(std::move(data), bits);
+}
+
+void TraceReader::_readProgram() {
+  _program.clear();
+  auto count = _readVarint();
+  for (std::uint64_t index = 0; index < count; ++index) {
+    auto address = _readVarint();
+    _program[address] = _readValue();
+  }
+}
+
+void TraceReader::_readRegisterName() {
+  auto id = _readVarint();
+  auto length = _readVarint();
+  if (id != _registerNames.size()) fail("unexpected register id");
+  if (length > _block.size() - _position) fail("truncated register name");
+  auto first = reinterpret_cast<const char *>(_block.data() + _position);
+  _registerNames.emplace_back(first, length);
+  _position += length;
+}
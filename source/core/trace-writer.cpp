@@ -0,0 +1,211 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/trace-writer.hpp"
+
+#include <utility>
+
+#include "common/assert.hpp"
+
+using Tag = TraceFormat::Tag;
+
+constexpr TraceWriter::size_t TraceWriter::defaultBlockSize;
+constexpr TraceWriter::size_t TraceWriter::defaultMaximumPendingBlocks;
+
+TraceWriter::TraceWriter(const std::string &path,
+                         bool compress,
+                         size_t blockSize,
+                         size_t maximumPendingBlocks)
+: _state(std::make_unique<State>())
+, _thread()
+, _blockSize(blockSize)
+, _block()
+, _registerIDs()
+, _lastAddress(0)
+, _stepCount(0)
+, _closed(false) {
+  assert::that(maximumPendingBlocks > 0);
+  _state->compress = compress;
+  _state->maximumPending = maximumPendingBlocks;
+  _state->file.open(path, std::ios::binary | std::ios::trunc);
+
+  std::uint16_t flags = compress ? TraceFormat::COMPRESSED : 0;
+  const char header[] = {static_cast<char>(TraceFormat::version & 0xFF),
+                         static_cast<char>(TraceFormat::version >> 8),
+                         static_cast<char>(flags & 0xFF),
+                         static_cast<char>(flags >> 8)};
+  _state->file.write(TraceFormat::magic, TraceFormat::magicSize);
+  _state->file.write(header, sizeof header);
+  _state->good = static_cast<bool>(_state->file);
+
+  _block.reserve(_blockSize + _blockSize / 8);
+  _thread = std::thread(&TraceWriter::_run, std::ref(*_state));
+}
+
+TraceWriter::~TraceWriter() {
+  close();
+}
+
+bool TraceWriter::isGood() const {
+  std::lock_guard<std::mutex> lock(_state->mutex);
+  return _state->good;
+}
+
+void TraceWriter::writeProgram(const Program &program) {
+  if (_closed) return;
+  _beginRecord(Tag::PROGRAM);
+  TraceFormat::writeVarint(_block, program.size());
+  for (const auto &instruction : program) {
+    TraceFormat::writeVarint(_block, instruction.address);
+    _writeValue(instruction.encoding);
+  }
+}
+
+void TraceWriter::beginStep(size_t address) {
+  if (_closed) return;
+  _beginRecord(Tag::STEP);
+  auto delta = static_cast<std::int64_t>(address - _lastAddress);
+  TraceFormat::writeVarint(_block, TraceFormat::zigzag(delta));
+  _lastAddress = address;
+  ++_stepCount;
+}
+
+void TraceWriter::writeRegister(const std::string &name,
+                                const MemoryValue &value) {
+  if (_closed) return;
+  auto id = _registerID(name);
+  _beginRecord(Tag::REGISTER_WRITE);
+  TraceFormat::writeVarint(_block, id);
+  _writeValue(value);
+}
+
+void TraceWriter::readMemory(size_t address, size_t amount) {
+  if (_closed) return;
+  _beginRecord(Tag::MEMORY_READ);
+  TraceFormat::writeVarint(_block, address);
+  TraceFormat::writeVarint(_block, amount);
+}
+
+void TraceWriter::writeMemory(size_t address, const MemoryValue &value) {
+  if (_closed) return;
+  _beginRecord(Tag::MEMORY_WRITE);
+  TraceFormat::writeVarint(_block, address);
+  _writeValue(value);
+}
+
+void TraceWriter::flush() {
+  if (_closed || _block.empty()) return;
+  Buffer next;
+  {
+    std::unique_lock<std::mutex> lock(_state->mutex);
+    // rather slow down the simulation than queue up the whole trace
+    _state->drained.wait(lock, [this] {
+      return _state->pending.size() < _state->maximumPending;
+    });
+    _state->pending.emplace_back(std::move(_block));
+    // reuse a buffer the writer is done with, to avoid reallocating
+    if (!_state->spare.empty()) {
+      next = std::move(_state->spare.back());
+      _state->spare.pop_back();
+    }
+  }
+  _state->condition.notify_one();
+  _block = std::move(next);
+  _block.clear();
+  _block.reserve(_blockSize + _blockSize / 8);
+}
+
+void TraceWriter::close() {
+  if (_closed) return;
+  flush();
+  _closed = true;
+  {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    _state->closing = true;
+  }
+  _state->condition.notify_one();
+  _thread.join();
+  _state->file.close();
+}
+
+std::uint64_t TraceWriter::getStepCount() const noexcept {
+  return _stepCount;
+}
+
+void TraceWriter::_run(State &state) {
+  Buffer header;
+  while (true) {
+    Buffer block;
+    {
+      std::unique_lock<std::mutex> lock(state.mutex);
+      state.condition.wait(
+          lock, [&state] { return state.closing || !state.pending.empty(); });
+      if (state.pending.empty()) return;
+      block = std::move(state.pending.front());
+      state.pending.pop_front();
+    }
+    state.drained.notify_one();
+
+    Buffer compressed;
+    const Buffer *data = &block;
+    if (state.compress) {
+      compressed = TraceFormat::compress(block.data(), block.size());
+      if (compressed.size() < block.size()) data = &compressed;
+    }
+
+    header.clear();
+    TraceFormat::writeVarint(header, block.size());
+    TraceFormat::writeVarint(header, data->size());
+    state.file.write(reinterpret_cast<const char *>(header.data()),
+                     header.size());
+    state.file.write(reinterpret_cast<const char *>(data->data()),
+                     data->size());
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (!state.file) state.good = false;
+    state.spare.emplace_back(std::move(block));
+  }
+}
+
+void TraceWriter::_beginRecord(Tag tag) {
+  // only split between steps, so that a step is never spread over two blocks
+  if (tag == Tag::STEP || tag == Tag::PROGRAM) {
+    if (_block.size() >= _blockSize) flush();
+  }
+  _block.push_back(static_cast<std::uint8_t>(tag));
+}
+
+void TraceWriter::_writeValue(const MemoryValue &value) {
+  const auto &bytes = value.internal();
+  TraceFormat::writeVarint(_block, value.getSize());
+  _block.insert(_block.end(), bytes.begin(), bytes.end());
+}
+
+std::uint64_t TraceWriter::_registerID(const std::string &name) {
+  auto iterator = _registerIDs.find(name);
+  if (iterator != _registerIDs.end()) return iterator->second;
+
+  auto id = _registerIDs.size();
+  _registerIDs.emplace(name, id);
+  _beginRecord(Tag::REGISTER_NAME);
+  TraceFormat::writeVarint(_block, id);
+  TraceFormat::writeVarint(_block, name.size());
+  _block.insert(_block.end(), name.begin(), name.end());
+  return id;
+}
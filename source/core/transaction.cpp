@@ -0,0 +1,69 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/transaction.hpp"
+
+#include "core/project.hpp"
+
+Transaction::Transaction(Project& project, size_t hart)
+: _project(project), _hart(hart) {
+}
+
+Transaction::size_t Transaction::getHart() const noexcept {
+  return _hart;
+}
+
+Transaction::size_t Transaction::getMemorySize() const {
+  return _project.getMemorySize();
+}
+
+MemoryValue
+Transaction::getMemoryValueAt(size_t address, size_t amount) const {
+  return _project.getMemoryValueAt(address, amount);
+}
+
+MemoryValue
+Transaction::tryGetMemoryValueAt(size_t address, size_t amount) const {
+  return _project.tryGetMemoryValueAt(address, amount);
+}
+
+void Transaction::putMemoryValueAt(size_t address, const MemoryValue& value) {
+  _project.putMemoryValueAt(address, value);
+}
+
+bool Transaction::isMemoryProtectedAt(size_t address, size_t amount) const {
+  return _project.isMemoryProtectedAt(address, amount);
+}
+
+MemoryValue Transaction::getRegisterValue(const std::string& name) const {
+  return _project.getHartRegisterValue(_hart, name);
+}
+
+void Transaction::putRegisterValue(const std::string& name,
+                                   const MemoryValue& value) {
+  _project.putHartRegisterValue(_hart, name, value);
+}
+
+MemoryValue Transaction::loadReserved(size_t address, size_t amount) {
+  return _project.loadReserved(_hart, address, amount);
+}
+
+bool Transaction::storeConditional(size_t address, const MemoryValue& value) {
+  return _project.storeConditional(_hart, address, value);
+}
@@ -0,0 +1,105 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/undo-log.hpp"
+
+#include "common/assert.hpp"
+#include "core/memory.hpp"
+#include "core/register-set.hpp"
+
+constexpr UndoLog::size_t UndoLog::defaultMaximumSteps;
+
+UndoLog::UndoLog(size_t maximumSteps)
+: _records(), _stepSizes(), _maximumSteps(maximumSteps), _recording(false) {
+  assert::that(maximumSteps > 0);
+}
+
+void UndoLog::beginStep() {
+  _stepSizes.push_back(0);
+  _recording = true;
+  _trim();
+}
+
+void UndoLog::endStep() {
+  _recording = false;
+  // steps which did not write anything are dropped, they cannot be told
+  // apart from their neighbours anyway
+  if (!_stepSizes.empty() && _stepSizes.back() == 0) {
+    _stepSizes.pop_back();
+  }
+}
+
+bool UndoLog::isRecording() const noexcept {
+  return _recording;
+}
+
+void UndoLog::recordMemory(size_t address, const MemoryValue &previous) {
+  assert::that(_recording);
+  _records.push_back({std::string(), address, previous});
+  ++_stepSizes.back();
+}
+
+void UndoLog::recordRegister(const std::string &name,
+                             const MemoryValue &previous) {
+  assert::that(_recording);
+  assert::that(!name.empty());
+  _records.push_back({name, 0, previous});
+  ++_stepSizes.back();
+}
+
+bool UndoLog::undoStep(Memory &memory, RegisterSet &registerSet) {
+  assert::that(!_recording);
+  if (_stepSizes.empty()) return false;
+  // restore in reverse order, so that multiple writes to the same location
+  // within one step end up with the oldest value
+  for (size_t i = 0; i < _stepSizes.back(); ++i) {
+    const auto &record = _records.back();
+    if (record.name.empty()) {
+      memory.tryPut(record.address, record.previous, true);
+    } else {
+      registerSet.put(record.name, record.previous);
+    }
+    _records.pop_back();
+  }
+  _stepSizes.pop_back();
+  return true;
+}
+
+UndoLog::size_t UndoLog::getStepCount() const noexcept {
+  return _stepSizes.size();
+}
+
+UndoLog::size_t UndoLog::getMaximumSteps() const noexcept {
+  return _maximumSteps;
+}
+
+void UndoLog::clear() {
+  _records.clear();
+  _stepSizes.clear();
+  _recording = false;
+}
+
+void UndoLog::_trim() {
+  while (_stepSizes.size() > _maximumSteps) {
+    for (size_t i = 0; i < _stepSizes.front(); ++i) {
+      _records.pop_front();
+    }
+    _stepSizes.pop_front();
+  }
+}
@@ -37,6 +37,14 @@ SyntaxInformation::getEntries() const {
   return _entries;
 }
 
+void SyntaxInformation::setLexer(Lexer lexer) {
+  _lexer = std::move(lexer);
+}
+
+const SyntaxInformation::Lexer &SyntaxInformation::getLexer() const noexcept {
+  return _lexer;
+}
+
 
 SyntaxInformation::TokenIterator
 SyntaxInformation::TokenIterable::begin() const {
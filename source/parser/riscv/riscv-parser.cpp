@@ -26,7 +26,6 @@
 #include <vector>
 
 #include "arch/common/architecture.hpp"
-#include "arch/common/node-factory-collection-maker.hpp"
 #include "arch/common/unit-information.hpp"
 #include "common/string-conversions.hpp"
 #include "core/conversions.hpp"
@@ -40,6 +39,7 @@
 #include "parser/independent/transformation-parameters.hpp"
 #include "parser/riscv/riscv-directive-factory.hpp"
 #include "parser/riscv/riscv-regex.hpp"
+#include "parser/riscv/riscv-syntax-lexer.hpp"
 
 const SyntaxTreeGenerator::ArgumentNodeGenerator
     RiscvParser::argumentGeneratorFunction = [](
@@ -82,7 +82,8 @@ const SyntaxTreeGenerator::ArgumentNodeGenerator
 RiscvParser::RiscvParser(const Architecture& architecture,
                          const MemoryAccess& memoryAccess)
 : _architecture(architecture), _memoryAccess(memoryAccess) {
-  _factoryCollection = NodeFactoryCollectionMaker::CreateFor(architecture);
+  // the factories were created when the architecture was brewed
+  _factoryCollection = architecture.getNodeFactories();
 }
 namespace {
 CodePositionInterval
@@ -246,5 +247,9 @@ const SyntaxInformation RiscvParser::getSyntaxInformation() {
     }
   }
 
+  // The lexer classifies a line in one pass, the regexes above remain for
+  // highlighters that cannot use it.
+  info.setLexer(RiscvSyntaxLexer(_architecture));
+
   return info;
 }
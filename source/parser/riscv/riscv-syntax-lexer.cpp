@@ -0,0 +1,127 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "parser/riscv/riscv-syntax-lexer.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#include "arch/common/architecture.hpp"
+#include "common/utility.hpp"
+#include "parser/common/compile-error-list.hpp"
+#include "parser/riscv/riscv-regex.hpp"
+
+namespace {
+bool isWordStart(char character) {
+  auto c = static_cast<unsigned char>(character);
+  return std::isalpha(c) || c == '_' || c == '.';
+}
+
+bool isWordPart(char character) {
+  auto c = static_cast<unsigned char>(character);
+  return std::isalnum(c) || c == '_' || c == '.';
+}
+
+bool isDigit(char character) {
+  return std::isdigit(static_cast<unsigned char>(character));
+}
+
+bool isOperator(char character) {
+  return character != '\0' && std::strchr("+-%*/()|^&=!<>~", character);
+}
+}
+
+RiscvSyntaxLexer::RiscvSyntaxLexer(const Architecture &architecture) {
+  auto registers = std::make_shared<std::unordered_set<std::string>>();
+  for (const auto &unit : architecture.getUnits()) {
+    for (const auto &registerInformation : unit) {
+      if (registerInformation.second.hasName()) {
+        registers->emplace(
+            Utility::toLower(registerInformation.second.getName()));
+      }
+    }
+  }
+  _registers = std::move(registers);
+}
+
+RiscvSyntaxLexer::TokenSpanList RiscvSyntaxLexer::
+operator()(const std::string &line) const {
+  TokenSpanList spans;
+  RiscvParser::RiscvRegex regex;
+  CompileErrorList errors;
+  auto position = regex.matchLine(line, 0, errors);
+
+  if (regex.hasLabel()) {
+    const auto &interval = regex.getLabel().positionInterval();
+    auto begin = interval.start().x();
+    spans.push_back({begin, interval.end().x() - begin, Token::Label});
+  }
+  if (regex.hasInstruction()) {
+    // the interval of a directive still includes the '.'
+    auto instruction = regex.getInstruction();
+    const auto &interval = instruction.positionInterval();
+    auto begin = interval.start().x();
+    spans.push_back({begin, interval.end().x() - begin, Token::Instruction});
+  }
+  for (int i = 0; i < regex.getParameterCount(); ++i) {
+    const auto &interval = regex.getParameter(i).positionInterval();
+    _lexOperands(line, interval.start().x(), interval.end().x(), spans);
+  }
+  // either the comment or, if the line is invalid, everything after the error
+  _lexOperands(line, position, line.size(), spans);
+
+  return spans;
+}
+
+void RiscvSyntaxLexer::_lexOperands(const std::string &line,
+                                    size_t begin,
+                                    size_t end,
+                                    TokenSpanList &spans) const {
+  auto index = begin;
+  while (index < end) {
+    const auto start = index;
+    const auto character = line[index];
+    if (character == ';') {
+      spans.push_back({start, end - start, Token::Comment});
+      return;
+    } else if (character == '"' || character == '\'') {
+      for (++index; index < end && line[index] != character; ++index) {
+        if (line[index] == '\\') ++index;
+      }
+      index = std::min(index + 1, end);
+      spans.push_back({start, index - start, Token::Immediate});
+    } else if (isDigit(character)) {
+      // covers hexadecimal and binary literals, too
+      while (index < end && isWordPart(line[index])) ++index;
+      spans.push_back({start, index - start, Token::Immediate});
+    } else if (isWordStart(character)) {
+      while (index < end && isWordPart(line[index])) ++index;
+      auto word = Utility::toLower(line.substr(start, index - start));
+      auto token = _registers->count(word) ? Token::Register : Token::Label;
+      spans.push_back({start, index - start, token});
+    } else if (isOperator(character)) {
+      while (index < end && isOperator(line[index])) ++index;
+      spans.push_back({start, index - start, Token::Immediate});
+    } else {
+      ++index;
+    }
+  }
+}
@@ -27,8 +27,12 @@ Item {
   id: consoleItem
 
   property bool currentMode
+  property bool currentRing
   property var currentAddress
 
+  // Subscription to the head of the output ring buffer, -1 if there is none.
+  property int ringSubscription: -1
+
   property alias readonlyConsole: readonlyConsole
   property alias inputConsole: inputConsole
 
@@ -124,6 +128,13 @@ Item {
     wrapMode: Text.WrapAnywhere
 
     Keys.onReturnPressed: {
+      if (currentRing) {
+        // The program reads the line from the input ring buffer, it is only
+        // echoed if it fit into the buffer, see onInputPushed.
+        consoleComponent.pushInput(inputConsole.text + "\n");
+        text = "";
+        return;
+      }
       var newText = "";
       if (readonlyConsole.text !== "") {
         newText = "\n" + newText;
@@ -170,6 +181,8 @@ Item {
     target: outputComponent
     // Check for changes in the memory (at any address).
     onMemoryChanged: {
+      // The ring buffer is only read when its head changes, see onRangeChanged.
+      if (currentRing) return;
       // we have to parse size_t to int, as qml/javascript handles them like strings.
       var baseAddress = parseInt(consoleComponent.getStart());
       var deleteBuffer = consoleComponent.deleteBuffer();
@@ -186,46 +199,94 @@ Item {
 
       if (!currentMode && (checkBegin || checkLength)) {
         consoleItem.updateContent(baseAddress);
-      } else if (consoleComponent.checkInterrupt()) {
-        consoleItem.updateContent(baseAddress);
-        consoleComponent.resetInterrupt();
+      } else {
+        // The text is updated once the interrupt is found set, see
+        // onInterruptRaised.
+        consoleComponent.checkInterrupt();
+      }
+    }
+  }
+
+  Connections {
+    target: outputComponent
+    // The program moved the head of the output ring buffer.
+    onRangeChanged: {
+      if (subscription === ringSubscription) {
+        consoleComponent.drainOutput();
       }
     }
   }
 
   Connections {
     target: consoleComponent
+    onOutputDrained: readonlyConsole.text += text;
+    onTextFetched: {
+      if (currentMode) {
+        readonlyConsole.text += text;
+      } else {
+        readonlyConsole.text = text;
+      }
+    }
+    onInterruptRaised: {
+      consoleItem.updateContent();
+      consoleComponent.resetInterrupt();
+    }
+    onInputPushed: {
+      if (accepted) readonlyConsole.text += text;
+    }
     onSettingsChanged: {
       settingsWindowConsole.updateSettings();
       var mode = consoleComponent.deleteBuffer();
+      var ring = consoleComponent.ringBuffer();
       var baseAddress = consoleComponent.getStart();
 
-      if(mode === currentMode && baseAddress === currentAddress) return;
+      if(mode === currentMode && ring === currentRing &&
+         baseAddress === currentAddress) return;
 
       currentMode = mode;
+      currentRing = ring;
+      updateRingSubscription();
 
       if (currentAddress !== baseAddress) {
         currentAddress = baseAddress;
         consoleItem.clear();
       }
 
-      if (!currentMode) {
+      if (!currentMode || currentRing) {
         consoleItem.updateContent();
       }
     }
   }
 
+  // Subscribes to the head of the output ring buffer while in ring mode.
+  function updateRingSubscription() {
+    var baseAddress = parseInt(consoleComponent.getStart());
+    if (!currentRing) {
+      outputComponent.unsubscribe(ringSubscription);
+      ringSubscription = -1;
+    } else if (ringSubscription < 0) {
+      ringSubscription = outputComponent.subscribe(baseAddress, 4);
+    } else {
+      outputComponent.setSubscriptionRange(ringSubscription, baseAddress, 4);
+    }
+  }
+
   function updateContent() {
-    if (currentMode) {
-      readonlyConsole.text += consoleComponent.getText();
+    if (currentRing) {
+      consoleComponent.drainOutput();
     } else {
-      readonlyConsole.text = consoleComponent.getText();
+      // The text arrives through onTextFetched.
+      consoleComponent.fetchText();
     }
   }
 
   Component.onCompleted: {
     currentAddress = consoleComponent.getStart();
     currentMode = consoleComponent.deleteBuffer();
+    currentRing = consoleComponent.ringBuffer();
+    updateRingSubscription();
     consoleItem.updateContent();
   }
+
+  Component.onDestruction: outputComponent.unsubscribe(ringSubscription);
 }
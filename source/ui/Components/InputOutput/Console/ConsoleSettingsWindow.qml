@@ -40,7 +40,13 @@ Window {
     var interruptAddressInt = parseInt(consoleComponent.getInterruptAddress());
     baseAddressTextField.text = "0x" + baseAddressInt.toString(16);
     interruptAddressTextField.text = "0x" + interruptAddressInt.toString(16);
-    if(consoleComponent.deleteBuffer()) {
+    ringCapacityTextField.text = parseInt(consoleComponent.getRingCapacity());
+    grid.ringSettingsOpacity = 0.0;
+    if (consoleComponent.ringBuffer()) {
+      ringMode.checked = true;
+      grid.interruptSettingsOpacity = 0.0;
+      grid.ringSettingsOpacity = 1.0;
+    } else if(consoleComponent.deleteBuffer()) {
       pipeMode.checked = true;
       grid.interruptSettingsOpacity = 1.0;
     } else {
@@ -52,6 +58,7 @@ Window {
   function finishEditing() {
     baseAddressTextField.focus = false;
     interruptAddressTextField.focus = false;
+    ringCapacityTextField.focus = false;
   }
 
   GridLayout {
@@ -64,6 +71,7 @@ Window {
     columns: 2
 
     property real interruptSettingsOpacity: 0
+    property real ringSettingsOpacity: 0
 
     Behavior on interruptSettingsOpacity {
       NumberAnimation {
@@ -72,6 +80,13 @@ Window {
       }
     }
 
+    Behavior on ringSettingsOpacity {
+      NumberAnimation {
+        duration: 200
+        easing.type: Easing.OutExpo
+      }
+    }
+
     Text {
       text: "Memory Source Address:"
     }
@@ -121,6 +136,32 @@ Window {
       }
     }
 
+    Text {
+      text: "Ring Buffer Capacity:"
+
+      opacity: grid.ringSettingsOpacity
+    }
+
+    // The output ring buffer starts at the source address, the input ring
+    // buffer directly behind it. Both have this capacity.
+    TextField {
+      id: ringCapacityTextField
+
+      opacity: grid.ringSettingsOpacity
+      onAccepted: processInput();
+      onEditingFinished: processInput();
+
+      function processInput() {
+        var inputValue = TextUtility.convertStringToInteger(String(ringCapacityTextField.text));
+        if (inputValue !== undefined && inputValue >= 2) {
+          consoleComponent.setRingCapacity(inputValue);
+        } else {
+          // If an incorrect value was entered, reset to previous value.
+          updateSettings();
+        }
+      }
+    }
+
     ExclusiveGroup { id: modeGroup }
 
     RadioButton {
@@ -129,8 +170,10 @@ Window {
       exclusiveGroup: modeGroup
       onClicked: {
         finishEditing();
+        consoleComponent.setRingBuffer(false);
         consoleComponent.setDeleteBuffer(false);
         grid.interruptSettingsOpacity = 0.0;
+        grid.ringSettingsOpacity = 0.0;
       }
     }
 
@@ -140,8 +183,22 @@ Window {
       exclusiveGroup: modeGroup
       onClicked: {
         finishEditing();
+        consoleComponent.setRingBuffer(false);
         consoleComponent.setDeleteBuffer(true);
         grid.interruptSettingsOpacity = 1.0;
+        grid.ringSettingsOpacity = 0.0;
+      }
+    }
+
+    RadioButton {
+      id: ringMode
+      text: "Ring Mode"
+      exclusiveGroup: modeGroup
+      onClicked: {
+        finishEditing();
+        consoleComponent.setRingBuffer(true);
+        grid.interruptSettingsOpacity = 0.0;
+        grid.ringSettingsOpacity = 1.0;
       }
     }
 
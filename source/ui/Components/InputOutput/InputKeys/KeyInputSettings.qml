@@ -39,6 +39,7 @@ Window {
   function updateSettings() {
     var baseAddressInt = parseInt(inputKeyMod.getStart());
     baseAddressTextField.text = "0x" + baseAddressInt.toString(16);
+    ringCapacityTextField.text = inputKeyMod.getRingCapacity();
   }
 
   onVisibleChanged: settingsWindowIK.updateSettings();
@@ -74,6 +75,27 @@ Window {
         }
       }
     }
+
+    Text {
+      text: "Ring Buffer Capacity (0 = off):"
+    }
+
+    // Text field for queueing keys in a ring buffer at the source address.
+    TextField {
+      id: ringCapacityTextField
+
+      onAccepted: { processInput(); }
+      onEditingFinished: { processInput(); }
+
+      // Reads the current input and passes the new value to the model.
+      function processInput() {
+        var inputValue = TextUtility.convertStringToInteger(String(ringCapacityTextField.text))
+        if (inputValue !== undefined && inputValue >= 0) {
+          inputKeyMod.setRingCapacity(inputValue);
+        }
+        settingsWindowIK.updateSettings();
+      }
+    }
   }
 
   // Button for accepting setting changes and closing the settings window.
@@ -88,6 +110,7 @@ Window {
 
     onClicked: {
       baseAddressTextField.focus = false;
+      ringCapacityTextField.focus = false;
       close();
     }
   }
@@ -23,6 +23,14 @@ Rectangle {
   // the model.
   property var outputItemIndex: 0
 
+  // Identifier of the memory range this output item subscribed to, -1 while
+  // there is none.
+  property int _subscription: -1
+
+  // Identifier of the latest request for the content of the subscribed range,
+  // older answers are ignored.
+  property int _contentRequest: -1
+
   // Called by Output.qml (i.e. component wrapper) when it receives
   // the signal that component settings icon was pressed.
   signal settingsButtonPressed()
@@ -40,18 +48,22 @@ Rectangle {
     updateContent(output["baseAddress"]);
   }
 
+  Component.onDestruction: outputComponent.unsubscribe(_subscription);
+
   // Connect the output item to signals that the model might send.
   Connections {
     target: outputComponent
-    // Send when the memory changes (at any address).
-    onMemoryChanged: {
-      var output = outputComponent.getOutputItem(outputItemIndex);
-      var _baseAddress = output["baseAddress"];
-      // Check if the memory address that was changed (at least partly) belongs
-      // to the output item's source space.
-      if ((address + length) >= _baseAddress &&
-          (address <= (_baseAddress+(lightstripModel.count + 7)/8))) {
-        updateContent(_baseAddress);
+    // Send when the memory changes inside the range of a subscription.
+    onRangeChanged: {
+      if (subscription === _subscription) {
+        var output = outputComponent.getOutputItem(outputItemIndex);
+        updateContent(output["baseAddress"]);
+      }
+    }
+    // Send with the answer to fetchMemoryWords.
+    onMemoryWordsFetched: {
+      if (request === _contentRequest) {
+        _showContent(words);
       }
     }
     // Send when any item's settings where updated.
@@ -69,15 +81,32 @@ Rectangle {
   // Updates the content of the output model depending on the value in memory.
   function updateContent(_baseAddress) {
     _updatelightstripModel();
-    var content = outputComponent.getMemoryContent(
-      _baseAddress,
-      (lightstripModel.count + 7) / 8
-    );
+    var numberOfBytes = Math.floor((lightstripModel.count + 7) / 8);
+    _updateSubscription(_baseAddress, numberOfBytes);
 
+    // The content arrives through onMemoryWordsFetched.
+    _contentRequest =
+      outputComponent.fetchMemoryWords(_baseAddress, numberOfBytes);
+  }
+
+  // Shows the content of the subscribed range, one number per byte, the first
+  // strip is the lowest bit.
+  function _showContent(content) {
     for (var bitIndex = 0;
-         bitIndex < content.length && bitIndex < lightstripModel.count;
+         (bitIndex >> 3) < content.length && bitIndex < lightstripModel.count;
         ++bitIndex) {
-      lightstripModel.setProperty(bitIndex, "active", content[bitIndex]);
+      var active = ((content[bitIndex >> 3] >> (bitIndex & 7)) & 1) === 1;
+      lightstripModel.setProperty(bitIndex, "active", active);
+    }
+  }
+
+  // Makes sure that changes to the given range are signaled to this item.
+  function _updateSubscription(_baseAddress, numberOfBytes) {
+    if (_subscription < 0) {
+      _subscription = outputComponent.subscribe(_baseAddress, numberOfBytes);
+    } else {
+      outputComponent.setSubscriptionRange(
+        _subscription, _baseAddress, numberOfBytes);
     }
   }
 
@@ -210,11 +239,16 @@ Rectangle {
               for (var lightIndex = 0;
                    lightIndex < lightstripModel.count;
                    ++lightIndex) {
-                memoryContent.push(lightstripModel.get(lightIndex).active);
+                if ((lightIndex & 7) === 0) {
+                  memoryContent.push(0);
+                }
+                if (lightstripModel.get(lightIndex).active) {
+                  memoryContent[lightIndex >> 3] |= 1 << (lightIndex & 7);
+                }
               }
               var output = outputComponent.getOutputItem(outputItemIndex);
               var _baseAddress = output["baseAddress"];
-              outputComponent.putMemoryValue(_baseAddress, memoryContent);
+              outputComponent.putMemoryWords(_baseAddress, memoryContent);
             }
           }
           onExited: rect.border.width = 0
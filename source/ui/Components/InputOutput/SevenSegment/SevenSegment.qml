@@ -41,6 +41,14 @@ Rectangle {
   // the model.
   property var outputItemIndex: 1
 
+  // Identifier of the memory range this output item subscribed to, -1 while
+  // there is none.
+  property int _subscription: -1
+
+  // Identifier of the latest request for the content of the subscribed range,
+  // older answers are ignored.
+  property int _contentRequest: -1
+
   signal settingsButtonPressed()
 
   // Color definitions
@@ -53,14 +61,16 @@ Rectangle {
   // Connect the output item to signals that the model might send.
   Connections {
     target: outputComponent
-    // Send when the memory changes (at any address).
-    onMemoryChanged: {
-      var _baseAddress = outputComponent.getOutputItem(outputItemIndex)["baseAddress"];
-      var numberOfDigits = outputComponent.getOutputItem(outputItemIndex)["numberOfDigits"];
-      // Check if the memory address that was changed (at least partly) belongs to
-      // the output item's source space.
-      if ((address+length) >= _baseAddress && (address <= (_baseAddress+(numberOfDigits)))) {
-        updateContent(_baseAddress);
+    // Send when the memory changes inside the range of a subscription.
+    onRangeChanged: {
+      if (subscription === _subscription) {
+        updateContent(outputComponent.getOutputItem(outputItemIndex)["baseAddress"]);
+      }
+    }
+    // Sent with the answer to fetchMemoryWords.
+    onMemoryWordsFetched: {
+      if (request === _contentRequest) {
+        _showContent(words);
       }
     }
     // Sent when any item's settings where updated.
@@ -75,6 +85,8 @@ Rectangle {
     updateContent(outputComponent.getOutputItem(outputItemIndex)["baseAddress"]);
   }
 
+  Component.onDestruction: outputComponent.unsubscribe(_subscription);
+
   // Called from outside by the output tab view to signal that the settings button for the current
   // output item was pressed.
   onSettingsButtonPressed: {
@@ -127,15 +139,19 @@ Rectangle {
       onSegmentPressed: {
         var segmentIdentifier = "segment" + segmentIndex;
         sevenSegmentDigitsModel.setProperty(index, segmentIdentifier, !sevenSegmentDigitsModel.get(index)[segmentIdentifier]);
+        // One byte per digit, the lowest bit is segment 0.
         var memoryContent = [];
         for (var digitIndex = (sevenSegmentDigitsModel.count -1); digitIndex >= 0; --digitIndex) {
+          var digit = 0;
           for (var currentSegmentIndex = 0; currentSegmentIndex < 7; ++currentSegmentIndex) {
-            memoryContent.push(sevenSegmentDigitsModel.get(digitIndex)["segment" + currentSegmentIndex]);
+            if (sevenSegmentDigitsModel.get(digitIndex)["segment" + currentSegmentIndex]) {
+              digit |= 1 << currentSegmentIndex;
+            }
           }
-          memoryContent.push(false);  // Fill one byte.
+          memoryContent.push(digit);
         }
         var _baseAddress = outputComponent.getOutputItem(outputItemIndex)["baseAddress"];
-        outputComponent.putMemoryValue(_baseAddress, memoryContent);
+        outputComponent.putMemoryWords(_baseAddress, memoryContent);
       }
 
       MouseArea {
@@ -166,13 +182,24 @@ Rectangle {
   function updateContent(_baseAddress) {
     _updateSevenSegmentDigitsModel();
 
-    var content = outputComponent.getMemoryContent(_baseAddress, sevenSegmentDigitsModel.count);
+    if (_subscription < 0) {
+      _subscription = outputComponent.subscribe(_baseAddress, sevenSegmentDigitsModel.count);
+    } else {
+      outputComponent.setSubscriptionRange(_subscription, _baseAddress, sevenSegmentDigitsModel.count);
+    }
+
+    // The content arrives through onMemoryWordsFetched.
+    _contentRequest = outputComponent.fetchMemoryWords(_baseAddress, sevenSegmentDigitsModel.count);
+  }
+
+  // Shows the content of the subscribed range, one number per digit.
+  function _showContent(content) {
     for (var digitIndex = 0; digitIndex < sevenSegmentDigitsModel.count; ++digitIndex) {
       // Iterate memory bytewise from right to left, so the rightmost digit represents the first byte in memory.
       var digitInContentIndex = sevenSegmentDigitsModel.count -1 - digitIndex;
       for (var currentSegmentIndex = 0; currentSegmentIndex < 7; ++currentSegmentIndex) {
         var segmentIdentifier = "segment" + currentSegmentIndex;
-        var bitValue = content[digitInContentIndex*8+currentSegmentIndex];
+        var bitValue = ((content[digitInContentIndex] >> currentSegmentIndex) & 1) === 1;
         sevenSegmentDigitsModel.setProperty(digitIndex, segmentIdentifier, bitValue);
       }
     }
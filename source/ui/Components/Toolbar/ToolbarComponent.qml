@@ -72,6 +72,26 @@ ToolBar {
       }
     }
 
+    ToolbarButton {
+      enabled: !running
+      icon: "Icons/StepBack.svg"
+      tooltip: "Undo the last executed line"
+      onClicked: {
+        running = true;
+        ui.stepBack(tabView.currentProjectId());
+      }
+    }
+
+    ToolbarButton {
+      enabled: !running
+      icon: "Icons/RunBackToBreakpoint.svg"
+      tooltip: "Undo execution back to the previous breakpoint"
+      onClicked: {
+        running = true;
+        ui.stepBackToBreakpoint(tabView.currentProjectId());
+      }
+    }
+
     ToolbarButton {
       enabled: running
       tooltip: "Stop execution"
@@ -19,9 +19,21 @@
 
 #include "ui/console-component.hpp"
 
+#include <algorithm>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include "core/conversions.hpp"
+#include "core/memory-ring-buffer.hpp"
+#include "core/result.hpp"
+#include "core/transaction.hpp"
+#include "ui/gui-executor.hpp"
+
+namespace {
+/** The number of cells fetchText() fetches at once. */
+constexpr std::size_t textChunkSize = 256;
+}
 
 ConsoleComponent::ConsoleComponent(QQmlContext* context,
                                    MemoryAccess memoryAccess)
@@ -31,7 +43,10 @@ ConsoleComponent::ConsoleComponent(QQmlContext* context,
 , _interruptAddress(0)
 , _memoryAccess(memoryAccess)
 , _deleteBuffer(false)
-, _interruptTriggered(false) {
+, _ringBuffer(false)
+, _ringCapacity(256)
+, _interruptTriggered(false)
+, _textVersion(0) {
   context->setContextProperty("consoleComponent", this);
 }
 
@@ -39,47 +54,72 @@ void ConsoleComponent::appendText(QString text) {
   if (_deleteBuffer) {
     deleteTextInMemory();
   }
+  auto memorySize = _memoryAccess.getCachedMemorySize();
+  MemoryValue::Underlying bytes;
+  size_t length = 0;
   for (auto i : Utility::range<size_t>(0, text.length())) {
-    if (_start + _length >= _memoryAccess.getMemorySize().get()) {
+    if (_start + _length + bytes.size() >= memorySize) {
       // Too long
-      return;
+      break;
     }
     QChar qchar = text.at(i);
-    MemoryValue m = conversions::convert(qchar.unicode(), 8);
-    _memoryAccess.putMemoryValueAt(_start + _length, m);
+    bytes.push_back(static_cast<std::uint8_t>(qchar.unicode()));
     // A nullbyte signals the last byte of the console, so we should not have
     // one inside the text.
-    if (qchar == QChar{'\0'}) return;
+    if (qchar == QChar{'\0'}) break;
 
     // Don't count a nullbyte as length, otherwise text can't be appended
     // afterwards!
-    ++_length;
+    ++length;
   }
-}
-
-QString ConsoleComponent::getText() {
-  QString text = "";
-  for (_length = 0; (_start + _length) < _memoryAccess.getMemorySize().get();
-       ++_length) {
-    MemoryValue memoryValue =
-        _memoryAccess.getMemoryValueAt(_start + _length).get();
-    uint8_t value = conversions::convert<uint8_t>(memoryValue);
+  if (bytes.empty()) return;
 
-    // Stop when a null character is read.
-    if (value == 0) {
-      break;
-    }
+  auto size = bytes.size() * 8;
+  _memoryAccess.putMemoryValueAt(_start + _length,
+                                 MemoryValue(std::move(bytes), size));
+  _length += length;
+  ++_textVersion;
+}
 
-    text += value;
-  }
-  return text;
+void ConsoleComponent::fetchText() {
+  auto start = _start;
+  auto version = _textVersion;
+  _memoryAccess.transactionAsync(
+      GuiExecutor::forObject(this),
+      [this, version](Result<std::string> result) {
+        if (result.hasException()) return;
+        auto text = result.get();
+        // the console changed the text itself in the meantime
+        if (version == _textVersion) _length = text.size();
+        emit textFetched(QString::fromLatin1(
+            text.data(), static_cast<int>(text.size())));
+      },
+      [start](Transaction& transaction) {
+        std::string text;
+        auto memorySize = transaction.getMemorySize();
+        // Fetch the memory in chunks instead of every single character.
+        while (start + text.size() < memorySize) {
+          auto amount =
+              std::min(textChunkSize, memorySize - start - text.size());
+          MemoryValue chunk =
+              transaction.getMemoryValueAt(start + text.size(), amount);
+          const auto& bytes = chunk.internal();
+
+          // Stop when a null character is read.
+          auto end = std::find(bytes.begin(), bytes.begin() + amount, 0);
+          text.append(bytes.begin(), end);
+          if (end != bytes.begin() + amount) break;
+        }
+        return text;
+      });
 }
 
 void ConsoleComponent::setStart(size_t start) {
-  if (_memoryAccess.getMemorySize().get() >= start) {
+  if (_memoryAccess.getCachedMemorySize() >= start) {
     deleteTextInMemory();
     _start = start;
     _length = 0;
+    ++_textVersion;
   }
 }
 
@@ -108,34 +148,43 @@ bool ConsoleComponent::deleteBuffer() {
   return _deleteBuffer;
 }
 
-bool ConsoleComponent::checkInterrupt() {
-  // The interrupt is edge triggered to prevent flooding the console.
-  MemoryValue memoryValue =
-      _memoryAccess.getMemoryValueAt(_interruptAddress).get();
-  uint8_t value = conversions::convert<uint8_t>(memoryValue);
-  bool interruptValue = value & 1;
-  if (_interruptTriggered) {
-    // reset the triggered flag (false if the interrupt was reset)
-    _interruptTriggered = interruptValue;
-    return false;
-  }
-  return interruptValue;
+void ConsoleComponent::checkInterrupt() {
+  _memoryAccess.tryGetMemoryValueAtAsync(
+      GuiExecutor::forObject(this),
+      [this](Result<MemoryValue> result) {
+        if (result.hasException()) return;
+        uint8_t value = conversions::convert<uint8_t>(result.get());
+        bool interruptValue = value & 1;
+        // The interrupt is edge triggered to prevent flooding the console.
+        if (_interruptTriggered) {
+          // reset the triggered flag (false if the interrupt was reset)
+          _interruptTriggered = interruptValue;
+          return;
+        }
+        if (interruptValue) emit interruptRaised();
+      },
+      _interruptAddress,
+      1);
 }
 
 void ConsoleComponent::setInterrupt() {
-  MemoryValue memoryValue =
-      _memoryAccess.getMemoryValueAt(_interruptAddress).get();
-  uint8_t value = conversions::convert<uint8_t>(memoryValue);
-  MemoryValue resetValue = conversions::convert(value | 1, 8);
-  _memoryAccess.putMemoryValueAt(_interruptAddress, resetValue);
+  _writeInterrupt(true);
 }
 
 void ConsoleComponent::resetInterrupt() {
-  MemoryValue memoryValue =
-      _memoryAccess.getMemoryValueAt(_interruptAddress).get();
-  uint8_t value = conversions::convert<uint8_t>(memoryValue);
-  MemoryValue resetValue = conversions::convert(value & 254, 8);
-  _memoryAccess.putMemoryValueAt(_interruptAddress, resetValue);
+  _writeInterrupt(false);
+}
+
+void ConsoleComponent::_writeInterrupt(bool set) {
+  auto address = _interruptAddress;
+  // read and write in one transaction, so the program can't change the other
+  // bits in between
+  _memoryAccess.runTransaction([address, set](Transaction& transaction) {
+    MemoryValue memoryValue = transaction.getMemoryValueAt(address);
+    uint8_t value = conversions::convert<uint8_t>(memoryValue);
+    value = set ? (value | 1) : (value & 254);
+    transaction.putMemoryValueAt(address, conversions::convert(value, 8));
+  });
 }
 
 void ConsoleComponent::deleteTextInMemory() {
@@ -143,5 +192,57 @@ void ConsoleComponent::deleteTextInMemory() {
     MemoryValue zero(_length * 8);
     _memoryAccess.putMemoryValueAt(_start, zero);
     _length = 0;
+    ++_textVersion;
   }
 }
+
+void ConsoleComponent::setRingBuffer(bool ringBuffer) {
+  _ringBuffer = ringBuffer;
+  emit settingsChanged();
+}
+
+bool ConsoleComponent::ringBuffer() {
+  return _ringBuffer;
+}
+
+void ConsoleComponent::setRingCapacity(size_t capacity) {
+  if (capacity >= 2) {
+    _ringCapacity = capacity;
+    emit settingsChanged();
+  }
+}
+
+ConsoleComponent::size_t ConsoleComponent::getRingCapacity() {
+  return _ringCapacity;
+}
+
+ConsoleComponent::size_t ConsoleComponent::getInputRingAddress() {
+  return _start + MemoryRingBuffer::headerSize + _ringCapacity;
+}
+
+void ConsoleComponent::drainOutput() {
+  _memoryAccess.drainRingBufferAsync(
+      GuiExecutor::forObject(this),
+      [this](Result<std::string> result) {
+        if (result.hasException()) return;
+        auto bytes = result.get();
+        if (bytes.empty()) return;
+        emit outputDrained(QString::fromLatin1(
+            bytes.data(), static_cast<int>(bytes.size())));
+      },
+      _start,
+      _ringCapacity);
+}
+
+void ConsoleComponent::pushInput(QString text) {
+  auto bytes = text.toLatin1();
+  std::string data(bytes.constData(), bytes.size());
+  _memoryAccess.fillRingBufferAsync(
+      GuiExecutor::forObject(this),
+      [this, text](Result<bool> result) {
+        emit inputPushed(text, !result.hasException() && result.get());
+      },
+      getInputRingAddress(),
+      _ringCapacity,
+      data);
+}
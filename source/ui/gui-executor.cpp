@@ -0,0 +1,50 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "ui/gui-executor.hpp"
+
+GuiExecutor& GuiExecutor::instance() {
+  static GuiExecutor executor;
+  return executor;
+}
+
+GuiExecutor::Executor GuiExecutor::forObject(QObject* context) {
+  QPointer<QObject> guard(context);
+  return [guard](Function function) {
+    instance().post([guard, function] {
+      if (guard) function();
+    });
+  };
+}
+
+void GuiExecutor::post(Function function) {
+  emit functionPosted(std::move(function));
+}
+
+void GuiExecutor::_run(GuiExecutor::Function function) {
+  function();
+}
+
+GuiExecutor::GuiExecutor() : QObject() {
+  connect(this,
+          &GuiExecutor::functionPosted,
+          this,
+          &GuiExecutor::_run,
+          Qt::QueuedConnection);
+}
@@ -26,6 +26,7 @@
 
 #include "common/string-conversions.hpp"
 #include "common/utility.hpp"
+#include "core/binary-snapshot.hpp"
 #include "core/snapshot.hpp"
 #include "ui/snapshot-component.hpp"
 #include "ui/translateable-processing.hpp"
@@ -37,6 +38,10 @@ GuiProject::MemoryToStringConverterMap GuiProject::_memoryToStringMap = {
     {"SignedDecimalData", StringConversions::toSignedDecString},
     {"UnsignedDecimalData", StringConversions::toUnsignedDecString}};
 
+GuiProject::MemoryToStringsConverterMap GuiProject::_memoryToStringsMap = {
+    {"BinaryData", StringConversions::toBinStrings},
+    {"HexData", StringConversions::toHexStrings}};
+
 GuiProject::StringToMemoryConverterMap GuiProject::_stringToMemoryMap = {
     {"BinaryData", StringConversions::binStringToMemoryValue},
     {"HexData", StringConversions::hexStringToMemoryValue},
@@ -184,6 +189,18 @@ void GuiProject::runBreakpoint() {
   _projectModule.getCommandInterface().executeToBreakpoint();
 }
 
+void GuiProject::stepBack() {
+  emit runClicked(true);
+  _editorComponent.parse();
+  _projectModule.getCommandInterface().executePreviousLine();
+}
+
+void GuiProject::stepBackToBreakpoint() {
+  emit runClicked(false);
+  _editorComponent.parse();
+  _projectModule.getCommandInterface().executeBackwardsToBreakpoint();
+}
+
 void GuiProject::stop() {
   _projectModule.stopExecution();
 }
@@ -233,18 +250,12 @@ void GuiProject::loadText(const QUrl& path) {
 }
 
 void GuiProject::saveSnapshot(const QString& qName) {
-  // clang-format off
-  auto snapshot = _projectModule
-    .getMemoryManager()
-    .generateSnapshot()
-    .get()
-    .getJson()
-    .dump(4);
-  // clang-format on
+  auto snapshot =
+      _projectModule.getMemoryManager().generateBinarySnapshot().get();
 
   try {
     _snapshotComponent->addSnapshot(
-        _architectureFormulaString, qName, snapshot);
+        _architectureFormulaString, qName, snapshot.getData());
   } catch (const std::exception& exception) {
     _throwError(Translateable(
         QT_TRANSLATE_NOOP("GUI error messages",
@@ -311,9 +322,15 @@ void GuiProject::loadSnapshot(const QString& qName) {
   try {
     auto path =
         _snapshotComponent->snapshotPath(_architectureFormulaString, qName);
-    Json snapshotData = Json::parse(Utility::loadFromFile(path));
-    Snapshot snapshot(snapshotData);
-    _projectModule.getMemoryManager().loadSnapshot(snapshot);
+    auto snapshotData = Utility::loadFromFile(path);
+    if (BinarySnapshot::isBinarySnapshot(snapshotData)) {
+      BinarySnapshot snapshot(std::move(snapshotData));
+      _projectModule.getMemoryManager().loadBinarySnapshot(snapshot);
+    } else {
+      // snapshots saved by older versions are json
+      Snapshot snapshot(Json::parse(snapshotData));
+      _projectModule.getMemoryManager().loadSnapshot(snapshot);
+    }
     _editorComponent.parse(true);
   } catch (const std::exception& exception) {
     _throwError(Translateable(
@@ -360,6 +377,11 @@ GuiProject::getMemoryToStringConversions() {
   return _memoryToStringMap;
 }
 
+const GuiProject::MemoryToStringsConverterMap&
+GuiProject::getMemoryToStringsConversions() {
+  return _memoryToStringsMap;
+}
+
 const GuiProject::StringToMemoryConverterMap&
 GuiProject::getStringToMemoryConversions() {
   return _stringToMemoryMap;
@@ -37,7 +37,7 @@ void InputClickModel::newClick(unsigned int x, unsigned int y) {
 }
 
 void InputClickModel::setStart(unsigned int start) {
-  if (_memoryAccess.getMemorySize().get() > start + 2) {
+  if (_memoryAccess.getCachedMemorySize() > start + 2) {
     _start = start;
   }
 }
@@ -18,16 +18,31 @@
   */
 
 #include <QKeySequence>
+#include <string>
 #include "ui/input-key-model.hpp"
 #include "core/conversions.hpp"
+#include "core/memory-ring-buffer.hpp"
 
 InputKeyModel::InputKeyModel(QQmlContext* context,
                                    MemoryAccess memoryAccess)
-: QObject(), _context(context), _start(0), _memoryAccess(memoryAccess) {
+: QObject()
+, _context(context)
+, _start(0)
+, _ringCapacity(0)
+, _memoryAccess(memoryAccess) {
   _context->setContextProperty("inputKeyMod", this);
 }
 
 void InputKeyModel::keyPressed(unsigned int id) {
+  if (_ringCapacity > 0) {
+    // queue the id (little endian), it is dropped if the buffer is full
+    std::string bytes;
+    for (int byte = 0; byte < 4; ++byte) {
+      bytes.push_back(static_cast<char>(id >> (8 * byte)));
+    }
+    _memoryAccess.fillRingBuffer(_start, _ringCapacity, bytes);
+    return;
+  }
   // save id at start in Memory
   auto memoryValue = conversions::convert(id, 32);
   _memoryAccess.putMemoryValueAt(_start, memoryValue);
@@ -42,7 +57,19 @@ QString InputKeyModel::getStart() {
 }
 
 void InputKeyModel::setStart(unsigned int start) {
-  if (_memoryAccess.getMemorySize().get() > start + 2) {
+  if (_memoryAccess.getCachedMemorySize() > start + 2) {
     _start = start;
   }
 }
+
+unsigned int InputKeyModel::getRingCapacity() {
+  return _ringCapacity;
+}
+
+void InputKeyModel::setRingCapacity(unsigned int capacity) {
+  if (capacity == 0 ||
+      (capacity >= 2 && _memoryAccess.getCachedMemorySize() >=
+                            _start + MemoryRingBuffer::headerSize + capacity)) {
+    _ringCapacity = capacity;
+  }
+}
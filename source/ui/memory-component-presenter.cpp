@@ -20,11 +20,13 @@
 #include "ui/memory-component-presenter.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <string>
 
 #include "common/assert.hpp"
 #include "common/string-conversions.hpp"
 #include "core/memory-value.hpp"
+#include "ui/gui-executor.hpp"
 #include "ui/gui-project.hpp"
 
 MemoryComponentPresenter::MemoryComponentPresenter(const MemoryAccess &access,
@@ -34,35 +36,52 @@ MemoryComponentPresenter::MemoryComponentPresenter(const MemoryAccess &access,
 : QAbstractListModel(parent)
 , _memoryAccess(access)
 , _memoryManager(manager)
-, _memorySize(access.getMemorySize().get())
-, _memoryCacheOffset(std::min(static_cast<size_t>(10), _memorySize / 2)) {
+, _memorySize(access.getCachedMemorySize()) {
+  // look up the converter of every role once instead of on every data() call
+  for (int role = ValueRoleBin8; role < InfoRole; ++role) {
+    QString roleString = roleNames().value(role);
+    auto dataFormat = _roleToDataFormat(roleString);
+    assert::that(
+        GuiProject::getMemoryToStringConversions().contains(dataFormat));
+
+    int numberOfBits = 8;
+    if (roleString.endsWith("16")) numberOfBits = 16;
+    if (roleString.endsWith("32")) numberOfBits = 32;
+    if (roleString.endsWith("64")) numberOfBits = 64;
+
+    _formats.push_back(
+        {GuiProject::getMemoryToStringConversions()[dataFormat],
+         numberOfBits,
+         GuiProject::getMemoryToStringsConversions().value(dataFormat)});
+  }
+  _formatted.resize(_formats.size());
+
   projectContext->setContextProperty("memoryModel", this);
 }
 
 void MemoryComponentPresenter::onMemoryChanged(size_t address, size_t length) {
-  // calculate region for (max) 64bit memory cells
-  // region should not exceed real memory size
-  size_t start = address - (address % (64 / 8));
-  size_t end = std::min(start + (length - (length % (64 / 8)) + (64 / 8)) - 1,
-                        _memorySize - 1);
-
-  // if the memory that is hold in cache is changed, invalidate cache
-  bool overlapAddress = (address >= _memoryCacheBaseAddress &&
-                         address <= _memoryCacheBaseAddress + _memoryCacheSize);
-
-  bool overlapLength =
-      ((address + length) >= _memoryCacheBaseAddress &&
-       (address + length) <= _memoryCacheBaseAddress + _memoryCacheSize);
-
-  if (overlapAddress || overlapLength) {
-    _memoryCacheValid = false;
-  }
+  auto overlaps = [address, length](size_t begin, size_t cells) {
+    return address < begin + cells && address + length > begin;
+  };
 
-  // update calculated region
-  emit dataChanged(this->index(start), this->index(end));
+  // Protections are created along with the code that is written into them.
+  _protection.erase(_protection.lower_bound(address),
+                    _protection.lower_bound(address + length));
+
+  // Only the window that is going to be displayed has to be fetched again. A
+  // window that was not sent to the core yet will read the new values anyway.
+  if (_nextPending) return;
+  if (_fetching) {
+    if (overlaps(_fetchingAddress, _fetchingCells)) {
+      _fetchWindow(_fetchingAddress, _fetchingCells);
+    }
+  } else if (overlaps(_windowAddress, _windowCells)) {
+    _fetchWindow(_windowAddress, _windowCells);
+  }
 }
 
 void MemoryComponentPresenter::onMemorySizeChanged(size_t newSize) {
+  _protection.clear();
   if (newSize > _memorySize) {
     beginInsertRows(QModelIndex(), _memorySize, newSize - 1);
     _memorySize = newSize;
@@ -70,6 +89,11 @@ void MemoryComponentPresenter::onMemorySizeChanged(size_t newSize) {
   } else if (newSize < _memorySize) {
     beginRemoveRows(QModelIndex(), newSize, _memorySize - 1);
     _memorySize = newSize;
+    // the window could reach beyond the new end, it is fetched again
+    _windowCells = 0;
+    for (auto &strings : _formatted) {
+      strings.clear();
+    }
     endRemoveRows();
   }
 }
@@ -99,7 +123,27 @@ void MemoryComponentPresenter::setValue(int address,
 }
 
 bool MemoryComponentPresenter::isMemoryProtected(size_t address) {
-  return _memoryAccess.isMemoryProtectedAt(address).get();
+  auto iterator = _protection.find(address);
+  if (iterator != _protection.end()) return iterator->second;
+
+  _protection.emplace(address, false);
+  _memoryAccess.isMemoryProtectedAtAsync(
+      GuiExecutor::forObject(this),
+      [this, address](Result<bool> result) {
+        // The cell is shown as unprotected if the project could not tell.
+        if (result.hasException()) return;
+        auto isProtected = result.get();
+        auto iterator = _protection.find(address);
+        // The cell changed in the meantime, it is asked for again.
+        if (iterator == _protection.end()) return;
+        if (iterator->second != isProtected) {
+          iterator->second = isProtected;
+          emit dataChanged(this->index(address), this->index(address));
+        }
+      },
+      address,
+      std::size_t{1});
+  return false;
 }
 
 void MemoryComponentPresenter::setContextInformation(int addressStart,
@@ -134,35 +178,39 @@ MemoryComponentPresenter::dataAdress(const QModelIndex &index, int role) const {
 
 QVariant
 MemoryComponentPresenter::dataMemory(const QModelIndex &index, int role) const {
-  // get role as a string because there is more information in it
-  QString roleString = MemoryComponentPresenter::roleNames().value(role);
-
-  int numberOfBits = 8;
-  if (roleString.endsWith("16")) numberOfBits = 16;
-  if (roleString.endsWith("32")) numberOfBits = 32;
-  if (roleString.endsWith("64")) numberOfBits = 64;
-
+  if (role < ValueRoleBin8 || role >= InfoRole) return QString("");
+  auto formatIndex = role - ValueRoleBin8;
+  const auto &format = _formats[formatIndex];
 
-  int memoryAddress = index.row();
-  int memoryLength = numberOfBits / 8;
+  size_t memoryAddress = index.row();
+  size_t memoryLength = format.numberOfBits / 8;
 
   // return empty string if cell is not displayed
   if (memoryAddress % memoryLength != 0) return QString("");
+  // wrong address
+  if (memoryAddress + memoryLength > _memorySize) return QString("");
+
+  // Never wait for the core here, the cell stays empty until its window has
+  // arrived and dataChanged is emitted.
+  if (memoryAddress < _windowAddress ||
+      memoryAddress + memoryLength > _windowAddress + _windowCells) {
+    _requestWindow(memoryAddress);
+    return QString("");
+  }
 
+  auto offset = memoryAddress - _windowAddress;
+  auto &strings = _formatted[formatIndex];
+  if (strings.empty()) {
+    strings.resize(_windowCells);
+    if (format.rangeConverter) _convertWindow(format, strings);
+  }
 
-  if (memoryAddress + memoryLength <= _memorySize) {
-    MemoryValue memoryCell = getMemoryValueCached(memoryAddress, memoryLength);
-
-    // auto dataFormat = role_string.remove(QRegularExpression("\\d+"));
-    auto dataFormat = _roleToDataFormat(roleString);
-    auto converter = GuiProject::getMemoryToStringConversions()[dataFormat];
-    auto memoryValueString = converter(memoryCell);
-
-    return QString::fromStdString(memoryValueString);
-  } else {
-    // wrong address
-    return QString("");
+  auto &string = strings[offset];
+  if (string.isNull()) {
+    MemoryValue memoryCell(_window, offset * 8, (offset + memoryLength) * 8);
+    string = QString::fromStdString(format.converter(memoryCell));
   }
+  return string;
 }
 
 
@@ -173,35 +221,6 @@ MemoryComponentPresenter::dataInfo(const QModelIndex &index, int role) const {
 }
 
 
-MemoryValue MemoryComponentPresenter::getMemoryValueCached(
-    const size_t memoryAddress, const size_t memoryLength) const {
-  // check for cache
-  if (_memoryCacheValid && memoryAddress >= _memoryCacheBaseAddress &&
-      memoryAddress + memoryLength <=
-          _memoryCacheBaseAddress + _memoryCacheSize) {
-    // cache hit -> get memory value from cache
-
-    // fetch data from cache
-    return _memoryCache.subSet(
-        (memoryAddress - _memoryCacheBaseAddress) * 8,
-        (memoryAddress - _memoryCacheBaseAddress + memoryLength) * 8);
-  } else {
-    // cache miss -> update cache from core
-
-    // calculate new cache region
-    _memoryCacheBaseAddress = memoryAddress;
-    _memoryCacheSize = memoryLength;
-
-    _updateCache();
-
-    size_t subsetStart = (memoryAddress - _memoryCacheBaseAddress) * 8;
-    size_t subsetEnd =
-        (memoryAddress - _memoryCacheBaseAddress + memoryLength) * 8;
-    return _memoryCache.subSet(subsetStart, subsetEnd);
-  }
-}
-
-
 QHash<int, QByteArray> MemoryComponentPresenter::roleNames() const {
   // clang-format off
   static QHash<int, QByteArray> roles = {
@@ -228,28 +247,85 @@ QHash<int, QByteArray> MemoryComponentPresenter::roleNames() const {
   return roles;
 }
 
-void MemoryComponentPresenter::_updateCache() const {
-  // add some offset around but
-  // cache size should not exceed real memory boundaries
-  // (done this way to prevent overflows)
-  if (_memoryCacheBaseAddress < _memoryCacheOffset) {
-    _memoryCacheBaseAddress = 0;
-  } else {
-    _memoryCacheBaseAddress -= _memoryCacheOffset;
+void MemoryComponentPresenter::_requestWindow(size_t address) const {
+  // the window that is going to replace the current one
+  if (_nextPending) {
+    if (address >= _nextAddress && address < _nextAddress + _nextCells) return;
+  } else if (_fetching) {
+    if (address >= _fetchingAddress &&
+        address < _fetchingAddress + _fetchingCells) {
+      return;
+    }
   }
-  if (_memoryCacheBaseAddress + _memoryCacheSize >=
-      _memorySize - _memoryCacheOffset * 2) {
-    _memoryCacheSize = _memorySize - _memoryCacheBaseAddress;
-  } else {
-    _memoryCacheSize += _memoryCacheOffset * 2;
+
+  // start a bit in front of the address, as the view usually scrolls on, and
+  // keep 64 bit cells from crossing the end of the window
+  auto begin = address < _windowMargin ? 0 : address - _windowMargin;
+  begin -= begin % 8;
+  _fetchWindow(begin, std::min(_windowSize, _memorySize - begin));
+}
+
+void MemoryComponentPresenter::_fetchWindow(size_t address,
+                                            size_t size) const {
+  if (_fetching) {
+    _nextPending = true;
+    _nextAddress = address;
+    _nextCells = size;
+    return;
+  }
+  _fetching = true;
+  _fetchingAddress = address;
+  _fetchingCells = size;
+
+  // data() is const, but fetching only changes what is cached; the executor
+  // drops the result if the presenter is gone by the time it arrives
+  auto self = const_cast<MemoryComponentPresenter *>(this);
+  _memoryAccess.tryGetMemoryValueAtAsync(
+      GuiExecutor::forObject(self),
+      [self, address](Result<MemoryValue> window) {
+        self->_onWindowFetched(address, window);
+      },
+      address,
+      size);
+}
+
+void MemoryComponentPresenter::_onWindowFetched(
+    size_t address, const Result<MemoryValue> &window) {
+  _fetching = false;
+
+  // the memory could have shrunk while the window was fetched; a failed
+  // fetch keeps the old window, the next request tries again
+  if (address < _memorySize && !window.hasException()) {
+    auto value = window.get();
+    size_t cells = std::min(value.getSize() / 8, _memorySize - address);
+    auto data = value.internal();
+    data.resize(cells);
+    _window = MemoryValue(std::move(data), cells * 8);
+    _windowAddress = address;
+    _windowCells = cells;
+    for (auto &strings : _formatted) {
+      strings.clear();
+    }
+    emit dataChanged(this->index(address), this->index(address + cells - 1));
   }
 
-  // fetch cache from core
-  _memoryCache =
-      _memoryAccess.getMemoryValueAt(_memoryCacheBaseAddress, _memoryCacheSize)
-          .get();
-  // set cache status to valid
-  _memoryCacheValid = true;
+  if (_nextPending) {
+    _nextPending = false;
+    _fetchWindow(_nextAddress, _nextCells);
+  }
+}
+
+void MemoryComponentPresenter::_convertWindow(
+    const Format &format, std::vector<QString> &strings) const {
+  // the window starts at a multiple of eight cells, so every cell of the
+  // format is aligned to the window
+  size_t cellLength = format.numberOfBits / 8;
+  size_t cells = _windowCells / cellLength;
+  auto converted = format.rangeConverter(
+      _window.subSet(0, cells * format.numberOfBits), format.numberOfBits);
+  for (size_t cell = 0; cell < cells; ++cell) {
+    strings[cell * cellLength] = QString::fromStdString(converted[cell]);
+  }
 }
 
 QString MemoryComponentPresenter::_roleToDataFormat(QString role) {
@@ -18,15 +18,25 @@
 
 #include "ui/output-component.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "common/assert.hpp"
 #include "core/conversions.hpp"
 #include "core/memory-manager.hpp"
 #include "core/memory-value.hpp"
+#include "core/result.hpp"
+#include "ui/gui-executor.hpp"
 
 OutputComponent::OutputComponent(MemoryManager &memoryManager,
                                  MemoryAccess &memoryAccess,
                                  QQmlContext *projectContext,
                                  QObject *parent)
-: _memoryAccess(memoryAccess) {
+: _memoryAccess(memoryAccess)
+, _byteSize(memoryAccess.getByteSize().get()) {
   // Make this component available to all QML output items.
   projectContext->setContextProperty("outputComponent", this);
 
@@ -68,6 +78,19 @@ void OutputComponent::setOutputItemProperty(int ouputItemIndex,
 
 void OutputComponent::updateMemory(size_t address, size_t length) {
   emit memoryChanged(QVariant::fromValue(address), QVariant::fromValue(length));
+  // The slots of rangeChanged may subscribe or unsubscribe, so the matching
+  // subscriptions are collected before any of them is signaled.
+  std::vector<int> changed;
+  for (const auto &subscription : _subscriptions) {
+    const auto &range = subscription.second;
+    if (address < range.first + range.second &&
+        address + length > range.first) {
+      changed.push_back(subscription.first);
+    }
+  }
+  for (auto subscription : changed) {
+    emit rangeChanged(subscription);
+  }
 }
 
 void OutputComponent::putMemoryValue(int address,
@@ -98,8 +121,115 @@ QList<bool> OutputComponent::getMemoryContent(int address, int length) const {
   return contentList;
 }
 
+int OutputComponent::fetchMemoryBytes(int address, int length) {
+  auto request = _nextRequest++;
+  auto executor = GuiExecutor::forObject(this);
+  if (length <= 0 || _byteSize != 8) {
+    // Answered later as well, so the caller always knows the request first.
+    executor([this, request] { emit memoryBytesFetched(request, {}); });
+    return request;
+  }
+  _memoryAccess.tryGetMemoryValueAtAsync(
+      executor,
+      [this, request, length](Result<MemoryValue> result) {
+        QByteArray bytes;
+        if (!result.hasException()) {
+          auto content = result.get();
+          bytes = QByteArray(
+              reinterpret_cast<const char *>(content.internal().data()),
+              length);
+        }
+        emit memoryBytesFetched(request, bytes);
+      },
+      address,
+      length);
+  return request;
+}
+
+int OutputComponent::fetchMemoryWords(int address, int count, int wordSize) {
+  assert::that(wordSize >= 1 && wordSize <= 4);
+  auto request = _nextRequest++;
+  auto executor = GuiExecutor::forObject(this);
+  if (count <= 0 || _byteSize != 8) {
+    // Answered later as well, so the caller always knows the request first.
+    executor([this, request] { emit memoryWordsFetched(request, {}); });
+    return request;
+  }
+  _memoryAccess.tryGetMemoryValueAtAsync(
+      executor,
+      [this, request, count, wordSize](Result<MemoryValue> result) {
+        QList<qreal> words;
+        if (!result.hasException()) {
+          auto content = result.get();
+          const auto &bytes = content.internal();
+          words.reserve(count);
+          for (int word = 0; word < count; ++word) {
+            std::uint32_t value = 0;
+            for (int byte = wordSize - 1; byte >= 0; --byte) {
+              value = (value << 8) | bytes[word * wordSize + byte];
+            }
+            words.append(value);
+          }
+        }
+        emit memoryWordsFetched(request, words);
+      },
+      address,
+      count * wordSize);
+  return request;
+}
+
+void OutputComponent::putMemoryBytes(int address, const QByteArray &bytes) {
+  if (bytes.isEmpty() || _byteSize != 8) return;
+  MemoryValue::Underlying data(bytes.begin(), bytes.end());
+  auto size = data.size() * 8;
+  _memoryAccess.putMemoryValueAt(address, MemoryValue(std::move(data), size));
+}
+
+void OutputComponent::putMemoryWords(int address,
+                                     const QList<qreal> &words,
+                                     int wordSize) {
+  assert::that(wordSize >= 1 && wordSize <= 4);
+  if (words.isEmpty() || _byteSize != 8) return;
+
+  MemoryValue::Underlying data;
+  data.reserve(words.size() * wordSize);
+  std::uint32_t maximum =
+      std::numeric_limits<std::uint32_t>::max() >> (8 * (4 - wordSize));
+  for (auto word : words) {
+    // Converting a negative, too large or NaN value would be undefined
+    std::uint32_t value = 0;
+    if (word >= maximum) {
+      value = maximum;
+    } else if (word > 0) {
+      value = static_cast<std::uint32_t>(word);
+    }
+    for (int byte = 0; byte < wordSize; ++byte) {
+      data.push_back(static_cast<std::uint8_t>(value >> (8 * byte)));
+    }
+  }
+  auto size = data.size() * 8;
+  _memoryAccess.putMemoryValueAt(address, MemoryValue(std::move(data), size));
+}
+
+int OutputComponent::subscribe(int address, int length) {
+  auto subscription = _nextSubscription++;
+  setSubscriptionRange(subscription, address, length);
+  return subscription;
+}
+
+void OutputComponent::setSubscriptionRange(int subscription,
+                                           int address,
+                                           int length) {
+  _subscriptions[subscription] = {static_cast<size_t>(std::max(address, 0)),
+                                  static_cast<size_t>(std::max(length, 0))};
+}
+
+void OutputComponent::unsubscribe(int subscription) {
+  _subscriptions.erase(subscription);
+}
+
 int OutputComponent::getMemorySize() {
-  return _memoryAccess.getMemorySize().get();
+  return _memoryAccess.getCachedMemorySize();
 }
 
 MemoryAccess &OutputComponent::getMemoryAccess() {
@@ -20,103 +20,317 @@
 #include "ui/pixel-display-color-mode.hpp"
 
 #include <QImage>
+#include <algorithm>
+#include <tuple>
 
 #include "core/conversions.hpp"
 #include "core/memory-value.hpp"
-#include "ui/output-component.hpp"
+#include "core/transaction.hpp"
 #include "ui/pixel-display-options.hpp"
 
 namespace colormode {
-size_t ColorMode::loadPointer(Optional<OutputComponent *> memoryAccess,
-                              size_t address,
-                              bool indirect,
-                              size_t cellSize,
-                              size_t pointerSize,
-                              Options &o) {
-  if (indirect) {
-    if (memoryAccess) {
-      if ((address + (pointerSize + cellSize - 1) / cellSize) >=
-          (*memoryAccess)->getMemoryAccess().getMemorySize().get()) {
-        // the address of the pointer is invalid
-        o.setError(1);
-        return 0;
-      }
-      MemoryValue pointer = ColorMode::getMemoryValueAt(
-          memoryAccess, address, (pointerSize + cellSize - 1) / cellSize, o);
-      return conversions::convert<size_t>(
-          pointer, conversions::standardConversions::nonsigned);
-    } else {
+namespace {
+constexpr std::uint32_t errorColor = 0xFFFF00FF;
+constexpr std::size_t cellSize = 8;          // TODO
+constexpr std::size_t pointerSizeInByte = 4;  // TODO
+
+// distance between two consecutive pixels of the RGB pixel buffer in bit
+std::size_t rgbStrideInBit(const Options &o) {
+  std::size_t sizeInBit = o.rBit + o.gBit + o.bBit;
+  if (o.tight) return sizeInBit;
+  return ((sizeInBit + cellSize - 1) / cellSize + o.freeBytes) * cellSize;
+}
+
+std::size_t rgbBufferSize(const Options &o) {
+  return (rgbStrideInBit(o) * o.width * o.height + cellSize - 1) / cellSize;
+}
+
+std::size_t monochromeBitsPerByte(const Options &o) {
+  return o.freeBits < cellSize ? cellSize - o.freeBits : 1;
+}
+
+std::size_t monochromeBufferSize(const Options &o) {
+  std::size_t bitsPerByte = monochromeBitsPerByte(o);
+  return (o.width * o.height + bitsPerByte - 1) / bitsPerByte;
+}
+
+// index of the first pixel of row y and the distance between two pixels of
+// the same row, both in pixels
+std::size_t firstIndexOfRow(const Options &o, std::size_t y) {
+  return o.columns_rows ? y : y * o.width;
+}
+
+std::size_t indexStride(const Options &o) {
+  return o.columns_rows ? o.height : 1;
+}
+
+// loads count (at most 57) bits starting at bit from a little endian buffer,
+// the caller guarantees that all of them are inside the buffer
+std::uint64_t
+loadBits(const std::uint8_t *data, std::size_t bit, std::size_t count) {
+  const std::uint8_t *source = data + bit / 8;
+  std::size_t bytes = (bit % 8 + count + 7) / 8;
+  std::uint64_t raw = 0;
+  for (std::size_t i = 0; i < bytes; ++i) {
+    raw |= static_cast<std::uint64_t>(source[i]) << (8 * i);
+  }
+  return (raw >> (bit % 8)) & ((std::uint64_t(1) << count) - 1);
+}
+
+// scales a channel of the given width to 8 bit
+std::uint32_t scaleChannel(std::uint64_t value, std::size_t bits) {
+  if (bits >= 8) return static_cast<std::uint32_t>(value >> (bits - 8));
+  return static_cast<std::uint32_t>(value << (8 - bits)) & 0xFF;
+}
+
+// converts count pixels beginning at bit, step bits apart, into out
+void convertRGBLine(const std::uint8_t *data,
+                    std::size_t bit,
+                    std::size_t step,
+                    std::size_t count,
+                    const Options &o,
+                    std::uint32_t *out) {
+  if (o.rBit == 8 && o.gBit == 8 && o.bBit == 8 && bit % 8 == 0 &&
+      step % 8 == 0) {
+    // byte aligned 24 bit pixels, the common case
+    const std::uint8_t *source = data + bit / 8;
+    std::size_t stepInByte = step / 8;
+    for (std::size_t i = 0; i < count; ++i) {
+      const std::uint8_t *pixel = source + i * stepInByte;
+      out[i] = 0xFF000000u | (std::uint32_t(pixel[2]) << 16) |
+               (std::uint32_t(pixel[1]) << 8) | pixel[0];
+    }
+    return;
+  }
+  const std::size_t sizeInBit = o.rBit + o.gBit + o.bBit;
+  const std::uint64_t blueMask = (std::uint64_t(1) << o.bBit) - 1;
+  const std::uint64_t greenMask = (std::uint64_t(1) << o.gBit) - 1;
+  const std::uint64_t redMask = (std::uint64_t(1) << o.rBit) - 1;
+  for (std::size_t i = 0; i < count; ++i) {
+    std::uint64_t pixel = loadBits(data, bit + i * step, sizeInBit);
+    std::uint32_t blue = scaleChannel(pixel & blueMask, o.bBit);
+    std::uint32_t green = scaleChannel((pixel >> o.bBit) & greenMask, o.gBit);
+    std::uint32_t red =
+        scaleChannel((pixel >> (o.bBit + o.gBit)) & redMask, o.rBit);
+    out[i] = 0xFF000000u | (red << 16) | (green << 8) | blue;
+  }
+}
+
+std::uint8_t reverseBits(std::uint8_t byte) {
+  byte = ((byte & 0xF0) >> 4) | ((byte & 0x0F) << 4);
+  byte = ((byte & 0xCC) >> 2) | ((byte & 0x33) << 2);
+  return ((byte & 0xAA) >> 1) | ((byte & 0x55) << 1);
+}
+}
+
+void ColorMode::locateFrame(Transaction &transaction,
+                            Options &o,
+                            Frame &frame,
+                            bool pixels,
+                            bool colors) {
+  frame.pixelBufferPointer = o.pixelBaseAddress;
+  frame.colorTablePointer = o.colorBaseAddress;
+  frame.memorySize = transaction.getMemorySize();
+  auto loadPointer = [&](size_t address) -> size_t {
+    if (address + pointerSizeInByte >= frame.memorySize) {
+      o.setError(1);
       return 0;
     }
-  } else {
-    return address;
+    return conversions::convert<size_t>(
+        transaction.tryGetMemoryValueAt(address, pointerSizeInByte),
+        conversions::standardConversions::nonsigned);
+  };
+  if (pixels && o.pixelBufferPointerLike) {
+    frame.pixelBufferPointer = loadPointer(o.pixelBaseAddress);
+  }
+  if (colors && o.colorTablePointerLike) {
+    frame.colorTablePointer = loadPointer(o.colorBaseAddress);
   }
 }
-MemoryValue
-ColorMode::getMemoryValueAt(Optional<OutputComponent *> memoryAccess,
-                            size_t address,
-                            size_t length,
-                            // size_t defaultLength,
-                            Options &o) {
-  if (memoryAccess) {
-    size_t memSize = (*memoryAccess)->getMemoryAccess().getMemorySize().get();
-    if (memSize >= address + length) {
-      return (*memoryAccess)
-          ->getMemoryAccess()
-          .tryGetMemoryValueAt(address, length)
-          .get();
-    } else if (memSize > address) {
-      return (*memoryAccess)
-          ->getMemoryAccess()
-          .tryGetMemoryValueAt(address, memSize - address)
-          .get();
+
+void ColorMode::fetchFrame(Transaction &transaction,
+                           Options &o,
+                           Frame &frame,
+                           size_t pixelOffset,
+                           size_t pixelLength,
+                           size_t colorLength) {
+  // buffers reaching past the end of the memory are cut off
+  auto fetch = [&](size_t address, size_t length) {
+    Optional<MemoryValue> value;
+    if (length == 0) return value;
+    if (address < frame.memorySize) {
+      value = transaction.tryGetMemoryValueAt(
+          address, std::min(length, frame.memorySize - address));
     } else {
       o.setError(4);
-      return MemoryValue{1};
     }
+    return value;
+  };
+  if (pixelLength > 0) {
+    frame.pixelOffset = pixelOffset;
+    frame.pixels = fetch(frame.pixelBufferPointer + pixelOffset, pixelLength);
+  }
+  if (colorLength > 0) {
+    frame.colors = fetch(frame.colorTablePointer, colorLength);
   }
-  o.setError(0);
-  return MemoryValue{1};
 }
 
+ColorMode::size_t ColorMode::getPixelBufferSize(const Options &o) {
+  return o.colorMode == 1 ? monochromeBufferSize(o) : rgbBufferSize(o);
+}
 
-// RGB*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*
-const ColorMode::GetPixelFunction ColorMode::RGBGetPixel = [](
-    Optional<OutputComponent *> memoryAccess,
-    Options &o,
-    size_t x,
-    size_t y) -> std::uint32_t {
-  size_t cellSize = 8;      // TODO
-  size_t pointerSize = 32;  // TODO
-  size_t pixelBufferPointer = ColorMode::loadPointer(memoryAccess,
-                                                     o.pixelBaseAddress,
-                                                     o.pixelBufferPointerLike,
-                                                     cellSize,
-                                                     pointerSize,
-                                                     o);
-  size_t sizeInBit = o.rBit + o.gBit + o.bBit;
-  size_t byteSize =
-      (sizeInBit + cellSize - 1) / cellSize + (o.tight ? 0 : o.freeBytes);
-  size_t index =
-      x * (o.columns_rows ? o.height : 1) + y * (o.columns_rows ? 1 : o.width);
-  size_t address = pixelBufferPointer;
-  size_t bitOffset = 0;
-  if (o.tight) {
-    address += (sizeInBit * index) / cellSize;
-    bitOffset = (sizeInBit * index) % cellSize;
+std::pair<ColorMode::size_t, ColorMode::size_t>
+ColorMode::rowsOf(const Options &o, size_t begin, size_t end) {
+  if (o.columns_rows || o.width == 0) {
+    // in column major order a single changed column touches every row
+    return {0, o.height};
+  }
+  size_t firstIndex;
+  size_t lastIndex;
+  if (o.colorMode == 1) {
+    size_t bitsPerByte = monochromeBitsPerByte(o);
+    firstIndex = begin * bitsPerByte;
+    lastIndex = end * bitsPerByte;
   } else {
-    address += byteSize * index;
+    size_t stride = std::max<size_t>(rgbStrideInBit(o), 1);
+    firstIndex = begin * cellSize / stride;
+    lastIndex = (end * cellSize + stride - 1) / stride;
   }
-  MemoryValue buffer = ColorMode::getMemoryValueAt(
-      memoryAccess, address, byteSize + (bitOffset > 0 ? 1 : 0), o);
-  return o.getPixelFromBuffer(buffer, address, x, y);
-};
+  return {std::min(o.height, firstIndex / o.width),
+          std::min(o.height, (lastIndex + o.width - 1) / o.width)};
+}
 
-const ColorMode::GetColorFunction ColorMode::RGBGetColor = [](
-    Optional<OutputComponent *> memoryAccess,
-    Options &o,
-    size_t index) -> std::uint32_t { return 0; };
+void ColorMode::convertRGB(const Frame &frame,
+                           Options &o,
+                           QImage &image,
+                           size_t firstRow,
+                           size_t lastRow) {
+  if (frame.pixels) {
+    convertRGB(frame.pixels->internal().data(),
+               frame.pixels->getSize(),
+               frame.pixelOffset,
+               o,
+               image,
+               firstRow,
+               lastRow);
+  } else {
+    convertRGB(nullptr, 0, frame.pixelOffset, o, image, firstRow, lastRow);
+  }
+}
 
+void ColorMode::convertRGB(const std::uint8_t *data,
+                           size_t bufferSize,
+                           size_t pixelOffset,
+                           Options &o,
+                           QImage &image,
+                           size_t firstRow,
+                           size_t lastRow) {
+  const size_t sizeInBit = o.rBit + o.gBit + o.bBit;
+  const size_t stride = rgbStrideInBit(o);
+  const size_t step = stride * indexStride(o);
+  const size_t bufferBegin = pixelOffset * cellSize;
+  for (size_t y = firstRow; y < lastRow; ++y) {
+    auto line = reinterpret_cast<std::uint32_t *>(image.scanLine(y));
+    size_t first = firstIndexOfRow(o, y) * stride;
+    size_t valid = 0;
+    if (sizeInBit <= 56 && first >= bufferBegin &&
+        first - bufferBegin + sizeInBit <= bufferSize) {
+      size_t begin = first - bufferBegin;
+      size_t remaining = bufferSize - sizeInBit - begin;
+      valid = step == 0 ? o.width : std::min(o.width, remaining / step + 1);
+      convertRGBLine(data, begin, step, valid, o, line);
+    }
+    if (valid < o.width) {
+      // these pixels are apparently not within the memory
+      std::fill(line + valid, line + o.width, errorColor);
+      o.setError(2);
+    }
+  }
+}
+
+void ColorMode::convertMonochrome(const Frame &frame,
+                                  Options &o,
+                                  QImage &image,
+                                  size_t firstRow,
+                                  size_t lastRow) {
+  if (frame.pixels) {
+    convertMonochrome(frame.pixels->internal().data(),
+                      frame.pixels->getSize(),
+                      frame.pixelOffset,
+                      o,
+                      image,
+                      firstRow,
+                      lastRow);
+  } else {
+    convertMonochrome(
+        nullptr, 0, frame.pixelOffset, o, image, firstRow, lastRow);
+  }
+}
+
+void ColorMode::convertMonochrome(const std::uint8_t *data,
+                                  size_t bufferSize,
+                                  size_t pixelOffset,
+                                  Options &o,
+                                  QImage &image,
+                                  size_t firstRow,
+                                  size_t lastRow) {
+  const size_t bitsPerByte = monochromeBitsPerByte(o);
+  const size_t bufferBegin = pixelOffset * cellSize;
+  for (size_t y = firstRow; y < lastRow; ++y) {
+    std::uint8_t *line = image.scanLine(y);
+    std::fill(line, line + (o.width + 7) / 8, 0);
+    size_t first = firstIndexOfRow(o, y);
+    size_t x = 0;
+    if (bitsPerByte == cellSize && !o.columns_rows && first >= bufferBegin &&
+        (first - bufferBegin) % 8 == 0) {
+      // the row is a plain byte aligned bitmap, QImage just wants the most
+      // significant bit first
+      size_t begin = first - bufferBegin;
+      size_t available = bufferSize > begin ? (bufferSize - begin) / 8 : 0;
+      size_t whole = std::min(o.width / 8, available);
+      const std::uint8_t *source = data + begin / 8;
+      for (size_t i = 0; i < whole; ++i) {
+        line[i] = reverseBits(source[i]);
+      }
+      x = whole * 8;
+    }
+    for (; x < o.width; ++x) {
+      size_t index = first + x * indexStride(o);
+      size_t bit = index / bitsPerByte * cellSize + index % bitsPerByte;
+      if (bit >= bufferBegin && bit - bufferBegin < bufferSize) {
+        bit -= bufferBegin;
+        if ((data[bit / 8] >> (bit % 8)) & 1) {
+          line[x / 8] |= 0x80 >> (x % 8);
+        }
+      } else {
+        o.setError(2);
+      }
+    }
+  }
+}
+
+void ColorMode::convertColors(const Frame &frame, Options &o, QImage &image) {
+  constexpr size_t colorCount = 2;
+  constexpr size_t colorSizeInBit = 32;
+  const size_t bufferSize = frame.colors ? frame.colors->getSize() : 0;
+  const std::uint8_t *data =
+      frame.colors ? frame.colors->internal().data() : nullptr;
+  for (size_t i = 0; i < colorCount; ++i) {
+    if (bufferSize >= (i + 1) * colorSizeInBit) {
+      const std::uint8_t *color = data + i * (colorSizeInBit / cellSize);
+      image.setColor(i,
+                     std::uint32_t(color[0]) | (std::uint32_t(color[1]) << 8) |
+                         (std::uint32_t(color[2]) << 16) |
+                         (std::uint32_t(color[3]) << 24));
+    } else {
+      o.setError(3);
+      image.setColor(i, errorColor);
+    }
+  }
+}
+
+
+// RGB*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*
 const ColorMode::GetPixelFromBufferFunction ColorMode::RGBGetPixelFromBuffer =
     [](const MemoryValue &buffer,
        size_t offset,
@@ -162,160 +376,71 @@ const ColorMode::GetColorFromBufferFunction ColorMode::RGBGetColorFromBuffer =
        size_t index) -> std::uint32_t { return 0; };
 
 const ColorMode::UpdateMemoryFunction ColorMode::RGBUpdateMemory = [](
-    Optional<OutputComponent *> memoryAccess,
+    Transaction &transaction,
     Options &o,
-    std::shared_ptr<QImage> image,
+    Frame &frame,
     size_t address,
     size_t amount) -> void {
-  size_t cellSize = 8;      // TODO
-  size_t pointerSize = 32;  // TODO
-  size_t memSize = (*memoryAccess)->getMemoryAccess().getMemorySize().get();
-  size_t pointerSizeInByte = (pointerSize + cellSize - 1) / cellSize;
-  size_t pixelBufferPointer = o.pixelBaseAddress;
-  bool hasAlreadyUpdatedAllPixels = false;
-  if (o.pixelBufferPointerLike) {
-    if (address < pixelBufferPointer + pointerSizeInByte &&
-        address + amount > pixelBufferPointer) {
-      // pixel pointer has changed
-      o.updateAllPixels(memoryAccess, image);
-      hasAlreadyUpdatedAllPixels = true;
-    } else {
-      pixelBufferPointer = ColorMode::loadPointer(memoryAccess,
-                                                  o.pixelBaseAddress,
-                                                  o.pixelBufferPointerLike,
-                                                  cellSize,
-                                                  pointerSize,
-                                                  o);
-    }
+  if (o.pixelBufferPointerLike && address < o.pixelBaseAddress + 4 &&
+      address + amount > o.pixelBaseAddress) {
+    // pixel pointer has changed
+    ColorMode::RGBUpdateAllPixels(transaction, o, frame);
+    return;
   }
-  if (!hasAlreadyUpdatedAllPixels) {
-    size_t sizeInBit = o.rBit + o.gBit + o.bBit;
-    size_t pixelBufferSize =
-        (o.tight ? ((sizeInBit * o.width * o.height + cellSize - 1) / cellSize)
-                 : (((sizeInBit + cellSize - 1) / cellSize + o.freeBytes) *
-                    o.height * o.width));
-    if (pixelBufferPointer + pixelBufferSize > memSize) {
-      o.setError(2);
-    }
-    if (address < pixelBufferPointer + pixelBufferSize &&
-        address + amount > pixelBufferPointer) {
-      // At least some pixel have changed
-      size_t sizeInByte =
-          (sizeInBit + cellSize - 1) / cellSize + (o.tight ? 0 : o.freeBytes);
-      size_t minIndex = 0;
-      if (address > pixelBufferPointer) {
-        minIndex = o.tight
-                       ? ((address - pixelBufferPointer) * cellSize / sizeInBit)
-                       : ((address - pixelBufferPointer) / sizeInByte);
-      }
-      size_t maxIndex = o.height * o.width;
-      if (address + amount < pixelBufferPointer + pixelBufferSize) {
-        maxIndex =
-            o.tight
-                ? (((address + amount - pixelBufferPointer) * cellSize +
-                    sizeInBit - 1) /
-                   sizeInBit)
-                : (((address + amount - pixelBufferPointer) + sizeInByte - 1) /
-                   sizeInByte);
-      }
-      size_t beginOffset =
-          o.tight ? (minIndex * sizeInBit / cellSize) : (minIndex * sizeInByte);
-      size_t endOffset =
-          o.tight ? (maxIndex * sizeInBit / cellSize) : (maxIndex * sizeInByte);
-      MemoryValue buffer =
-          ColorMode::getMemoryValueAt(memoryAccess,
-                                      pixelBufferPointer + beginOffset,
-                                      endOffset - beginOffset,
-                                      o);
-      for (size_t index = minIndex; index < maxIndex; index++) {
-        size_t x = o.columns_rows ? (index / o.height) : (index % o.width);
-        size_t y = o.columns_rows ? (index % o.height) : (index / o.width);
-        image->setPixel(x, y, o.getPixelFromBuffer(buffer, beginOffset, x, y));
-      }
-    }
+  ColorMode::locateFrame(transaction, o, frame, true, false);
+  size_t pixelBufferPointer = frame.pixelBufferPointer;
+  size_t pixelBufferSize = rgbBufferSize(o);
+  if (pixelBufferPointer + pixelBufferSize > frame.memorySize) {
+    o.setError(2);
+  }
+  if (address >= pixelBufferPointer + pixelBufferSize ||
+      address + amount <= pixelBufferPointer || o.width == 0) {
+    return;
+  }
+  // At least some pixel have changed, redraw the rows containing them
+  std::tie(frame.firstRow, frame.lastRow) = ColorMode::rowsOf(
+      o,
+      address > pixelBufferPointer ? address - pixelBufferPointer : 0,
+      std::min(address + amount, pixelBufferPointer + pixelBufferSize) -
+          pixelBufferPointer);
+  size_t beginOffset = 0;
+  size_t endOffset = pixelBufferSize;
+  if (!o.columns_rows) {
+    size_t stride = rgbStrideInBit(o);
+    beginOffset = frame.firstRow * o.width * stride / cellSize;
+    endOffset = std::min(pixelBufferSize,
+                         (frame.lastRow * o.width * stride + cellSize - 1) /
+                             cellSize);
   }
+  ColorMode::fetchFrame(
+      transaction, o, frame, beginOffset, endOffset - beginOffset, 0);
 };
 
 const ColorMode::UpdateAllPixelsFunction ColorMode::RGBUpdateAllPixels = [](
-    Optional<OutputComponent *> memoryAccess,
-    Options &o,
-    std::shared_ptr<QImage> image) -> void {
-  size_t cellSize = 8;      // TODO
-  size_t pointerSize = 32;  // TODO
-  size_t pixelBufferPointer = ColorMode::loadPointer(memoryAccess,
-                                                     o.pixelBaseAddress,
-                                                     o.pixelBufferPointerLike,
-                                                     cellSize,
-                                                     pointerSize,
-                                                     o);
-  size_t sizeOfColorInBit = o.rBit + o.gBit + o.bBit;
-  if (!o.tight) {
-    sizeOfColorInBit =
-        ((sizeOfColorInBit + cellSize - 1) / cellSize + o.freeBytes) * cellSize;
-  }
-  size_t sizeInMemory =
-      (sizeOfColorInBit * o.width * o.height + cellSize - 1) / cellSize;
-  MemoryValue buffer = ColorMode::getMemoryValueAt(
-      memoryAccess, pixelBufferPointer, sizeInMemory, o);
-  for (size_t y = 0; y < o.height; ++y) {
-    for (size_t x = 0; x < o.width; ++x) {
-      image->setPixel(x, y, o.getPixelFromBuffer(buffer, 0, x, y));
-    }
-  }
+    Transaction &transaction, Options &o, Frame &frame) -> void {
+  ColorMode::locateFrame(transaction, o, frame, true, false);
+  ColorMode::fetchFrame(transaction, o, frame, 0, rgbBufferSize(o), 0);
+  frame.firstRow = 0;
+  frame.lastRow = o.height;
 };
 
 const ColorMode::UpdateAllColorsFunction ColorMode::RGBUpdateAllColors = [](
-    Optional<OutputComponent *> memoryAccess,
-    Options &o,
-    std::shared_ptr<QImage> image) -> void {};
+    Transaction &transaction, Options &o, Frame &frame) -> void {};
 
 const ColorMode::CheckErrorsFunction ColorMode::RGBCheckErrors = [](
-    Optional<OutputComponent *> memoryAccess, Options &o) -> void {
+    size_t memorySize, Options &o) -> void {
   size_t pointerSize = 4;
-  if (memoryAccess) {
-    size_t memSize = (*memoryAccess)->getMemoryAccess().getMemorySize().get();
-    if (o.pixelBaseAddress + pointerSize >= memSize) {
-      o.setError(1);
-      return;
-    }
-  } else {
-    o.setError(0);
+  if (o.pixelBaseAddress + pointerSize >= memorySize) {
+    o.setError(1);
   }
 };
 
-// Monochrome*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*
-const ColorMode::GetPixelFunction ColorMode::MonochromeGetPixel = [](
-    Optional<OutputComponent *> memoryAccess,
-    Options &o,
-    size_t x,
-    size_t y) -> std::uint32_t {
-  size_t cellSize = 8;            // TODO
-  size_t bitsPerByte = cellSize;  // TODO
-  size_t index =
-      x * (o.columns_rows ? o.height : 1) + y * (o.columns_rows ? 1 : o.width);
-  size_t address = o.pixelBaseAddress + index / bitsPerByte;
-  MemoryValue buffer = ColorMode::getMemoryValueAt(memoryAccess, address, 1, o);
-  return o.getPixelFromBuffer(buffer, address, x, y);
-};
-const ColorMode::GetColorFunction ColorMode::MonochromeGetColor = [](
-    Optional<OutputComponent *> memoryAccess,
-    Options &o,
-    size_t index) -> std::uint32_t {
-  size_t cellSize = 8;      // TODO
-  size_t pointerSize = 32;  // TODO
-  constexpr size_t colorSizeInBit = 32;
-  size_t colorSize = (32 + cellSize - 1) / cellSize;
-  size_t colorTablePointer = ColorMode::loadPointer(memoryAccess,
-                                                    o.colorBaseAddress,
-                                                    o.colorTablePointerLike,
-                                                    cellSize,
-                                                    pointerSize,
-                                                    o);
-  MemoryValue buffer = ColorMode::getMemoryValueAt(
-      memoryAccess, colorTablePointer + (index * colorSize), colorSize, o);
-  return o.getColorFromBuffer(buffer, index * colorSize, index);
+const ColorMode::DrawFunction ColorMode::RGBDraw = [](
+    const Frame &frame, Options &o, QImage &image) -> void {
+  ColorMode::convertRGB(frame, o, image, frame.firstRow, frame.lastRow);
 };
 
+// Monochrome*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*
 const ColorMode::GetPixelFromBufferFunction
     ColorMode::MonochromeGetPixelFromBuffer = [](const MemoryValue &buffer,
                                                  size_t offset,
@@ -354,175 +479,118 @@ const ColorMode::GetColorFromBufferFunction
 };
 
 const ColorMode::UpdateMemoryFunction ColorMode::MonochromeUpdateMemory = [](
-    Optional<OutputComponent *> memoryAccess,
+    Transaction &transaction,
     Options &o,
-    std::shared_ptr<QImage> image,
+    Frame &frame,
     size_t address,
     size_t amount) -> void {
-  size_t cellSize = 8;      // TODO
-  size_t pointerSize = 32;  // TODO
-  size_t memSize = (*memoryAccess)->getMemoryAccess().getMemorySize().get();
-  size_t pointerSizeInByte = (pointerSize + cellSize - 1) / cellSize;
-  size_t pixelBufferPointer = o.pixelBaseAddress;
-  bool hasAlreadyUpdatedAllPixels = false;
-  if (o.pixelBufferPointerLike) {
-    if (address < pixelBufferPointer + pointerSizeInByte &&
-        address + amount > pixelBufferPointer) {
-      // pixel pointer has changed
-      o.updateAllPixels(memoryAccess, image);
-      hasAlreadyUpdatedAllPixels = true;
-    } else {
-      pixelBufferPointer = ColorMode::loadPointer(memoryAccess,
-                                                  o.pixelBaseAddress,
-                                                  o.pixelBufferPointerLike,
-                                                  cellSize,
-                                                  pointerSize,
-                                                  o);
-    }
+  bool pixelPointerChanged = o.pixelBufferPointerLike &&
+                             address < o.pixelBaseAddress + 4 &&
+                             address + amount > o.pixelBaseAddress;
+  bool colorPointerChanged = o.colorTablePointerLike &&
+                             address < o.colorBaseAddress + 4 &&
+                             address + amount > o.colorBaseAddress;
+  if (pixelPointerChanged) {
+    ColorMode::MonochromeUpdateAllPixels(transaction, o, frame);
   }
-  if (!hasAlreadyUpdatedAllPixels) {
-    size_t pixelBufferSize = (o.width * o.height + cellSize - 1) / cellSize;
-    if (pixelBufferPointer + pixelBufferSize > memSize) {
+  if (colorPointerChanged) {
+    ColorMode::MonochromeUpdateAllColors(transaction, o, frame);
+  }
+  if (pixelPointerChanged && colorPointerChanged) return;
+  ColorMode::locateFrame(
+      transaction, o, frame, !pixelPointerChanged, !colorPointerChanged);
+  size_t pixelBufferSize = monochromeBufferSize(o);
+  size_t colorBufferSize = 2 * 4;
+  size_t beginOffset = 0;
+  size_t endOffset = 0;
+  size_t colorLength = 0;
+  if (!pixelPointerChanged) {
+    size_t pixelBufferPointer = frame.pixelBufferPointer;
+    if (pixelBufferPointer + pixelBufferSize > frame.memorySize) {
       o.setError(2);
     }
     if (address < pixelBufferPointer + pixelBufferSize &&
-        address + amount > pixelBufferPointer) {
+        address + amount > pixelBufferPointer && o.width > 0) {
       // At least some pixel have changed
-      size_t bitsPerByte = cellSize - o.freeBits;
-      size_t minIndex = 0;
-      if (address > pixelBufferPointer) {
-        minIndex = (address - pixelBufferPointer) * bitsPerByte;
-      }
-      size_t maxIndex = o.height * o.width;
-      if (address + amount < pixelBufferPointer + pixelBufferSize) {
-        maxIndex = (address + amount - pixelBufferPointer) * bitsPerByte;
-      }
-      size_t beginOffset = minIndex / bitsPerByte;
-      size_t endOffset = (maxIndex + bitsPerByte - 1) / bitsPerByte;
-      MemoryValue buffer = ColorMode::getMemoryValueAt(
-          memoryAccess, pixelBufferPointer, pixelBufferSize, o);
-      // this could be optimized, we don't actually need the whole pixel buffer,
-      // but anyways... (I'm not sure I'm calculating the offset correctly TODO)
-      //  .getMemoryValueAt(pixelBufferPointer + beginOffset,
-      //                    endOffset - beginOffset)
-      for (size_t index = minIndex; index < maxIndex; index++) {
-        size_t x = o.columns_rows ? (index / o.height) : (index % o.width);
-        size_t y = o.columns_rows ? (index % o.height) : (index / o.width);
-        image->setPixel(x, y, o.getPixelFromBuffer(buffer, 0, x, y));
+      std::tie(frame.firstRow, frame.lastRow) = ColorMode::rowsOf(
+          o,
+          address > pixelBufferPointer ? address - pixelBufferPointer : 0,
+          std::min(address + amount, pixelBufferPointer + pixelBufferSize) -
+              pixelBufferPointer);
+      endOffset = pixelBufferSize;
+      if (!o.columns_rows) {
+        size_t bitsPerByte = monochromeBitsPerByte(o);
+        beginOffset = frame.firstRow * o.width / bitsPerByte;
+        endOffset = std::min(pixelBufferSize,
+                             (frame.lastRow * o.width + bitsPerByte - 1) /
+                                 bitsPerByte);
       }
     }
   }
-  // the colors
-  size_t colorBufferPointer = o.colorBaseAddress;
-  bool hasAlreadyUpdatedAllColors = false;
-  if (o.colorTablePointerLike) {
-    if (address < colorBufferPointer + pointerSizeInByte &&
-        address + amount > colorBufferPointer) {
-      // pixel pointer has changed
-      o.updateAllColors(memoryAccess, image);
-      hasAlreadyUpdatedAllColors = true;
-    } else {
-      colorBufferPointer = ColorMode::loadPointer(memoryAccess,
-                                                  o.colorBaseAddress,
-                                                  o.colorTablePointerLike,
-                                                  cellSize,
-                                                  pointerSize,
-                                                  o);
-    }
-  }
-  if (!hasAlreadyUpdatedAllColors) {
-    constexpr size_t colorCount = 2;
-    constexpr size_t colorSizeInBit = 32;
-    size_t colorSizeInByte = (colorSizeInBit + cellSize - 1) / cellSize;
-    size_t colorBufferSize = colorCount * colorSizeInByte;
-    if (colorBufferPointer + colorBufferSize > memSize) {
+  if (!colorPointerChanged) {
+    size_t colorBufferPointer = frame.colorTablePointer;
+    if (colorBufferPointer + colorBufferSize > frame.memorySize) {
       o.setError(3);
     }
     if (address < colorBufferPointer + colorBufferSize &&
         address + amount > colorBufferPointer) {
-      // At least some colors have changed
-      o.updateAllColors(memoryAccess, image);
-      // this could be optimized, but 2 colors are not many enough to really
-      // need that
+      // At least some colors have changed, 2 colors are not many enough to
+      // only update some of them
+      colorLength = colorBufferSize;
+      frame.redrawColors = true;
     }
   }
+  ColorMode::fetchFrame(transaction,
+                        o,
+                        frame,
+                        beginOffset,
+                        endOffset - beginOffset,
+                        colorLength);
 };
 
 const ColorMode::UpdateAllPixelsFunction ColorMode::MonochromeUpdateAllPixels =
-    [](Optional<OutputComponent *> memoryAccess,
-       Options &o,
-       std::shared_ptr<QImage> image) -> void {
-  size_t cellSize = 8;      // TODO
-  size_t pointerSize = 32;  // TODO
-  size_t pixelBufferPointer = ColorMode::loadPointer(memoryAccess,
-                                                     o.pixelBaseAddress,
-                                                     o.pixelBufferPointerLike,
-                                                     cellSize,
-                                                     pointerSize,
-                                                     o);
-  size_t bitsPerByte = cellSize - o.freeBits;
-  size_t sizeInMemory = (o.width * o.height + bitsPerByte - 1) / bitsPerByte;
-  MemoryValue buffer = ColorMode::getMemoryValueAt(
-      memoryAccess, pixelBufferPointer, sizeInMemory, o);
-  for (size_t y = 0; y < o.height; ++y) {
-    for (size_t x = 0; x < o.width; ++x) {
-      image->setPixel(x, y, o.getPixelFromBuffer(buffer, 0, x, y));
-    }
-  }
+    [](Transaction &transaction, Options &o, Frame &frame) -> void {
+  ColorMode::locateFrame(transaction, o, frame, true, false);
+  ColorMode::fetchFrame(transaction, o, frame, 0, monochromeBufferSize(o), 0);
+  frame.firstRow = 0;
+  frame.lastRow = o.height;
 };
 
 const ColorMode::UpdateAllColorsFunction ColorMode::MonochromeUpdateAllColors =
-    [](Optional<OutputComponent *> memoryAccess,
-       Options &o,
-       std::shared_ptr<QImage> image) -> void {
-  size_t colorCount = 2;
-  size_t cellSize = 8;      // TODO
-  size_t pointerSize = 32;  // TODO
-  constexpr size_t colorSizeInBit = 32;
-  size_t colorSize = (colorSizeInBit + cellSize - 1) / cellSize;
-  size_t colorTablePointer = ColorMode::loadPointer(memoryAccess,
-                                                    o.colorBaseAddress,
-                                                    o.colorTablePointerLike,
-                                                    cellSize,
-                                                    pointerSize,
-                                                    o);
-  MemoryValue buffer = ColorMode::getMemoryValueAt(
-      memoryAccess, colorTablePointer, colorSize * colorCount, o);
-  for (size_t i = 0; i < colorCount; ++i) {
-    image->setColor(i, o.getColorFromBuffer(buffer, 0, i));
-  }
+    [](Transaction &transaction, Options &o, Frame &frame) -> void {
+  ColorMode::locateFrame(transaction, o, frame, false, true);
+  ColorMode::fetchFrame(transaction, o, frame, 0, 0, 2 * 4);
+  frame.redrawColors = true;
 };
 
 const ColorMode::CheckErrorsFunction ColorMode::MonochromeCheckErrors = [](
-    Optional<OutputComponent *> memoryAccess, Options &o) -> void {
+    size_t memorySize, Options &o) -> void {
   size_t pointerSize = 4;
-  if (memoryAccess) {
-    size_t memSize = (*memoryAccess)->getMemoryAccess().getMemorySize().get();
-    if (o.pixelBaseAddress + pointerSize >= memSize ||
-        o.colorBaseAddress + pointerSize >= memSize) {
-      o.setError(1);
-      return;
-    }
-  } else {
-    o.setError(0);
+  if (o.pixelBaseAddress + pointerSize >= memorySize ||
+      o.colorBaseAddress + pointerSize >= memorySize) {
+    o.setError(1);
   }
 };
 
+const ColorMode::DrawFunction ColorMode::MonochromeDraw = [](
+    const Frame &frame, Options &o, QImage &image) -> void {
+  ColorMode::convertMonochrome(frame, o, image, frame.firstRow, frame.lastRow);
+  if (frame.redrawColors) ColorMode::convertColors(frame, o, image);
+};
+
 // ColorMode*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*-_-*
-ColorMode Options::RGB{ColorMode::RGBGetPixel,
-                       ColorMode::RGBGetColor,
-                       ColorMode::RGBGetPixelFromBuffer,
+ColorMode Options::RGB{ColorMode::RGBGetPixelFromBuffer,
                        ColorMode::RGBGetColorFromBuffer,
                        ColorMode::RGBUpdateMemory,
                        ColorMode::RGBUpdateAllPixels,
                        ColorMode::RGBUpdateAllColors,
-                       ColorMode::RGBCheckErrors};
-ColorMode Options::Monochrome{ColorMode::MonochromeGetPixel,
-                              ColorMode::MonochromeGetColor,
-                              ColorMode::MonochromeGetPixelFromBuffer,
+                       ColorMode::RGBCheckErrors,
+                       ColorMode::RGBDraw};
+ColorMode Options::Monochrome{ColorMode::MonochromeGetPixelFromBuffer,
                               ColorMode::MonochromeGetColorFromBuffer,
                               ColorMode::MonochromeUpdateMemory,
                               ColorMode::MonochromeUpdateAllPixels,
                               ColorMode::MonochromeUpdateAllColors,
-                              ColorMode::MonochromeCheckErrors};
+                              ColorMode::MonochromeCheckErrors,
+                              ColorMode::MonochromeDraw};
 }
@@ -23,7 +23,8 @@
 #include <sstream>
 
 #include "common/assert.hpp"
-#include "ui/pixel-display-color-mode.hpp"
+#include "core/framebuffer-channel.hpp"
+#include "core/transaction.hpp"
 
 namespace colormode {
 
@@ -45,15 +46,6 @@ ColorMode Options::getColorMode() const {
   return RGB;
 }
 
-std::uint32_t Options::getPixel(Optional<OutputComponent *> memoryAccess,
-                                std::size_t x,
-                                std::size_t y) {
-  return getColorMode().getPixel(memoryAccess, *this, x, y);
-}
-std::uint32_t
-Options::getColor(Optional<OutputComponent *> memoryAccess, std::size_t index) {
-  return getColorMode().getColor(memoryAccess, *this, index);
-}
 std::uint32_t Options::getPixelFromBuffer(const MemoryValue &buffer,
                                           std::size_t offset,
                                           std::size_t x,
@@ -65,33 +57,48 @@ std::uint32_t Options::getColorFromBuffer(const MemoryValue &buffer,
                                           std::size_t index) {
   return getColorMode().getColorFromBuffer(buffer, offset, *this, index);
 }
-void Options::updatePixel(Optional<OutputComponent *> memoryAccess,
-                          std::shared_ptr<QImage> image,
-                          std::size_t x,
-                          std::size_t y) {
-  image->setPixel(x, y, getPixel(memoryAccess, x, y));
-}
-void Options::updateColor(Optional<OutputComponent *> memoryAccess,
-                          std::shared_ptr<QImage> image,
-                          std::size_t index) {
-  image->setColor(index, getColor(memoryAccess, index));
-}
-void Options::updateMemory(Optional<OutputComponent *> memoryAccess,
-                           std::shared_ptr<QImage> image,
+void Options::updateMemory(Transaction &transaction,
+                           ColorMode::Frame &frame,
                            std::size_t address,
                            std::size_t amount) {
-  checkErrors(memoryAccess);
-  getColorMode().updateMemory(memoryAccess, *this, image, address, amount);
+  checkErrors(transaction.getMemorySize());
+  getColorMode().updateMemory(transaction, *this, frame, address, amount);
+}
+void Options::updateAllPixels(Transaction &transaction,
+                              ColorMode::Frame &frame) {
+  checkErrors(transaction.getMemorySize());
+  getColorMode().updateAllPixels(transaction, *this, frame);
 }
-void Options::updateAllPixels(Optional<OutputComponent *> memoryAccess,
-                              std::shared_ptr<QImage> image) {
-  checkErrors(memoryAccess);
-  getColorMode().updateAllPixels(memoryAccess, *this, image);
+void Options::updateAllColors(Transaction &transaction,
+                              ColorMode::Frame &frame) {
+  checkErrors(transaction.getMemorySize());
+  getColorMode().updateAllColors(transaction, *this, frame);
 }
-void Options::updateAllColors(Optional<OutputComponent *> memoryAccess,
-                              std::shared_ptr<QImage> image) {
-  checkErrors(memoryAccess);
-  getColorMode().updateAllColors(memoryAccess, *this, image);
+void Options::draw(const ColorMode::Frame &frame, QImage &image) {
+  getColorMode().draw(frame, *this, image);
+}
+void Options::updateFromFramebuffer(const FramebufferChannel &channel,
+                                    std::shared_ptr<QImage> image) {
+  auto rows =
+      ColorMode::rowsOf(*this, channel.getDirtyBegin(), channel.getDirtyEnd());
+  const auto &frame = channel.getFrame();
+  if (colorMode == 1) {
+    ColorMode::convertMonochrome(frame.data(),
+                                 frame.size() * 8,
+                                 0,
+                                 *this,
+                                 *image,
+                                 rows.first,
+                                 rows.second);
+  } else {
+    ColorMode::convertRGB(frame.data(),
+                          frame.size() * 8,
+                          0,
+                          *this,
+                          *image,
+                          rows.first,
+                          rows.second);
+  }
 }
 
 std::shared_ptr<QImage> Options::makeImage() const {
@@ -110,6 +117,12 @@ void Options::setError(size_t index) {
   errorVector[index] = true;
 }
 
+void Options::mergeErrors(const Options &other) {
+  for (size_t i = 0; i < maxError; ++i) {
+    if (other.errorVector[i]) errorVector[i] = true;
+  }
+}
+
 void Options::handleErrors(const pixelDisplayErrorFunction &errFun) {
   bool resolved = true;
   std::stringstream stream{};
@@ -124,8 +137,8 @@ void Options::handleErrors(const pixelDisplayErrorFunction &errFun) {
   errFun(resolved, stream.str());
 }
 
-void Options::checkErrors(Optional<OutputComponent *> memoryAccess){
-  getColorMode().checkErrors(memoryAccess, *this);
+void Options::checkErrors(size_t memorySize) {
+  getColorMode().checkErrors(memorySize, *this);
 }
 
 }
@@ -22,9 +22,15 @@
 #include <algorithm>
 #include <ctime>
 #include <iostream>
+#include <utility>
 
 #include "common/assert.hpp"
+#include "core/framebuffer-channel.hpp"
+#include "core/result.hpp"
+#include "core/transaction.hpp"
+#include "ui/gui-executor.hpp"
 #include "ui/output-component.hpp"
+#include "ui/pixel-display-color-mode.hpp"
 
 PixelDisplayPaintedItem::PixelDisplayPaintedItem(QQuickItem *parent)
 : QQuickPaintedItem(parent)
@@ -44,31 +50,46 @@ PixelDisplayPaintedItem::PixelDisplayPaintedItem(QQuickItem *parent)
 }
 
 void PixelDisplayPaintedItem::paint(QPainter *painter) {
+  if (_framebuffer && _framebuffer->consume()) {
+    _options.updateFromFramebuffer(*_framebuffer, _image);
+  }
   painter->drawImage(painter->window(), *_image);
 }
 
 void PixelDisplayPaintedItem::memoryChanged(std::size_t address,
                                             std::size_t amount) {
-  if (amount == 0 && _outputComponentPointer) {
-    amount =
-        (*_outputComponentPointer)->getMemoryAccess().getMemorySize().get();
+  if (_framebuffer && amount != 0) {
+    // the pixels arrive through the channel, only the colors are left
+    if (_options.colorMode == 1 && address < _options.colorBaseAddress + 8 &&
+        address + amount > _options.colorBaseAddress) {
+      redraw(false, true);
+    }
+    doUpdate();
+    return;
+  }
+  if (amount == 0) {
+    // the whole memory changed, so just redraw everything
+    redraw(true, true);
+  } else {
+    requestFrame([address, amount](colormode::Options &options,
+                                   Transaction &transaction,
+                                   colormode::ColorMode::Frame &frame) {
+      options.updateMemory(transaction, frame, address, amount);
+    });
   }
-  _options.updateMemory(_outputComponentPointer, _image, address, amount);
-  doUpdate();
 }
 
 void PixelDisplayPaintedItem::setPixelBaseAddress(size_t pixelBaseAddress) {
   if (_options.pixelBaseAddress != pixelBaseAddress) {
     _options.pixelBaseAddress = pixelBaseAddress;
-    _options.updateAllPixels(_outputComponentPointer, _image);
-    doUpdate();
+    remapFramebuffer();
+    redraw(true, false);
   }
 }
 void PixelDisplayPaintedItem::setColorBaseAddress(size_t colorBaseAddress) {
   if (_options.colorBaseAddress != colorBaseAddress) {
     _options.colorBaseAddress = colorBaseAddress;
-    _options.updateAllColors(_outputComponentPointer, _image);
-    doUpdate();
+    redraw(false, true);
   }
 }
 void PixelDisplayPaintedItem::setWidth(size_t width) {
@@ -86,37 +107,36 @@ void PixelDisplayPaintedItem::setColorMode(const QString &colorMode) {
   if (_options.colorMode != colorModeIndex) {
     _options.colorMode = colorModeIndex;
     _image = _options.makeImage();
-    _options.updateAllPixels(_outputComponentPointer, _image);
-    _options.updateAllColors(_outputComponentPointer, _image);
-    doUpdate();
+    remapFramebuffer();
+    redraw(true, true);
   }
 }
 void PixelDisplayPaintedItem::setRBit(size_t rBit) {
   if (_options.rBit != rBit) {
     _options.rBit = rBit;
-    _options.updateAllPixels(_outputComponentPointer, _image);
-    doUpdate();
+    remapFramebuffer();
+    redraw(true, false);
   }
 }
 void PixelDisplayPaintedItem::setGBit(size_t gBit) {
   if (_options.gBit != gBit) {
     _options.gBit = gBit;
-    _options.updateAllPixels(_outputComponentPointer, _image);
-    doUpdate();
+    remapFramebuffer();
+    redraw(true, false);
   }
 }
 void PixelDisplayPaintedItem::setBBit(size_t bBit) {
   if (_options.bBit != bBit) {
     _options.bBit = bBit;
-    _options.updateAllPixels(_outputComponentPointer, _image);
-    doUpdate();
+    remapFramebuffer();
+    redraw(true, false);
   }
 }
 void PixelDisplayPaintedItem::setColumns_rows(bool columns_rows) {
   if (_options.columns_rows != columns_rows) {
     _options.columns_rows = columns_rows;
-    _options.updateAllPixels(_outputComponentPointer, _image);
-    doUpdate();
+    remapFramebuffer();
+    redraw(true, false);
   }
 }
 void PixelDisplayPaintedItem::setHorizontallyMirrored(
@@ -129,38 +149,38 @@ void PixelDisplayPaintedItem::setVerticallyMirrored(bool verticallyMirrored) {
 void PixelDisplayPaintedItem::setTight(bool tight) {
   if (_options.tight != tight) {
     _options.tight = tight;
-    _options.updateAllPixels(_outputComponentPointer, _image);
-    doUpdate();
+    remapFramebuffer();
+    redraw(true, false);
   }
 }
 void PixelDisplayPaintedItem::setPixelBufferPointerLike(
     bool pixelBufferPointerLike) {
   if (_options.pixelBufferPointerLike != pixelBufferPointerLike) {
     _options.pixelBufferPointerLike = pixelBufferPointerLike;
-    _options.updateAllPixels(_outputComponentPointer, _image);
-    doUpdate();
+    remapFramebuffer();
+    redraw(true, false);
   }
 }
 void PixelDisplayPaintedItem::setColorTablePointerLike(
     bool colorTablePointerLike) {
   if (_options.colorTablePointerLike != colorTablePointerLike) {
     _options.colorTablePointerLike = colorTablePointerLike;
-    _options.updateAllColors(_outputComponentPointer, _image);
-    doUpdate();
+    remapFramebuffer();
+    redraw(false, true);
   }
 }
 void PixelDisplayPaintedItem::setFreeBytes(size_t freeBytes) {
   if (_options.freeBytes != freeBytes) {
     _options.freeBytes = freeBytes;
-    _options.updateAllPixels(_outputComponentPointer, _image);
-    doUpdate();
+    remapFramebuffer();
+    redraw(true, false);
   }
 }
 void PixelDisplayPaintedItem::setFreeBits(size_t freeBits) {
   if (_options.freeBits != freeBits) {
     _options.freeBits = freeBits;
-    _options.updateAllPixels(_outputComponentPointer, _image);
-    doUpdate();
+    remapFramebuffer();
+    redraw(true, false);
   }
 }
 
@@ -218,14 +238,103 @@ void PixelDisplayPaintedItem::resize(size_t width, size_t height) {
     _options.width = width;
     _options.height = height;
     _image = _options.makeImage();
-    _options.updateAllPixels(_outputComponentPointer, _image);
-    _options.updateAllColors(_outputComponentPointer, _image);
-    doUpdate();
+    remapFramebuffer();
+    redraw(true, true);
   }
 }
 
 void PixelDisplayPaintedItem::setOutputComponent(OutputComponent *o) {
+  if (_framebuffer && _outputComponentPointer) {
+    (*_outputComponentPointer)->getMemoryAccess().unmapFramebuffer(
+        _framebuffer);
+  }
+  _framebuffer.reset();
   _outputComponentPointer = o;
+  remapFramebuffer();
+}
+
+void PixelDisplayPaintedItem::redraw(bool pixels, bool colors) {
+  requestFrame([pixels, colors](colormode::Options &options,
+                                Transaction &transaction,
+                                colormode::ColorMode::Frame &frame) {
+    if (pixels) options.updateAllPixels(transaction, frame);
+    if (colors) options.updateAllColors(transaction, frame);
+  });
+}
+
+void PixelDisplayPaintedItem::requestFrame(const FetchFunction &fetch) {
+  if (!_outputComponentPointer) {
+    _options.setError(0);
+    doUpdate();
+    return;
+  }
+  // the frame is fetched with a copy of the options, so that it is drawn the
+  // way it was fetched even if the options change in the meantime
+  colormode::Options options = _options;
+  std::fill(options.errorVector.begin(), options.errorVector.end(), false);
+  auto image = _image;
+  using Fetched = std::pair<colormode::ColorMode::Frame, colormode::Options>;
+  (*_outputComponentPointer)
+      ->getMemoryAccess()
+      .transactionAsync(
+          GuiExecutor::forObject(this),
+          [this, image](Result<Fetched> result) {
+            // an image which was replaced in the meantime is redrawn anyway
+            if (result.hasException() || image != _image) return;
+            auto fetched = result.get();
+            fetched.second.draw(fetched.first, *image);
+            _options.mergeErrors(fetched.second);
+            doUpdate();
+          },
+          [fetch, options](Transaction &transaction) mutable -> Fetched {
+            colormode::ColorMode::Frame frame;
+            fetch(options, transaction, frame);
+            return {std::move(frame), std::move(options)};
+          });
+}
+
+void PixelDisplayPaintedItem::remapFramebuffer() {
+  size_t address = _options.pixelBaseAddress;
+  size_t size = colormode::ColorMode::getPixelBufferSize(_options);
+  // a pointer to the pixel buffer or the color table may change at any time,
+  // then the display has to go through the project
+  bool fixed = !_options.pixelBufferPointerLike &&
+               !(_options.colorMode == 1 && _options.colorTablePointerLike);
+  if (_framebuffer && fixed && _framebuffer->getAddress() == address &&
+      _framebuffer->getSize() == size) {
+    return;
+  }
+  // an answer to an earlier request is outdated now
+  ++_framebufferRequest;
+  if (!_outputComponentPointer) return;
+  auto &memoryAccess = (*_outputComponentPointer)->getMemoryAccess();
+  if (_framebuffer) {
+    memoryAccess.unmapFramebuffer(_framebuffer);
+    _framebuffer.reset();
+  }
+  if (fixed && size > 0) {
+    // until the channel arrives, the display goes through the project
+    auto request = _framebufferRequest;
+    memoryAccess.mapFramebufferAsync(
+        GuiExecutor::forObject(this),
+        [this, request](Result<std::shared_ptr<FramebufferChannel>> result) {
+          // without a channel, the display keeps going through the project
+          if (result.hasException()) return;
+          auto channel = result.get();
+          if (!channel) return;
+          if (request != _framebufferRequest || !_outputComponentPointer) {
+            if (_outputComponentPointer) {
+              (*_outputComponentPointer)->getMemoryAccess().unmapFramebuffer(
+                  channel);
+            }
+            return;
+          }
+          _framebuffer = std::move(channel);
+          doUpdate();
+        },
+        address,
+        size);
+  }
 }
 
 size_t PixelDisplayPaintedItem::stringToColorMode(const QString &colorMode) {
@@ -18,8 +18,11 @@
 #include "ui/register-model.hpp"
 
 #include <QByteArray>
+#include <QMetaObject>
 #include <QString>
+#include <algorithm>
 #include <map>
+#include <utility>
 
 #include "arch/common/unit-container.hpp"
 #include "common/string-conversions.hpp"
@@ -36,7 +39,8 @@ RegisterModel::RegisterModel(ArchitectureAccess &architectureAccess,
                              QObject *parent)
 : QAbstractItemModel(parent)
 , _rootItem(new RegisterInformation())
-, _memoryAccess(memoryAccess) {
+, _memoryAccess(memoryAccess)
+, _registerSnapshots(memoryAccess.getRegisterSnapshots().get()) {
   projectContext->setContextProperty("registerModel", this);
 
   // Fetch register units from core.
@@ -54,30 +58,60 @@ RegisterModel::RegisterModel(ArchitectureAccess &architectureAccess,
       }
       // Add every register to map of all registers, organised by their
       // identifier.
+      auto item = new RegisterInformation(registerItem);
       _items.insert(std::pair<id_t, std::unique_ptr<RegisterInformation>>(
-          registerItem.getID(),
-          std::unique_ptr<RegisterInformation>(
-              new RegisterInformation(registerItem))));
+          registerItem.getID(), std::unique_ptr<RegisterInformation>(item)));
+      _itemsByName.emplace(item->getName(), item);
     }
   }
 }
 
 
 void RegisterModel::updateContent(const QString &registerTitle) {
-  // Notify the model about the change
-  // Notifying requires the model index of the altered item.
-  // The only reasonable way of accomplishing this is by filtering the registers
-  // by their title.
-  QModelIndexList alteredItems =
-      match(this->index(0, 0),
-            TitleRole,
-            registerTitle,
-            1,
-            Qt::MatchFlags(Qt::MatchExactly | Qt::MatchRecursive));
-  if (!alteredItems.isEmpty()) {
-    QModelIndex alteredItem = alteredItems.first();
-    // The data method will be called, fetching the updated content.
-    emit dataChanged(alteredItem, alteredItem);
+  auto iterator = _itemsByName.find(registerTitle.toStdString());
+  if (iterator == _itemsByName.end()) return;
+
+  // The core reports all registers of a step one after another. Collect them
+  // and notify the view once, after the ones already queued were handled.
+  if (_changedItems.empty()) {
+    QMetaObject::invokeMethod(this, "_emitChanges", Qt::QueuedConnection);
+  }
+  _changedItems.insert(iterator->second->getID());
+}
+
+
+void RegisterModel::_emitChanges() {
+  struct Range {
+    int first, last;
+    RegisterInformation *firstItem, *lastItem;
+  };
+  std::map<RegisterInformation *, Range> ranges;
+
+  for (auto identifier : _changedItems) {
+    auto item = _items.at(identifier).get();
+    auto row = _getRowRelativeToParent(*item);
+    if (!row) continue;
+
+    auto parent = item->hasEnclosing() ? _items.at(item->getEnclosing()).get()
+                                       : _rootItem.get();
+    auto inserted = ranges.emplace(parent, Range{*row, *row, item, item});
+    auto &range = inserted.first->second;
+    if (*row < range.first) {
+      range.first = *row;
+      range.firstItem = item;
+    }
+    if (*row > range.last) {
+      range.last = *row;
+      range.lastItem = item;
+    }
+  }
+  _changedItems.clear();
+
+  // The data method will be called, reading the newest snapshot.
+  for (const auto &pair : ranges) {
+    const auto &range = pair.second;
+    emit dataChanged(createIndex(range.first, 0, range.firstItem),
+                     createIndex(range.last, 0, range.lastItem));
   }
 }
 
@@ -104,6 +138,8 @@ QVariant RegisterModel::data(const QModelIndex &index, int role) const {
   // Return the row's correponding RegisterItem's information.
   RegisterInformation *registerItem =
       static_cast<RegisterInformation *>(index.internalPointer());
+  // Keeps the snapshot alive, even if the core publishes a newer one.
+  auto snapshot = _registerSnapshots->load();
 
   switch (role) {
     case TitleRole: return QString::fromStdString(registerItem->getName());
@@ -116,16 +152,13 @@ QVariant RegisterModel::data(const QModelIndex &index, int role) const {
         case RegisterInformation::Type::LINK: return "Link";
         case RegisterInformation::Type::PROGRAM_COUNTER:
           return "ProgramCounter";
+        case RegisterInformation::Type::HART_ID: return "HartId";
       }
     case IsConstantRole: return registerItem->isConstant();
-    case FlagDataRole:
-      return _memoryAccess.getRegisterValue(registerItem->getName())
-          .get()
-          .get(0);
+    case FlagDataRole: return snapshot->get(registerItem->getName()).get(0);
     default:
       auto roleString = roleNames()[role];
-      auto registerValue =
-          _memoryAccess.getRegisterValue(registerItem->getName()).get();
+      auto registerValue = snapshot->get(registerItem->getName());
       assert::that(
           GuiProject::getMemoryToStringConversions().contains(roleString));
       auto converter = GuiProject::getMemoryToStringConversions()[roleString];
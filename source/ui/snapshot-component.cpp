@@ -25,6 +25,7 @@
 
 #include "arch/common/architecture-formula.hpp"
 #include "common/utility.hpp"
+#include "core/binary-snapshot.hpp"
 #include "core/snapshot.hpp"
 
 QString
@@ -91,7 +92,17 @@ SnapshotComponent::snapshotPath(const QString& architectureIdentifier,
 void SnapshotComponent::importSnapshot(const QUrl& qPath) {
   auto path = qPath.path().toStdString();
   try {
-    auto json = Json::parse(Utility::loadFromFile(path));
+    auto data = Utility::loadFromFile(path);
+    QFileInfo fileInfo(qPath.path());
+    if (BinarySnapshot::isBinarySnapshot(data)) {
+      // throws if the snapshot is not valid
+      BinarySnapshot snapshot(data);
+      auto architectureString =
+          architectureToString(snapshot.getArchitectureFormula());
+      addSnapshot(architectureString, fileInfo.completeBaseName(), data);
+      return;
+    }
+    auto json = Json::parse(data);
     Snapshot snapshot(json);
     if (!snapshot.isValid()) {
       emit snapshotError("Import failed: Snapshot not valid.");
@@ -99,7 +110,6 @@ void SnapshotComponent::importSnapshot(const QUrl& qPath) {
     }
     auto architectureFormula = snapshot.getArchitectureFormula();
     auto architectureString = architectureToString(architectureFormula);
-    QFileInfo fileInfo(qPath.path());
     addSnapshot(architectureString, fileInfo.completeBaseName(), json.dump(4));
   } catch (const std::exception& exception) {
     emit snapshotError("Import failed: " +
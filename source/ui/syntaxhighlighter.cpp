@@ -22,13 +22,15 @@
 #include <QQuickTextDocument>
 #include <QString>
 #include <QTextCharFormat>
+#include <string>
 
 #include "core/parser-interface.hpp"
 #include "ui/theme.hpp"
 
 SyntaxHighlighter::SyntaxHighlighter(ParserInterface &parserInterface,
                                      QTextDocument *document)
-: QSyntaxHighlighter(document) {
+: QSyntaxHighlighter(document)
+, _lexer(parserInterface.getSyntaxLexer().get()) {
   _addImmediateRegexToSyntaxHighlighter(parserInterface);
   _addLabelRegexToSyntaxHighlighter(parserInterface);
   _addInstructionKeywordsRegexToSyntaxHighlighter(parserInterface);
@@ -37,6 +39,16 @@ SyntaxHighlighter::SyntaxHighlighter(ParserInterface &parserInterface,
 }
 
 void SyntaxHighlighter::highlightBlock(const QString &text) {
+  if (_lexer) {
+    // Latin-1 has exactly one byte per QChar, so the positions still match.
+    auto latin1 = text.toLatin1();
+    auto line = std::string(latin1.constData(), latin1.size());
+    for (const auto &span : _lexer(line)) {
+      setFormat(span.begin, span.length, _formats[span.token]);
+    }
+    return;
+  }
+
   for (std::size_t i = 0; i < _keywords.size(); i++) {
     const KeywordRule &rule = _keywords.at(i);
     QRegularExpressionMatchIterator it = rule.rulePattern.globalMatch(text);
@@ -53,6 +65,10 @@ void SyntaxHighlighter::_addKeywords(
     QTextCharFormat format,
     QRegularExpression::PatternOption patternOption,
     ParserInterface &parserInterface) {
+  _formats[token] = format;
+  // the lexer makes the regexes obsolete
+  if (_lexer) return;
+
   for (const auto &regexString : parserInterface.getSyntaxRegex(token).get()) {
     QRegularExpression regex(QString::fromStdString(regexString),
                              patternOption);
@@ -22,13 +22,16 @@
 #include <QByteArray>
 #include <QUrl>
 #include <string>
+#include <vector>
 
 #include "arch/common/architecture-formula.hpp"
 #include "common/assert.hpp"
 #include "common/translateable.hpp"
 #include "common/utility.hpp"
+#include "core/project-factory.hpp"
 #include "parser/common/final-representation.hpp"
 #include "ui/console-component.hpp"
+#include "ui/gui-executor.hpp"
 #include "ui/output-component.hpp"
 #include "ui/pixel-display-painted-item.hpp"
 #include "ui/settings.hpp"
@@ -43,6 +46,14 @@ Ui::id_t Ui::_rollingProjectId = 0;
 Ui::Ui(int& argc, char** argv)
 : _architectureMap(), _qmlApplication(argc, argv), _engine(), _projects() {
   _loadArchitectures();
+  _prewarmArchitectures();
+}
+
+Ui::~Ui() {
+  _stopPrewarming = true;
+  if (_prewarming.valid()) {
+    _prewarming.wait();
+  }
 }
 
 int Ui::runUi() {
@@ -130,6 +141,18 @@ void Ui::runBreakpoint(id_t id) {
   iterator->second->runBreakpoint();
 }
 
+void Ui::stepBack(id_t id) {
+  auto iterator = _projects.find(id);
+  assert::that(iterator != _projects.end());
+  iterator->second->stepBack();
+}
+
+void Ui::stepBackToBreakpoint(id_t id) {
+  auto iterator = _projects.find(id);
+  assert::that(iterator != _projects.end());
+  iterator->second->stepBackToBreakpoint();
+}
+
 void Ui::stop(id_t id) {
   auto iterator = _projects.find(id);
   assert::that(iterator != _projects.end());
@@ -261,6 +284,37 @@ void Ui::_loadArchitectures() {
   }
 }
 
+void Ui::_prewarmArchitectures() {
+  std::vector<ArchitectureFormula> formulas;
+  for (auto architecture = _architectureMap.begin();
+       architecture != _architectureMap.end();
+       ++architecture) {
+    auto formulaMap = std::get<0>(architecture.value());
+    for (const auto& extensions : formulaMap) {
+      ArchitectureFormula formula(architecture.key().toStdString());
+      for (const auto& extension : extensions) {
+        formula.addExtension(extension.toStdString());
+      }
+      formulas.push_back(formula);
+    }
+  }
+
+  // a formula that fails to brew only fails again once a project uses it,
+  // the others are brewed anyway
+  _prewarming = std::async(std::launch::async, [this, formulas] {
+    for (const auto& formula : formulas) {
+      if (_stopPrewarming) return;
+      try {
+        ProjectFactory::prewarm(formula);
+      } catch (const std::exception& exception) {
+        qWarning("Could not brew architecture %s: %s",
+                 formula.getArchitectureName().c_str(),
+                 exception.what());
+      }
+    }
+  });
+}
+
 QStringList
 Ui::_getOptionFormula(QString architectureName, QString optionName) const {
   auto formulaMap =
@@ -275,6 +329,9 @@ void Ui::_registerCustomTypes() {
   qRegisterMetaType<Status>();
   qRegisterMetaType<id_t>("id_t");
   qRegisterMetaType<OutputComponent*>("OutputComponentPointer");
+  qRegisterMetaType<GuiExecutor::Function>("GuiExecutor::Function");
+  // Create the executor in the gui thread, where its functions have to run.
+  GuiExecutor::instance();
   qmlRegisterType<PixelDisplayPaintedItem>(
       "eragpsim.pixeldisplaypainteditem", 1, 0, "PixelDisplayPaintedItem");
 }
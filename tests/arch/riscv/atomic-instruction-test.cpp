@@ -0,0 +1,213 @@
+/* C++ Assembler Interpreter
+ * Copyright (C) 2016 Chair of Computer Architecture
+ * at Technical University of Munich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "arch/common/abstract-syntax-tree-node.hpp"
+#include "arch/riscv/atomic-instructions.hpp"
+#include "arch/riscv/utility.hpp"
+
+#include "tests/arch/riscv/base-fixture.hpp"
+
+using namespace riscv;
+
+struct AtomicInstructionTest : public riscv::BaseFixture {
+  using Node = std::shared_ptr<AbstractSyntaxTreeNode>;
+
+  AtomicInstructionTest() : BaseFixture({"rv32i", "rv32a"}) {
+  }
+
+  Node createNode(const std::string& mnemonic,
+                  const std::vector<std::string>& registers) {
+    auto node = factories.createInstructionNode(mnemonic);
+    for (const auto& name : registers) {
+      node->addChild(factories.createRegisterNode(name));
+    }
+    return node;
+  }
+
+  template <typename T>
+  T getRegister(const std::string& name, std::size_t hart = 0) {
+    auto memoryAccess = getMemoryAccess().forHart(hart);
+    return riscv::convert<T>(memoryAccess.getRegisterValue(name).get());
+  }
+
+  template <typename T>
+  T getMemory(std::size_t address) {
+    auto value = getMemoryAccess().getMemoryValueAt(address, sizeof(T)).get();
+    return riscv::convert<T>(value);
+  }
+};
+
+TEST_F(AtomicInstructionTest, Validation) {
+  auto& memoryAccess = getMemoryAccess();
+  memoryAccess.putRegisterValue("x2", riscv::convert<uint32_t>(16));
+
+  EXPECT_FALSE(createNode("amoadd.w", {"x1", "x3"})->validate(memoryAccess));
+  EXPECT_FALSE(createNode("lr.w", {"x1", "x3", "x2"})->validate(memoryAccess));
+
+  auto immediate = createNode("amoadd.w", {"x1", "x3"});
+  immediate->addChild(factories.createImmediateNode(convert<uint32_t>(16)));
+  EXPECT_FALSE(immediate->validate(memoryAccess));
+
+  auto valid = createNode("amoadd.w", {"x1", "x3", "x2"});
+  ASSERT_TRUE(valid->validate(memoryAccess));
+  EXPECT_TRUE(valid->validateRuntime(memoryAccess));
+
+  // The address must be aligned to the accessed size
+  memoryAccess.putRegisterValue("x2", riscv::convert<uint32_t>(18));
+  EXPECT_FALSE(valid->validateRuntime(memoryAccess));
+
+  // The address must be inside the memory
+  memoryAccess.putRegisterValue("x2", riscv::convert<uint32_t>(64));
+  EXPECT_FALSE(valid->validateRuntime(memoryAccess));
+}
+
+TEST_F(AtomicInstructionTest, MemoryOperations32) {
+  auto& memoryAccess = getMemoryAccess();
+  memoryAccess.putRegisterValue("x2", riscv::convert<uint32_t>(8));
+
+  struct Case {
+    std::string mnemonic;
+    uint32_t memory, source, expected;
+  };
+
+  // clang-format off
+  const std::vector<Case> cases = {
+    {"amoswap.w", 0xDEADBEEF, 42, 42},
+    {"amoadd.w", 0xFFFFFFFF, 2, 1},
+    {"amoxor.w", 0xF0F0, 0xFF00, 0x0FF0},
+    {"amoand.w", 0xF0F0, 0xFF00, 0xF000},
+    {"amoor.w", 0xF0F0, 0xFF00, 0xFFF0},
+    {"amomin.w", 0xFFFFFFFF, 1, 0xFFFFFFFF},
+    {"amomax.w", 0xFFFFFFFF, 1, 1},
+    {"amominu.w", 0xFFFFFFFF, 1, 1},
+    {"amomaxu.w", 0xFFFFFFFF, 1, 0xFFFFFFFF}
+  };
+  // clang-format on
+
+  for (const auto& test : cases) {
+    memoryAccess.putMemoryValueAt(8, riscv::convert<uint32_t>(test.memory));
+    memoryAccess.putRegisterValue("x3", riscv::convert<uint32_t>(test.source));
+    auto node = createNode(test.mnemonic, {"x1", "x3", "x2"});
+    ASSERT_TRUE(node->validate(memoryAccess));
+    node->getValue(memoryAccess);
+
+    EXPECT_EQ(test.expected, getMemory<uint32_t>(8)) << test.mnemonic;
+    EXPECT_EQ(test.memory, getRegister<uint32_t>("x1")) << test.mnemonic;
+  }
+}
+
+TEST_F(AtomicInstructionTest, MemoryOperations64) {
+  loadArchitecture({"rv32i", "rv32a", "rv64i", "rv64a"});
+  auto& memoryAccess = getMemoryAccess();
+  memoryAccess.putRegisterValue("x2", riscv::convert<uint64_t>(8));
+  memoryAccess.putRegisterValue("x3", riscv::convert<uint64_t>(1));
+
+  memoryAccess.putMemoryValueAt(8, riscv::convert<uint64_t>(0xFFFFFFFF));
+  createNode("amoadd.d", {"x1", "x3", "x2"})->getValue(memoryAccess);
+  EXPECT_EQ(0x100000000, getMemory<uint64_t>(8));
+  EXPECT_EQ(0xFFFFFFFF, getRegister<uint64_t>("x1"));
+
+  // The word variants sign-extend the loaded value
+  memoryAccess.putMemoryValueAt(8, riscv::convert<uint64_t>(0xFFFFFFFF));
+  createNode("amoadd.w", {"x1", "x3", "x2"})->getValue(memoryAccess);
+  EXPECT_EQ(0, getMemory<uint64_t>(8));
+  EXPECT_EQ(0xFFFFFFFFFFFFFFFF, getRegister<uint64_t>("x1"));
+
+  memoryAccess.putMemoryValueAt(8, riscv::convert<uint64_t>(0));
+  createNode("amomaxu.d", {"x1", "x3", "x2"})->getValue(memoryAccess);
+  EXPECT_EQ(1, getMemory<uint64_t>(8));
+}
+
+TEST_F(AtomicInstructionTest, LoadReservedStoreConditional) {
+  auto& memoryAccess = getMemoryAccess();
+  memoryAccess.putRegisterValue("x2", riscv::convert<uint32_t>(8));
+  memoryAccess.putRegisterValue("x3", riscv::convert<uint32_t>(42));
+  memoryAccess.putMemoryValueAt(8, riscv::convert<uint32_t>(7));
+
+  auto loadReserved = createNode("lr.w", {"x1", "x2"});
+  auto storeConditional = createNode("sc.w", {"x4", "x3", "x2"});
+  ASSERT_TRUE(loadReserved->validate(memoryAccess));
+  ASSERT_TRUE(storeConditional->validate(memoryAccess));
+
+  loadReserved->getValue(memoryAccess);
+  EXPECT_EQ(7, getRegister<uint32_t>("x1"));
+  storeConditional->getValue(memoryAccess);
+  EXPECT_EQ(0, getRegister<uint32_t>("x4"));
+  EXPECT_EQ(42, getMemory<uint32_t>(8));
+
+  // The reservation was used up by the successful store
+  memoryAccess.putRegisterValue("x3", riscv::convert<uint32_t>(43));
+  storeConditional->getValue(memoryAccess);
+  EXPECT_EQ(1, getRegister<uint32_t>("x4"));
+  EXPECT_EQ(42, getMemory<uint32_t>(8));
+
+  // Another write to the reserved memory breaks the reservation
+  loadReserved->getValue(memoryAccess);
+  memoryAccess.putMemoryValueAt(8, riscv::convert<uint32_t>(5));
+  storeConditional->getValue(memoryAccess);
+  EXPECT_EQ(1, getRegister<uint32_t>("x4"));
+  EXPECT_EQ(5, getMemory<uint32_t>(8));
+}
+
+TEST_F(AtomicInstructionTest, Harts) {
+  auto& memoryAccess = getMemoryAccess();
+  memoryAccess.setHartCount(2);
+  ASSERT_EQ(2, memoryAccess.getHartCount().get());
+
+  EXPECT_EQ(0, getRegister<uint32_t>("mhartid", 0));
+  EXPECT_EQ(1, getRegister<uint32_t>("mhartid", 1));
+
+  // Each hart writes its own registers
+  auto hart = memoryAccess.forHart(1);
+  hart.putRegisterValue("x2", riscv::convert<uint32_t>(8));
+  hart.putRegisterValue("x3", riscv::convert<uint32_t>(3));
+  memoryAccess.putMemoryValueAt(8, riscv::convert<uint32_t>(4));
+  createNode("amoadd.w", {"x1", "x3", "x2"})->getValue(hart);
+  EXPECT_EQ(4, getRegister<uint32_t>("x1", 1));
+  EXPECT_EQ(0, getRegister<uint32_t>("x1", 0));
+  EXPECT_EQ(7, getMemory<uint32_t>(8));
+
+  // Reservations belong to a hart
+  memoryAccess.putRegisterValue("x2", riscv::convert<uint32_t>(8));
+  createNode("lr.w", {"x1", "x2"})->getValue(memoryAccess);
+  createNode("sc.w", {"x4", "x3", "x2"})->getValue(hart);
+  EXPECT_EQ(1, getRegister<uint32_t>("x4", 1));
+
+  // A store of one hart breaks the reservation of another
+  createNode("amoswap.w", {"x1", "x3", "x2"})->getValue(hart);
+  createNode("sc.w", {"x4", "x2", "x2"})->getValue(memoryAccess);
+  EXPECT_EQ(1, getRegister<uint32_t>("x4", 0));
+  EXPECT_EQ(3, getMemory<uint32_t>(8));
+}
+
+TEST_F(AtomicInstructionTest, Assemble) {
+  // funct5 | aq | rl | rs2 | rs1 | funct3 | rd | opcode
+  auto amoadd = createNode("amoadd.w", {"x1", "x3", "x2"});
+  EXPECT_EQ(riscv::convert<uint32_t>(0x003120AF), amoadd->assemble());
+
+  auto loadReserved = createNode("lr.w", {"x1", "x2"});
+  EXPECT_EQ(riscv::convert<uint32_t>(0x100120AF), loadReserved->assemble());
+}
@@ -24,7 +24,8 @@
 
 struct ContextInformationTest : public riscv::BaseFixture {
   using super = riscv::BaseFixture;
-  ContextInformationTest() : super({"rv32i", "rv32m", "rv64i", "rv64m"}) {
+  ContextInformationTest()
+  : super({"rv32i", "rv32m", "rv32a", "rv64i", "rv64m", "rv64a"}) {
   }
 };
 
@@ -0,0 +1,98 @@
+/* C++ Assembler Interpreter
+ * Copyright (C) 2016 Chair of Computer Architecture
+ * at Technical University of Munich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.*/
+
+#include <cstddef>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "arch/common/instruction-key.hpp"
+#include "arch/common/instruction-set.hpp"
+#include "arch/riscv/format.hpp"
+#include "arch/riscv/instruction-table.hpp"
+#include "arch/riscv/utility.hpp"
+#include "tests/arch/riscv/base-fixture.hpp"
+
+using namespace riscv;
+
+// The lookups and encoders are constexpr, so these are checked by the compiler
+static_assert(InstructionTable::find("add") != InstructionTable::invalidID,
+              "add must be in the instruction table");
+static_assert(InstructionTable::find("doesnotexist") ==
+                  InstructionTable::invalidID,
+              "unknown mnemonics must not be found");
+static_assert(InstructionTable::get(InstructionTable::find("add", "rv32i"))
+                      .opcode == 0x33,
+              "add must have the opcode of an R instruction");
+static_assert(InstructionTable::get(InstructionTable::find("srai", "rv64i"))
+                      .funct7 == 1,
+              "rv64i must override the funct7 field of srai");
+// add x1, x2, x3
+static_assert(Format::Encoding::R(0x33, 0, 0, 1, 2, 3) == 0x003100B3,
+              "R format must be encoded at compile-time");
+// beq x1, x2, 8 (the immediate is in units of two bytes)
+static_assert(Format::Encoding::SB(0x63, 0, 1, 2, 4) == 0x00208463,
+              "SB format must be encoded at compile-time");
+
+struct InstructionTableTest : public riscv::BaseFixture {
+  InstructionTableTest()
+  : BaseFixture({"rv32i", "rv32m", "rv32a", "rv64i", "rv64m", "rv64a"}) {
+  }
+};
+
+TEST(InstructionTable, TableIsSortedByMnemonic) {
+  for (std::size_t id = 1; id < InstructionTable::size; ++id) {
+    const auto& previous = InstructionTable::get(id - 1);
+    const auto& current = InstructionTable::get(id);
+    EXPECT_LE(std::string(previous.mnemonic), std::string(current.mnemonic));
+  }
+}
+
+TEST_F(InstructionTableTest, EveryInstructionHasMatchingEntry) {
+  const auto& instructions = getArchitecture().getInstructions();
+  for (const auto& pair : instructions) {
+    const auto& information = pair.second;
+    auto id = InstructionTable::find(information);
+    ASSERT_NE(id, InstructionTable::invalidID) << pair.first;
+
+    const auto& entry = InstructionTable::get(id);
+    const auto& key = information.getKey();
+    EXPECT_EQ(std::string(entry.mnemonic), information.getMnemonic());
+    EXPECT_EQ(entry.length, information.getLength());
+    if (entry.funct7 != InstructionTable::none) {
+      EXPECT_EQ(entry.funct7, key["funct7"]) << pair.first;
+    }
+  }
+}
+
+TEST_F(InstructionTableTest, TableAssemblesLikeKey) {
+  const auto& instructions = getArchitecture().getInstructions();
+  Format::Operands operands = {riscv::convert<riscv::unsigned32_t>(5),
+                               riscv::convert<riscv::unsigned32_t>(17),
+                               riscv::convert<riscv::unsigned32_t>(0xABC)};
+
+  for (const auto& pair : instructions) {
+    const auto& information = pair.second;
+    const auto& entry =
+        InstructionTable::get(InstructionTable::find(information));
+    if (!Format::isSupported(entry)) continue;
+
+    EXPECT_EQ(Format::assemble(entry, operands),
+              Format::assemble(information, operands))
+        << pair.first;
+  }
+}
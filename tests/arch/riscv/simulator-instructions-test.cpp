@@ -79,11 +79,34 @@ TEST_F(SimulatorInstructionTest, SIMUSLEEP) {
 
   ASSERT_TRUE(instr->validate(memoryAccess).isSuccess());
 
+  // the sleep is only requested, the execution loop suspends itself
+  auto& sleepTimer = project->getSleepTimer();
   auto start = std::chrono::high_resolution_clock::now();
   instr->getValue(memoryAccess);
   auto end = std::chrono::high_resolution_clock::now();
-  EXPECT_LE(std::chrono::milliseconds(sleeptime),
+  EXPECT_GT(std::chrono::milliseconds(sleeptime),
             std::chrono::duration_cast<std::chrono::milliseconds>(end - start));
+  ASSERT_TRUE(sleepTimer.hasRequest());
+  EXPECT_EQ(std::chrono::milliseconds(sleeptime), sleepTimer.takeRequest());
+  EXPECT_FALSE(sleepTimer.hasRequest());
+}
+
+TEST_F(SimulatorInstructionTest, SIMUSLEEP_virtualTime) {
+  constexpr riscv::signed32_t sleeptime = 200;
+  loadArchitecture({"rv32i"});
+  auto& memoryAccess = getMemoryAccess();
+  auto& sleepTimer = project->getSleepTimer();
+  sleepTimer.setVirtualTime(true);
+
+  auto instr = factories.createInstructionNode("simusleep");
+  instr->addChild(factories.createImmediateNode(
+      riscv::convert<riscv::signed32_t>(sleeptime)));
+  instr->getValue(memoryAccess);
+  instr->getValue(memoryAccess);
+
+  EXPECT_FALSE(sleepTimer.hasRequest());
+  EXPECT_EQ(std::chrono::milliseconds(2 * sleeptime),
+            sleepTimer.getVirtualTime());
 }
 
 TEST_F(SimulatorInstructionTest, SIMUSLEEP_validation) {
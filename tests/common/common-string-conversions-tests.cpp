@@ -53,6 +53,36 @@ TEST(StringConversionsTests, TestToHexStringConversion) {
 }
 
 
+TEST(StringConversionsTests, TestRangeConversions) {
+  MemoryValue range{{0x12, 0xA4, 0xFF, 0x00, 0x3C, 0x81}, 48};
+
+  // Cells of whole bytes.
+  EXPECT_EQ(StringConversions::toHexStrings(range, 8),
+            (std::vector<std::string>{"12", "a4", "ff", "00", "3c", "81"}));
+  EXPECT_EQ(StringConversions::toBinStrings(range, 16),
+            (std::vector<std::string>{"1010010000010010",
+                                      "0000000011111111",
+                                      "1000000100111100"}));
+
+  // Every cell has to be converted exactly like on its own, also if cells are
+  // not aligned to bytes or nibbles.
+  for (std::size_t cellSize : {1, 3, 4, 6, 8, 12, 16, 24, 48}) {
+    auto hex = StringConversions::toHexStrings(range, cellSize);
+    auto bin = StringConversions::toBinStrings(range, cellSize);
+    ASSERT_EQ(48 / cellSize, hex.size());
+    ASSERT_EQ(48 / cellSize, bin.size());
+    for (std::size_t cell = 0; cell < hex.size(); ++cell) {
+      auto value = range.subSet(cell * cellSize, (cell + 1) * cellSize);
+      EXPECT_EQ(StringConversions::toHexString(value), hex[cell]);
+      EXPECT_EQ(StringConversions::toBinString(value), bin[cell]);
+    }
+  }
+
+  EXPECT_EQ(StringConversions::toHexString(MemoryValue{{0x2A, 0x01}, 9}),
+            "12a");
+}
+
+
 TEST(StringConversionsTests, TestToSignedDecStringConversion) {
   EXPECT_EQ(StringConversions::toSignedDecString(MemoryValue{{0}, 8}), "0");
 
@@ -152,6 +182,18 @@ TEST(StringConversionsTests, TestHexStringToMemoryValueConversion) {
 }
 
 
+TEST(StringConversionsTests, TestInvalidStringToMemoryValueConversion) {
+  EXPECT_FALSE(StringConversions::hexStringToMemoryValue("12g4", 16));
+  EXPECT_FALSE(StringConversions::hexStringToMemoryValue("-1", 8));
+  EXPECT_FALSE(StringConversions::binStringToMemoryValue("1021", 8));
+  EXPECT_FALSE(StringConversions::binStringToMemoryValue("", 8));
+
+  // Upper case digits are accepted as well.
+  EXPECT_EQ(StringConversions::hexStringToMemoryValue("0xAb", 8),
+            (MemoryValue{{0xAB}, 8}));
+}
+
+
 TEST(StringConversionsTests, TestSignedDecStringToMemoryValueConversion) {
   EXPECT_EQ(StringConversions::signedDecStringToMemoryValue("0", 8),
             (MemoryValue{{0}, 8}));
@@ -100,4 +100,14 @@ TEST(UtilityTest, TestBitChecks) {
 
   EXPECT_FALSE(Utility::fitsIntoBits(convert(-0xFFF), bits));
   EXPECT_TRUE(Utility::fitsIntoBits(convert(-0xFFF), bits + 1));
+
+  // Values wider than a machine word.
+  MemoryValue wide(200);
+  wide.put(11);
+  EXPECT_FALSE(Utility::fitsIntoBits(wide, bits));
+  EXPECT_TRUE(Utility::fitsIntoBits(wide, bits + 1));
+  EXPECT_FALSE(Utility::occupiesMoreBitsThan(wide, bits, Utility::UNSIGNED));
+  wide.signExtend(11);
+  EXPECT_TRUE(Utility::fitsIntoBits(wide, bits));
+  EXPECT_TRUE(Utility::occupiesMoreBitsThan(wide, bits, Utility::UNSIGNED));
 }
@@ -0,0 +1,168 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <cstdint>
+#include <string>
+
+// clang-format off
+#include "gtest/gtest.h"
+#include "arch/common/architecture-formula.hpp"
+#include "core/binary-snapshot.hpp"
+#include "core/conversions.hpp"
+#include "core/deserialization-error.hpp"
+#include "core/memory.hpp"
+#include "core/register-set.hpp"
+// clang-format on
+
+namespace {
+const ArchitectureFormula formula("riscv", {"rv32i", "rv32m"});
+
+RegisterSet createRegisters() {
+  RegisterSet registers;
+  registers.createRegister("x1", 32);
+  registers.createRegister("x2", 32);
+  registers.aliasRegister(
+      "x2_low", "x2", std::size_t{0}, std::size_t{16});
+  registers.createRegister("flag", 1);
+  return registers;
+}
+
+void put(Memory &memory, std::size_t address, std::uint32_t value) {
+  memory.put(address, conversions::convert(value, 32));
+}
+}
+
+TEST(binarySnapshot, restoresMemoryAndRegisters) {
+  // 16 MB with a few scattered values
+  Memory memory(1 << 24);
+  for (std::size_t address = 0; address < memory.getByteCount();
+       address += 1 << 20) {
+    put(memory, address + 17, 0xdeadbeef);
+  }
+  put(memory, memory.getByteCount() - 4, 0x12345678);
+  auto registers = createRegisters();
+  registers.put("x1", conversions::convert(0xcafe, 32));
+  registers.put("x2", conversions::convert(0xf00d, 32));
+  registers.put("flag", conversions::convert(1, 1));
+
+  BinarySnapshot snapshot(formula, memory, registers);
+  EXPECT_TRUE(BinarySnapshot::isBinarySnapshot(snapshot.getData()));
+  EXPECT_FALSE(snapshot.isDelta());
+  EXPECT_LT(snapshot.getData().size(), 4096u);
+
+  BinarySnapshot loaded(snapshot.getData());
+  EXPECT_EQ(formula, loaded.getArchitectureFormula());
+  EXPECT_EQ(memory.getByteCount(), loaded.getMemorySize());
+  EXPECT_EQ(snapshot.getChecksum(), loaded.getChecksum());
+
+  // the snapshot also replaces data and grows the memory
+  Memory restoredMemory(1024);
+  put(restoredMemory, 100, 42);
+  auto restoredRegisters = createRegisters();
+  loaded.restore(restoredMemory, restoredRegisters);
+  EXPECT_EQ(memory, restoredMemory);
+  EXPECT_EQ(registers, restoredRegisters);
+}
+
+TEST(binarySnapshot, deltaOnlyStoresChangedPages) {
+  Memory memory(1 << 20);
+  for (std::size_t address = 0; address < memory.getByteCount();
+       address += 1000) {
+    put(memory, address, static_cast<std::uint32_t>(address * 7919));
+  }
+  auto registers = createRegisters();
+  BinarySnapshot base(formula, memory, registers);
+
+  // change one page and clear another one
+  put(memory, 5000, 1);
+  memory.put(BinarySnapshot::pageSize * 10, MemoryValue(8 * 4096));
+  registers.put("x1", conversions::convert(7, 32));
+  BinarySnapshot delta(formula, memory, registers, base);
+  EXPECT_TRUE(delta.isDelta());
+  EXPECT_EQ(base.getChecksum(), delta.getBaseChecksum());
+  EXPECT_LT(delta.getData().size(), base.getData().size() / 50);
+
+  Memory restoredMemory(1 << 20);
+  auto restoredRegisters = createRegisters();
+  BinarySnapshot(delta.getData())
+      .restore(base, restoredMemory, restoredRegisters);
+  EXPECT_EQ(memory, restoredMemory);
+  EXPECT_EQ(registers, restoredRegisters);
+
+  // a delta cannot be loaded without its base
+  EXPECT_THROW(delta.restore(restoredMemory, restoredRegisters),
+               DeserializationError);
+  EXPECT_THROW(delta.restore(delta, restoredMemory, restoredRegisters),
+               DeserializationError);
+}
+
+TEST(binarySnapshot, deltaAgainstForkSkipsSharedPages) {
+  Memory memory(1 << 20);
+  for (std::size_t address = 0; address < memory.getByteCount();
+       address += 1000) {
+    put(memory, address, static_cast<std::uint32_t>(address * 7919));
+  }
+  auto registers = createRegisters();
+  BinarySnapshot base(formula, memory, registers);
+  auto baseMemory = memory.fork();
+  EXPECT_TRUE(memory.sharesPage(3, baseMemory));
+
+  put(memory, 5000, 1);
+  // written, but with the same value
+  const auto unchanged = BinarySnapshot::pageSize * 20;
+  memory.put(unchanged, memory.get(unchanged, 4));
+  EXPECT_FALSE(memory.sharesPage(1, baseMemory));
+  EXPECT_FALSE(memory.sharesPage(20, baseMemory));
+  BinarySnapshot delta(formula, memory, registers, base, baseMemory);
+  EXPECT_EQ(base.getChecksum(), delta.getBaseChecksum());
+  EXPECT_EQ(BinarySnapshot(formula, memory, registers, base).getData(),
+            delta.getData());
+
+  Memory restoredMemory(1 << 20);
+  auto restoredRegisters = createRegisters();
+  delta.restore(base, restoredMemory, restoredRegisters);
+  EXPECT_EQ(memory, restoredMemory);
+}
+
+TEST(binarySnapshot, rejectsInvalidData) {
+  Memory memory(4096);
+  put(memory, 8, 1234);
+  auto registers = createRegisters();
+  BinarySnapshot snapshot(formula, memory, registers);
+
+  EXPECT_FALSE(BinarySnapshot::isBinarySnapshot("{\"memory\": {}}"));
+  EXPECT_THROW(BinarySnapshot("{\"memory\": {}}"), DeserializationError);
+
+  auto corrupted = snapshot.getData();
+  corrupted[corrupted.size() / 2] ^= 1;
+  EXPECT_THROW(BinarySnapshot{corrupted}, DeserializationError);
+
+  auto truncated = snapshot.getData();
+  truncated.resize(truncated.size() - 1);
+  EXPECT_THROW(BinarySnapshot{truncated}, DeserializationError);
+
+  Memory wideMemory(4096, 16);
+  EXPECT_THROW(snapshot.restore(wideMemory, registers), DeserializationError);
+
+  RegisterSet otherRegisters;
+  otherRegisters.createRegister("x1", 64);
+  EXPECT_THROW(snapshot.restore(memory, otherRegisters),
+               DeserializationError);
+}
@@ -0,0 +1,97 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "core/change-tracker.hpp"
+
+namespace {
+using Range = std::pair<std::size_t, std::size_t>;
+
+struct Flushed {
+  std::vector<Range> memory;
+  std::vector<std::string> registers;
+};
+
+Flushed flush(ChangeTracker &tracker, std::size_t memorySize = 1 << 20) {
+  Flushed flushed;
+  tracker.flush(memorySize,
+                [&](auto address, auto amount) {
+                  flushed.memory.emplace_back(address, amount);
+                },
+                [&](const auto &name) { flushed.registers.push_back(name); });
+  return flushed;
+}
+}
+
+TEST(changeTracker, mergesMemoryChanges) {
+  ChangeTracker tracker{16};
+  EXPECT_FALSE(tracker.isDirty());
+
+  tracker.markMemory(3, 1);
+  tracker.markMemory(20, 4);
+  tracker.markMemory(5, 2);
+  tracker.markMemory(100, 1);
+  EXPECT_TRUE(tracker.isDirty());
+
+  auto flushed = flush(tracker);
+  // pages [0, 32) and [96, 112)
+  EXPECT_EQ((std::vector<Range>{{0, 32}, {96, 16}}), flushed.memory);
+  EXPECT_TRUE(flushed.registers.empty());
+  EXPECT_FALSE(tracker.isDirty());
+  EXPECT_TRUE(flush(tracker).memory.empty());
+}
+
+TEST(changeTracker, rangesAcrossWords) {
+  ChangeTracker tracker{1};
+  tracker.markMemory(60, 10);
+  tracker.markMemory(128, 64);
+  tracker.markMemory(1000, 0);
+  auto flushed = flush(tracker);
+  EXPECT_EQ((std::vector<Range>{{60, 10}, {128, 64}}), flushed.memory);
+}
+
+TEST(changeTracker, cutsOffAtMemorySize) {
+  ChangeTracker tracker{64};
+  tracker.markMemory(90, 1);
+  tracker.markMemory(500, 1);
+  auto flushed = flush(tracker, 100);
+  EXPECT_EQ((std::vector<Range>{{64, 36}}), flushed.memory);
+  EXPECT_FALSE(tracker.isDirty());
+}
+
+TEST(changeTracker, reportsEachRegisterOnce) {
+  ChangeTracker tracker;
+  for (int i = 0; i < 1000; ++i) {
+    tracker.markRegister("x" + std::to_string(i % 100));
+  }
+  tracker.markRegister("pc");
+  auto flushed = flush(tracker);
+  EXPECT_EQ(101, flushed.registers.size());
+  EXPECT_EQ("x0", flushed.registers.front());
+  EXPECT_EQ("pc", flushed.registers.back());
+
+  tracker.markRegister("x5");
+  EXPECT_EQ(std::vector<std::string>{"x5"}, flush(tracker).registers);
+}
@@ -0,0 +1,69 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "core/condition-timer.hpp"
+
+TEST(ConditionTimerTest, notifyWakesBlockedThread) {
+  ConditionTimer timer;
+  std::atomic<bool> woken(false);
+  std::thread waiter([&] {
+    timer.wait();
+    woken = true;
+  });
+  // long enough for the waiter to stop spinning and block
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(woken);
+  EXPECT_FALSE(timer.getFlag());
+  timer.notifyOne();
+  waiter.join();
+  EXPECT_TRUE(woken);
+  EXPECT_TRUE(timer.getFlag());
+}
+
+TEST(ConditionTimerTest, waitAndReset) {
+  ConditionTimer timer;
+  timer.notifyAll();
+  // the flag is set already, this returns right away
+  timer.waitAndReset();
+  EXPECT_FALSE(timer.getFlag());
+
+  std::thread notifier([&] { timer.notifyAll(); });
+  timer.waitAndReset();
+  notifier.join();
+  EXPECT_FALSE(timer.getFlag());
+}
+
+TEST(ConditionTimerTest, waitForTimesOut) {
+  ConditionTimer timer;
+  auto start = std::chrono::steady_clock::now();
+  timer.waitFor(std::chrono::milliseconds(20));
+  EXPECT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(20));
+  EXPECT_FALSE(timer.getFlag());
+
+  timer.notifyAll();
+  timer.waitFor(std::chrono::hours(1));
+  EXPECT_TRUE(timer.getFlag());
+}
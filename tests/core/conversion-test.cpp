@@ -18,7 +18,9 @@
 
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <random>
+#include <type_traits>
 #include <vector>
 
 // clang-format off
@@ -285,3 +287,56 @@ TEST(TestConversions, onehundredandtwentyeight) {
                     -128, conversions::standardConversions::twosComplement, 8),
                 conversions::standardConversions::twosComplement));
 }
+
+template <typename T>
+void testNativeLayout(std::function<std::uint8_t()> &gen) {
+  using conversions::detail::SignedRepresentation;
+  const auto representation = std::is_signed<T>::value
+                                  ? SignedRepresentation::TWOS_COMPLEMENT
+                                  : SignedRepresentation::UNSIGNED;
+  MemGen memGen{gen};
+  TGen<T, sizeof(T) * 8> tGen{gen};
+  // A signed value needs at least a sign bit and one value bit
+  for (std::size_t size = std::is_signed<T>::value ? 2 : 1; size <= 72;
+       ++size) {
+    for (std::size_t i = 0; i < 16; ++i) {
+      MemoryValue memoryValue{memGen(size)};
+      if (size <= sizeof(T) * 8) {
+        ASSERT_EQ(conversions::detail::convertForced<T>(memoryValue,
+                                                        representation),
+                  conversions::detail::loadLittleEndian<T>(memoryValue))
+            << "size " << size;
+      } else {
+        // Wider values are truncated to their lower bits
+        ASSERT_EQ(conversions::detail::loadLittleEndian<T>(
+                      memoryValue.subSet(0, sizeof(T) * 8)),
+                  conversions::detail::loadLittleEndian<T>(memoryValue))
+            << "size " << size;
+      }
+
+      // The generic conversion cannot negate the smallest value
+      T value{tGen()};
+      if (std::is_signed<T>::value &&
+          value == std::numeric_limits<T>::min()) {
+        continue;
+      }
+      ASSERT_EQ(conversions::detail::convertForced<T>(value,
+                                                      size,
+                                                      representation),
+                conversions::detail::storeLittleEndian<T>(value, size))
+          << "size " << size;
+    }
+  }
+}
+
+TEST(TestConversions, nativeLayout) {
+  std::function<std::uint8_t()> gen = Gen();
+  testNativeLayout<std::uint8_t>(gen);
+  testNativeLayout<std::int8_t>(gen);
+  testNativeLayout<std::uint16_t>(gen);
+  testNativeLayout<std::int16_t>(gen);
+  testNativeLayout<std::uint32_t>(gen);
+  testNativeLayout<std::int32_t>(gen);
+  testNativeLayout<std::uint64_t>(gen);
+  testNativeLayout<std::int64_t>(gen);
+}
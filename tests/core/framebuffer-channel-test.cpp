@@ -0,0 +1,149 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Gtest has to be included before memory-value.
+// clang-format off
+#include "gtest/gtest.h"
+#include "core/conversions.hpp"
+#include "core/framebuffer-channel.hpp"
+#include "core/memory-value.hpp"
+#include "core/memory.hpp"
+// clang-format on
+
+TEST(framebufferChannel, publishAndConsume) {
+  std::vector<std::uint8_t> memory(64, 0);
+  FramebufferChannel channel{16, 8};
+  EXPECT_FALSE(channel.consume());
+
+  memory[18] = 42;
+  channel.publish(memory.data(), 18, 1);
+  ASSERT_TRUE(channel.consume());
+  EXPECT_EQ(42, channel.getFrame()[2]);
+  // the reader did not see any frame before, so everything is dirty
+  EXPECT_EQ(0, channel.getDirtyBegin());
+  EXPECT_EQ(8, channel.getDirtyEnd());
+  EXPECT_FALSE(channel.consume());
+
+  memory[20] = 7;
+  channel.publish(memory.data(), 20, 1);
+  ASSERT_TRUE(channel.consume());
+  EXPECT_EQ(42, channel.getFrame()[2]);
+  EXPECT_EQ(7, channel.getFrame()[4]);
+  // the writer cannot know whether the last frame was taken already, so the
+  // dirty range may be larger than the write
+  EXPECT_LE(channel.getDirtyBegin(), 4);
+  EXPECT_GE(channel.getDirtyEnd(), 5);
+
+  // writes outside of the area are ignored
+  memory[0] = 1;
+  channel.publish(memory.data(), 0, 1);
+  EXPECT_FALSE(channel.consume());
+}
+
+TEST(framebufferChannel, droppedFramesKeepTheirDirtyRange) {
+  std::vector<std::uint8_t> memory(8, 0);
+  FramebufferChannel channel{0, 8};
+  channel.publish(memory.data(), 0, 8);
+  ASSERT_TRUE(channel.consume());
+
+  for (std::size_t i = 1; i < 6; ++i) {
+    memory[i] = i;
+    channel.publish(memory.data(), i, 1);
+  }
+  ASSERT_TRUE(channel.consume());
+  EXPECT_EQ(1, channel.getDirtyBegin());
+  EXPECT_EQ(6, channel.getDirtyEnd());
+  EXPECT_TRUE(std::equal(memory.begin(), memory.end(),
+                         channel.getFrame().begin()));
+}
+
+TEST(framebufferChannel, mappedMemory) {
+  Memory memory{128};
+  EXPECT_EQ(nullptr, memory.mapFramebuffer(120, 16));
+  auto channel = memory.mapFramebuffer(64, 16);
+  ASSERT_NE(nullptr, channel);
+
+  memory.put(66, conversions::convert(0x1234, 16));
+  ASSERT_TRUE(channel->consume());
+  EXPECT_EQ(0x34, channel->getFrame()[2]);
+  EXPECT_EQ(0x12, channel->getFrame()[3]);
+
+  memory.unmapFramebuffer(channel);
+  memory.put(66, conversions::convert(0, 16));
+  EXPECT_FALSE(channel->consume());
+}
+
+TEST(framebufferChannel, copiesDoNotShareFramebuffers) {
+  Memory memory{128};
+  auto channel = memory.mapFramebuffer(64, 16);
+  ASSERT_NE(nullptr, channel);
+  ASSERT_TRUE(channel->consume());
+
+  // writes to a copy are not mirrored into the channel of the original
+  Memory copy{memory};
+  copy.put(66, conversions::convert(0x1234, 16));
+  EXPECT_FALSE(channel->consume());
+
+  // assigning a copy keeps the own channel, which shows the new contents
+  memory = copy;
+  ASSERT_TRUE(channel->consume());
+  EXPECT_EQ(0x34, channel->getFrame()[2]);
+  copy.put(66, conversions::convert(0, 16));
+  EXPECT_FALSE(channel->consume());
+  memory.put(67, conversions::convert(0, 8));
+  ASSERT_TRUE(channel->consume());
+  EXPECT_EQ(0, channel->getFrame()[3]);
+}
+
+TEST(framebufferChannel, framesAreNeverTorn) {
+  constexpr std::size_t size = 4096;
+  constexpr int frames = 2000;
+  std::vector<std::uint8_t> memory(size, 0);
+  FramebufferChannel channel{0, size};
+  std::atomic<bool> done{false};
+
+  std::thread reader([&] {
+    while (!done) {
+      if (channel.consume()) {
+        const auto &frame = channel.getFrame();
+        // every frame is written completely by a single publish
+        ASSERT_TRUE(std::all_of(frame.begin(), frame.end(), [&](auto value) {
+          return value == frame.front();
+        }));
+      }
+    }
+  });
+  for (int i = 1; i <= frames; ++i) {
+    std::fill(memory.begin(), memory.end(), i % 256);
+    channel.publish(memory.data(), 0, size);
+  }
+  done = true;
+  reader.join();
+
+  // the reader may already have taken the last frame
+  channel.consume();
+  EXPECT_EQ(frames % 256, channel.getFrame().front());
+}
@@ -0,0 +1,86 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <cstdint>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "core/conversions.hpp"
+#include "core/memory-ring-buffer.hpp"
+#include "core/memory.hpp"
+
+namespace {
+/** Writes the head, as the program producing into the buffer would. */
+void setIndex(Memory &memory, std::size_t address, std::uint32_t index) {
+  memory.put(address, conversions::convert(index, 32));
+}
+
+std::uint32_t getIndex(const Memory &memory, std::size_t address) {
+  return conversions::convert<std::uint32_t>(memory.get(address, 4));
+}
+}
+
+TEST(memoryRingBuffer, fillAndDrain) {
+  Memory memory{64};
+  MemoryRingBuffer buffer{16, 8};
+  EXPECT_EQ(std::string(), buffer.drain(memory));
+
+  EXPECT_TRUE(buffer.fill(memory, "abc"));
+  EXPECT_EQ(3, getIndex(memory, 16));
+  EXPECT_EQ(0, getIndex(memory, 20));
+  EXPECT_EQ("abc", buffer.drain(memory));
+  EXPECT_EQ(3, getIndex(memory, 20));
+  EXPECT_EQ(std::string(), buffer.drain(memory));
+}
+
+TEST(memoryRingBuffer, wrapsAround) {
+  Memory memory{64};
+  MemoryRingBuffer buffer{0, 8};
+  setIndex(memory, 0, 6);
+  setIndex(memory, 4, 6);
+
+  EXPECT_TRUE(buffer.fill(memory, "hello"));
+  EXPECT_EQ(3, getIndex(memory, 0));
+  EXPECT_EQ("hello", buffer.drain(memory));
+  EXPECT_EQ(3, getIndex(memory, 4));
+}
+
+TEST(memoryRingBuffer, fillIsAllOrNothing) {
+  Memory memory{64};
+  MemoryRingBuffer buffer{0, 8};
+  EXPECT_FALSE(buffer.fill(memory, "12345678"));
+  EXPECT_EQ(0, getIndex(memory, 0));
+
+  EXPECT_TRUE(buffer.fill(memory, "12345"));
+  EXPECT_FALSE(buffer.fill(memory, "678"));
+  EXPECT_TRUE(buffer.fill(memory, "67"));
+  EXPECT_FALSE(buffer.fill(memory, "8"));
+  EXPECT_EQ("1234567", buffer.drain(memory));
+}
+
+TEST(memoryRingBuffer, fitsInto) {
+  Memory memory{64};
+  EXPECT_TRUE(MemoryRingBuffer(0, 56).fitsInto(memory));
+  EXPECT_TRUE(MemoryRingBuffer(32, 24).fitsInto(memory));
+  EXPECT_FALSE(MemoryRingBuffer(32, 25).fitsInto(memory));
+  EXPECT_FALSE(MemoryRingBuffer(128, 2).fitsInto(memory));
+  EXPECT_FALSE(MemoryRingBuffer(0, 8).fitsInto(Memory(64, 16)));
+}
@@ -27,6 +27,7 @@
 #include "core/memory-value.hpp"
 #include "core/memory.hpp"
 #include "core/conversions.hpp"
+#include "core/deserialization-error.hpp"
 // clang-format on
 
 namespace {
@@ -66,6 +67,69 @@ TEST(memory, readWrite) {
   }
 }
 
+TEST(memory, readWriteAcrossPages) {
+  // 12 bit cells straddle both byte and page boundaries
+  Memory memory{4096, 12};
+  MemoryValue value{std::vector<std::uint8_t>{0xCD, 0x0A}, 12};
+  MemoryValue zero{12};
+  for (std::size_t address = 2725; address < 2740; ++address) {
+    memory.put(address, value);
+  }
+  for (std::size_t address = 2720; address < 2745; ++address) {
+    const bool written = address >= 2725 && address < 2740;
+    ASSERT_EQ(memory.get(address), written ? value : zero);
+  }
+  MemoryValue range{memory.get(2725, 15)};
+  ASSERT_EQ(range.getSize(), 15 * 12);
+  for (std::size_t index = 0; index < 15; ++index) {
+    ASSERT_EQ(range.subSet(index * 12, (index + 1) * 12), value);
+  }
+}
+
+TEST(memory, copyOnWrite) {
+  Memory memory{10000, 8};
+  MemoryValue a{std::vector<std::uint8_t>{0xAA}, 8};
+  MemoryValue b{std::vector<std::uint8_t>{0xBB}, 8};
+  memory.put(5000, a);
+
+  Memory copy{memory};
+  Memory fork{memory.fork()};
+  ASSERT_EQ(copy, memory);
+  ASSERT_EQ(fork, memory);
+
+  copy.put(5000, b);
+  fork.put(9999, b);
+  ASSERT_EQ(memory.get(5000), a);
+  ASSERT_EQ(memory.get(9999), MemoryValue(8));
+  ASSERT_EQ(copy.get(5000), b);
+  ASSERT_EQ(fork.get(5000), a);
+  ASSERT_EQ(fork.get(9999), b);
+  ASSERT_FALSE(copy == memory);
+  ASSERT_FALSE(fork == memory);
+
+  memory.put(0, b);
+  ASSERT_EQ(copy.get(0), MemoryValue(8));
+  ASSERT_EQ(fork.get(0), MemoryValue(8));
+}
+
+TEST(memory, rawData) {
+  Memory memory{6000, 6};
+  MemoryValue value{std::vector<std::uint8_t>{0x2A}, 6};
+  memory.put(5999, value);
+  memory.put(1, value);
+
+  auto raw = memory.getRawData();
+  ASSERT_EQ(raw.size(), 4500);
+  Memory other{6000, 6};
+  other.setRawData(6000, std::move(raw));
+  ASSERT_EQ(other, memory);
+  ASSERT_EQ(other.get(5999), value);
+
+  memory.clear();
+  ASSERT_EQ(memory, Memory(6000, 6));
+  ASSERT_EQ(other.get(1), value);
+}
+
 TEST(memory, serialization) {
   constexpr std::size_t memorySize = 1024 * 64 - 1;
   Memory instance0{memorySize, 8};
@@ -94,6 +158,45 @@ TEST(memory, serialization) {
   ASSERT_EQ(instance3, instance4);
 }
 
+TEST(memory, serializationCellSizes) {
+  for (std::size_t byteSize : {4, 12, 16}) {
+    constexpr std::size_t memorySize = 100;
+    Memory instance0{memorySize, byteSize};
+    std::uniform_int_distribution<std::uint16_t> dist{0, 0xFFFF};
+    std::mt19937 rand(byteSize);
+    for (std::size_t i = 0; i < memorySize; ++i) {
+      instance0.put(i,
+                    conversions::convert(
+                        dist(rand) % (1 << byteSize),
+                        conversions::standardConversions::nonsigned,
+                        byteSize));
+    }
+    nlohmann::json json = instance0.serializeJSON(nlohmann::json{}, ',', 7);
+    Memory instance1{memorySize, byteSize};
+    instance1.deserializeJSON(json);
+    ASSERT_EQ(instance0, instance1);
+  }
+
+  Memory instance{4, 16};
+  instance.put(1,
+               conversions::convert(
+                   0xAB01, conversions::standardConversions::nonsigned, 16));
+  nlohmann::json json = instance.serializeJSON(nlohmann::json{}, ',', 2);
+  EXPECT_EQ("0000,AB01,", json["memory_map"]["memory_line_0"]);
+  EXPECT_EQ(0, json["memory_map"].count("memory_line_2"));
+
+  // a digit must not reach beyond its cell
+  Memory small{2, 6};
+  json = small.serializeJSON(nlohmann::json{}, ',', 2);
+  json["memory_map"]["memory_line_0"] = "3f,00,";
+  small.deserializeJSON(json);
+  EXPECT_EQ(conversions::convert(
+                0x3F, conversions::standardConversions::nonsigned, 6),
+            small.get(0));
+  json["memory_map"]["memory_line_0"] = "7f,00,";
+  EXPECT_THROW(small.deserializeJSON(json), DeserializationError);
+}
+
 TEST(memory, protection) {
   const MemoryValue FF{std::vector<std::uint8_t>{0xFF}, 8};
   const MemoryValue OO{std::vector<std::uint8_t>{0x00}, 8};
@@ -455,3 +455,45 @@ TEST(TestMemoryValue, TestIteratorBehavior) {
                assert::AssertionError);
   EXPECT_THROW(memory.begin() - memory2.end(), assert::AssertionError);
 }
+
+TEST(TestMemoryValue, bitQueries) {
+  // compare against bit by bit counting for sizes around word boundaries
+  std::mt19937 rand(0);
+  std::uniform_int_distribution<int> bits(0, 1);
+  for (std::size_t size : {1, 5, 8, 13, 63, 64, 65, 129, 200}) {
+    for (int run = 0; run < 50; ++run) {
+      MemoryValue value(size);
+      // long runs of equal bits at the top are the interesting case
+      std::uniform_int_distribution<std::size_t> topBits(0, size);
+      std::size_t top = topBits(rand);
+      bool fill = bits(rand);
+      for (std::size_t i = 0; i < size; ++i) {
+        value.put(i, i >= size - top ? fill : bits(rand));
+      }
+
+      std::size_t zeros = 0, ones = 0, set = 0;
+      while (zeros < size && !value.get(size - 1 - zeros)) ++zeros;
+      while (ones < size && value.get(size - 1 - ones)) ++ones;
+      for (std::size_t i = 0; i < size; ++i) set += value.get(i);
+
+      EXPECT_EQ(zeros, value.countLeadingZeros());
+      EXPECT_EQ(ones, value.countLeadingOnes());
+      EXPECT_EQ(set, value.countOnes());
+      EXPECT_EQ(zeros == size ? size : size - 1 - zeros, value.highestSetBit());
+    }
+  }
+}
+
+TEST(TestMemoryValue, signExtend) {
+  MemoryValue value{std::vector<std::uint8_t>{0x80, 0x00, 0x00}, 20};
+  value.signExtend(7);
+  EXPECT_EQ((MemoryValue{std::vector<std::uint8_t>{0x80, 0xFF, 0x0F}, 20}),
+            value);
+  EXPECT_EQ(13, value.countLeadingOnes());
+  EXPECT_EQ(0x0F, value.internal().back());
+
+  value.signExtend(3);
+  EXPECT_EQ((MemoryValue{std::vector<std::uint8_t>{0x00, 0x00, 0x00}, 20}),
+            value);
+  EXPECT_TRUE(value.isZero());
+}
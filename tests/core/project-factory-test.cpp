@@ -0,0 +1,71 @@
+/* C++ Assembler Interpreter
+ * Copyright (C) 2016 Chair of Computer Architecture
+ * at Technical University of Munich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <string>
+
+// Gtest has to be included before memory-value.
+// clang-format off
+#include "gtest/gtest.h"
+#include "arch/common/architecture-formula.hpp"
+#include "core/conversions.hpp"
+#include "core/memory-value.hpp"
+#include "core/project-factory.hpp"
+#include "core/project-module.hpp"
+#include "core/register-set.hpp"
+// clang-format on
+
+TEST(projectFactory, templatesAreShared) {
+  ProjectFactory::clear();
+  ArchitectureFormula formula{"riscv", {"rv32i"}};
+  ArchitectureFormula other{"riscv", {"rv32i", "rv32m"}};
+
+  auto first = ProjectFactory::getTemplate(formula);
+  EXPECT_EQ(first, ProjectFactory::getTemplate(formula));
+  EXPECT_NE(first, ProjectFactory::getTemplate(other));
+  EXPECT_TRUE(first->architecture.isValidated());
+
+  // the template holds the registers a project starts with
+  RegisterSet registers;
+  Project::createRegisters(first->architecture, registers, 0);
+  EXPECT_EQ(registers, first->registers);
+
+  // templates that are handed out stay valid
+  ProjectFactory::clear();
+  EXPECT_EQ(32, first->architecture.getWordSize());
+  EXPECT_NE(first, ProjectFactory::getTemplate(formula));
+}
+
+TEST(projectFactory, projectsDoNotShareState) {
+  ArchitectureFormula formula{"riscv", {"rv32i"}};
+  ProjectFactory::prewarm(formula);
+  ProjectModule first{formula, 64, "riscv"};
+  ProjectModule second{formula, 64, "riscv"};
+
+  auto value = conversions::convert(42, 32);
+  first.getMemoryAccess().putRegisterValue("x1", value);
+  first.getMemoryAccess().putMemoryValueAt(0, conversions::convert(7, 8));
+
+  EXPECT_EQ(value, first.getMemoryAccess().getRegisterValue("x1").get());
+  EXPECT_EQ(MemoryValue(32),
+            second.getMemoryAccess().getRegisterValue("x1").get());
+  EXPECT_EQ(MemoryValue(8),
+            second.getMemoryAccess().getMemoryValueAt(0).get());
+  EXPECT_EQ(MemoryValue(32),
+            ProjectFactory::getTemplate(formula)->registers.get("x1"));
+}
@@ -17,9 +17,12 @@
  */
 
 
+#include <atomic>
 #include <chrono>
+#include <cstdio>
 #include <functional>
 #include <random>
+#include <thread>
 
 // clang-format off
 #include "gtest/gtest.h"
@@ -27,6 +30,7 @@
 #include "core/project-module.hpp"
 #include "core/scheduler.hpp"
 #include "core/servant.hpp"
+#include "core/trace-reader.hpp"
 #include "core/proxy.hpp"
 #include "arch/common/architecture-formula.hpp"
 #include "parser/common/final-representation.hpp"
@@ -294,6 +298,85 @@ TEST_F(ProjectTestFixture, CommandInterfaceTest) {
   EXPECT_EQ(5, proxy.getLine().get());
 }
 
+TEST_F(ProjectTestFixture, ReverseExecutionTest) {
+  CommandInterface commandInterface = projectModule.getCommandInterface();
+  MemoryAccess memoryAccess = projectModule.getMemoryAccess();
+  MemoryValue zero = conversions::convert(0, 32);
+
+  commandInterface.parse(testProgram);
+  commandInterface.execute();
+  // sync with other thread
+  commandInterface.setBreakpoint(0).get();
+
+  EXPECT_EQ(5, proxy.getLine().get());
+  EXPECT_EQ(0xDEADB000,
+            conversions::convert<std::uint32_t>(
+                memoryAccess.getRegisterValue("x2").get()));
+  EXPECT_EQ(3, memoryAccess.getUndoStepCount().get());
+
+  commandInterface.executePreviousLine();
+  commandInterface.setBreakpoint(0).get();
+
+  EXPECT_EQ(4, proxy.getLine().get());
+  EXPECT_EQ(2, memoryAccess.getUndoStepCount().get());
+
+  commandInterface.setBreakpoint(1);
+  commandInterface.executeBackwardsToBreakpoint();
+  commandInterface.setBreakpoint(0).get();
+
+  EXPECT_EQ(1, proxy.getLine().get());
+  EXPECT_EQ(zero, memoryAccess.getRegisterValue("x2").get());
+  EXPECT_EQ(zero, memoryAccess.getRegisterValue("pc").get());
+  EXPECT_EQ(0, memoryAccess.getUndoStepCount().get());
+
+  // nothing left to undo
+  commandInterface.executePreviousLine();
+  commandInterface.setBreakpoint(0).get();
+  EXPECT_EQ(1, proxy.getLine().get());
+
+  // replaying gives the same result
+  commandInterface.execute();
+  commandInterface.setBreakpoint(0).get();
+  EXPECT_EQ(0xDEADB000,
+            conversions::convert<std::uint32_t>(
+                memoryAccess.getRegisterValue("x2").get()));
+
+  // a new program invalidates the log
+  commandInterface.parse(testProgram + "\n");
+  commandInterface.setBreakpoint(0).get();
+  EXPECT_EQ(0, memoryAccess.getUndoStepCount().get());
+}
+
+TEST_F(ProjectTestFixture, TraceTest) {
+  const std::string path = "project-test.trace";
+  CommandInterface commandInterface = projectModule.getCommandInterface();
+
+  commandInterface.parse(testProgram);
+  ASSERT_TRUE(commandInterface.startTrace(path, true).get());
+  commandInterface.execute();
+  EXPECT_EQ(3, commandInterface.stopTrace().get());
+
+  TraceReader reader(path);
+  TraceReader::Step step;
+  ASSERT_TRUE(reader.next(step));
+  EXPECT_EQ(0, step.address);
+  EXPECT_EQ(32, step.encoding.getSize());
+  // lui x2 writes x2 and the program counter
+  ASSERT_EQ(2, step.registerWrites.size());
+  EXPECT_EQ("x2", step.registerWrites[0].name);
+  EXPECT_EQ(0xDEADB000,
+            conversions::convert<std::uint32_t>(
+                step.registerWrites[0].value));
+  EXPECT_EQ("pc", step.registerWrites[1].name);
+
+  ASSERT_TRUE(reader.next(step));
+  EXPECT_EQ(4, step.address);
+  ASSERT_TRUE(reader.next(step));
+  EXPECT_EQ(8, step.address);
+  EXPECT_FALSE(reader.next(step));
+  std::remove(path.c_str());
+}
+
 TEST_F(ProjectTestFixture, ParserInterfaceTest) {
   ParserInterface parserInterface = projectModule.getParserInterface();
   SyntaxInformation syntaxInformation = parserValidator->getSyntaxInformation();
@@ -316,10 +399,56 @@ TEST_F(ProjectTestFixture, SleepTest) {
   auto beforeSleep = std::chrono::high_resolution_clock::now();
   memoryAccess.sleep(targetedSleep);
   auto afterSleep = std::chrono::high_resolution_clock::now();
-  // should sleep now
-  EXPECT_LE(targetedSleep,
+  // should only request the sleep
+  EXPECT_GT(targetedSleep,
             std::chrono::duration_cast<std::chrono::milliseconds>(afterSleep -
                                                                   beforeSleep));
+  EXPECT_EQ(targetedSleep, projectModule.getSleepTimer().takeRequest());
+}
+
+TEST_F(ProjectTestFixture, SleepDoesNotBlockTest) {
+  using namespace std::chrono;
+  CommandInterface commandInterface = projectModule.getCommandInterface();
+  MemoryAccess memoryAccess = projectModule.getMemoryAccess();
+  std::atomic<bool> running(true);
+  commandInterface.setExecutionStoppedCallback([&running] { running = false; });
+
+  commandInterface.parse("simusleep 10000\naddi x1, x0, 1");
+  commandInterface.execute();
+  // sync with the other thread, the program is sleeping now
+  commandInterface.setBreakpoint(0).get();
+
+  // the servant still answers while the program sleeps
+  auto start = steady_clock::now();
+  EXPECT_TRUE(commandInterface.setBreakpoint(1).get());
+  EXPECT_GT(milliseconds(5000),
+            duration_cast<milliseconds>(steady_clock::now() - start));
+  EXPECT_TRUE(running);
+  EXPECT_EQ(0,
+            conversions::convert<int>(
+                memoryAccess.getRegisterValue("x1").get()));
+
+  // stopping wakes the program up immediately
+  projectModule.stopExecution();
+  commandInterface.setBreakpoint(0).get();
+  EXPECT_FALSE(running);
+  EXPECT_GT(milliseconds(5000),
+            duration_cast<milliseconds>(steady_clock::now() - start));
+  EXPECT_EQ(0,
+            conversions::convert<int>(
+                memoryAccess.getRegisterValue("x1").get()));
+
+  // a short sleep is resumed by the timer
+  commandInterface.parse("simusleep 50\naddi x1, x0, 1");
+  commandInterface.setExecutionPoint(0);
+  running = true;
+  commandInterface.execute();
+  while (running) {
+    std::this_thread::sleep_for(milliseconds(10));
+  }
+  EXPECT_EQ(1,
+            conversions::convert<int>(
+                memoryAccess.getRegisterValue("x1").get()));
 }
 
 TEST_F(ProjectTestFixture, SerializationTest) {
@@ -361,3 +490,166 @@ TEST_F(ProjectTestFixture, SerializationTest) {
               memoryAccess.getMemoryValueAt(i, 4).get());
   }
 }
+
+TEST_F(ProjectTestFixture, ChangeBatchTest) {
+  MemoryManager memoryManager = projectModule.getMemoryManager();
+  MemoryAccess memoryAccess = projectModule.getMemoryAccess();
+  // the callbacks run on the project thread, the futures below sync with it
+  std::vector<std::pair<std::size_t, std::size_t>> memoryUpdates;
+  std::vector<std::string> registerUpdates;
+  memoryManager.setUpdateMemoryCallback(
+      [&memoryUpdates](std::size_t address, std::size_t amount) {
+        memoryUpdates.emplace_back(address, amount);
+      });
+  memoryManager.setUpdateRegisterCallback(
+      [&registerUpdates](const std::string& name) {
+        registerUpdates.push_back(name);
+      });
+
+  // without a batch, every change is reported right away
+  memoryAccess.putMemoryValueAt(3, MemoryValue(8));
+  memoryAccess.getMemorySize().get();
+  ASSERT_EQ(1, memoryUpdates.size());
+  EXPECT_EQ(3, memoryUpdates[0].first);
+  memoryUpdates.clear();
+
+  memoryAccess.beginChangeBatch();
+  for (std::size_t address = 0; address < 10; ++address) {
+    memoryAccess.putMemoryValueAt(address, MemoryValue(8));
+  }
+  memoryAccess.putMemoryValueAt(990, MemoryValue(8));
+  for (int i = 0; i < 10; ++i) {
+    memoryAccess.setRegisterValue("x1", MemoryValue(32));
+  }
+  memoryAccess.getMemorySize().get();
+  EXPECT_TRUE(memoryUpdates.empty());
+  EXPECT_TRUE(registerUpdates.empty());
+
+  memoryAccess.endChangeBatch();
+  memoryAccess.getMemorySize().get();
+  // one page at the start, the last page cut off at the memory size
+  ASSERT_EQ(2, memoryUpdates.size());
+  EXPECT_EQ(0, memoryUpdates[0].first);
+  EXPECT_LE(10, memoryUpdates[0].second);
+  EXPECT_GE(990, memoryUpdates[1].first);
+  EXPECT_EQ(memorySize, memoryUpdates[1].first + memoryUpdates[1].second);
+  EXPECT_EQ(std::vector<std::string>{"x1"}, registerUpdates);
+}
+
+TEST_F(ProjectTestFixture, TransactionTest) {
+  MemoryManager memoryManager = projectModule.getMemoryManager();
+  MemoryAccess memoryAccess = projectModule.getMemoryAccess();
+  std::vector<std::pair<std::size_t, std::size_t>> memoryUpdates;
+  memoryManager.setUpdateMemoryCallback(
+      [&memoryUpdates](std::size_t address, std::size_t amount) {
+        memoryUpdates.emplace_back(address, amount);
+      });
+
+  // several values are read in a single request
+  memoryAccess.setRegisterValue("x1", MemoryValue(32));
+  auto values = memoryAccess
+                    .transaction([](Transaction& transaction) {
+                      return std::make_pair(
+                          transaction.getMemorySize(),
+                          transaction.getRegisterValue("x1"));
+                    })
+                    .get();
+  EXPECT_EQ(memorySize, values.first);
+  EXPECT_EQ(MemoryValue(32), values.second);
+
+  // the writes of a transaction are reported once it is finished
+  memoryAccess.runTransaction([](Transaction& transaction) {
+    for (std::size_t address = 0; address < 10; ++address) {
+      transaction.putMemoryValueAt(address, MemoryValue(8));
+    }
+  });
+  memoryAccess.getMemorySize().get();
+  ASSERT_EQ(1, memoryUpdates.size());
+  EXPECT_EQ(0, memoryUpdates[0].first);
+  EXPECT_LE(10, memoryUpdates[0].second);
+  memoryUpdates.clear();
+
+  // nested in a batch, the changes are reported when the batch ends
+  memoryAccess.beginChangeBatch();
+  memoryAccess.runTransaction([](Transaction& transaction) {
+    transaction.putMemoryValueAt(3, MemoryValue(8));
+  });
+  memoryAccess.getMemorySize().get();
+  EXPECT_TRUE(memoryUpdates.empty());
+  memoryAccess.endChangeBatch();
+  memoryAccess.getMemorySize().get();
+  EXPECT_EQ(1, memoryUpdates.size());
+}
+
+TEST_F(ProjectTestFixture, HartTransactionTest) {
+  MemoryAccess memoryAccess = projectModule.getMemoryAccess();
+  memoryAccess.setHartCount(2);
+  memoryAccess.putRegisterValue("x1", MemoryValue(32));
+
+  // a transaction works on the registers of its hart
+  MemoryAccess hartAccess = memoryAccess.forHart(1);
+  auto hart = hartAccess.transaction([](Transaction& transaction) {
+    transaction.putRegisterValue("x1", conversions::convert(7, 32));
+    return transaction.getHart();
+  });
+  EXPECT_EQ(1, hart.get());
+  EXPECT_EQ(MemoryValue(32), memoryAccess.getRegisterValue("x1").get());
+  EXPECT_EQ(conversions::convert(7, 32),
+            hartAccess.getRegisterValue("x1").get());
+}
+
+TEST_F(ProjectTestFixture, RegisterSnapshotTest) {
+  MemoryAccess memoryAccess = projectModule.getMemoryAccess();
+  auto snapshots = memoryAccess.getRegisterSnapshots().get();
+  auto before = snapshots->load();
+  EXPECT_TRUE(before->hasRegister("x1"));
+  EXPECT_TRUE(before->hasRegister("pc"));
+
+  memoryAccess.putRegisterValue("x1", conversions::convert(42, 32));
+  memoryAccess.getMemorySize().get();
+  auto after = snapshots->load();
+  EXPECT_LT(before->getVersion(), after->getVersion());
+  EXPECT_EQ(42, conversions::convert<int>(after->get("x1")));
+  EXPECT_EQ(0, conversions::convert<int>(before->get("x1")));
+}
+
+TEST_F(ProjectTestFixture, PublishedMemorySizeTest) {
+  MemoryAccess memoryAccess = projectModule.getMemoryAccess();
+  EXPECT_EQ(memorySize, memoryAccess.getCachedMemorySize());
+
+  // The memory only grows by loading a snapshot of a bigger memory.
+  ProjectModule bigger(formula, 2 * memorySize, "riscv");
+  auto snapshot = bigger.getMemoryManager().generateBinarySnapshot().get();
+  projectModule.getMemoryManager().loadBinarySnapshot(snapshot);
+  EXPECT_EQ(2 * memorySize, memoryAccess.getMemorySize().get());
+  EXPECT_EQ(2 * memorySize, memoryAccess.getCachedMemorySize());
+}
+
+TEST_F(ProjectTestFixture, CheckpointTest) {
+  MemoryAccess memoryAccess = projectModule.getMemoryAccess();
+  MemoryManager memoryManager = projectModule.getMemoryManager();
+  memoryAccess.putMemoryValueAt(16, conversions::convert(42, 32));
+  memoryAccess.putRegisterValue("x1", conversions::convert(1, 32));
+  auto checkpoint = memoryManager.createCheckpoint().get();
+
+  // every run starts from the same state
+  for (int run = 2; run < 5; ++run) {
+    memoryAccess.putMemoryValueAt(16, conversions::convert(run, 32));
+    memoryAccess.putRegisterValue("x1", conversions::convert(run, 32));
+    auto delta = memoryManager.generateDeltaSnapshot(checkpoint).get();
+    EXPECT_TRUE(delta.isDelta());
+    EXPECT_EQ(checkpoint.snapshot.getChecksum(), delta.getBaseChecksum());
+
+    memoryManager.restoreCheckpoint(checkpoint);
+    EXPECT_EQ(conversions::convert(42, 32),
+              memoryAccess.getMemoryValueAt(16, 4).get());
+    EXPECT_EQ(conversions::convert(1, 32),
+              memoryAccess.getRegisterValue("x1").get());
+
+    memoryManager.loadDeltaSnapshot(checkpoint.snapshot, delta);
+    EXPECT_EQ(conversions::convert(run, 32),
+              memoryAccess.getMemoryValueAt(16, 4).get());
+    memoryManager.restoreCheckpoint(checkpoint);
+  }
+  EXPECT_EQ(42, conversions::convert<int>(checkpoint.memory.get(16, 4)));
+}
@@ -26,6 +26,7 @@
 // Include Google Test first
 // clang-format off
 #include "gtest/gtest.h"
+#include "core/bounded-queue.hpp"
 #include "core/lockfree-queue.hpp"
 #include "core/locking-queue.hpp"
 // clang-format on
@@ -151,3 +152,30 @@ TEST(TestQueues, lockingQueueCopyOnly) {
 TEST(TestQueues, lockingQueueMoveOnly) {
   testQueue<LockingQueue, MoveOnlyObject>();
 }
+
+TEST(TestQueues, boundedQueue) {
+  testQueue<BoundedQueue, std::size_t>();
+}
+TEST(TestQueues, boundedQueueCopyOnly) {
+  testQueue<BoundedQueue, CopyOnlyObject>();
+}
+TEST(TestQueues, boundedQueueMoveOnly) {
+  testQueue<BoundedQueue, MoveOnlyObject>();
+}
+TEST(TestQueues, boundedQueueFull) {
+  BoundedQueue<std::size_t> queue(4);
+  for (std::size_t index = 0; index < 4; ++index) {
+    ASSERT_TRUE(queue.tryPush(index));
+  }
+  ASSERT_FALSE(queue.tryPush(std::size_t{4}));
+  std::size_t value;
+  ASSERT_TRUE(queue.pop(value));
+  ASSERT_EQ(std::size_t{0}, value);
+  ASSERT_TRUE(queue.tryPush(std::size_t{4}));
+  for (std::size_t index = 1; index <= 4; ++index) {
+    ASSERT_TRUE(queue.pop(value));
+    ASSERT_EQ(index, value);
+  }
+  ASSERT_TRUE(queue.isEmpty());
+  ASSERT_FALSE(queue.pop(value));
+}
@@ -18,6 +18,7 @@
 
 #include <random>
 #include <sstream>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -225,3 +226,52 @@ TEST(registerSet, serialization) {
   instance1.deserializeJSON(json);
   ASSERT_EQ(instance0, instance1);
 }
+
+TEST(registerSet, snapshot) {
+  RegisterSet instance{};
+  instance.createRegister("parent", 32);
+  instance.aliasRegister("low", "parent", 0, 16, false);
+  instance.put("parent", conversions::convert(0x12345678, 32));
+
+  auto snapshot = instance.takeSnapshot(1);
+  EXPECT_EQ(1, snapshot.getVersion());
+  EXPECT_TRUE(snapshot.hasRegister("low"));
+  EXPECT_FALSE(snapshot.hasRegister("high"));
+  EXPECT_EQ(conversions::convert(0x5678, 16), snapshot.get("low"));
+
+  // the snapshot is not affected by later changes
+  instance.put("low", conversions::convert(0, 16));
+  EXPECT_EQ(conversions::convert(0x12345678, 32), snapshot.get("parent"));
+
+  // new registers show up in the following snapshots only
+  instance.aliasRegister("high", "parent", 16, 32, false);
+  auto next = instance.takeSnapshot(2);
+  EXPECT_FALSE(snapshot.hasRegister("high"));
+  EXPECT_EQ(conversions::convert(0x1234, 16), next.get("high"));
+  EXPECT_EQ(conversions::convert(0x12340000, 32), next.get("parent"));
+}
+
+TEST(registerSet, operand) {
+  RegisterSet instance{};
+  instance.createRegister("parent", 32);
+  instance.aliasRegister("high", "parent", 16, 32, false);
+  instance.put("parent", conversions::convert(0xFFFE1234, 32));
+
+  auto parent = instance.getID("parent");
+  auto high = instance.getID("high");
+  EXPECT_EQ(parent.address, high.address);
+
+  auto operand = instance.getOperand(parent);
+  EXPECT_EQ(32, operand.size);
+  EXPECT_EQ(0xFFFE1234, operand.as<std::uint32_t>());
+
+  // aliases are read from their bit range and sign-extended on request
+  operand = instance.getOperand(high);
+  EXPECT_EQ(16, operand.size);
+  EXPECT_EQ(0xFFFE, operand.as<std::uint64_t>());
+  EXPECT_EQ(-2, operand.as<std::int64_t>());
+
+  // the operand sees later writes, as the id stays valid
+  instance.put("high", conversions::convert(7, 16));
+  EXPECT_EQ(0x00071234, instance.getOperand(parent).as<std::uint32_t>());
+}
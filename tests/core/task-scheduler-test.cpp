@@ -20,8 +20,10 @@
 #include <exception>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <thread>
+#include <vector>
 
 // clang-format off
 #include "gtest/gtest.h"
@@ -88,6 +90,7 @@ class Testproxy2 : public Proxy<Testservant2> {
   POST_FUTURE(testException)
   POST_CALLBACK_UNSAFE(testException)
   POST_CALLBACK_SAFE(testException)
+  POST_ASYNC(testException)
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -212,6 +215,7 @@ class Testproxy1 : public Proxy<Testservant1> {
   POST_FUTURE_BLOCKING(testFuture)
   POST_FUTURE(testFutureNonBlocking)
   POST_FUTURE_CONST(testFutureConst)
+  POST_ASYNC(testFutureConst)
   POST(postCallbackUnsafeTest)
   POST(postCallbackTest)
   POST(postDoubleTest)
@@ -307,6 +311,41 @@ TEST_F(SchedulerQueueFixture, schedulerQueueTest) {
   ASSERT_EQ(verifyCounter, testCounter);
 }
 
+// Tests that the tasks of a thread run in order, also when they do not fit
+// into the ring buffer of the scheduler anymore
+TEST(SchedulerTest, keepsOrderWhenFull) {
+  auto scheduler = std::make_shared<Scheduler>();
+  std::vector<std::size_t> order;
+  std::promise<void> blocked;
+  auto unblock = blocked.get_future().share();
+  // keep the scheduler busy, so that the tasks pile up
+  scheduler->push([unblock] { unblock.wait(); });
+  auto count = 4 * Scheduler::queueCapacity;
+  for (std::size_t index = 0; index < count; ++index) {
+    scheduler->push([&order, index] { order.push_back(index); });
+  }
+  blocked.set_value();
+  // delete the scheduler to make sure every task gets executed.
+  scheduler.reset();
+  ASSERT_EQ(count, order.size());
+  for (std::size_t index = 0; index < count; ++index) {
+    ASSERT_EQ(index, order[index]);
+  }
+}
+
+// Tests that tasks can hold move-only objects
+TEST(SchedulerTest, moveOnlyTask) {
+  auto scheduler = std::make_shared<Scheduler>();
+  auto value = std::make_unique<int>(42);
+  std::promise<int> promise;
+  auto future = promise.get_future();
+  scheduler->push([
+    value = std::move(value),
+    promise = std::move(promise)
+  ]() mutable { promise.set_value(*value); });
+  ASSERT_EQ(42, future.get());
+}
+
 // Tests if constructor and destructor are running in the scheduler thread
 TEST(ThreadingTestProxy, constructorTest) {
   std::shared_ptr<Scheduler> scheduler = std::make_shared<Scheduler>();
@@ -341,6 +380,51 @@ TEST_F(ThreadingTestFixture, postFuture) {
   }
 }
 
+// tests receiving a result through a continuation that is handed to an
+// executor, which runs it in the test thread (POST_ASYNC)
+TEST_F(ThreadingTestFixture, postAsync) {
+  std::mutex mutex;
+  std::vector<std::function<void()>> posted;
+  auto executor = [&mutex, &posted](std::function<void()> function) {
+    std::lock_guard<std::mutex> lock(mutex);
+    posted.push_back(std::move(function));
+  };
+
+  std::vector<int> results;
+  auto testThreadId = std::this_thread::get_id();
+  for (int i = 0; i < testRepeat; i++) {
+    proxy1.testFutureConstAsync(
+        executor,
+        [&results, testThreadId](Result<int> result) {
+          EXPECT_EQ(testThreadId, std::this_thread::get_id());
+          results.push_back(result.get());
+        },
+        i,
+        testThreadId);
+  }
+  // a failure reaches the continuation as well
+  bool failed = false;
+  proxy2.testExceptionAsync(executor, [&failed](Result<int> result) {
+    failed = result.hasException();
+  });
+
+  // The queues run in order, so every task above has finished afterwards.
+  proxy1.testFuture(0, testThreadId);
+  EXPECT_ANY_THROW(proxy2.testExceptionBlocking());
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_EQ(posted.size(), static_cast<std::size_t>(testRepeat) + 1);
+  ASSERT_TRUE(results.empty());
+  for (auto& function : posted) {
+    function();
+  }
+  ASSERT_TRUE(failed);
+  ASSERT_EQ(results.size(), static_cast<std::size_t>(testRepeat));
+  for (int i = 0; i < testRepeat; i++) {
+    ASSERT_EQ(results[i], i);
+  }
+}
+
 // tests calling a simple method of servant1 (POST) and servant1 calling a
 // simple method of servant2
 TEST_F(ThreadingTestFixture, doublePost) {
@@ -0,0 +1,77 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "core/sleep-timer.hpp"
+#include "core/timer-queue.hpp"
+
+TEST(TimerQueueTest, runsTasksInDeadlineOrder) {
+  using namespace std::chrono;
+  TimerQueue queue;
+  std::mutex mutex;
+  std::vector<int> order;
+  std::atomic<int> done(0);
+
+  auto start = steady_clock::now();
+  for (int i : {3, 1, 2}) {
+    queue.schedule(milliseconds(20 * i), [&, i] {
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(i);
+      ++done;
+    });
+  }
+  while (done < 3) {
+    std::this_thread::sleep_for(milliseconds(5));
+  }
+  EXPECT_LE(milliseconds(60),
+            duration_cast<milliseconds>(steady_clock::now() - start));
+  EXPECT_EQ((std::vector<int>{1, 2, 3}), order);
+}
+
+TEST(TimerQueueTest, dropsWaitingTasks) {
+  std::atomic<bool> called(false);
+  {
+    TimerQueue queue;
+    queue.schedule(std::chrono::hours(1), [&called] { called = true; });
+  }
+  EXPECT_FALSE(called);
+}
+
+TEST(SleepTimerTest, requestsAddUp) {
+  using std::chrono::milliseconds;
+  SleepTimer timer;
+  EXPECT_FALSE(timer.hasRequest());
+  timer.request(milliseconds(5));
+  timer.request(milliseconds(7));
+  EXPECT_TRUE(timer.hasRequest());
+  EXPECT_EQ(milliseconds(12), timer.takeRequest());
+  EXPECT_FALSE(timer.hasRequest());
+
+  timer.setVirtualTime(true);
+  timer.request(milliseconds(5));
+  EXPECT_FALSE(timer.hasRequest());
+  EXPECT_EQ(milliseconds(5), timer.getVirtualTime());
+}
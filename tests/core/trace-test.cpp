@@ -0,0 +1,192 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+// Gtest has to be included before memory-value.
+// clang-format off
+#include "gtest/gtest.h"
+#include "core/conversions.hpp"
+#include "core/deserialization-error.hpp"
+#include "core/memory-value.hpp"
+#include "core/trace-format.hpp"
+#include "core/trace-reader.hpp"
+#include "core/trace-writer.hpp"
+// clang-format on
+
+namespace {
+const std::string path = "trace-test.trace";
+
+MemoryValue word(std::uint32_t value) {
+  return conversions::convert(value, 32);
+}
+
+void writeLoop(TraceWriter& writer, std::size_t steps) {
+  writer.writeProgram({{0, word(0x00500093)}, {4, word(0xFE009EE3)}});
+  for (std::size_t step = 0; step < steps; ++step) {
+    auto address = (step % 2) * 4;
+    writer.beginStep(address);
+    writer.readMemory(0x100 + step, 4);
+    writer.writeRegister(step % 2 ? "pc" : "x1", word(step));
+    if (step % 3 == 0) writer.writeMemory(0x200, word(step));
+  }
+}
+
+void checkLoop(std::size_t steps) {
+  TraceReader reader(path);
+  TraceReader::Step step;
+  std::size_t count = 0;
+  while (reader.next(step)) {
+    ASSERT_LT(count, steps);
+    EXPECT_EQ((count % 2) * 4, step.address);
+    EXPECT_EQ(word(count % 2 ? 0xFE009EE3 : 0x00500093), step.encoding);
+
+    ASSERT_EQ(1, step.memoryReads.size());
+    EXPECT_EQ(0x100 + count, step.memoryReads[0].address);
+    EXPECT_EQ(4, step.memoryReads[0].amount);
+
+    ASSERT_EQ(1, step.registerWrites.size());
+    EXPECT_EQ(count % 2 ? "pc" : "x1", step.registerWrites[0].name);
+    EXPECT_EQ(word(count), step.registerWrites[0].value);
+
+    ASSERT_EQ(count % 3 == 0 ? 1 : 0, step.memoryWrites.size());
+    if (count % 3 == 0) {
+      EXPECT_EQ(0x200, step.memoryWrites[0].address);
+      EXPECT_EQ(word(count), step.memoryWrites[0].value);
+    }
+    ++count;
+  }
+  EXPECT_EQ(steps, count);
+}
+}
+
+TEST(trace, varint) {
+  TraceFormat::Buffer buffer;
+  TraceFormat::writeVarint(buffer, 0);
+  TraceFormat::writeVarint(buffer, 127);
+  TraceFormat::writeVarint(buffer, 128);
+  TraceFormat::writeVarint(buffer, UINT64_MAX);
+  EXPECT_EQ(1 + 1 + 2 + 10, buffer.size());
+
+  std::size_t position = 0;
+  std::uint64_t value;
+  for (auto expected : {std::uint64_t(0), std::uint64_t(127),
+                        std::uint64_t(128), UINT64_MAX}) {
+    ASSERT_TRUE(
+        TraceFormat::readVarint(buffer.data(), buffer.size(), position, value));
+    EXPECT_EQ(expected, value);
+  }
+  EXPECT_FALSE(
+      TraceFormat::readVarint(buffer.data(), buffer.size(), position, value));
+
+  EXPECT_EQ(-5, TraceFormat::unzigzag(TraceFormat::zigzag(-5)));
+  EXPECT_EQ(1, TraceFormat::zigzag(-1));
+}
+
+TEST(trace, compressRoundTrip) {
+  TraceFormat::Buffer data;
+  for (int index = 0; index < 10000; ++index) {
+    data.push_back(index % 7 == 0 ? index & 0xFF : 42);
+  }
+  auto compressed = TraceFormat::compress(data.data(), data.size());
+  EXPECT_LT(compressed.size(), data.size() / 2);
+
+  TraceFormat::Buffer output;
+  ASSERT_TRUE(TraceFormat::decompress(
+      compressed.data(), compressed.size(), data.size(), output));
+  EXPECT_EQ(data, output);
+
+  // corrupt input is rejected instead of read out of bounds
+  compressed.resize(compressed.size() / 2);
+  EXPECT_FALSE(TraceFormat::decompress(
+      compressed.data(), compressed.size(), data.size(), output));
+}
+
+TEST(trace, roundTrip) {
+  {
+    TraceWriter writer(path);
+    ASSERT_TRUE(writer.isGood());
+    writeLoop(writer, 1000);
+    EXPECT_EQ(1000, writer.getStepCount());
+  }
+  TraceReader reader(path);
+  EXPECT_EQ(TraceFormat::version, reader.getVersion());
+  EXPECT_FALSE(reader.isCompressed());
+  checkLoop(1000);
+  std::remove(path.c_str());
+}
+
+TEST(trace, compressedRoundTripOverManyBlocks) {
+  std::size_t uncompressedSize;
+  {
+    TraceWriter writer(path, false, 256);
+    writeLoop(writer, 10000);
+  }
+  {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    uncompressedSize = file.tellg();
+  }
+  {
+    TraceWriter writer(path, true, 256);
+    writeLoop(writer, 10000);
+  }
+  {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    EXPECT_LT(static_cast<std::size_t>(file.tellg()), uncompressedSize);
+  }
+  TraceReader reader(path);
+  EXPECT_TRUE(reader.isCompressed());
+  checkLoop(10000);
+  std::remove(path.c_str());
+}
+
+TEST(trace, boundedQueueKeepsEveryStep) {
+  {
+    // every flush has to wait until the writer took the previous block
+    TraceWriter writer(path, true, 64, 1);
+    writeLoop(writer, 10000);
+    EXPECT_EQ(10000, writer.getStepCount());
+  }
+  checkLoop(10000);
+  std::remove(path.c_str());
+}
+
+TEST(trace, recordsAfterCloseAreDropped) {
+  TraceWriter writer(path);
+  writeLoop(writer, 3);
+  writer.close();
+  writer.beginStep(8);
+  EXPECT_EQ(3, writer.getStepCount());
+  checkLoop(3);
+  std::remove(path.c_str());
+}
+
+TEST(trace, invalidFile) {
+  EXPECT_THROW(TraceReader("does-not-exist.trace"), DeserializationError);
+  {
+    std::ofstream file(path);
+    file << "not a trace at all";
+  }
+  EXPECT_THROW(TraceReader reader(path), DeserializationError);
+  std::remove(path.c_str());
+}
@@ -0,0 +1,126 @@
+/*
+* C++ Assembler Interpreter
+* Copyright (C) 2016 Chair of Computer Architecture
+* at Technical University of Munich
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Gtest has to be included before memory-value.
+// clang-format off
+#include "gtest/gtest.h"
+#include "core/memory-value.hpp"
+#include "core/memory.hpp"
+#include "core/register-set.hpp"
+#include "core/conversions.hpp"
+#include "core/undo-log.hpp"
+// clang-format on
+
+namespace {
+MemoryValue byte(int value) {
+  return conversions::convert(value, 8);
+}
+}
+
+TEST(undoLog, undoMemoryAndRegisters) {
+  Memory memory{16, 8};
+  RegisterSet registerSet{};
+  registerSet.createRegister("a", 32);
+  UndoLog log{};
+
+  log.beginStep();
+  log.recordMemory(3, memory.set(3, byte(1)));
+  log.recordRegister("a", registerSet.set("a", conversions::convert(7, 32)));
+  log.endStep();
+
+  log.beginStep();
+  log.recordMemory(3, memory.set(3, byte(2)));
+  log.recordMemory(3, memory.set(3, byte(3)));
+  log.endStep();
+
+  ASSERT_EQ(2, log.getStepCount());
+  ASSERT_EQ(byte(3), memory.get(3));
+
+  // both writes of the second step are undone, in reverse order
+  ASSERT_TRUE(log.undoStep(memory, registerSet));
+  ASSERT_EQ(byte(1), memory.get(3));
+  ASSERT_EQ(conversions::convert(7, 32), registerSet.get("a"));
+
+  ASSERT_TRUE(log.undoStep(memory, registerSet));
+  ASSERT_EQ(byte(0), memory.get(3));
+  ASSERT_EQ(conversions::convert(0, 32), registerSet.get("a"));
+
+  ASSERT_FALSE(log.undoStep(memory, registerSet));
+  ASSERT_EQ(0, log.getStepCount());
+}
+
+TEST(undoLog, undoIgnoresProtection) {
+  Memory memory{4, 8};
+  RegisterSet registerSet{};
+  UndoLog log{};
+
+  log.beginStep();
+  log.recordMemory(0, memory.set(0, byte(5)));
+  log.endStep();
+  memory.makeProtected(0, 1);
+
+  ASSERT_TRUE(log.undoStep(memory, registerSet));
+  ASSERT_EQ(byte(0), memory.get(0));
+}
+
+TEST(undoLog, emptyStepsAreDropped) {
+  UndoLog log{};
+  log.beginStep();
+  ASSERT_TRUE(log.isRecording());
+  log.endStep();
+  ASSERT_FALSE(log.isRecording());
+  ASSERT_EQ(0, log.getStepCount());
+}
+
+TEST(undoLog, boundedSize) {
+  Memory memory{4, 8};
+  RegisterSet registerSet{};
+  UndoLog log{3};
+
+  for (int i = 1; i <= 5; ++i) {
+    log.beginStep();
+    log.recordMemory(0, memory.set(0, byte(i)));
+    log.endStep();
+  }
+  ASSERT_EQ(3, log.getStepCount());
+
+  // only the three latest steps can be undone
+  while (log.undoStep(memory, registerSet)) {
+  }
+  ASSERT_EQ(byte(2), memory.get(0));
+}
+
+TEST(undoLog, clear) {
+  Memory memory{4, 8};
+  RegisterSet registerSet{};
+  UndoLog log{};
+
+  log.beginStep();
+  log.recordMemory(0, memory.set(0, byte(1)));
+  log.endStep();
+  log.clear();
+
+  ASSERT_EQ(0, log.getStepCount());
+  ASSERT_FALSE(log.undoStep(memory, registerSet));
+  ASSERT_EQ(byte(1), memory.get(0));
+}
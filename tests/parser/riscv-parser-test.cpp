@@ -18,6 +18,11 @@
 
 #include "parser/riscv/riscv-parser.hpp"
 
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <vector>
+
 #include "arch/common/architecture-formula.hpp"
 #include "arch/common/architecture.hpp"
 #include "core/memory-access.hpp"
@@ -318,3 +323,48 @@ TEST_F(RiscParserTest, SyntaxInformation) {
   }
   printIfDefined("");
 }
+
+namespace {
+using Token = SyntaxInformation::Token;
+using Span = std::tuple<std::size_t, std::size_t, Token>;
+
+std::vector<Span> lex(const SyntaxInformation& info, const std::string& line) {
+  std::vector<Span> spans;
+  for (const auto& span : info.getLexer()(line)) {
+    spans.emplace_back(span.begin, span.length, span.token);
+  }
+  return spans;
+}
+}
+
+TEST_F(RiscParserTest, SyntaxLexer) {
+  const SyntaxInformation info{parser.getSyntaxInformation()};
+  ASSERT_TRUE(static_cast<bool>(info.getLexer()));
+
+  EXPECT_EQ((std::vector<Span>{{0, 4, Token::Label},
+                               {6, 4, Token::Instruction},
+                               {11, 2, Token::Register},
+                               {15, 2, Token::Register},
+                               {19, 4, Token::Immediate},
+                               {24, 9, Token::Comment}}),
+            lex(info, "loop: addi x1, X2, 0x10 ; comment"));
+
+  EXPECT_EQ((std::vector<Span>{{2, 2, Token::Instruction},
+                               {5, 2, Token::Register},
+                               {9, 2, Token::Immediate},
+                               {11, 4, Token::Label},
+                               {15, 2, Token::Immediate},
+                               {17, 2, Token::Register},
+                               {19, 1, Token::Immediate}}),
+            lex(info, "  lw x5, -(loop)(x2)"));
+
+  // strings may contain ';' and ','
+  EXPECT_EQ((std::vector<Span>{{0, 6, Token::Instruction},
+                               {7, 7, Token::Immediate},
+                               {14, 3, Token::Comment}}),
+            lex(info, ".ascii \"a;b,c\";;;"));
+
+  EXPECT_EQ((std::vector<Span>{{0, 9, Token::Comment}}),
+            lex(info, "; comment"));
+  EXPECT_TRUE(lex(info, "").empty());
+}
@@ -0,0 +1,143 @@
+/* C++ Assembler Interpreter
+ * Copyright (C) 2016 Chair of Computer Architecture
+ * at Technical University of Munich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.*/
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "arch/common/architecture-formula.hpp"
+#include "core/conversions.hpp"
+#include "tests/system/differential-harness.hpp"
+
+#include "gtest/gtest.h"
+
+namespace {
+// the code is placed at address 0, the data area behind it must be
+// reachable by a 12 bit immediate
+constexpr std::size_t memorySize = 2048;
+constexpr std::size_t dataBegin = 1024;
+constexpr std::size_t dataEnd = 2040;
+constexpr std::size_t programLength = 200;
+constexpr std::size_t interval = 16;
+
+/**
+ * Behaves like the reference, but corrupts a register after one step. The
+ * generated programs do not use the register, so the error persists.
+ */
+class FaultyEngine : public ExecutionEngine {
+ public:
+  FaultyEngine(const ArchitectureFormula& formula, std::size_t faultyStep)
+  : _engine(formula, memorySize), _faultyStep(faultyStep), _steps(0) {
+  }
+
+  bool load(const std::string& program) override {
+    _steps = 0;
+    return _engine.load(program);
+  }
+
+  bool step() override {
+    auto stepped = _engine.step();
+    if (++_steps == _faultyStep) {
+      auto value = getMemoryAccess().getRegisterValue("x20").get();
+      value.flip(0);
+      getMemoryAccess().putRegisterValue("x20", value);
+    }
+    return stepped;
+  }
+
+  MemoryAccess& getMemoryAccess() override {
+    return _engine.getMemoryAccess();
+  }
+
+ private:
+  ReferenceEngine _engine;
+  std::size_t _faultyStep;
+  std::size_t _steps;
+};
+
+std::string getLine(const std::string& program, std::size_t number) {
+  std::istringstream stream(program);
+  std::string line;
+  for (std::size_t index = 0; index < number; ++index) {
+    std::getline(stream, line);
+  }
+  return line;
+}
+}
+
+struct DifferentialExecutionTest : public ::testing::Test {
+  void runCorpus(const ArchitectureFormula& formula,
+                 std::uint32_t firstSeed,
+                 std::uint32_t seeds) {
+    ReferenceEngine reference(formula, memorySize);
+    ProjectEngine candidate(formula, memorySize);
+    DifferentialHarness harness(reference, candidate, interval);
+    ProgramGenerator generator(reference.getArchitecture(), dataBegin, dataEnd);
+
+    for (auto seed = firstSeed; seed < firstSeed + seeds; ++seed) {
+      auto program = generator.generate(seed, programLength);
+      auto result = harness.run(program, programLength * 2);
+      ASSERT_FALSE(result.diverged) << "Seed " << seed << ": "
+                                    << result.divergence.toString();
+      EXPECT_EQ(programLength, result.steps) << "Seed " << seed;
+    }
+  }
+};
+
+TEST_F(DifferentialExecutionTest, corpusMatchesReference32) {
+  runCorpus(ArchitectureFormula("riscv", {"rv32i", "rv32m"}), 1, 10);
+}
+
+TEST_F(DifferentialExecutionTest, corpusMatchesReference64) {
+  runCorpus(
+      ArchitectureFormula("riscv", {"rv32i", "rv32m", "rv64i", "rv64m"}),
+      100,
+      10);
+}
+
+TEST_F(DifferentialExecutionTest, reportsFirstDivergence) {
+  ArchitectureFormula formula("riscv", {"rv32i"});
+  ReferenceEngine reference(formula, memorySize);
+  FaultyEngine candidate(formula, 21);
+  DifferentialHarness harness(reference, candidate, interval);
+  ProgramGenerator generator(reference.getArchitecture(), dataBegin, dataEnd);
+
+  auto program = generator.generate(7, programLength);
+  auto result = harness.run(program, programLength);
+
+  ASSERT_TRUE(result.diverged);
+  // detected at the comparison after 32 steps, located by replaying
+  EXPECT_EQ(32, result.steps);
+  EXPECT_EQ(21, result.divergence.step);
+  EXPECT_NE(std::string::npos,
+            result.divergence.instruction.find(getLine(program, 21)));
+  ASSERT_FALSE(result.divergence.differences.empty());
+  EXPECT_EQ(0, result.divergence.differences[0].find("x20"));
+}
+
+TEST_F(DifferentialExecutionTest, identicalEnginesDoNotDiverge) {
+  ArchitectureFormula formula("riscv", {"rv32i"});
+  ReferenceEngine reference(formula, memorySize);
+  ReferenceEngine candidate(formula, memorySize);
+  DifferentialHarness harness(reference, candidate, 1);
+
+  auto result = harness.run("addi x1, x0, 5\nsw x1, x0, 1024\n", 10);
+  EXPECT_FALSE(result.diverged) << result.divergence.toString();
+  EXPECT_EQ(2, result.steps);
+}
@@ -0,0 +1,442 @@
+/* C++ Assembler Interpreter
+ * Copyright (C) 2016 Chair of Computer Architecture
+ * at Technical University of Munich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.*/
+
+#include "tests/system/differential-harness.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <utility>
+
+#include "arch/common/instruction-information.hpp"
+#include "arch/common/instruction-key.hpp"
+#include "arch/common/register-information.hpp"
+#include "arch/common/unit-information.hpp"
+#include "common/translateable.hpp"
+#include "core/conversions.hpp"
+#include "parser/factory/parser-factory.hpp"
+
+namespace {
+const std::string parserName = "riscv";
+
+std::string findProgramCounter(const Architecture& architecture) {
+  for (const auto& unit : architecture.getUnits()) {
+    if (unit.hasSpecialRegister(RegisterInformation::Type::PROGRAM_COUNTER)) {
+      return unit
+          .getSpecialRegister(RegisterInformation::Type::PROGRAM_COUNTER)
+          .getName();
+    }
+  }
+  return "pc";
+}
+
+std::size_t readAddress(MemoryAccess& memoryAccess, const std::string& name) {
+  auto value = memoryAccess.getRegisterValue(name).get();
+  return conversions::convert<std::size_t>(value);
+}
+
+void reset(ProjectModule& project) {
+  auto& memoryAccess = project.getMemoryAccess();
+  // the protection of the code of the previous program is not reset
+  memoryAccess.removeMemoryProtection(0, memoryAccess.getMemorySize().get());
+  project.getMemoryManager().resetMemory();
+  project.getMemoryManager().resetRegisters();
+}
+
+std::string toHex(std::size_t value) {
+  std::ostringstream stream;
+  stream << "0x" << std::hex << value;
+  return stream.str();
+}
+}
+
+ReferenceEngine::ReferenceEngine(const ArchitectureFormula& formula,
+                                 std::size_t memorySize)
+: _project(formula, memorySize, parserName)
+, _architecture(_project.getArchitectureAccess().getArchitecture().get())
+, _programCounter(findProgramCounter(_architecture)) {
+}
+
+bool ReferenceEngine::load(const std::string& program) {
+  reset(_project);
+  auto& memoryAccess = _project.getMemoryAccess();
+  auto parser =
+      ParserFactory::createParser(_architecture, memoryAccess, parserName);
+  _finalRepresentation = parser->parse(program);
+  _addressCommandMap = _finalRepresentation.createMapping();
+  if (_finalRepresentation.errorList().hasErrors()) return false;
+
+  _lines.clear();
+  std::istringstream stream(program);
+  for (std::string line; std::getline(stream, line);) {
+    _lines.push_back(line);
+  }
+
+  // assemble the program into memory, like the execution unit does
+  const auto& commands = _finalRepresentation.commandList();
+  for (const auto& command : commands) {
+    auto assembled = command.node()->assemble();
+    memoryAccess.putMemoryValueAt(command.address(), assembled);
+    memoryAccess.makeMemoryProtected(command.address(),
+                                     assembled.getSize() / 8);
+  }
+  if (!commands.empty() && _addressCommandMap.count(0) == 0) {
+    auto size = memoryAccess.getRegisterValue(_programCounter).get().getSize();
+    auto address = conversions::convert(commands.front().address(), size);
+    memoryAccess.putRegisterValue(_programCounter, address);
+  }
+
+  return true;
+}
+
+bool ReferenceEngine::step() {
+  auto& memoryAccess = _project.getMemoryAccess();
+  auto iterator =
+      _addressCommandMap.find(readAddress(memoryAccess, _programCounter));
+  if (iterator == _addressCommandMap.end()) return false;
+
+  const auto& command = _finalRepresentation.commandList()[iterator->second];
+  if (!command.node()->validateRuntime(memoryAccess).isSuccess()) {
+    return false;
+  }
+  auto next = command.node()->getValue(memoryAccess);
+  memoryAccess.putRegisterValue(_programCounter, next);
+  return true;
+}
+
+MemoryAccess& ReferenceEngine::getMemoryAccess() {
+  return _project.getMemoryAccess();
+}
+
+std::string ReferenceEngine::disassemble(std::size_t address) const {
+  auto iterator = _addressCommandMap.find(address);
+  if (iterator == _addressCommandMap.end()) {
+    return toHex(address) + ": <no instruction>";
+  }
+
+  const auto& command = _finalRepresentation.commandList()[iterator->second];
+  std::string source;
+  std::size_t line = command.position().startLine();
+  if (line > 0 && line <= _lines.size()) source = _lines[line - 1];
+  auto encoding = command.node()->assemble().toHexString(true, false);
+
+  return toHex(address) + ": " + source + " [" + encoding + "]";
+}
+
+const Architecture& ReferenceEngine::getArchitecture() const noexcept {
+  return _architecture;
+}
+
+ProjectEngine::ProjectEngine(const ArchitectureFormula& formula,
+                             std::size_t memorySize)
+: _running(false)
+, _parsed(false)
+, _failed(false)
+, _project(formula, memorySize, parserName)
+, _programCounter(findProgramCounter(
+      _project.getArchitectureAccess().getArchitecture().get())) {
+  _project.getSleepTimer().setVirtualTime(true);
+
+  auto& parserInterface = _project.getParserInterface();
+  parserInterface.setFinalRepresentationCallback(
+      [this](const FinalRepresentation& finalRepresentation) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _addressCommandMap = finalRepresentation.createMapping();
+        _failed = finalRepresentation.errorList().hasErrors();
+        _parsed = true;
+        _condition.notify_all();
+      });
+  parserInterface.setThrowErrorCallback([this](const Translateable&) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _failed = true;
+  });
+
+  auto& commandInterface = _project.getCommandInterface();
+  commandInterface.setExecutionStoppedCallback([this] {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _running = false;
+    _condition.notify_all();
+  });
+  commandInterface.setSyncCallback([this] { _project.guiReady(); });
+}
+
+bool ProjectEngine::load(const std::string& program) {
+  reset(_project);
+  std::unique_lock<std::mutex> lock(_mutex);
+  _parsed = false;
+  _failed = false;
+  _project.getCommandInterface().parse(program);
+  _condition.wait(lock, [this] { return _parsed; });
+  return !_failed;
+}
+
+bool ProjectEngine::step() {
+  auto address = readAddress(getMemoryAccess(), _programCounter);
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_addressCommandMap.count(address) == 0) return false;
+    _running = true;
+  }
+  _project.getCommandInterface().executeNextLine();
+  _waitUntilStopped();
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  return !_failed;
+}
+
+MemoryAccess& ProjectEngine::getMemoryAccess() {
+  return _project.getMemoryAccess();
+}
+
+void ProjectEngine::_waitUntilStopped() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  _condition.wait(lock, [this] { return !_running; });
+}
+
+std::string DifferentialHarness::Divergence::toString() const {
+  std::ostringstream stream;
+  stream << "Divergence at instruction " << step << ": " << instruction;
+  for (const auto& difference : differences) {
+    stream << "\n  " << difference;
+  }
+  return stream.str();
+}
+
+DifferentialHarness::DifferentialHarness(ReferenceEngine& reference,
+                                         ExecutionEngine& candidate,
+                                         std::size_t interval)
+: _reference(reference)
+, _candidate(candidate)
+, _interval(std::max<std::size_t>(interval, 1))
+, _programCounter(findProgramCounter(reference.getArchitecture())) {
+  using Order = UnitInformation::AlphabeticOrder;
+  for (const auto& unit : reference.getArchitecture().getUnits()) {
+    for (const auto& information : unit.getAllRegisterSorted(Order{})) {
+      _registers.push_back(information.get().getName());
+    }
+    for (const auto& special : unit.getSpecialRegisters()) {
+      _registers.push_back(special.second.getName());
+    }
+  }
+}
+
+DifferentialHarness::Result
+DifferentialHarness::run(const std::string& program, std::size_t maximumSteps) {
+  Result result{0, false, Divergence()};
+  auto referenceLoaded = _reference.load(program);
+  auto candidateLoaded = _candidate.load(program);
+  if (!referenceLoaded || !candidateLoaded) {
+    result.diverged = referenceLoaded != candidateLoaded;
+    result.divergence.differences.push_back(
+        referenceLoaded ? "only the reference engine loaded the program"
+                        : "the reference engine could not load the program");
+    return result;
+  }
+
+  std::size_t lastMatch = 0;
+  while (result.steps < maximumSteps) {
+    auto referenceStepped = _reference.step();
+    auto candidateStepped = _candidate.step();
+    if (!referenceStepped && !candidateStepped) break;
+    ++result.steps;
+
+    // an engine stopping early counts as a divergence in this interval
+    bool stopped = referenceStepped != candidateStepped;
+    if (stopped || result.steps % _interval == 0) {
+      auto differences = _compare(_capture(_reference), _capture(_candidate));
+      if (stopped || !differences.empty()) {
+        result.diverged = true;
+        result.divergence = _locate(program, lastMatch);
+        return result;
+      }
+      lastMatch = result.steps;
+    }
+  }
+
+  if (lastMatch != result.steps) {
+    auto differences = _compare(_capture(_reference), _capture(_candidate));
+    if (!differences.empty()) {
+      result.diverged = true;
+      result.divergence = _locate(program, lastMatch);
+    }
+  }
+
+  return result;
+}
+
+DifferentialHarness::State
+DifferentialHarness::_capture(ExecutionEngine& engine) const {
+  auto& memoryAccess = engine.getMemoryAccess();
+  State state;
+  for (const auto& name : _registers) {
+    state.push_back(memoryAccess.getRegisterValue(name).get());
+  }
+  auto memorySize = memoryAccess.getMemorySize().get();
+  state.push_back(memoryAccess.getMemoryValueAt(0, memorySize).get());
+  return state;
+}
+
+std::vector<std::string>
+DifferentialHarness::_compare(const State& reference,
+                              const State& candidate) const {
+  // report at most this many differing memory cells
+  constexpr std::size_t maximumCells = 8;
+  std::vector<std::string> differences;
+
+  for (std::size_t index = 0; index < _registers.size(); ++index) {
+    if (reference[index] != candidate[index]) {
+      differences.push_back(_registers[index] + ": expected " +
+                            reference[index].toHexString(true, false) +
+                            ", got " +
+                            candidate[index].toHexString(true, false));
+    }
+  }
+
+  const auto& referenceMemory = reference.back().internal();
+  const auto& candidateMemory = candidate.back().internal();
+  std::size_t cells = 0;
+  auto size = std::min(referenceMemory.size(), candidateMemory.size());
+  for (std::size_t address = 0; address < size; ++address) {
+    if (referenceMemory[address] == candidateMemory[address]) continue;
+    if (++cells > maximumCells) {
+      differences.push_back("...");
+      break;
+    }
+    differences.push_back("memory[" + toHex(address) + "]: expected " +
+                          toHex(referenceMemory[address]) + ", got " +
+                          toHex(candidateMemory[address]));
+  }
+
+  return differences;
+}
+
+DifferentialHarness::Divergence
+DifferentialHarness::_locate(const std::string& program,
+                             std::size_t firstStep) {
+  _reference.load(program);
+  _candidate.load(program);
+  for (std::size_t step = 0; step < firstStep; ++step) {
+    _reference.step();
+    _candidate.step();
+  }
+
+  Divergence divergence;
+  for (std::size_t step = firstStep + 1; step <= firstStep + _interval;
+       ++step) {
+    auto address =
+        readAddress(_reference.getMemoryAccess(), _programCounter);
+    auto referenceStepped = _reference.step();
+    auto candidateStepped = _candidate.step();
+
+    divergence.step = step;
+    divergence.instruction = _reference.disassemble(address);
+    divergence.differences =
+        _compare(_capture(_reference), _capture(_candidate));
+    if (referenceStepped != candidateStepped) {
+      divergence.differences.insert(
+          divergence.differences.begin(),
+          referenceStepped ? "the candidate did not execute the instruction"
+                           : "the reference did not execute the instruction");
+    }
+    if (!divergence.differences.empty()) return divergence;
+  }
+
+  divergence.step = firstStep;
+  divergence.instruction.clear();
+  divergence.differences.assign(1, "the divergence is not reproducible");
+  return divergence;
+}
+
+ProgramGenerator::ProgramGenerator(const Architecture& architecture,
+                                   std::size_t dataBegin,
+                                   std::size_t dataEnd)
+: _dataBegin(dataBegin), _dataEnd(dataEnd) {
+  for (const auto& pair : architecture.getInstructions()) {
+    const auto& information = pair.second;
+    if (!information.hasKey() || !information.hasFormat()) continue;
+    const auto& key = information.getKey();
+    if (!key.hasKey("opcode")) continue;
+
+    auto format = information.getFormat();
+    Shape shape;
+    switch (key["opcode"]) {
+      case 0x33:// OP
+      case 0x3B:// OP-32
+        shape = Shape::REGISTERS;
+        break;
+      case 0x13:// OP-IMM
+      case 0x1B:// OP-IMM-32
+        shape = format == "R" ? Shape::SHIFT : Shape::IMMEDIATE;
+        break;
+      case 0x03: shape = Shape::LOAD; break;
+      case 0x23: shape = Shape::STORE; break;
+      case 0x37:// LUI
+      case 0x17:// AUIPC
+        shape = Shape::UPPER;
+        break;
+      // control flow, floating point and simulator instructions
+      default: continue;
+    }
+    _templates.push_back({information.getMnemonic(), shape});
+  }
+
+  // the iteration order of the instruction set is unspecified
+  std::sort(_templates.begin(),
+            _templates.end(),
+            [](const Template& first, const Template& second) {
+              return first.mnemonic < second.mnemonic;
+            });
+}
+
+std::string
+ProgramGenerator::generate(std::uint32_t seed, std::size_t length) const {
+  std::mt19937 random(seed);
+  auto uniform = [&random](std::int64_t minimum, std::int64_t maximum) {
+    return std::uniform_int_distribution<std::int64_t>(minimum,
+                                                       maximum)(random);
+  };
+  // few registers, so that instructions use each other's results
+  auto reg = [&uniform] { return "x" + std::to_string(uniform(0, 7)); };
+  auto address = [this, &uniform] {
+    auto slots = static_cast<std::int64_t>((_dataEnd - _dataBegin) / 8);
+    return std::to_string(_dataBegin + 8 * uniform(0, slots - 1));
+  };
+
+  std::ostringstream program;
+  for (std::size_t index = 0; index < length; ++index) {
+    const auto& instruction = _templates[uniform(0, _templates.size() - 1)];
+    program << instruction.mnemonic << " ";
+    switch (instruction.shape) {
+      case Shape::REGISTERS:
+        program << reg() << ", " << reg() << ", " << reg();
+        break;
+      case Shape::IMMEDIATE:
+        program << reg() << ", " << reg() << ", " << uniform(-2048, 2047);
+        break;
+      case Shape::SHIFT:
+        program << reg() << ", " << reg() << ", " << uniform(0, 31);
+        break;
+      case Shape::LOAD:
+      case Shape::STORE: program << reg() << ", x0, " << address(); break;
+      case Shape::UPPER:
+        program << reg() << ", " << uniform(0, 0xFFFFF);
+        break;
+    }
+    program << "\n";
+  }
+
+  return program.str();
+}
@@ -0,0 +1,245 @@
+/* C++ Assembler Interpreter
+ * Copyright (C) 2016 Chair of Computer Architecture
+ * at Technical University of Munich
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.*/
+
+#ifndef ERAGPSIM_TESTS_SYSTEM_DIFFERENTIAL_HARNESS_HPP
+#define ERAGPSIM_TESTS_SYSTEM_DIFFERENTIAL_HARNESS_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "arch/common/architecture-formula.hpp"
+#include "arch/common/architecture.hpp"
+#include "core/memory-access.hpp"
+#include "core/project-module.hpp"
+#include "parser/common/final-representation.hpp"
+
+/**
+ * An engine which executes a program one instruction at a time.
+ *
+ * Every engine owns its own project (memory and registers), so that two
+ * engines can run the same program side by side.
+ */
+class ExecutionEngine {
+ public:
+  virtual ~ExecutionEngine() = default;
+
+  /**
+   * Resets the state and loads a program.
+   *
+   * \param program The assembler source of the program.
+   * \return false if the program could not be assembled.
+   */
+  virtual bool load(const std::string& program) = 0;
+
+  /**
+   * Executes the instruction the program counter points to.
+   *
+   * \return false if there was no instruction or it failed.
+   */
+  virtual bool step() = 0;
+
+  /**
+   * Returns the memory access of the project of the engine.
+   */
+  virtual MemoryAccess& getMemoryAccess() = 0;
+};
+
+/**
+ * The reference semantics: calls AbstractSyntaxTreeNode::getValue on the
+ * node the program counter points to, exactly as ParsingAndExecutionUnit
+ * does, but without any of its bookkeeping.
+ */
+class ReferenceEngine : public ExecutionEngine {
+ public:
+  ReferenceEngine(const ArchitectureFormula& formula, std::size_t memorySize);
+
+  bool load(const std::string& program) override;
+  bool step() override;
+  MemoryAccess& getMemoryAccess() override;
+
+  /**
+   * Describes the instruction at an address: its source line and encoding.
+   */
+  std::string disassemble(std::size_t address) const;
+
+  /**
+   * Returns the architecture of the engine.
+   */
+  const Architecture& getArchitecture() const noexcept;
+
+ private:
+  ProjectModule _project;
+  Architecture _architecture;
+  std::string _programCounter;
+  FinalRepresentation _finalRepresentation;
+  std::unordered_map<MemoryAddress, std::size_t> _addressCommandMap;
+  std::vector<std::string> _lines;
+};
+
+/**
+ * The production path: single steps through the ParsingAndExecutionUnit via
+ * the CommandInterface, including validation, undo log and sleep handling.
+ */
+class ProjectEngine : public ExecutionEngine {
+ public:
+  ProjectEngine(const ArchitectureFormula& formula, std::size_t memorySize);
+
+  bool load(const std::string& program) override;
+  bool step() override;
+  MemoryAccess& getMemoryAccess() override;
+
+ private:
+  /** Blocks until the execution unit reports that it stopped. */
+  void _waitUntilStopped();
+
+  // the callbacks of the project use these, so they are declared first
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  std::unordered_map<MemoryAddress, std::size_t> _addressCommandMap;
+  bool _running;
+  bool _parsed;
+  bool _failed;
+
+  ProjectModule _project;
+  std::string _programCounter;
+};
+
+/**
+ * Runs a candidate engine in lock-step with the reference engine and reports
+ * the first instruction after which their states differ.
+ *
+ * The register sets and the whole memory are compared every `interval`
+ * instructions. If they differ, both engines are replayed from the start (all
+ * engines are deterministic) up to the last matching comparison, and then
+ * compared after every instruction to find the first divergence.
+ */
+class DifferentialHarness {
+ public:
+  /** The first divergence of two engines. */
+  struct Divergence {
+    /** The number of the diverging instruction, starting at 1. */
+    std::size_t step;
+
+    /** The source line and encoding of the diverging instruction. */
+    std::string instruction;
+
+    /** The differing registers and memory cells. */
+    std::vector<std::string> differences;
+
+    std::string toString() const;
+  };
+
+  struct Result {
+    /** The number of executed instructions. */
+    std::size_t steps;
+
+    /** True if the engines diverged, see `divergence`. */
+    bool diverged;
+
+    Divergence divergence;
+  };
+
+  /**
+   * \param reference The engine with the reference semantics.
+   * \param candidate The engine to check.
+   * \param interval The number of instructions between two comparisons.
+   */
+  DifferentialHarness(ReferenceEngine& reference,
+                      ExecutionEngine& candidate,
+                      std::size_t interval);
+
+  /**
+   * Runs a program on both engines.
+   *
+   * \param program The assembler source of the program.
+   * \param maximumSteps The maximum number of instructions to execute.
+   */
+  Result run(const std::string& program, std::size_t maximumSteps);
+
+ private:
+  using State = std::vector<MemoryValue>;
+
+  /** Captures all registers and the memory of an engine. */
+  State _capture(ExecutionEngine& engine) const;
+
+  /** Lists the differences of two states. */
+  std::vector<std::string> _compare(const State& reference,
+                                    const State& candidate) const;
+
+  /** Steps both engines, returns false if one of them stopped. */
+  bool _step();
+
+  /** Finds the first divergence after `firstStep`, see the class comment. */
+  Divergence _locate(const std::string& program, std::size_t firstStep);
+
+  ReferenceEngine& _reference;
+  ExecutionEngine& _candidate;
+  std::size_t _interval;
+  std::vector<std::string> _registers;
+  std::string _programCounter;
+};
+
+/**
+ * Generates random, terminating RISC-V programs from an InstructionSet, as a
+ * fuzz corpus for the differential harness.
+ *
+ * The programs are straight-line code (no branches or jumps) built from all
+ * integer instructions of the architecture, with random registers and
+ * immediates. Loads and stores only access the data area behind the code.
+ * The same seed always gives the same program.
+ */
+class ProgramGenerator {
+ public:
+  /**
+   * \param architecture The architecture whose instructions are used.
+   * \param dataBegin The first address of the data area (< 2048).
+   * \param dataEnd The end of the data area (<= 2048).
+   */
+  ProgramGenerator(const Architecture& architecture,
+                   std::size_t dataBegin,
+                   std::size_t dataEnd);
+
+  /**
+   * Generates a program.
+   *
+   * \param seed The seed of the random generator.
+   * \param length The number of instructions.
+   */
+  std::string generate(std::uint32_t seed, std::size_t length) const;
+
+ private:
+  /** The operand shapes the generator knows about. */
+  enum class Shape { REGISTERS, IMMEDIATE, SHIFT, LOAD, STORE, UPPER };
+
+  struct Template {
+    std::string mnemonic;
+    Shape shape;
+  };
+
+  std::vector<Template> _templates;
+  std::size_t _dataBegin;
+  std::size_t _dataEnd;
+};
+
+#endif /* ERAGPSIM_TESTS_SYSTEM_DIFFERENTIAL_HARNESS_HPP */
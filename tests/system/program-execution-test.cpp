@@ -15,6 +15,10 @@
  * You should have received a copy of the GNU General Public License
 * along with this program. If not, see <http://www.gnu.org/licenses/>.*/
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 #include "arch/riscv/utility.hpp"
 #include "common/utility.hpp"
 #include "core/memory-access.hpp"
@@ -27,13 +31,18 @@ using InitializerList = ArchitectureFormula::InitializerList;
 static const std::string TEST_FILE_DIR = "tests/system/testfiles/";
 static long timeout = 10000;  // 10s
 
-template <typename SizeType, bool hasMulEnabled = false, size_t memory = 256>
+template <typename SizeType,
+          bool hasMulEnabled = false,
+          size_t memory = 256,
+          bool hasAtomicEnabled = false>
 struct ProgramExecutionFixture : public ::testing::Test {
   using ErrorCallback = ParsingAndExecutionUnit::Callback<Translateable>;
 
   ProgramExecutionFixture(const std::string& file) {
     loadArchitecture();
     loadFile(file);
+    // headless runs do not need to wait for sleeps
+    _project->getSleepTimer().setVirtualTime(true);
     _project->getCommandInterface().setSyncCallback(
         [this] { this->_project->guiReady(); });
     _project->getCommandInterface().setExecutionStoppedCallback(
@@ -57,6 +66,9 @@ struct ProgramExecutionFixture : public ::testing::Test {
     if (hasMulEnabled) {
       modList.emplace_back("rv32m");
     }
+    if (hasAtomicEnabled) {
+      modList.emplace_back("rv32a");
+    }
     if (sizeof(SizeType) == 64) {
       modList.emplace_back("rv64i");
       if (hasMulEnabled) {
@@ -255,3 +267,82 @@ TEST_F(EndlessTest32, endless32) { endlessTest(); }
 
 using EndlessTest64 = EndlessTest<int64_t>;
 TEST_F(EndlessTest64, endless64) { endlessTest(); }
+
+template <typename SizeType>
+struct SleepTest : public ProgramExecutionFixture<SizeType> {
+  using super = ProgramExecutionFixture<SizeType>;
+  SleepTest() : super("sleep.txt") {}
+
+  void parseWhileSleepingTest() {
+    super::_project->getSleepTimer().setVirtualTime(false);
+    super::executeAll();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_TRUE(super::running) << "The program should sleep";
+    // replacing the program ends the suspended execution
+    super::_project->getCommandInterface().parse(super::_input);
+    super::waitUntilExecutionFinished();
+    // the wake-up must not run the new program
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    super::assertRegisterValue("x1", 0);
+  }
+};
+
+using SleepTest32 = SleepTest<int32_t>;
+TEST_F(SleepTest32, parseWhileSleeping) { parseWhileSleepingTest(); }
+
+template <typename SizeType>
+struct AtomicCounterTest
+    : public ProgramExecutionFixture<SizeType, false, 256, true> {
+  using super = ProgramExecutionFixture<SizeType, false, 256, true>;
+  AtomicCounterTest() : super("atomic_counter.txt") {}
+
+  void atomicCounterTest() {
+    super::_project->getCommandInterface().setHartCount(2);
+    super::executeAll();
+    super::waitUntilExecutionFinished();
+    // No increment of either hart may get lost
+    super::assertMemory(0, 4, 200);
+    super::assertRegisterValue("x7", 0);
+  }
+};
+
+using AtomicCounterTest32 = AtomicCounterTest<int32_t>;
+TEST_F(AtomicCounterTest32, atomicCounter32) { atomicCounterTest(); }
+
+template <typename SizeType>
+struct HartZeroFirstTest
+    : public ProgramExecutionFixture<SizeType, false, 256, true> {
+  using super = ProgramExecutionFixture<SizeType, false, 256, true>;
+  HartZeroFirstTest() : super("hart_zero_first.txt") {}
+
+  void hartZeroFirstTest() {
+    // The registers of the other harts are created anew, so they get x31 = 0
+    super::getMemoryAccess().putRegisterValue("x31",
+                                              riscv::convert<SizeType>(1));
+    super::_project->getCommandInterface().setHartCount(3);
+    super::executeAll();
+    super::waitUntilExecutionFinished();
+    // The other harts keep running after hart 0 left the program
+    super::assertMemory(0, 4, 200);
+  }
+
+  void noStepBackTest() {
+    std::atomic<bool> failed(false);
+    super::setCallbackOnError([&failed](auto) { failed = true; });
+    super::_project->getCommandInterface().setHartCount(2);
+    super::executeNext();
+    super::waitUntilExecutionFinished();
+    super::executeNext();
+    super::waitUntilExecutionFinished();
+    super::running = true;
+    super::_project->getCommandInterface().executePreviousLine();
+    super::waitUntilExecutionFinished();
+    // Stepping back is refused instead of undoing only some of the writes
+    ASSERT_TRUE(failed);
+    super::assertRegisterValue("x6", 1);
+  }
+};
+
+using HartZeroFirstTest32 = HartZeroFirstTest<int32_t>;
+TEST_F(HartZeroFirstTest32, hartZeroFirst32) { hartZeroFirstTest(); }
+TEST_F(HartZeroFirstTest32, noStepBack32) { noStepBackTest(); }